@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Compara SugiyamaLayout con Graphviz 'dot' sobre el mismo grafo sintético.
+
+Ejecuta layout_bench (que escribe el grafo en DOT), distribuye ese archivo
+con 'dot -Tplain' y muestra, para los dos, el número de capas, los cruces
+entre capas consecutivas y el tiempo.
+
+Los cruces de dot se cuentan a partir de su salida: cada arista se corta
+con la altura de cada capa que atraviesa (interpolando los puntos de
+control de su curva), y se cuentan los pares de aristas que cambian de
+orden entre dos capas seguidas, como hace el layout nativo con sus nodos
+ficticios.
+
+Uso: compare_dot.py path/a/layout_bench [--dot dot] [argumentos de layout_bench...]
+"""
+
+import argparse
+import bisect
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def run_native(bench, bench_args, dot_path):
+    output = subprocess.run([bench, *bench_args, "--dot", dot_path], check=True, capture_output=True,
+                            text=True).stdout
+    metrics = {}
+    for line in output.splitlines():
+        key, _, value = line.partition(":")
+        metrics[key.strip()] = float(value)
+    return metrics
+
+
+def run_dot(dot, dot_path):
+    start = time.perf_counter()
+    output = subprocess.run([dot, "-Tplain", dot_path], check=True, capture_output=True, text=True).stdout
+    seconds = time.perf_counter() - start
+
+    nodes = {}
+    edges = []
+    for line in output.splitlines():
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "node":
+            nodes[fields[1]] = (float(fields[2]), float(fields[3]))
+        elif fields[0] == "edge":
+            count = int(fields[3])
+            points = [(float(fields[4 + 2 * i]), float(fields[5 + 2 * i])) for i in range(count)]
+            edges.append((fields[1], fields[2], points))
+    return nodes, edges, seconds
+
+
+def x_at(points, y):
+    """La x de la polilínea de control a la altura 'y'."""
+    for (x0, y0), (x1, y1) in zip(points, points[1:]):
+        if min(y0, y1) <= y <= max(y0, y1):
+            return x0 if y0 == y1 else x0 + (x1 - x0) * (y - y0) / (y1 - y0)
+    return min(points, key=lambda p: abs(p[1] - y))[0]
+
+
+def count_inversions(values):
+    """Pares i < j con values[i] > values[j] (Fenwick sobre los rangos)."""
+    ranks = {v: i + 1 for i, v in enumerate(sorted(set(values)))}
+    tree = [0] * (len(ranks) + 1)
+    inversions = 0
+    for seen, value in enumerate(values):
+        rank = ranks[value]
+        below = 0
+        i = rank
+        while i > 0:
+            below += tree[i]
+            i -= i & -i
+        inversions += seen - below
+        i = rank
+        while i < len(tree):
+            tree[i] += 1
+            i += i & -i
+    return inversions
+
+
+def dot_metrics(nodes, edges):
+    # Las capas de dot son las alturas distintas de los centros (la y crece hacia arriba).
+    levels = sorted({round(y, 3) for _, y in nodes.values()}, reverse=True)
+    segments = [[] for _ in range(max(0, len(levels) - 1))]  # (x arriba, x abajo) por hueco
+    descending = [-y for y in levels]
+    for tail, head, points in edges:
+        top, bottom = nodes[tail], nodes[head]
+        if top[1] < bottom[1]:
+            top, bottom = bottom, top
+        first = bisect.bisect_left(descending, -round(top[1], 3))
+        last = bisect.bisect_left(descending, -round(bottom[1], 3))
+        route = [top, *sorted(points, key=lambda p: -p[1]), bottom]
+        for gap in range(first, last):
+            upper = route[0][0] if gap == first else x_at(route, levels[gap])
+            lower = route[-1][0] if gap + 1 == last else x_at(route, levels[gap + 1])
+            segments[gap].append((upper, lower))
+
+    crossings = 0
+    for gap in segments:
+        gap.sort()
+        # Empates arriba (mismo origen) no cruzan: se ordenan también por abajo.
+        crossings += count_inversions([lower for _, lower in gap])
+    return len(levels), crossings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bench", help="layout_bench executable")
+    parser.add_argument("--dot", default="dot", help="Graphviz dot executable")
+    args, bench_args = parser.parse_known_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        dot_path = os.path.join(directory, "graph.dot")
+        native = run_native(args.bench, bench_args, dot_path)
+        try:
+            nodes, edges, seconds = run_dot(args.dot, dot_path)
+        except FileNotFoundError:
+            print(f"Error: '{args.dot}' not found (install Graphviz or pass --dot)", file=sys.stderr)
+            return 1
+    layers, crossings = dot_metrics(nodes, edges)
+
+    print(f"graph: {int(native['nodes'])} nodes, {int(native['edges'])} edges")
+    print(f"{'':12}{'native':>14}{'dot':>14}")
+    print(f"{'layers':12}{int(native['layers']):>14}{layers:>14}")
+    print(f"{'crossings':12}{int(native['crossings']):>14}{crossings:>14}")
+    print(f"{'time (ms)':12}{native['total_ms']:>14.1f}{seconds * 1000:>14.1f}")
+    print(f"native phases (ms): cycles {native['cycle_breaking_ms']:.1f}, layering {native['layering_ms']:.1f}, "
+          f"crossings {native['crossing_reduction_ms']:.1f}, coordinates {native['coordinate_assignment_ms']:.1f}; "
+          f"{int(native['dummy_nodes'])} dummy nodes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,157 @@
+/**
+ * @file layout_bench.cpp
+ * @brief Métricas de SugiyamaLayout (cruces, nodos ficticios, tiempo por
+ *        fase) sobre un grafo de clases sintético y reproducible.
+ *
+ * El grafo imita un proyecto: bosques de herencia poco profundos (la base
+ * es una clase reciente, como en un módulo) y asociaciones, casi todas a
+ * clases cercanas y algunas a cualquiera, que pueden formar ciclos. Con
+ * '--dot' se escribe el mismo grafo en formato DOT para compararlo con
+ * Graphviz (compare_dot.py). Con '--layer-associations' las asociaciones
+ * también asignan capas (LayoutOptions::layerAssociations).
+ *
+ * Uso: layout_bench [--nodes N] [--locality L] [--seed S] [--threads T]
+ *                   [--layer-associations] [--dot archivo.dot]
+ *
+ * La salida son líneas "clave: valor" en stdout.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "layout/SugiyamaLayout.h"
+
+using namespace cppuml;
+
+namespace {
+
+constexpr int kMaxDepth = 5; ///< Niveles de herencia como máximo
+
+/**
+ * @brief El grafo sintético: ~0.7 herencias y ~0.9 asociaciones por nodo.
+ * @param locality Las asociaciones locales van a una de las 'locality'
+ *        clases anteriores o posteriores; una de cada diez, a cualquiera.
+ */
+layout::LayoutGraph generateGraph(std::size_t nodes, std::size_t locality, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> width(80.0, 220.0);
+    std::uniform_real_distribution<double> height(40.0, 160.0);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    layout::LayoutGraph graph;
+    graph.nodes.reserve(nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        graph.nodes.push_back(layout::LayoutNode{nullptr, width(random), height(random)});
+    }
+    std::vector<int> depth(nodes, 0); ///< Profundidad de cada clase en su jerarquía
+    for (std::size_t i = 1; i < nodes; ++i) {
+        if (chance(random) < 0.7) {
+            // La base, entre las 40 clases anteriores (base -> derivada), sin
+            // pasar de 'kMaxDepth' niveles: las jerarquías reales son bajas.
+            const std::size_t window = std::min<std::size_t>(i, 40);
+            const std::size_t base = i - 1 - std::uniform_int_distribution<std::size_t>(0, window - 1)(random);
+            if (depth[base] < kMaxDepth) {
+                depth[i] = depth[base] + 1;
+                graph.edges.push_back({base, i, RelationshipKind::Inheritance});
+            }
+        }
+        if (chance(random) < 0.9) {
+            const bool local = chance(random) < 0.9;
+            const std::size_t first = local && i > locality ? i - locality : 0;
+            const std::size_t last = local ? std::min(nodes - 1, i + locality) : nodes - 1;
+            const std::size_t target = std::uniform_int_distribution<std::size_t>(first, last)(random);
+            if (target != i) {
+                const RelationshipKind kind = chance(random) < 0.5 ? RelationshipKind::Association
+                                                                   : RelationshipKind::Composition;
+                graph.edges.push_back({i, target, kind});
+            }
+        }
+    }
+    return graph;
+}
+
+/**
+ * @brief El grafo en DOT, con los mismos tamaños (en pulgadas, a 72 ppp)
+ *        y separaciones que el layout nativo.
+ */
+bool writeDot(const layout::LayoutGraph& graph, const layout::LayoutOptions& options, const std::string& path) {
+    std::ofstream out(path);
+    out << "digraph bench {\n"
+        << "  graph [ranksep=" << options.layerSpacing / 72.0 << ", nodesep=" << options.nodeSpacing / 72.0
+        << "];\n"
+        << "  node [shape=box, fixedsize=true, label=\"\"];\n";
+    for (std::size_t i = 0; i < graph.nodes.size(); ++i) {
+        out << "  n" << i << " [width=" << graph.nodes[i].width / 72.0 << ", height=" << graph.nodes[i].height / 72.0
+            << "];\n";
+    }
+    for (const auto& edge : graph.edges) {
+        out << "  n" << edge.source << " -> n" << edge.target << ";\n";
+    }
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t nodes = 2000;
+    std::size_t locality = 100;
+    unsigned seed = 1;
+    layout::LayoutOptions options;
+    std::string dotPath;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--nodes") == 0 && hasValue) {
+            nodes = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--locality") == 0 && hasValue) {
+            locality = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--layer-associations") == 0) {
+            options.layerAssociations = true;
+        } else if (std::strcmp(argv[i], "--dot") == 0 && hasValue) {
+            dotPath = argv[++i];
+        } else {
+            std::cerr << "Usage: layout_bench [--nodes N] [--locality L] [--seed S] [--threads T]\n"
+                         "                    [--layer-associations] [--dot FILE]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    const layout::LayoutGraph graph = generateGraph(nodes, locality, seed);
+    if (!dotPath.empty() && !writeDot(graph, options, dotPath)) {
+        std::cerr << "Error: could not write " << dotPath << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const layout::LayoutResult result = layout::SugiyamaLayout(options).run(graph);
+    const double totalMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const auto reversed = std::count(result.reversedEdges.begin(), result.reversedEdges.end(), true);
+    std::cout << "nodes: " << graph.nodes.size() << '\n'
+              << "edges: " << graph.edges.size() << '\n'
+              << "reversed_edges: " << reversed << '\n'
+              << "layers: " << result.layerCount << '\n'
+              << "dummy_nodes: " << result.dummyCount << '\n'
+              << "direct_edges: " << result.directEdges << '\n'
+              << "crossings: " << result.crossings << '\n'
+              << "width: " << result.width << '\n'
+              << "height: " << result.height << '\n'
+              << "cycle_breaking_ms: " << result.cycleBreakingMs << '\n'
+              << "layering_ms: " << result.layeringMs << '\n'
+              << "crossing_reduction_ms: " << result.crossingReductionMs << '\n'
+              << "coordinate_assignment_ms: " << result.coordinateAssignmentMs << '\n'
+              << "total_ms: " << totalMs << '\n';
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file visitor_bench.cpp
+ * @brief Cursores por segundo del despacho de AstVisitor: la tabla indexada
+ *        por CXCursorKind frente al 'switch' anterior.
+ *
+ * Analiza una TU de prueba una vez y la recorre varias veces con tres
+ * visitantes que solo se distinguen en cómo despachan cada cursor:
+ *
+ * - walk:   devuelve siempre Recurse (el coste del propio recorrido). Baja
+ *           también a las cabeceras del sistema, así que solo sus
+ *           cursores/s son comparables con los otros dos, no su ms/walk.
+ * - switch: como el visitNode anterior: comprueba la cabecera del sistema y
+ *           copia el nombre del cursor en un std::string antes del 'switch'.
+ * - table:  como el visitNode actual: lee el tipo y llama al manejador de la
+ *           tabla; solo las declaraciones miran la ubicación.
+ *
+ * Los manejadores no construyen el modelo (eso no cambió): cuentan las
+ * clases y los miembros que la visita real crearía, y los dos visitantes
+ * deben dar los mismos números.
+ *
+ * Uso: visitor_bench [archivo.cpp] [repeticiones] [-- flags del compilador]
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <clang-c/Index.h>
+
+#ifndef BENCH_FIXTURE
+#define BENCH_FIXTURE "test/test_inputs/level3_templates_and_overloads.cpp"
+#endif
+
+namespace {
+
+/**
+ * @brief Lo que encontró un recorrido.
+ */
+struct WalkCounts {
+    std::size_t cursors = 0; ///< Llamadas al visitante
+    std::size_t records = 0; ///< Definiciones de clase fuera de cabeceras del sistema
+    std::size_t members = 0; ///< Campos, métodos, bases y parámetros de plantilla
+};
+
+bool inSystemHeader(CXCursor cursor) {
+    return clang_Location_isInSystemHeader(clang_getCursorLocation(cursor)) != 0;
+}
+
+constexpr bool isRecord(CXCursorKind kind) {
+    return kind == CXCursor_ClassDecl || kind == CXCursor_StructDecl || kind == CXCursor_UnionDecl ||
+           kind == CXCursor_ClassTemplate || kind == CXCursor_ClassTemplatePartialSpecialization;
+}
+
+constexpr bool isMember(CXCursorKind kind) {
+    return kind == CXCursor_FieldDecl || kind == CXCursor_VarDecl || kind == CXCursor_CXXMethod ||
+           kind == CXCursor_CXXBaseSpecifier || kind == CXCursor_TemplateTypeParameter ||
+           kind == CXCursor_NonTypeTemplateParameter || kind == CXCursor_TemplateTemplateParameter;
+}
+
+// --- walk ---
+
+CXChildVisitResult walkOnly(CXCursor, CXCursor, CXClientData data) {
+    ++static_cast<WalkCounts*>(data)->cursors;
+    return CXChildVisit_Recurse;
+}
+
+// --- switch (el visitNode anterior) ---
+
+CXChildVisitResult switchVisit(CXCursor cursor, CXCursor, CXClientData data) {
+    WalkCounts& counts = *static_cast<WalkCounts*>(data);
+    ++counts.cursors;
+    const CXCursorKind kind = clang_getCursorKind(cursor);
+    if (inSystemHeader(cursor)) {
+        return CXChildVisit_Continue;
+    }
+    CXString spelling = clang_getCursorSpelling(cursor);
+    const std::string name = clang_getCString(spelling);
+    clang_disposeString(spelling);
+
+    switch (kind) {
+        case CXCursor_Namespace:
+            return CXChildVisit_Recurse;
+        case CXCursor_ClassDecl:
+        case CXCursor_StructDecl:
+        case CXCursor_UnionDecl:
+        case CXCursor_ClassTemplate:
+        case CXCursor_ClassTemplatePartialSpecialization:
+            if (!clang_isCursorDefinition(cursor)) return CXChildVisit_Continue;
+            counts.records += name.empty() ? 0 : 1;
+            return CXChildVisit_Recurse;
+        case CXCursor_TemplateTypeParameter:
+        case CXCursor_NonTypeTemplateParameter:
+        case CXCursor_TemplateTemplateParameter:
+        case CXCursor_FieldDecl:
+        case CXCursor_VarDecl:
+        case CXCursor_CXXMethod:
+        case CXCursor_CXXBaseSpecifier:
+            ++counts.members;
+            return CXChildVisit_Continue;
+        default:
+            return CXChildVisit_Recurse;
+    }
+}
+
+// --- table (el visitNode actual) ---
+
+using Handler = CXChildVisitResult (*)(CXCursor, WalkCounts&);
+using HandlerTable = std::array<Handler, CXCursor_OverloadCandidate + 1>;
+
+CXChildVisitResult recurse(CXCursor, WalkCounts&) { return CXChildVisit_Recurse; }
+CXChildVisitResult skip(CXCursor, WalkCounts&) { return CXChildVisit_Continue; }
+
+CXChildVisitResult declaration(CXCursor cursor, WalkCounts&) {
+    return inSystemHeader(cursor) ? CXChildVisit_Continue : CXChildVisit_Recurse;
+}
+
+CXChildVisitResult record(CXCursor cursor, WalkCounts& counts) {
+    if (inSystemHeader(cursor) || !clang_isCursorDefinition(cursor)) return CXChildVisit_Continue;
+    // El nombre solo se pide aquí (el visitante real lo lee en un búfer reutilizado).
+    CXString spelling = clang_getCursorSpelling(cursor);
+    counts.records += *clang_getCString(spelling) ? 1 : 0;
+    clang_disposeString(spelling);
+    return CXChildVisit_Recurse;
+}
+
+CXChildVisitResult member(CXCursor cursor, WalkCounts& counts) {
+    if (!inSystemHeader(cursor)) ++counts.members;
+    return CXChildVisit_Continue;
+}
+
+constexpr HandlerTable makeHandlerTable() {
+    HandlerTable table{};
+    auto fill = [&table](int first, int last, Handler handler) {
+        for (int kind = first; kind <= last; ++kind) table[static_cast<std::size_t>(kind)] = handler;
+    };
+    fill(0, CXCursor_OverloadCandidate, &recurse);
+    fill(CXCursor_FirstRef, CXCursor_LastRef, &skip);
+    fill(CXCursor_FirstInvalid, CXCursor_LastInvalid, &skip);
+    fill(CXCursor_FirstAttr, CXCursor_LastAttr, &skip);
+    fill(CXCursor_FirstPreprocessing, CXCursor_LastPreprocessing, &skip);
+    fill(CXCursor_FirstDecl, CXCursor_LastDecl, &declaration);
+    fill(CXCursor_FirstExtraDecl, CXCursor_LastExtraDecl, &declaration);
+    table[CXCursor_Namespace] = &declaration;
+    for (int kind = 0; kind <= CXCursor_OverloadCandidate; ++kind) {
+        const auto cursorKind = static_cast<CXCursorKind>(kind);
+        if (isRecord(cursorKind)) table[static_cast<std::size_t>(kind)] = &record;
+        if (isMember(cursorKind)) table[static_cast<std::size_t>(kind)] = &member;
+    }
+    return table;
+}
+
+const HandlerTable kHandlers = makeHandlerTable();
+
+CXChildVisitResult tableVisit(CXCursor cursor, CXCursor, CXClientData data) {
+    WalkCounts& counts = *static_cast<WalkCounts*>(data);
+    ++counts.cursors;
+    const auto kind = static_cast<std::size_t>(clang_getCursorKind(cursor));
+    if (kind >= kHandlers.size()) return CXChildVisit_Recurse;
+    return kHandlers[kind](cursor, counts);
+}
+
+// --- Medición ---
+
+/**
+ * @brief Recorre la TU 'repeats' veces y escribe una línea con el resultado.
+ */
+WalkCounts measure(const char* label, CXTranslationUnit unit, CXCursorVisitor visitor, int repeats) {
+    WalkCounts counts;
+    const CXCursor root = clang_getTranslationUnitCursor(unit);
+    clang_visitChildren(root, visitor, &counts); // Calentamiento
+    counts = WalkCounts();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) clang_visitChildren(root, visitor, &counts);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double perWalk = static_cast<double>(counts.cursors) / repeats;
+    std::cout << label << ": " << static_cast<std::size_t>(perWalk) << " cursors/walk, "
+              << static_cast<std::size_t>(static_cast<double>(counts.cursors) / seconds) << " cursors/s, "
+              << (seconds * 1e3 / repeats) << " ms/walk, " << counts.records / static_cast<std::size_t>(repeats)
+              << " records, " << counts.members / static_cast<std::size_t>(repeats) << " members\n";
+    counts.records /= static_cast<std::size_t>(repeats);
+    counts.members /= static_cast<std::size_t>(repeats);
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string fixture = BENCH_FIXTURE;
+    int repeats = 200;
+    std::vector<const char*> args{"-xc++", "-std=c++17"};
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--") == 0) {
+            args.insert(args.end(), argv + i + 1, argv + argc);
+            break;
+        }
+        if (i == 1) {
+            fixture = argv[i];
+        } else {
+            repeats = std::max(1, std::atoi(argv[i]));
+        }
+    }
+
+    CXIndex index = clang_createIndex(0, 0);
+    CXTranslationUnit unit = nullptr;
+    const CXErrorCode error = clang_parseTranslationUnit2(index, fixture.c_str(), args.data(),
+                                                          static_cast<int>(args.size()), nullptr, 0,
+                                                          CXTranslationUnit_None, &unit);
+    if (error != CXError_Success || !unit) {
+        std::cerr << "Error: could not parse " << fixture << '\n';
+        clang_disposeIndex(index);
+        return EXIT_FAILURE;
+    }
+
+    std::cout << fixture << " (" << repeats << " walks)\n";
+    measure("walk  ", unit, walkOnly, repeats);
+    const WalkCounts before = measure("switch", unit, switchVisit, repeats);
+    const WalkCounts after = measure("table ", unit, tableVisit, repeats);
+
+    clang_disposeTranslationUnit(unit);
+    clang_disposeIndex(index);
+    if (before.records != after.records || before.members != after.members) {
+        std::cerr << "Error: the visitors disagree on the records/members found\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,1210 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "daemon/AnalysisDaemon.h"
+#include "daemon/DaemonClient.h"
+#include "diff/ModelDiff.h"
+#include "exporter/DiagramFarm.h"
+#include "exporter/NdjsonExporter.h"
+#include "exporter/PlantUmlExporter.h"
+#include "exporter/SvgExporter.h"
+#include "graph/RelationshipGraph.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Model.h"
+#include "parser/compilation_database.h"
+#include "parser/include_graph.h"
+#include "parser/libclang_parser.h"
+#include "parser/memory_monitor.h"
+#include "parser/parse_scheduler.h"
+#include "parser/pch_builder.h"
+#include "parser/process_pool.h"
+#include "parser/unity_batcher.h"
+#include "pipeline/AnalysisPipeline.h"
+#include "search/SymbolIndex.h"
+#include "serialization/ModelSerializer.h"
+#include "store/ModelStore.h"
+#include "streaming/StreamingAnalyzer.h"
+
+namespace {
+
+// --- Utilidades de la CLI ---
+
+void printUsage(std::ostream& out) {
+    out << "Usage: cpp-uml-generator <command> [options] <files...> [-- <compile args>]\n"
+           "\n"
+           "Commands:\n"
+           "  query <pattern>    Search classes, members and namespaces by name\n"
+           "      --mode M       exact | prefix | substring | fuzzy (default: substring)\n"
+           "      --limit N      Maximum number of results (default: 50, 0 = all)\n"
+           "      --interactive  Read one query per line from stdin (no <pattern>)\n"
+           "      --jobs N       Parse in N isolated worker processes (default: 1)\n"
+           "      --include-graph F  Save each TU's include set to F after parsing\n"
+           "      --timings F    With --jobs: dispatch longest TUs first using timings in F\n"
+           "                     (also records each TU's peak memory for --memory)\n"
+           "      --memory MB    Admit parallel parses by memory instead of count: stay\n"
+           "                     within MB (or 'auto' = 90% of the container limit), with\n"
+           "                     up to --jobs (default: all cores) parses at once\n"
+           "      --compile-db D Take files and flags from D/compile_commands.json\n"
+           "                     (<files> then only selects entries; none = all)\n"
+           "      --pch D        Precompile the headers shared by each flag group into D\n"
+           "      --unity        Parse headers in batches: one in-memory TU per group of\n"
+           "                     headers with the same flags that share <...> includes,\n"
+           "                     sized to the memory history (--timings, --memory)\n"
+           "      --skim         Quick structural parse of each file alone, without its\n"
+           "                     includes: tolerates missing headers and flags; unknown\n"
+           "                     types are kept as written and marked unresolved\n"
+           "      --include-namespace G / --exclude-namespace G\n"
+           "                     Model only namespaces matching the glob G (and their nested\n"
+           "                     ones) / skip them ('*' and '?'; repeatable)\n"
+           "      --include-path G / --exclude-path G\n"
+           "                     Same for the file that declares each class\n"
+           "      --include-class RE / --exclude-class RE\n"
+           "                     Same for the qualified class name (ECMAScript regex)\n"
+           "      --min-visibility V  public | protected | private (default): omit less\n"
+           "                     visible members\n"
+           "      --filter F     Read those rules from F, one 'key value' per line\n"
+           "                     (key = option name without '--')\n"
+           "  snapshot -o F      Parse the files and save the model to F\n"
+           "      --lazy         Save a tiered index for 'inspect' instead: a skeleton\n"
+           "                     (namespaces, classes, relationships) plus per-class\n"
+           "                     member blocks read on demand\n"
+           "                     (accepts --jobs, --compile-db, --pch and the filters)\n"
+           "  inspect <index> [classes...]\n"
+           "                     Open an index saved with 'snapshot --lazy' (skeleton only)\n"
+           "                     and show each class with its members, loaded on demand\n"
+           "      --cache MB     Memory for loaded member details, LRU (default: 64)\n"
+           "      --interactive  Read one class name per line from stdin\n"
+           "  export -o F        Write the model to F ('-' = stdout)\n"
+           "      --format X     ndjson | plantuml | svg (default: ndjson); svg lays out the\n"
+           "                     whole model with the built-in renderer\n"
+           "      --model S      Export a saved model instead of parsing files\n"
+           "      --threads N    ndjson: formatting threads; svg: layout threads\n"
+           "                     (default: all cores)\n"
+           "      --queue N      ndjson from sources: TUs buffered between the parse, resolve\n"
+           "                     and export stages, which run concurrently (default: 16)\n"
+           "      --stream-memory MB  plantuml: bounded-memory mode; reduce each TU and\n"
+           "                     spill sorted records to disk beyond MB megabytes\n"
+           "      --spill-dir D  Where to write spill runs (default: system temp dir)\n"
+           "      --max-classes N / --max-members N / --max-edges N\n"
+           "                     plantuml render budget (default: 400 / 40 / 1000; 0 = no\n"
+           "                     limit): fold namespaces, group overloads and drop the\n"
+           "                     lightest edges beyond it; the cuts are listed on stderr\n"
+           "                     (also accepts --jobs, --compile-db, --pch and the filters)\n"
+           "  diagrams -o D      Write one small .puml per class into D (<ns>/.../<Class>.puml):\n"
+           "                     the class, its direct bases and its associations; the\n"
+           "                     model is built once and files are generated in parallel.\n"
+           "                     Files whose content did not change are left untouched;\n"
+           "                     diagrams of classes no longer in the model are deleted\n"
+           "      --model S      Use a saved model instead of parsing files\n"
+           "      --threads N    Generation threads (default: all cores)\n"
+           "      --render R     none (default) | svg (built-in renderer) | a command that\n"
+           "                     gets .puml paths appended, e.g. \"plantuml -tsvg\"; only\n"
+           "                     changed diagrams or those without an image are rendered\n"
+           "      --render-jobs N  Renders at once (default: all cores)\n"
+           "      --render-batch N  .puml files per command run (default: 64)\n"
+           "      --render-ext E Image the command writes next to each .puml (default: .svg)\n"
+           "      --keep-stale   Do not delete diagrams of classes no longer in the model\n"
+           "                     (also accepts --max-members, --jobs, --compile-db, --pch\n"
+           "                     and the filters)\n"
+           "  diff <A> <B>       Report structural changes between two saved models\n"
+           "      --plantuml F   Also write a highlighted PlantUML diff diagram to F\n"
+           "  affected --include-graph F <changed files...>\n"
+           "                     List the TUs that must be reparsed after those files changed\n"
+           "  daemon --socket S  Parse once, keep the model resident and answer requests on\n"
+           "                     the Unix socket S; reparses affected TUs when files change\n"
+           "      --poll MS      How often to check files for changes (default: 500)\n"
+           "      --live-memory MB  Limit for the warm libclang TUs (default: 1024)\n"
+           "                     (also accepts --compile-db, --pch, the filters and the\n"
+           "                     --max-* render budget; --jobs, --memory, --timings,\n"
+           "                     --include-graph, --unity and --skim are rejected)\n"
+           "  ask --socket S <request...>\n"
+           "                     Send a request to a running daemon and print the reply:\n"
+           "                     query <pattern> [mode] [limit] | export [plantuml|ndjson] |\n"
+           "                     focus <class> [depth] | subclasses <class> | bases <class> |\n"
+           "                     isa <derived> <base> | dependents <class> [depth] |\n"
+           "                     update [files...] | status | stop\n"
+           "\n"
+           "Everything after '--' is passed to libclang as compiler arguments.\n";
+}
+
+/**
+ * @brief Argumentos comunes: archivos de entrada y flags del compilador.
+ */
+struct CommandLine {
+    std::vector<std::string> positional;  ///< Argumentos antes de '--' que no son opciones
+    std::vector<std::string> options;     ///< Opciones ('--x' y su valor, en orden)
+    std::vector<std::string> compileArgs; ///< Todo lo que sigue a '--'
+};
+
+/**
+ * @brief Separa los argumentos de un comando.
+ *
+ * Las opciones con valor se normalizan a la forma "--opt=valor" tanto si se
+ * escribieron así como si se escribieron "--opt valor".
+ *
+ * @param valued Nombres de las opciones que llevan valor (p.ej., "--mode", "-o").
+ */
+CommandLine splitArguments(int argc, char** argv, int first, const std::vector<std::string>& valued) {
+    CommandLine cmd;
+    bool afterSeparator = false;
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (afterSeparator) {
+            cmd.compileArgs.push_back(std::move(arg));
+        } else if (arg == "--") {
+            afterSeparator = true;
+        } else if ((arg.size() > 2 && arg.compare(0, 2, "--") == 0) ||
+                   std::find(valued.begin(), valued.end(), arg) != valued.end()) {
+            const bool takesValue = std::find(valued.begin(), valued.end(), arg) != valued.end();
+            if (takesValue && i + 1 < argc) {
+                arg += '=';
+                arg += argv[++i];
+            }
+            cmd.options.push_back(std::move(arg));
+        } else {
+            cmd.positional.push_back(std::move(arg));
+        }
+    }
+    return cmd;
+}
+
+/**
+ * @brief Opciones de análisis compartidas por los comandos.
+ */
+struct AnalyzeOptions {
+    unsigned jobs = 1;           ///< > 1: procesos aislados (ProcessPool)
+    std::string timingsPath;     ///< Historial de tiempos para el orden LPT (opcional)
+    std::string includeGraphPath; ///< Grafo de inclusiones a actualizar (opcional)
+    std::string compileDbPath;   ///< Directorio con compile_commands.json (opcional)
+    std::string pchDirectory;    ///< Generar PCHs por grupo de flags en este directorio (opcional)
+    cppuml::parser::ScopeFilterSpec filter; ///< Alcance del modelo (reglas de la línea de comandos)
+    std::string filterPath;      ///< Archivo con más reglas de alcance (opcional)
+    std::size_t memoryBytes = 0; ///< > 0: admitir análisis por memoria en lugar de por número de procesos
+    bool unity = false;          ///< Analizar las cabeceras en lotes unity (UnityBatcher)
+    bool skim = false;           ///< Análisis rápido sin inclusiones (LibClangParser::setSkim)
+};
+
+/**
+ * @brief Opciones del filtro de alcance: llevan valor y pueden repetirse.
+ */
+std::vector<std::string> withFilterOptions(std::vector<std::string> valued) {
+    for (const char* name : {"--filter", "--include-namespace", "--exclude-namespace", "--include-path",
+                             "--exclude-path", "--include-class", "--exclude-class", "--min-visibility"}) {
+        valued.emplace_back(name);
+    }
+    return valued;
+}
+
+/**
+ * @brief Opciones del presupuesto de renderizado PlantUML (--max-classes, --max-members, --max-edges).
+ * @return false si 'opt' no es una de ellas.
+ */
+bool parseBudgetOption(const std::string& opt, cppuml::exporter::RenderBudget& budget) {
+    const auto value = [&](std::size_t prefix) {
+        return static_cast<std::size_t>(std::strtoul(opt.c_str() + prefix, nullptr, 10));
+    };
+    if (opt.compare(0, 14, "--max-classes=") == 0) {
+        budget.maxClasses = value(14);
+    } else if (opt.compare(0, 14, "--max-members=") == 0) {
+        budget.maxMembersPerClass = value(14);
+    } else if (opt.compare(0, 12, "--max-edges=") == 0) {
+        budget.maxEdges = value(12);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta una opción de análisis común.
+ * @return false si 'opt' no es una opción de análisis.
+ */
+bool parseAnalyzeOption(const std::string& opt, AnalyzeOptions& options) {
+    if (opt.compare(0, 7, "--jobs=") == 0) {
+        options.jobs = static_cast<unsigned>(std::strtoul(opt.c_str() + 7, nullptr, 10));
+    } else if (opt.compare(0, 16, "--include-graph=") == 0) {
+        options.includeGraphPath = opt.substr(16);
+    } else if (opt.compare(0, 10, "--timings=") == 0) {
+        options.timingsPath = opt.substr(10);
+    } else if (opt.compare(0, 13, "--compile-db=") == 0) {
+        options.compileDbPath = opt.substr(13);
+    } else if (opt.compare(0, 6, "--pch=") == 0) {
+        options.pchDirectory = opt.substr(6);
+    } else if (opt.compare(0, 9, "--filter=") == 0) {
+        options.filterPath = opt.substr(9);
+    } else if (opt == "--unity") {
+        options.unity = true;
+    } else if (opt == "--skim") {
+        options.skim = true;
+    } else if (opt == "--memory=auto") {
+        // Margen para el propio proceso y la caché de páginas del contenedor.
+        options.memoryBytes = cppuml::parser::memory::containerLimitBytes() / 10 * 9;
+    } else if (opt.compare(0, 9, "--memory=") == 0) {
+        options.memoryBytes = static_cast<std::size_t>(std::strtoul(opt.c_str() + 9, nullptr, 10)) << 20;
+    } else {
+        // Las reglas de alcance usan como opción el nombre de la clave ("--exclude-path=...").
+        const auto equals = opt.find('=');
+        return opt.compare(0, 2, "--") == 0 && equals != std::string::npos &&
+               cppuml::parser::ScopeFilter::addRule(opt.substr(2, equals - 2), opt.substr(equals + 1),
+                                                    options.filter);
+    }
+    return true;
+}
+
+/**
+ * @brief Compila el filtro de alcance (nullptr si no hay reglas).
+ * @return false si el archivo de reglas o una expresión no son válidos.
+ */
+bool compileFilter(const AnalyzeOptions& options, std::shared_ptr<const cppuml::parser::ScopeFilter>& filter) {
+    cppuml::parser::ScopeFilterSpec spec = options.filter;
+    if (!options.filterPath.empty() && !cppuml::parser::ScopeFilter::loadSpec(options.filterPath, spec)) {
+        return false;
+    }
+    filter.reset();
+    if (spec.empty()) {
+        return true;
+    }
+    auto compiled = std::make_shared<cppuml::parser::ScopeFilter>();
+    if (!compiled->compile(spec)) {
+        return false;
+    }
+    filter = std::move(compiled);
+    return true;
+}
+
+/**
+ * @brief Construye la cola de trabajos: de la base de compilación o de la línea de comandos.
+ * @return false si la base de compilación no se pudo cargar.
+ */
+bool collectJobs(const std::vector<std::string>& files,
+                 const std::vector<std::string>& compileArgs,
+                 const AnalyzeOptions& options,
+                 std::vector<cppuml::parser::ParseJob>& jobs) {
+    if (options.compileDbPath.empty()) {
+        jobs.reserve(files.size());
+        for (const auto& file : files) jobs.push_back({file, compileArgs});
+        return true;
+    }
+    cppuml::parser::CompilationDatabase database;
+    if (!database.load(options.compileDbPath)) {
+        return false;
+    }
+    jobs = files.empty() ? database.jobs() : database.jobsFor(files);
+    if (!compileArgs.empty()) { // Los flags tras '--' se añaden a los de la base
+        for (auto& job : jobs) job.compileArgs.insert(job.compileArgs.end(), compileArgs.begin(), compileArgs.end());
+    }
+    return true;
+}
+
+/**
+ * @brief Genera los PCHs de cada grupo de flags e informa del coste y el ahorro.
+ */
+void applyPch(std::vector<cppuml::parser::ParseJob>& jobs, const std::string& directory) {
+    cppuml::parser::PchOptions pchOptions;
+    pchOptions.outputDirectory = directory;
+    const auto report = cppuml::parser::PchBuilder(pchOptions).apply(jobs);
+
+    std::size_t covered = 0;
+    double projectedSavings = 0.0;
+    for (std::size_t g = 0; g < report.groups.size(); ++g) {
+        const auto& group = report.groups[g];
+        const double perUnit = group.sampleSecondsWithout - group.sampleSecondsWith;
+        covered += group.coveredUnits;
+        projectedSavings += perUnit * static_cast<double>(group.coveredUnits);
+        std::cerr << "PCH " << g << ": " << group.headers.size() << " header(s), "
+                  << group.coveredUnits << "/" << group.units << " TU(s), built in " << group.buildSeconds
+                  << " s; sample TU " << group.sampleSecondsWithout << " s -> " << group.sampleSecondsWith
+                  << " s (" << perUnit << " s saved per TU)\n";
+    }
+    std::cerr << "PCH: " << report.groups.size() << " group(s) covering " << covered << "/" << jobs.size()
+              << " TU(s); build " << report.buildSeconds << " s, projected savings " << projectedSavings
+              << " s\n";
+}
+
+/**
+ * @brief Agrupa las cabeceras en lotes unity e informa del ahorro previsto.
+ */
+void applyUnity(std::vector<cppuml::parser::ParseJob>& jobs, const AnalyzeOptions& options,
+                const cppuml::parser::IncludeGraph* graph) {
+    cppuml::parser::UnityOptions unityOptions;
+    unityOptions.workers = options.jobs > 1 ? options.jobs
+                         : options.memoryBytes > 0 ? std::max(1u, std::thread::hardware_concurrency())
+                         : 1;
+    if (options.memoryBytes > 0) {
+        unityOptions.batchBytes = std::min(unityOptions.batchBytes, options.memoryBytes / unityOptions.workers);
+    }
+
+    // La memoria de cada cabecera por separado, si hay historial.
+    std::vector<std::size_t> estimates;
+    if (!options.timingsPath.empty()) {
+        cppuml::parser::ParseScheduler scheduler;
+        scheduler.load(options.timingsPath);
+        estimates = scheduler.plan(jobs, unityOptions.workers, graph).memoryEstimates;
+    }
+
+    const auto report = cppuml::parser::UnityBatcher(unityOptions).apply(jobs, estimates.empty() ? nullptr : &estimates);
+    std::cerr << "Unity: " << report.batchedHeaders << "/" << report.headers << " header(s) in " << report.batches
+              << " batch(es); system includes parsed " << report.systemIncludes << " -> " << report.unityIncludes;
+    if (report.largestBatchBytes > 0) {
+        std::cerr << "; largest batch ~" << (report.largestBatchBytes >> 20) << " MB";
+    }
+    std::cerr << '\n';
+}
+
+/**
+ * @brief Analiza todos los archivos y devuelve el modelo ya enlazado.
+ *
+ * Con jobs > 1 cada TU se analiza en un proceso aislado (ProcessPool):
+ * un archivo que haga fallar a libclang se omite en lugar de abortar.
+ * Con un historial de tiempos, las TUs se despachan de la más costosa a
+ * la más barata y se informa del ocio de cola previsto y real; el modelo
+ * las recibe igualmente en el orden de entrada.
+ *
+ * Con 'unity', las cabeceras se analizan en lotes (UnityBatcher) y cada
+ * lote devuelve una TU por cabecera. Con 'skim' no hay inclusiones que
+ * compartir y los lotes no se forman.
+ *
+ * Cada TU se enlaza (y, si 'stages' lo pide, se exporta) en cuanto llega,
+ * mientras las demás se siguen analizando (AnalysisPipeline).
+ * @return nullptr si la configuración no es válida o la exportación falló.
+ */
+std::unique_ptr<cppuml::Model> analyze(const std::vector<std::string>& files,
+                                       const std::vector<std::string>& compileArgs,
+                                       const AnalyzeOptions& options = {},
+                                       const cppuml::pipeline::PipelineOptions& stages = {},
+                                       cppuml::pipeline::PipelineReport* stagesReport = nullptr) {
+    std::vector<cppuml::parser::ParseJob> queue;
+    std::shared_ptr<const cppuml::parser::ScopeFilter> filter;
+    if (!compileFilter(options, filter) || !collectJobs(files, compileArgs, options, queue)) {
+        return nullptr;
+    }
+    if (!options.pchDirectory.empty()) {
+        applyPch(queue, options.pchDirectory);
+    }
+
+    cppuml::parser::IncludeGraph graph;
+    const bool haveGraph = !options.includeGraphPath.empty() && graph.load(options.includeGraphPath);
+    if (options.unity && !options.skim) {
+        applyUnity(queue, options, haveGraph ? &graph : nullptr);
+    }
+
+    auto model = std::make_unique<cppuml::Model>();
+    cppuml::pipeline::AnalysisPipeline pipeline(*model, stages);
+    if (options.jobs > 1 || options.memoryBytes > 0) {
+        const unsigned workers = options.jobs > 1 ? options.jobs : 0; // Con --memory, hasta un análisis por núcleo
+
+        cppuml::parser::ParseScheduler scheduler;
+        cppuml::parser::ParseSchedule schedule;
+        // Posición de entrada de cada resultado (una por cabecera en los lotes
+        // unity): el modelo conserva el orden de los archivos aunque el
+        // despacho siga el historial de tiempos.
+        std::vector<std::size_t> inputPosition;
+        if (!options.timingsPath.empty()) {
+            scheduler.load(options.timingsPath);
+            schedule = scheduler.plan(queue, workers ? workers : std::thread::hardware_concurrency(),
+                                      haveGraph ? &graph : nullptr);
+            for (std::size_t i = 0; i < queue.size(); ++i) queue[i].expectedBytes = schedule.memoryEstimates[i];
+
+            auto slots = [](const cppuml::parser::ParseJob& job) {
+                return std::max<std::size_t>(1, job.unityHeaders.size());
+            };
+            std::vector<std::size_t> firstSlot(queue.size() + 1, 0);
+            for (std::size_t i = 0; i < queue.size(); ++i) firstSlot[i + 1] = firstSlot[i] + slots(queue[i]);
+            inputPosition.reserve(firstSlot.back());
+
+            std::vector<cppuml::parser::ParseJob> ordered;
+            ordered.reserve(queue.size());
+            for (std::size_t index : schedule.order) {
+                for (std::size_t h = 0; h < slots(queue[index]); ++h) inputPosition.push_back(firstSlot[index] + h);
+                ordered.push_back(std::move(queue[index]));
+            }
+            queue = std::move(ordered);
+        }
+
+        cppuml::parser::ProcessPoolReport report;
+        cppuml::parser::ProcessPool({workers, filter, options.memoryBytes, options.skim}).run(queue, [&](std::size_t index, std::unique_ptr<cppuml::TranslationUnit> tu) {
+            pipeline.push(inputPosition.empty() ? index : inputPosition[index], std::move(tu));
+        }, &report);
+        if (!report.crashedFiles.empty()) {
+            std::cerr << report.crashedFiles.size() << " file(s) skipped after crashing libclang:\n";
+            for (const auto& file : report.crashedFiles) std::cerr << "  " << file << '\n';
+        }
+        if (options.memoryBytes > 0) {
+            std::cerr << "Memory: budget " << (options.memoryBytes >> 20) << " MB, peak "
+                      << (report.peakResidentBytes >> 20) << " MB; " << report.deferredJobs
+                      << " TU(s) waited for memory\n";
+        }
+
+        if (!options.timingsPath.empty()) {
+            std::cerr << "Schedule: " << schedule.estimatedFromHistory << "/" << queue.size()
+                      << " TU(s) from history; makespan expected " << schedule.expectedMakespanSeconds
+                      << " s (input order: " << schedule.naiveMakespanSeconds << " s), actual "
+                      << report.makespanSeconds << " s; tail idle expected "
+                      << schedule.expectedTailIdleSeconds << " s, actual " << report.tailIdleSeconds << " s\n";
+            scheduler.record(queue, report);
+            scheduler.save(options.timingsPath);
+        }
+    } else {
+        cppuml::parser::LibClangParser parser;
+        parser.setFilter(filter);
+        parser.setSkim(options.skim);
+        std::size_t next = 0; // Un lote unity ocupa una posición por cabecera
+        for (const auto& job : queue) {
+            if (job.unityHeaders.empty()) {
+                pipeline.push(next++, parser.parse(job.sourceFile, job.compileArgs));
+                continue;
+            }
+            auto units = parser.parseUnity(job.unityHeaders, job.compileArgs);
+            for (std::size_t h = 0; h < job.unityHeaders.size(); ++h) {
+                pipeline.push(next++, h < units.size() ? std::move(units[h]) : nullptr);
+            }
+        }
+    }
+    if (!pipeline.finish(stagesReport)) {
+        return nullptr;
+    }
+
+    if (!options.includeGraphPath.empty()) {
+        graph.record(*model); // Conserva las TUs de ejecuciones anteriores
+        graph.save(options.includeGraphPath);
+    }
+    return model;
+}
+
+const char* kindName(cppuml::ElementKind kind) {
+    switch (kind) {
+        case cppuml::ElementKind::Namespace: return "namespace";
+        case cppuml::ElementKind::Class:     return "class";
+        case cppuml::ElementKind::Field:     return "field";
+        case cppuml::ElementKind::Method:    return "method";
+        default:                             return "element";
+    }
+}
+
+// --- Comando 'query' ---
+
+int runQuery(const CommandLine& cmd) {
+    cppuml::search::MatchMode mode = cppuml::search::MatchMode::Substring;
+    std::size_t limit = 50;
+    bool interactive = false;
+    AnalyzeOptions analyzeOptions;
+
+    for (std::size_t i = 0; i < cmd.options.size(); ++i) {
+        const std::string& opt = cmd.options[i];
+        if (opt == "--interactive") {
+            interactive = true;
+        } else if (parseAnalyzeOption(opt, analyzeOptions)) {
+            continue;
+        } else if (opt.compare(0, 8, "--limit=") == 0) {
+            limit = static_cast<std::size_t>(std::strtoul(opt.c_str() + 8, nullptr, 10));
+        } else if (opt.compare(0, 7, "--mode=") == 0) {
+            const std::string value = opt.substr(7);
+            if (value == "exact") mode = cppuml::search::MatchMode::Exact;
+            else if (value == "prefix") mode = cppuml::search::MatchMode::Prefix;
+            else if (value == "substring") mode = cppuml::search::MatchMode::Substring;
+            else if (value == "fuzzy") mode = cppuml::search::MatchMode::Fuzzy;
+            else {
+                std::cerr << "Error: unknown --mode '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+        } else {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // En modo interactivo no hay patrón en la línea de comandos; con una
+    // base de compilación los archivos son opcionales.
+    const std::size_t firstFile = interactive ? 0 : 1;
+    const std::size_t minPositional = analyzeOptions.compileDbPath.empty() ? firstFile + 1 : firstFile;
+    if (cmd.positional.size() < minPositional) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<std::string> files(cmd.positional.begin() + static_cast<std::ptrdiff_t>(firstFile),
+                                         cmd.positional.end());
+    auto model = analyze(files, cmd.compileArgs, analyzeOptions);
+    if (!model) {
+        return EXIT_FAILURE;
+    }
+    const cppuml::search::SymbolIndex index(*model);
+
+    auto answer = [&](const std::string& pattern) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto hits = index.search(pattern, mode, limit);
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        for (const auto& hit : hits) {
+            std::cout << kindName(hit.entry->kind) << '\t' << hit.entry->qualifiedName << '\n';
+        }
+        std::cerr << hits.size() << " result(s) in " << ms << " ms\n";
+        std::cout.flush();
+    };
+
+    if (!interactive) {
+        answer(cmd.positional.front());
+        return EXIT_SUCCESS;
+    }
+
+    std::cerr << "Indexed " << index.size() << " symbols. One query per line (Ctrl-D to quit).\n";
+    for (std::string line; std::getline(std::cin, line);) {
+        answer(line);
+    }
+    return EXIT_SUCCESS;
+}
+
+// --- Comando 'snapshot' ---
+
+int runSnapshot(const CommandLine& cmd) {
+    AnalyzeOptions analyzeOptions;
+    std::string outputPath;
+    bool lazy = false;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 3, "-o=") == 0) {
+            outputPath = opt.substr(3);
+        } else if (opt == "--lazy") {
+            lazy = true;
+        } else if (!parseAnalyzeOption(opt, analyzeOptions)) {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (outputPath.empty() || (cmd.positional.empty() && analyzeOptions.compileDbPath.empty())) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    auto model = analyze(cmd.positional, cmd.compileArgs, analyzeOptions);
+    if (!model) {
+        return EXIT_FAILURE;
+    }
+    if (lazy) {
+        return cppuml::store::ModelStore::save(*model, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    return cppuml::serialization::ModelSerializer::saveModel(*model, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// --- Inspector ---
+
+char visibilityMark(cppuml::Visibility visibility) {
+    switch (visibility) {
+        case cppuml::Visibility::Public:    return '+';
+        case cppuml::Visibility::Protected: return '#';
+        case cppuml::Visibility::Private:   return '-';
+        default:                            return ' ';
+    }
+}
+
+/**
+ * @brief Una clase del índice: su posición en el grafo y sus miembros (cargados al pedirla).
+ */
+void printClass(cppuml::store::ModelStore& store, cppuml::store::ClassId id) {
+    const auto& entry = store.classAt(id);
+    std::cout << store.qualifiedName(id) << " (" << entry.fieldCount << " field(s), " << entry.methodCount
+              << " method(s))\n";
+    std::size_t derived = 0;
+    std::size_t dependents = 0;
+    for (const auto& edge : store.outgoing(id)) {
+        if (edge.kind == cppuml::RelationshipKind::Inheritance) {
+            std::cout << "  inherits " << store.qualifiedName(edge.other) << '\n';
+        }
+    }
+    for (const auto& edge : store.incoming(id)) {
+        ++(edge.kind == cppuml::RelationshipKind::Inheritance ? derived : dependents);
+    }
+    std::cout << "  " << derived << " derived class(es), " << dependents << " other dependent(s)\n";
+
+    const auto cls = store.details(id);
+    if (!cls) {
+        std::cerr << "Error: cannot load the members of " << store.qualifiedName(id) << '\n';
+        return;
+    }
+    for (const auto& field : cls->getFields()) {
+        std::cout << "  " << visibilityMark(field->getVisibility()) << field->getName() << " : "
+                  << field->getType().getFullName() << (field->isStatic() ? " {static}" : "") << '\n';
+    }
+    for (const auto& method : cls->getMethods()) {
+        std::cout << "  " << visibilityMark(method->getVisibility()) << method->getName() << '(';
+        const auto& params = method->getParameters();
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            std::cout << (i > 0 ? ", " : "") << params[i]->getType().getFullName();
+        }
+        std::cout << ") : " << method->getReturnType().getFullName() << (method->isConst() ? " const" : "") << '\n';
+    }
+}
+
+int runInspect(const CommandLine& cmd) {
+    std::size_t cacheMegabytes = cppuml::store::ModelStore::kDefaultCacheBytes >> 20;
+    bool interactive = false;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 8, "--cache=") == 0) {
+            cacheMegabytes = static_cast<std::size_t>(std::strtoul(opt.c_str() + 8, nullptr, 10));
+        } else if (opt == "--interactive") {
+            interactive = true;
+        } else {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (cmd.positional.empty()) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto store = cppuml::store::ModelStore::open(cmd.positional.front(), cacheMegabytes << 20);
+    if (!store) {
+        return EXIT_FAILURE;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Opened " << store->classCount() << " class(es) in " << store->namespaceCount()
+              << " namespace(s), " << store->edgeCount() << " relationship(s) in " << ms << " ms; skeleton "
+              << (store->stats().skeletonBytes >> 10) << " KB\n";
+
+    auto show = [&](const std::string& name) {
+        const auto id = store->find(name);
+        if (id == cppuml::store::kNotFound) {
+            std::cerr << "Error: no class named '" << name << "'\n";
+            return;
+        }
+        printClass(*store, id);
+        std::cout.flush();
+    };
+    for (std::size_t i = 1; i < cmd.positional.size(); ++i) show(cmd.positional[i]);
+    if (interactive) {
+        for (std::string line; std::getline(std::cin, line);) {
+            if (!line.empty()) show(line);
+        }
+    }
+
+    const auto stats = store->stats();
+    std::cerr << "Details cache: " << stats.cachedClasses << " class(es), " << (stats.cachedBytes >> 10) << " of "
+              << (stats.cacheBudget >> 10) << " KB; " << stats.hits << " hit(s), " << stats.misses << " load(s), "
+              << stats.evictions << " eviction(s)\n";
+    return EXIT_SUCCESS;
+}
+
+// --- Comando 'export' ---
+
+/**
+ * @brief 'export --stream-memory': análisis con memoria acotada (StreamingAnalyzer).
+ */
+int runStreamingExport(const CommandLine& cmd, const AnalyzeOptions& analyzeOptions,
+                       const cppuml::exporter::PlantUmlOptions& diagram, const std::string& outputPath,
+                       std::size_t megabytes, const std::string& spillDirectory) {
+    std::vector<cppuml::parser::ParseJob> jobs;
+    cppuml::streaming::StreamingOptions options;
+    options.diagram = diagram; // Sin el modelo completo solo se aplica el límite de miembros
+    if (!compileFilter(analyzeOptions, options.filter) ||
+        !collectJobs(cmd.positional, cmd.compileArgs, analyzeOptions, jobs)) {
+        return EXIT_FAILURE;
+    }
+    if (!analyzeOptions.pchDirectory.empty()) {
+        applyPch(jobs, analyzeOptions.pchDirectory);
+    }
+    if (analyzeOptions.unity && !analyzeOptions.skim) {
+        cppuml::parser::IncludeGraph graph;
+        const bool haveGraph = !analyzeOptions.includeGraphPath.empty() && graph.load(analyzeOptions.includeGraphPath);
+        applyUnity(jobs, analyzeOptions, haveGraph ? &graph : nullptr);
+    }
+
+    options.memoryBytes = megabytes << 20;
+    options.spillDirectory = spillDirectory;
+    options.jobs = analyzeOptions.jobs;
+    options.parseMemoryBytes = analyzeOptions.memoryBytes;
+    options.skim = analyzeOptions.skim;
+
+    std::ofstream file;
+    if (outputPath != "-") {
+        file.open(outputPath, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: cannot open " << outputPath << " for writing\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& out = outputPath == "-" ? std::cout : file;
+
+    cppuml::streaming::StreamingReport report;
+    const bool ok = cppuml::streaming::StreamingAnalyzer(options).run(jobs, out, &report);
+    std::cerr << report.units << " TU(s) reduced (" << report.failedUnits << " failed); " << report.classes
+              << " class(es), " << report.edges << " inheritance edge(s); " << report.skippedDuplicates
+              << " duplicate(s) dropped early; " << report.runs << " run(s), " << report.spilledBytes
+              << " bytes spilled\n";
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Una cola del pipeline en el informe de 'export'.
+ */
+void printQueue(const char* name, const cppuml::pipeline::QueueMetrics& queue) {
+    std::cerr << "Queue " << name << ": capacity " << queue.capacity << ", " << queue.items << " TU(s), depth max "
+              << queue.maxDepth << " / mean " << queue.meanDepth << "; producer waited " << queue.fullWaits
+              << " time(s) (" << queue.producerWaitSeconds << " s), consumer " << queue.emptyWaits << " time(s) ("
+              << queue.consumerWaitSeconds << " s)\n";
+}
+
+/**
+ * @brief 'export --format ndjson' desde fuentes: cada TU se enlaza y se
+ *        escribe mientras las demás se siguen analizando.
+ */
+int runPipelinedExport(const CommandLine& cmd, const AnalyzeOptions& analyzeOptions,
+                       const cppuml::exporter::NdjsonOptions& ndjsonOptions, const std::string& outputPath,
+                       std::size_t queueCapacity) {
+    std::ofstream file;
+    if (outputPath != "-") {
+        file.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: cannot open " << outputPath << " for writing\n";
+            return EXIT_FAILURE;
+        }
+    }
+    cppuml::pipeline::PipelineOptions stages;
+    stages.queueCapacity = queueCapacity;
+    stages.ndjson = outputPath == "-" ? &std::cout : &file;
+    stages.ndjsonOptions = ndjsonOptions;
+
+    cppuml::pipeline::PipelineReport report;
+    auto model = analyze(cmd.positional, cmd.compileArgs, analyzeOptions, stages, &report);
+    if (!model) {
+        return EXIT_FAILURE;
+    }
+    file.close();
+    if (outputPath != "-" && !file) {
+        std::cerr << "Error: cannot write " << outputPath << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << report.ndjson.records << " record(s), " << report.ndjson.bytes << " bytes in "
+              << report.totalSeconds << " s (parsing " << report.parseSeconds << " s, then "
+              << report.totalSeconds - report.parseSeconds << " s to drain)\n";
+    std::cerr << "Stage resolve: " << report.resolve.items << " TU(s), busy " << report.resolve.busySeconds
+              << " s, done at " << report.resolve.finishedSeconds << " s; " << report.maxReordered
+              << " TU(s) held for order; " << report.deferredBases << " base(s) linked at the end, "
+              << report.unresolvedBases << " unresolved\n";
+    std::cerr << "Stage export: " << report.exportStage.items << " TU(s), busy " << report.exportStage.busySeconds
+              << " s, done at " << report.exportStage.finishedSeconds << " s\n";
+    printQueue("parse->resolve", report.parsed);
+    printQueue("resolve->export", report.resolved);
+    return EXIT_SUCCESS;
+}
+
+int runExport(const CommandLine& cmd) {
+    AnalyzeOptions analyzeOptions;
+    std::string outputPath;
+    std::string format = "ndjson";
+    std::string modelPath;
+    cppuml::exporter::NdjsonOptions ndjsonOptions;
+    cppuml::exporter::PlantUmlOptions diagram;
+    std::size_t streamMegabytes = 0;
+    std::string spillDirectory;
+    std::size_t queueCapacity = cppuml::pipeline::PipelineOptions().queueCapacity;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 3, "-o=") == 0) {
+            outputPath = opt.substr(3);
+        } else if (opt.compare(0, 9, "--format=") == 0) {
+            format = opt.substr(9);
+        } else if (opt.compare(0, 8, "--model=") == 0) {
+            modelPath = opt.substr(8);
+        } else if (opt.compare(0, 10, "--threads=") == 0) {
+            ndjsonOptions.threads = static_cast<unsigned>(std::strtoul(opt.c_str() + 10, nullptr, 10));
+        } else if (opt.compare(0, 16, "--stream-memory=") == 0) {
+            streamMegabytes = static_cast<std::size_t>(std::strtoul(opt.c_str() + 16, nullptr, 10));
+        } else if (opt.compare(0, 12, "--spill-dir=") == 0) {
+            spillDirectory = opt.substr(12);
+        } else if (opt.compare(0, 8, "--queue=") == 0) {
+            queueCapacity = static_cast<std::size_t>(std::strtoul(opt.c_str() + 8, nullptr, 10));
+        } else if (!parseBudgetOption(opt, diagram.budget) && !parseAnalyzeOption(opt, analyzeOptions)) {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (format != "ndjson" && format != "plantuml" && format != "svg") {
+        std::cerr << "Error: unknown --format '" << format << "'\n";
+        return EXIT_FAILURE;
+    }
+    const bool haveInput = !modelPath.empty() || !cmd.positional.empty() || !analyzeOptions.compileDbPath.empty();
+    if (outputPath.empty() || !haveInput) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    if (streamMegabytes > 0) {
+        if (format != "plantuml" || !modelPath.empty()) {
+            std::cerr << "Error: --stream-memory requires --format plantuml and source files\n";
+            return EXIT_FAILURE;
+        }
+        return runStreamingExport(cmd, analyzeOptions, diagram, outputPath, streamMegabytes, spillDirectory);
+    }
+    if (format == "ndjson" && modelPath.empty()) {
+        return runPipelinedExport(cmd, analyzeOptions, ndjsonOptions, outputPath, queueCapacity);
+    }
+
+    auto model = modelPath.empty() ? analyze(cmd.positional, cmd.compileArgs, analyzeOptions)
+                                   : cppuml::serialization::ModelSerializer::loadModel(modelPath);
+    if (!model) {
+        return EXIT_FAILURE;
+    }
+
+    if (format == "plantuml") {
+        const cppuml::exporter::PlantUmlExporter exporter(diagram);
+        cppuml::exporter::BudgetReport report;
+        bool ok = true;
+        if (outputPath == "-") {
+            exporter.exportModel(*model, std::cout, &report);
+            ok = static_cast<bool>(std::cout);
+        } else {
+            ok = exporter.exportToFile(*model, outputPath, &report);
+        }
+        for (const auto& cut : report.cuts) std::cerr << "Render budget: " << cut << '\n';
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (format == "svg") {
+        cppuml::exporter::SvgOptions svgOptions;
+        svgOptions.layout.threads = ndjsonOptions.threads;
+        const cppuml::exporter::SvgExporter exporter(svgOptions);
+        if (outputPath == "-") {
+            exporter.exportModel(*model, std::cout);
+            return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        return exporter.exportToFile(*model, outputPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    cppuml::exporter::NdjsonStats stats;
+    if (!cppuml::exporter::NdjsonExporter(ndjsonOptions).exportToFile(*model, outputPath, &stats)) {
+        return EXIT_FAILURE;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << stats.records << " record(s), " << stats.bytes << " bytes in " << seconds << " s\n";
+    return EXIT_SUCCESS;
+}
+
+// --- Comando 'diagrams' ---
+
+int runDiagrams(const CommandLine& cmd) {
+    AnalyzeOptions analyzeOptions;
+    std::string modelPath;
+    cppuml::exporter::DiagramFarmOptions options;
+    for (const auto& opt : cmd.options) {
+        const auto count = [&](std::size_t prefix) {
+            return static_cast<unsigned>(std::strtoul(opt.c_str() + prefix, nullptr, 10));
+        };
+        if (opt.compare(0, 3, "-o=") == 0) {
+            options.outputDirectory = opt.substr(3);
+        } else if (opt.compare(0, 8, "--model=") == 0) {
+            modelPath = opt.substr(8);
+        } else if (opt.compare(0, 10, "--threads=") == 0) {
+            options.threads = count(10);
+        } else if (opt.compare(0, 9, "--render=") == 0) {
+            const std::string backend = opt.substr(9);
+            if (backend == "none") {
+                options.backend = cppuml::exporter::RenderBackend::None;
+            } else if (backend == "svg") {
+                options.backend = cppuml::exporter::RenderBackend::Svg;
+            } else {
+                // Un programa con sus argumentos, separados por espacios (sin shell).
+                options.backend = cppuml::exporter::RenderBackend::Command;
+                options.renderCommand.clear();
+                std::istringstream words(backend);
+                for (std::string word; words >> word;) options.renderCommand.push_back(word);
+            }
+        } else if (opt.compare(0, 14, "--render-jobs=") == 0) {
+            options.renderJobs = count(14);
+        } else if (opt.compare(0, 15, "--render-batch=") == 0) {
+            options.renderBatch = count(15);
+        } else if (opt.compare(0, 13, "--render-ext=") == 0) {
+            options.renderExtension = opt.substr(13);
+        } else if (opt == "--keep-stale") {
+            options.pruneStale = false;
+        } else if (!parseBudgetOption(opt, options.diagram.budget) && !parseAnalyzeOption(opt, analyzeOptions)) {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const bool haveInput = !modelPath.empty() || !cmd.positional.empty() || !analyzeOptions.compileDbPath.empty();
+    if (options.outputDirectory.empty() || !haveInput) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    auto model = modelPath.empty() ? analyze(cmd.positional, cmd.compileArgs, analyzeOptions)
+                                   : cppuml::serialization::ModelSerializer::loadModel(modelPath);
+    if (!model) {
+        return EXIT_FAILURE;
+    }
+
+    const cppuml::graph::RelationshipGraph graph(*model);
+    cppuml::exporter::DiagramFarmReport report;
+    const bool ok = cppuml::exporter::DiagramFarm(options).run(graph, &report);
+    std::cerr << "Diagrams: " << report.classes << " class(es); " << report.written << " written, "
+              << report.unchanged << " unchanged, " << report.removed << " removed in " << report.generateSeconds
+              << " s";
+    if (options.backend != cppuml::exporter::RenderBackend::None) {
+        std::cerr << "; " << report.rendered << " rendered, " << report.renderFailures << " failed in "
+                  << report.renderSeconds << " s";
+    }
+    std::cerr << '\n';
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// --- Comando 'diff' ---
+
+const char* changeMark(cppuml::diff::ChangeKind kind) {
+    switch (kind) {
+        case cppuml::diff::ChangeKind::Added:   return "+";
+        case cppuml::diff::ChangeKind::Removed: return "-";
+        default:                                return "~";
+    }
+}
+
+int runDiff(const CommandLine& cmd) {
+    std::string plantUmlPath;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 11, "--plantuml=") == 0) {
+            plantUmlPath = opt.substr(11);
+        } else {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (cmd.positional.size() != 2) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    auto before = cppuml::serialization::ModelSerializer::loadModel(cmd.positional[0]);
+    auto after = cppuml::serialization::ModelSerializer::loadModel(cmd.positional[1]);
+    if (!before || !after) {
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto diff = cppuml::diff::ModelDiffer::compare(*before, *after);
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& change : diff.classes) {
+        std::cout << changeMark(change.kind) << " class " << change.qualifiedName << '\n';
+        for (const auto& member : change.members) {
+            std::cout << "    " << changeMark(member.kind) << ' ';
+            if (member.kind == cppuml::diff::ChangeKind::Changed) {
+                std::cout << cppuml::diff::ModelDiffer::signature(*member.before) << "  ->  "
+                          << cppuml::diff::ModelDiffer::signature(*member.after);
+            } else {
+                std::cout << cppuml::diff::ModelDiffer::signature(member.after ? *member.after : *member.before);
+            }
+            std::cout << '\n';
+        }
+    }
+    for (const auto& rel : diff.relationships) {
+        std::cout << changeMark(rel.kind) << ' '
+                  << (rel.relationship == cppuml::RelationshipKind::Inheritance ? "inheritance " : "association ")
+                  << rel.source << (rel.relationship == cppuml::RelationshipKind::Inheritance ? " --|> " : " --> ")
+                  << rel.target << '\n';
+    }
+    std::cerr << diff.classes.size() << " class(es) and " << diff.relationships.size()
+              << " relationship(s) changed; " << diff.comparedClasses << " compared, "
+              << diff.skippedSubtrees << " identical subtree(s) skipped in " << ms << " ms\n";
+
+    if (!plantUmlPath.empty() &&
+        !cppuml::exporter::PlantUmlExporter().exportDiffToFile(diff, plantUmlPath)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// --- Comando 'affected' ---
+
+int runAffected(const CommandLine& cmd) {
+    std::string includeGraphPath;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 16, "--include-graph=") == 0) {
+            includeGraphPath = opt.substr(16);
+        } else {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (includeGraphPath.empty() || cmd.positional.empty()) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    cppuml::parser::IncludeGraph graph;
+    if (!graph.load(includeGraphPath)) {
+        std::cerr << "Error: cannot read include graph '" << includeGraphPath << "'\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto units = graph.affectedUnits(cmd.positional);
+    for (const auto& unit : units) {
+        std::cout << unit << '\n';
+    }
+    std::cerr << units.size() << " of " << graph.unitCount() << " translation unit(s) affected\n";
+    return EXIT_SUCCESS;
+}
+
+// --- Comandos 'daemon' y 'ask' ---
+
+int runDaemon(const CommandLine& cmd) {
+    AnalyzeOptions analyzeOptions;
+    cppuml::daemon::DaemonOptions options;
+    for (const auto& opt : cmd.options) {
+        if (opt.compare(0, 9, "--socket=") == 0) {
+            options.socketPath = opt.substr(9);
+        } else if (opt.compare(0, 7, "--poll=") == 0) {
+            options.pollMilliseconds = static_cast<unsigned>(std::strtoul(opt.c_str() + 7, nullptr, 10));
+        } else if (opt.compare(0, 14, "--live-memory=") == 0) {
+            options.liveUnitBytes = static_cast<std::size_t>(std::strtoul(opt.c_str() + 14, nullptr, 10)) << 20;
+        } else if (!parseBudgetOption(opt, options.diagram.budget) && !parseAnalyzeOption(opt, analyzeOptions)) {
+            std::cerr << "Error: unknown option '" << opt << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    // El daemon analiza en su proceso con TUs vivas: ni procesos aislados,
+    // ni lotes, ni análisis rápido, ni historiales que actualizar.
+    const std::pair<bool, const char*> unsupported[] = {
+        {analyzeOptions.jobs != 1, "--jobs"},
+        {analyzeOptions.memoryBytes > 0, "--memory"},
+        {!analyzeOptions.timingsPath.empty(), "--timings"},
+        {!analyzeOptions.includeGraphPath.empty(), "--include-graph"},
+        {analyzeOptions.unity, "--unity"},
+        {analyzeOptions.skim, "--skim"},
+    };
+    for (const auto& option : unsupported) {
+        if (option.first) {
+            std::cerr << "Error: 'daemon' does not support " << option.second << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    if (options.socketPath.empty() || (cmd.positional.empty() && analyzeOptions.compileDbPath.empty())) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+    if (options.pollMilliseconds == 0) options.pollMilliseconds = 500;
+
+    std::vector<cppuml::parser::ParseJob> jobs;
+    if (!compileFilter(analyzeOptions, options.filter) ||
+        !collectJobs(cmd.positional, cmd.compileArgs, analyzeOptions, jobs)) {
+        return EXIT_FAILURE;
+    }
+    if (!analyzeOptions.pchDirectory.empty()) {
+        applyPch(jobs, analyzeOptions.pchDirectory);
+    }
+
+    cppuml::daemon::AnalysisDaemon daemon(options, std::move(jobs));
+    if (!daemon.start()) {
+        return EXIT_FAILURE;
+    }
+    return daemon.serve() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief 'ask': todo lo que sigue a la ruta del socket se envía tal cual,
+ * de modo que los argumentos de la petición pueden empezar por '--'.
+ */
+int runAsk(int argc, char** argv) {
+    std::string socketPath;
+    int first = 2;
+    if (first < argc && std::string(argv[first]).compare(0, 9, "--socket=") == 0) {
+        socketPath = argv[first] + 9;
+        first += 1;
+    } else if (first + 1 < argc && std::string(argv[first]) == "--socket") {
+        socketPath = argv[first + 1];
+        first += 2;
+    }
+    if (socketPath.empty() || first >= argc) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<std::string> request(argv + first, argv + argc);
+    cppuml::daemon::DaemonReply reply;
+    if (!cppuml::daemon::DaemonClient(socketPath).request(request, reply)) {
+        return EXIT_FAILURE;
+    }
+    if (!reply.ok) {
+        std::cerr << "Error: " << reply.body;
+        return EXIT_FAILURE;
+    }
+    std::cout << reply.body;
+    return std::cout.flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
-    
-    return 0;
-}
\ No newline at end of file
+    if (argc < 2) {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    const std::string command = argv[1];
+    if (command == "-h" || command == "--help") {
+        printUsage(std::cout);
+        return EXIT_SUCCESS;
+    }
+
+    if (command == "query") {
+        return runQuery(splitArguments(argc, argv, 2, withFilterOptions({"--mode", "--limit", "--jobs", "--memory",
+                                                                         "--include-graph", "--timings",
+                                                                         "--compile-db", "--pch"})));
+    }
+    if (command == "snapshot") {
+        return runSnapshot(splitArguments(argc, argv, 2, withFilterOptions({"-o", "--jobs", "--memory",
+                                                                            "--include-graph", "--timings",
+                                                                            "--compile-db", "--pch"})));
+    }
+    if (command == "inspect") {
+        return runInspect(splitArguments(argc, argv, 2, {"--cache"}));
+    }
+    if (command == "export") {
+        return runExport(splitArguments(argc, argv, 2, withFilterOptions({"-o", "--format", "--model", "--threads",
+                                                                          "--jobs", "--memory", "--include-graph",
+                                                                          "--timings", "--compile-db", "--pch",
+                                                                          "--stream-memory", "--spill-dir", "--queue",
+                                                                          "--max-classes", "--max-members",
+                                                                          "--max-edges"})));
+    }
+    if (command == "diagrams") {
+        return runDiagrams(splitArguments(argc, argv, 2, withFilterOptions({"-o", "--model", "--threads", "--render",
+                                                                            "--render-jobs", "--render-batch",
+                                                                            "--render-ext", "--jobs", "--memory",
+                                                                            "--include-graph", "--timings",
+                                                                            "--compile-db", "--pch",
+                                                                            "--max-members"})));
+    }
+    if (command == "diff") {
+        return runDiff(splitArguments(argc, argv, 2, {"--plantuml"}));
+    }
+    if (command == "affected") {
+        return runAffected(splitArguments(argc, argv, 2, {"--include-graph"}));
+    }
+    if (command == "daemon") {
+        // --jobs, --memory, --timings e --include-graph llevan valor aunque se
+        // rechacen: así su valor no se toma por un archivo.
+        return runDaemon(splitArguments(argc, argv, 2, withFilterOptions({"--socket", "--poll", "--live-memory",
+                                                                          "--compile-db", "--pch", "--max-classes",
+                                                                          "--max-members", "--max-edges", "--jobs",
+                                                                          "--memory", "--timings",
+                                                                          "--include-graph"})));
+    }
+    if (command == "ask") {
+        return runAsk(argc, argv);
+    }
+
+    std::cerr << "Error: unknown command '" << command << "'\n";
+    printUsage(std::cerr);
+    return EXIT_FAILURE;
+}
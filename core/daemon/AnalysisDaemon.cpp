@@ -0,0 +1,521 @@
+#include "daemon/AnalysisDaemon.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "daemon/DaemonProtocol.h"
+#include "exporter/NdjsonExporter.h"
+#include "parser/incremental_updater.h"
+#include "parser/symbol_resolver.h"
+
+namespace cppuml {
+namespace daemon {
+
+namespace {
+
+volatile std::sig_atomic_t g_stopSignal = 0;
+
+void onStopSignal(int) {
+    g_stopSignal = 1;
+}
+
+/// Tiempo máximo que una conexión puede tardar en enviar su petición.
+constexpr int kRequestTimeoutSeconds = 5;
+
+const char* kindName(ElementKind kind) {
+    switch (kind) {
+        case ElementKind::Namespace: return "namespace";
+        case ElementKind::Class:     return "class";
+        case ElementKind::Field:     return "field";
+        case ElementKind::Method:    return "method";
+        default:                     return "element";
+    }
+}
+
+std::filesystem::file_time_type stampOf(const std::string& path) {
+    std::error_code ec;
+    const auto stamp = std::filesystem::last_write_time(path, ec);
+    return ec ? std::filesystem::file_time_type::min() : stamp; // Un archivo borrado también es un cambio
+}
+
+} // namespace
+
+AnalysisDaemon::AnalysisDaemon(DaemonOptions options, std::vector<parser::ParseJob> jobs)
+    : m_options(std::move(options)) {
+    for (auto& job : jobs) {
+        std::string key = parser::IncludeGraph::normalize(job.sourceFile);
+        m_jobs.emplace(std::move(key), std::move(job));
+    }
+}
+
+AnalysisDaemon::~AnalysisDaemon() {
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        ::unlink(m_options.socketPath.c_str());
+    }
+}
+
+bool AnalysisDaemon::start() {
+    return analyzeAll() && listen();
+}
+
+// --- Modelo y Actualización ---
+
+bool AnalysisDaemon::analyzeAll() {
+    const auto started = std::chrono::steady_clock::now();
+    m_parser.setKeepAlive(true, m_options.liveUnitBytes);
+    m_parser.setFilter(m_options.filter);
+    m_model = std::make_unique<Model>();
+    for (const auto& entry : m_jobs) {
+        auto tu = m_parser.parse(entry.second.sourceFile, entry.second.compileArgs);
+        if (tu) {
+            m_model->addTranslationUnit(std::move(tu));
+        } else {
+            m_pending.insert(entry.first);
+        }
+    }
+    if (m_model->getTranslationUnits().empty()) {
+        std::cerr << "Error: no se pudo analizar ninguna unidad de traducción" << std::endl;
+        return false;
+    }
+    parser::SymbolResolver::resolve(*m_model);
+    m_graph.record(*m_model);
+    track();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cerr << "Daemon: " << m_model->getTranslationUnits().size() << " TU(s) analizadas en " << seconds
+              << " s (" << m_pending.size() << " fallidas), " << m_stamps.size() << " archivos vigilados"
+              << std::endl;
+    return true;
+}
+
+void AnalysisDaemon::track() {
+    // Las fechas ya conocidas se conservan: un archivo que cambió mientras se
+    // reanalizaba otro se detectará en la siguiente comprobación.
+    std::unordered_map<std::string, std::filesystem::file_time_type> stamps;
+    auto watch = [&](const std::string& path) {
+        if (stamps.count(path)) return;
+        auto old = m_stamps.find(path);
+        stamps.emplace(path, old != m_stamps.end() ? old->second : stampOf(path));
+    };
+    for (const auto& tu : m_model->getTranslationUnits()) {
+        watch(tu->getName());
+        for (const auto& include : tu->getIncludedFiles()) watch(include);
+    }
+    for (const auto& key : m_pending) {
+        watch(m_jobs.at(key).sourceFile); // Se reintentan cuando cambian
+    }
+    m_stamps = std::move(stamps);
+    m_lastPoll = std::chrono::steady_clock::now();
+}
+
+std::vector<std::string> AnalysisDaemon::changedFiles() {
+    std::vector<std::string> changed;
+    for (auto& entry : m_stamps) {
+        const auto stamp = stampOf(entry.first);
+        if (stamp != entry.second) {
+            entry.second = stamp;
+            changed.push_back(entry.first);
+        }
+    }
+    m_lastPoll = std::chrono::steady_clock::now();
+    return changed;
+}
+
+std::string AnalysisDaemon::applyChanges(const std::vector<std::string>& changed) {
+    const auto started = std::chrono::steady_clock::now();
+    auto report = parser::IncrementalUpdater::update(
+        *m_model, m_graph, m_parser, changed, [this](const std::string& unit) {
+            auto it = m_jobs.find(parser::IncludeGraph::normalize(unit));
+            return it != m_jobs.end() ? it->second.compileArgs : std::vector<std::string>{};
+        });
+
+    // Los trabajos que fallaron antes no están en el grafo: se reintentan aparte.
+    bool added = false;
+    for (const auto& file : changed) {
+        auto pending = m_pending.find(parser::IncludeGraph::normalize(file));
+        if (pending == m_pending.end()) continue;
+        const auto& job = m_jobs.at(*pending);
+        auto tu = m_parser.parse(job.sourceFile, job.compileArgs);
+        if (!tu) {
+            report.failedUnits.push_back(job.sourceFile);
+            continue;
+        }
+        m_graph.record(job.sourceFile, tu->getIncludedFiles());
+        m_model->addTranslationUnit(std::move(tu));
+        report.reparsedUnits.push_back(job.sourceFile);
+        m_pending.erase(pending);
+        added = true;
+    }
+    if (added) {
+        parser::SymbolResolver::resolve(*m_model, /*relink=*/true);
+    }
+
+    if (!report.reparsedUnits.empty() || !report.removedUnits.empty()) {
+        invalidate();
+        track();
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::ostringstream summary;
+    summary << changed.size() << " archivo(s) cambiado(s): " << report.reparsedUnits.size() << " TU(s) reanalizadas, "
+            << report.removedUnits.size() << " eliminadas, " << report.failedUnits.size() << " fallidas en " << ms
+            << " ms\n";
+    for (const auto& unit : report.failedUnits) summary << "  fallida: " << unit << '\n';
+    return summary.str();
+}
+
+void AnalysisDaemon::invalidate() {
+    ++m_version;
+    m_index.reset();
+    m_relationships.reset();
+    m_plantUml.clear();
+    m_ndjson.clear();
+}
+
+// --- Socket ---
+
+bool AnalysisDaemon::listen() {
+    sockaddr_un address{};
+    if (m_options.socketPath.empty() || m_options.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: ruta de socket no válida: '" << m_options.socketPath << "'" << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, m_options.socketPath.c_str(), m_options.socketPath.size() + 1);
+
+    // Un socket que nadie atiende es el resto de un daemon que terminó mal.
+    if (::access(m_options.socketPath.c_str(), F_OK) == 0) {
+        const int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const bool alive = probe >= 0 &&
+                           ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) ::close(probe);
+        if (alive) {
+            std::cerr << "Error: ya hay un daemon escuchando en " << m_options.socketPath << std::endl;
+            return false;
+        }
+        ::unlink(m_options.socketPath.c_str());
+    }
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "Error: no se pudo crear el socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    const mode_t previous = ::umask(0077); // Solo el propietario puede conectarse
+    const bool bound = ::bind(m_listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    ::umask(previous);
+    if (!bound || ::listen(m_listenFd, 16) != 0) {
+        std::cerr << "Error: no se pudo escuchar en " << m_options.socketPath << ": " << std::strerror(errno)
+                  << std::endl;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    std::cerr << "Daemon: escuchando en " << m_options.socketPath << std::endl;
+    return true;
+}
+
+bool AnalysisDaemon::serve() {
+    struct sigaction action {};
+    action.sa_handler = onStopSignal; // Sin SA_RESTART: poll() debe despertar
+    struct sigaction previousInt {};
+    struct sigaction previousTerm {};
+    ::sigaction(SIGINT, &action, &previousInt);
+    ::sigaction(SIGTERM, &action, &previousTerm);
+    g_stopSignal = 0;
+
+    const auto interval = std::chrono::milliseconds(m_options.pollMilliseconds);
+    bool ok = true;
+    while (!m_stop && !g_stopSignal) {
+        pollfd listener{m_listenFd, POLLIN, 0};
+        const int ready = ::poll(&listener, 1, static_cast<int>(m_options.pollMilliseconds));
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "Error: poll() falló: " << std::strerror(errno) << std::endl;
+            ok = false;
+            break;
+        }
+        if (ready > 0 && (listener.revents & POLLIN)) {
+            const int client = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                handleConnection(client);
+                ::close(client);
+            }
+        }
+        // También con peticiones seguidas: un cliente insistente no retrasa las actualizaciones.
+        if (!m_stop && std::chrono::steady_clock::now() - m_lastPoll >= interval) {
+            const auto changed = changedFiles();
+            if (!changed.empty()) std::cerr << "Daemon: " << applyChanges(changed);
+        }
+    }
+
+    ::sigaction(SIGINT, &previousInt, nullptr);
+    ::sigaction(SIGTERM, &previousTerm, nullptr);
+    std::cerr << "Daemon: detenido" << std::endl;
+    return ok;
+}
+
+void AnalysisDaemon::handleConnection(int fd) {
+    timeval timeout{kRequestTimeoutSeconds, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string data;
+    if (!protocol::readAll(fd, data)) {
+        return; // Cliente que no terminó su petición a tiempo
+    }
+    const auto args = protocol::decodeRequest(data);
+    std::string body;
+    const bool ok = dispatch(args, body);
+    const char* header = ok ? "ok\n" : "error\n";
+    if (protocol::writeAll(fd, header, std::strlen(header))) {
+        protocol::writeAll(fd, body.data(), body.size());
+    }
+}
+
+// --- Peticiones ---
+
+bool AnalysisDaemon::dispatch(const std::vector<std::string>& args, std::string& body) {
+    if (args.empty()) {
+        body = "petición vacía\n";
+        return false;
+    }
+    const std::string& command = args.front();
+    if (command == "query") return query(args, body);
+    if (command == "export") return exportDiagram(args, body);
+    if (command == "focus") return focus(args, body);
+    if (command == "subclasses" || command == "bases" || command == "isa") return hierarchy(args, body);
+    if (command == "dependents") return dependents(args, body);
+    if (command == "update") {
+        std::vector<std::string> changed(args.begin() + 1, args.end());
+        if (changed.empty()) changed = changedFiles();
+        body = applyChanges(changed);
+        return true;
+    }
+    if (command == "status") {
+        body = status();
+        return true;
+    }
+    if (command == "stop") {
+        m_stop = true;
+        body = "deteniendo\n";
+        return true;
+    }
+    body = "orden desconocida '" + command + "'\n";
+    return false;
+}
+
+bool AnalysisDaemon::query(const std::vector<std::string>& args, std::string& body) {
+    if (args.size() < 2) {
+        body = "uso: query <patrón> [exact|prefix|substring|fuzzy] [límite]\n";
+        return false;
+    }
+    search::MatchMode mode = search::MatchMode::Substring;
+    if (args.size() > 2) {
+        const std::string& value = args[2];
+        if (value == "exact") mode = search::MatchMode::Exact;
+        else if (value == "prefix") mode = search::MatchMode::Prefix;
+        else if (value == "substring") mode = search::MatchMode::Substring;
+        else if (value == "fuzzy") mode = search::MatchMode::Fuzzy;
+        else {
+            body = "modo de búsqueda desconocido '" + value + "'\n";
+            return false;
+        }
+    }
+    const std::size_t limit = args.size() > 3 ? std::strtoul(args[3].c_str(), nullptr, 10) : 50;
+
+    for (const auto& hit : index().search(args[1], mode, limit)) {
+        body += kindName(hit.entry->kind);
+        body += '\t';
+        body += hit.entry->qualifiedName;
+        body += '\n';
+    }
+    return true;
+}
+
+bool AnalysisDaemon::exportDiagram(const std::vector<std::string>& args, std::string& body) {
+    const std::string format = args.size() > 1 ? args[1] : "plantuml";
+    if (format == "plantuml") {
+        if (m_plantUml.empty()) {
+            std::ostringstream out;
+            exporter::PlantUmlExporter(m_options.diagram).exportModel(*m_model, out);
+            m_plantUml = out.str();
+        }
+        body = m_plantUml;
+        return true;
+    }
+    if (format == "ndjson") {
+        if (m_ndjson.empty()) {
+            std::ostringstream out;
+            if (!exporter::NdjsonExporter().exportModel(*m_model, out)) {
+                body = "no se pudo generar el NDJSON\n";
+                return false;
+            }
+            m_ndjson = out.str();
+        }
+        body = m_ndjson;
+        return true;
+    }
+    body = "formato desconocido '" + format + "'\n";
+    return false;
+}
+
+bool AnalysisDaemon::focus(const std::vector<std::string>& args, std::string& body) {
+    if (args.size() < 2) {
+        body = "uso: focus <clase> [profundidad]\n";
+        return false;
+    }
+    const graph::NodeId target = findClass(args[1], body);
+    if (target == graph::kInvalidNode) return false;
+    const std::uint32_t depth = args.size() > 2 ? std::strtoul(args[2].c_str(), nullptr, 10) : 1;
+
+    // Bases y derivadas hasta la profundidad pedida (un BFS sobre ambos sentidos).
+    const graph::RelationshipGraph& g = relationships();
+    const graph::KindMask inheritance = graph::maskOf(RelationshipKind::Inheritance);
+    std::vector<graph::NodeId> order{target};
+    std::unordered_set<graph::NodeId> inFocus{target};
+    std::vector<graph::NodeId> frontier{target};
+    for (std::uint32_t d = 0; d < depth && !frontier.empty(); ++d) {
+        std::vector<graph::NodeId> next;
+        for (auto direction : {graph::Direction::Outgoing, graph::Direction::Incoming}) {
+            for (const auto& hit : g.reachable(frontier, inheritance, direction, 1, 1)) {
+                if (inFocus.insert(hit.first).second) next.push_back(hit.first);
+            }
+        }
+        std::sort(next.begin(), next.end(), [&](graph::NodeId a, graph::NodeId b) { return g.name(a) < g.name(b); });
+        order.insert(order.end(), next.begin(), next.end());
+        frontier.swap(next);
+    }
+
+    std::ostringstream out;
+    const exporter::PlantUmlExporter exporter(m_options.diagram);
+    exporter::PlantUmlExporter::beginDiagram(out);
+    for (graph::NodeId node : order) {
+        exporter.exportClass(g.name(node), *g.classOf(node), out);
+    }
+    for (graph::NodeId node : order) {
+        for (graph::NodeId base : g.neighbours(node, RelationshipKind::Inheritance, graph::Direction::Outgoing)) {
+            if (inFocus.count(base)) {
+                exporter::PlantUmlExporter::exportInheritance(g.name(node), g.name(base), out);
+            }
+        }
+    }
+    exporter::PlantUmlExporter::endDiagram(out);
+    body = out.str();
+    return true;
+}
+
+bool AnalysisDaemon::hierarchy(const std::vector<std::string>& args, std::string& body) {
+    const std::string& command = args.front();
+    const bool isa = command == "isa";
+    if (args.size() < (isa ? 3u : 2u)) {
+        body = isa ? "uso: isa <derivada> <base>\n" : "uso: " + command + " <clase>\n";
+        return false;
+    }
+    const graph::NodeId node = findClass(args[1], body);
+    if (node == graph::kInvalidNode) return false;
+    const graph::RelationshipGraph& g = relationships();
+
+    if (isa) {
+        const graph::NodeId base = findClass(args[2], body);
+        if (base == graph::kInvalidNode) return false;
+        body = g.isDerivedFrom(node, base) ? "yes\n" : "no\n";
+        return true;
+    }
+    std::vector<graph::NodeId> nodes = command == "subclasses" ? g.descendants(node) : g.ancestors(node);
+    std::vector<std::string> names;
+    names.reserve(nodes.size());
+    for (graph::NodeId n : nodes) names.push_back(g.name(n));
+    std::sort(names.begin(), names.end());
+    for (const auto& name : names) {
+        body += name;
+        body += '\n';
+    }
+    return true;
+}
+
+bool AnalysisDaemon::dependents(const std::vector<std::string>& args, std::string& body) {
+    if (args.size() < 2) {
+        body = "uso: dependents <clase> [profundidad]\n";
+        return false;
+    }
+    const graph::NodeId node = findClass(args[1], body);
+    if (node == graph::kInvalidNode) return false;
+    const std::uint32_t depth = args.size() > 2 ? std::strtoul(args[2].c_str(), nullptr, 10) : 0;
+
+    // Todo lo que hereda de la clase, la contiene o la usa, transitivamente.
+    const graph::RelationshipGraph& g = relationships();
+    for (const auto& hit : g.reachable({node}, graph::kAllKinds, graph::Direction::Incoming, depth)) {
+        body += std::to_string(hit.second);
+        body += '\t';
+        body += g.name(hit.first);
+        body += '\n';
+    }
+    return true;
+}
+
+std::string AnalysisDaemon::status() const {
+    const auto live = m_parser.liveUnitStats();
+    std::ostringstream out;
+    out << "units\t" << m_model->getTranslationUnits().size() << '\n'
+        << "pending\t" << m_pending.size() << '\n'
+        << "watched\t" << m_stamps.size() << '\n'
+        << "version\t" << m_version << '\n'
+        << "live units\t" << live.units << '\n'
+        << "live bytes\t" << live.bytes << '\n'
+        << "reparse hits\t" << live.hits << '\n'
+        << "reparse misses\t" << live.misses << '\n'
+        << "indexed\t" << (m_index ? "yes" : "no") << '\n'
+        << "graph nodes\t" << (m_relationships ? m_relationships->nodeCount() : 0) << '\n';
+    return out.str();
+}
+
+// --- Vistas Derivadas ---
+
+const search::SymbolIndex& AnalysisDaemon::index() {
+    if (!m_index) {
+        m_index = std::make_unique<search::SymbolIndex>(*m_model);
+    }
+    return *m_index;
+}
+
+const graph::RelationshipGraph& AnalysisDaemon::relationships() {
+    if (!m_relationships) {
+        m_relationships = std::make_unique<graph::RelationshipGraph>(*m_model);
+    }
+    return *m_relationships;
+}
+
+graph::NodeId AnalysisDaemon::findClass(const std::string& name, std::string& body) {
+    const graph::NodeId node = relationships().find(name);
+    if (node != graph::kInvalidNode) return node;
+
+    std::vector<std::string> suggestions;
+    for (const auto& hit : index().search(name, search::MatchMode::Fuzzy, 20)) {
+        if (hit.entry->kind == ElementKind::Class && suggestions.size() < 5) {
+            suggestions.push_back(hit.entry->qualifiedName);
+        }
+    }
+    body = "clase desconocida '" + name + "'";
+    for (std::size_t i = 0; i < suggestions.size(); ++i) {
+        body += (i == 0 ? "; ¿quizá " : ", ") + suggestions[i];
+    }
+    body += suggestions.empty() ? "\n" : "?\n";
+    return graph::kInvalidNode;
+}
+
+} // namespace daemon
+} // namespace cppuml
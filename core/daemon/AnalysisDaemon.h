@@ -0,0 +1,143 @@
+#ifndef CPP_UML_GENERATOR_CORE_DAEMON_ANALYSIS_DAEMON_H
+#define CPP_UML_GENERATOR_CORE_DAEMON_ANALYSIS_DAEMON_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "exporter/PlantUmlExporter.h"
+#include "graph/RelationshipGraph.h"
+#include "model/Model.h"
+#include "parser/include_graph.h"
+#include "parser/libclang_parser.h"
+#include "parser/process_pool.h"
+#include "search/SymbolIndex.h"
+
+namespace cppuml {
+namespace daemon {
+
+/**
+ * @brief Configuración del daemon de análisis.
+ */
+struct DaemonOptions {
+    std::string socketPath;                    ///< Socket Unix donde escuchar
+    unsigned pollMilliseconds = 500;           ///< Intervalo de comprobación de cambios en disco
+    std::size_t liveUnitBytes = parser::LibClangParser::kDefaultLiveUnitBytes; ///< Límite de la caché de TUs vivas
+    std::shared_ptr<const parser::ScopeFilter> filter; ///< Alcance del modelo (nullptr = todo)
+    exporter::PlantUmlOptions diagram;
+};
+
+/**
+ * @class AnalysisDaemon
+ * @brief Proceso residente que mantiene el modelo analizado y responde peticiones por un socket Unix.
+ *
+ * Cada invocación de la CLI paga el arranque, la carga de libclang y un
+ * análisis en frío. El daemon los paga una vez y conserva en memoria:
+ *   - el LibClangParser con sus TUs vivas (preámbulos precompilados);
+ *   - el Modelo enlazado y su IncludeGraph;
+ *   - las vistas derivadas (SymbolIndex, RelationshipGraph, diagramas ya
+ *     generados), que se construyen al primer uso y se invalidan cuando el
+ *     modelo cambia.
+ *
+ * Cada 'pollMilliseconds' compara la fecha de modificación de las TUs y de
+ * todas sus cabeceras con la registrada; los archivos cambiados se pasan a
+ * IncrementalUpdater, que solo reanaliza las TUs afectadas.
+ *
+ * Peticiones (ver DaemonProtocol.h para el formato):
+ *   - query <patrón> [exact|prefix|substring|fuzzy] [límite]
+ *   - export [plantuml|ndjson]
+ *   - focus <clase> [profundidad]: la clase y sus bases y derivadas hasta
+ *     esa distancia (1 por defecto)
+ *   - subclasses <clase> / bases <clase>: la jerarquía transitiva
+ *   - isa <derivada> <base>: "yes" o "no"
+ *   - dependents <clase> [profundidad]: lo que hereda de, contiene o usa
+ *     la clase, transitivamente, con su distancia
+ *   - update [archivos...]: comprueba ya los cambios, o fuerza esos archivos
+ *   - status
+ *   - stop
+ *
+ * Las peticiones se atienden de una en una en el mismo hilo que las
+ * actualizaciones, por lo que nunca ven un modelo a medio reemplazar.
+ */
+class AnalysisDaemon {
+public:
+    AnalysisDaemon(DaemonOptions options, std::vector<parser::ParseJob> jobs);
+    ~AnalysisDaemon();
+
+    AnalysisDaemon(const AnalysisDaemon&) = delete;
+    AnalysisDaemon& operator=(const AnalysisDaemon&) = delete;
+
+    /**
+     * @brief Analiza todos los trabajos y abre el socket.
+     * @return false si ninguna TU se pudo analizar o el socket no se pudo abrir
+     *         (p.ej., porque ya hay un daemon escuchando en esa ruta).
+     */
+    bool start();
+
+    /**
+     * @brief Atiende peticiones hasta recibir 'stop', SIGINT o SIGTERM.
+     * @return false si el socket falló.
+     */
+    bool serve();
+
+private:
+    // --- Modelo y Actualización ---
+    bool analyzeAll();
+    void track();
+    std::vector<std::string> changedFiles();
+    std::string applyChanges(const std::vector<std::string>& changed);
+    void invalidate();
+
+    // --- Socket ---
+    bool listen();
+    void handleConnection(int fd);
+
+    // --- Peticiones ---
+    bool dispatch(const std::vector<std::string>& args, std::string& body);
+    bool query(const std::vector<std::string>& args, std::string& body);
+    bool exportDiagram(const std::vector<std::string>& args, std::string& body);
+    bool focus(const std::vector<std::string>& args, std::string& body);
+    bool hierarchy(const std::vector<std::string>& args, std::string& body);
+    bool dependents(const std::vector<std::string>& args, std::string& body);
+    std::string status() const;
+
+    // --- Vistas Derivadas ---
+    const search::SymbolIndex& index();
+    const graph::RelationshipGraph& relationships();
+
+    /**
+     * @brief El nodo de una clase; si no existe, deja en 'body' el error con sugerencias.
+     */
+    graph::NodeId findClass(const std::string& name, std::string& body);
+
+    DaemonOptions m_options;
+    std::map<std::string, parser::ParseJob> m_jobs;           ///< Por ruta normalizada (orden de análisis estable)
+    std::unordered_set<std::string> m_pending;                ///< Trabajos sin TU en el modelo (falló el análisis)
+
+    parser::LibClangParser m_parser;
+    std::unique_ptr<Model> m_model;
+    parser::IncludeGraph m_graph;
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_stamps; ///< Archivos vigilados
+    std::chrono::steady_clock::time_point m_lastPoll;
+
+    std::uint64_t m_version = 0; ///< Se incrementa con cada cambio del modelo
+    std::unique_ptr<search::SymbolIndex> m_index;
+    std::unique_ptr<graph::RelationshipGraph> m_relationships;
+    std::string m_plantUml;
+    std::string m_ndjson;
+
+    int m_listenFd = -1;
+    bool m_stop = false;
+};
+
+} // namespace daemon
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_DAEMON_ANALYSIS_DAEMON_H
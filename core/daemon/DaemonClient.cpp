@@ -0,0 +1,54 @@
+#include "daemon/DaemonClient.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "daemon/DaemonProtocol.h"
+
+namespace cppuml {
+namespace daemon {
+
+bool DaemonClient::request(const std::vector<std::string>& args, DaemonReply& reply) const {
+    sockaddr_un address{};
+    if (m_socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: ruta de socket demasiado larga: " << m_socketPath << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, m_socketPath.c_str(), m_socketPath.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "Error: no se pudo crear el socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error: no hay un daemon escuchando en " << m_socketPath << ": " << std::strerror(errno)
+                  << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    const std::string data = protocol::encodeRequest(args);
+    std::string response;
+    const bool sent = protocol::writeAll(fd, data.data(), data.size()) && ::shutdown(fd, SHUT_WR) == 0;
+    const bool received = sent && protocol::readAll(fd, response);
+    ::close(fd);
+
+    const std::size_t newline = response.find('\n');
+    if (!received || newline == std::string::npos) {
+        std::cerr << "Error: el daemon cerró la conexión sin responder" << std::endl;
+        return false;
+    }
+    reply.ok = response.compare(0, newline, "ok") == 0;
+    reply.body = response.substr(newline + 1);
+    return true;
+}
+
+} // namespace daemon
+} // namespace cppuml
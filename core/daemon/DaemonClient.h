@@ -0,0 +1,46 @@
+#ifndef CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_CLIENT_H
+#define CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_CLIENT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppuml {
+namespace daemon {
+
+/**
+ * @brief Respuesta del daemon a una petición.
+ */
+struct DaemonReply {
+    bool ok = false;  ///< false: el daemon rechazó la petición ('body' es el motivo)
+    std::string body;
+};
+
+/**
+ * @class DaemonClient
+ * @brief Cliente mínimo de AnalysisDaemon: una conexión por petición.
+ *
+ * No carga libclang ni el modelo; el coste de una petición es abrir el
+ * socket y copiar la respuesta.
+ */
+class DaemonClient {
+public:
+    explicit DaemonClient(std::string socketPath)
+        : m_socketPath(std::move(socketPath)) {}
+
+    /**
+     * @brief Envía una petición y espera la respuesta completa.
+     * @return false si no se pudo hablar con el daemon (no está en marcha,
+     *         se cerró la conexión...). Un rechazo del daemon devuelve true
+     *         con reply.ok = false.
+     */
+    bool request(const std::vector<std::string>& args, DaemonReply& reply) const;
+
+private:
+    std::string m_socketPath;
+};
+
+} // namespace daemon
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_CLIENT_H
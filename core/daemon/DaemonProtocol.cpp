@@ -0,0 +1,62 @@
+#include "daemon/DaemonProtocol.h"
+
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace cppuml {
+namespace daemon {
+namespace protocol {
+
+std::string encodeRequest(const std::vector<std::string>& args) {
+    std::string data;
+    for (const auto& arg : args) {
+        data += arg;
+        data += '\0';
+    }
+    return data;
+}
+
+std::vector<std::string> decodeRequest(const std::string& data) {
+    std::vector<std::string> args;
+    std::size_t start = 0;
+    while (start < data.size()) {
+        std::size_t end = data.find('\0', start);
+        if (end == std::string::npos) end = data.size();
+        args.push_back(data.substr(start, end - start));
+        start = end + 1;
+    }
+    return args;
+}
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        // MSG_NOSIGNAL: un cliente que se va no debe matar al daemon con SIGPIPE
+        const ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, std::string& data) {
+    char buffer[64 * 1024];
+    for (;;) {
+        const ssize_t got = ::read(fd, buffer, sizeof(buffer));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (got == 0) return true;
+        data.append(buffer, static_cast<std::size_t>(got));
+    }
+}
+
+} // namespace protocol
+} // namespace daemon
+} // namespace cppuml
@@ -0,0 +1,41 @@
+#ifndef CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_PROTOCOL_H
+#define CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_PROTOCOL_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cppuml {
+namespace daemon {
+
+/**
+ * @brief Protocolo entre AnalysisDaemon y DaemonClient (socket Unix, una petición por conexión).
+ *
+ *   - Petición: los argumentos, cada uno terminado en '\0'. El cliente
+ *     cierra su lado de escritura al terminar.
+ *   - Respuesta: "ok\n" o "error\n" seguido del cuerpo (diagrama, resultados
+ *     o mensaje de error) hasta el cierre de la conexión.
+ *
+ * Al no haber longitudes ni escapes, un diagrama se transmite tal cual y
+ * el cliente puede volcarlo a stdout sin copiarlo.
+ */
+namespace protocol {
+
+/// Codifica los argumentos de una petición.
+std::string encodeRequest(const std::vector<std::string>& args);
+
+/// Decodifica una petición; el último argumento puede no llevar '\0'.
+std::vector<std::string> decodeRequest(const std::string& data);
+
+/// Escribe todo el búfer (reintenta escrituras parciales). false si la conexión se cerró.
+bool writeAll(int fd, const char* data, std::size_t size);
+
+/// Lee hasta el cierre de la conexión. false ante un error o un tiempo de espera agotado.
+bool readAll(int fd, std::string& data);
+
+} // namespace protocol
+
+} // namespace daemon
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_DAEMON_DAEMON_PROTOCOL_H
@@ -0,0 +1,365 @@
+#include "diff/ModelDiff.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "diff/StructuralHasher.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace diff {
+
+namespace {
+
+// --- Vista Fusionada del Modelo ---
+
+/**
+ * @brief Un namespace lógico: la unión de ese namespace en todas las TUs.
+ *
+ * Las claves son vistas de los nombres del propio modelo (que sigue vivo
+ * durante el diff): fusionar cientos de miles de clases no copia cadenas.
+ */
+struct NamespaceNode {
+    std::uint64_t hash = 0;
+    std::unordered_map<std::string_view, std::unique_ptr<NamespaceNode>> children;
+    /// (nombre simple, primera definición), ordenado por nombre tras 'finalize'
+    std::vector<std::pair<std::string_view, const Class*>> classes;
+};
+
+using ClassEntry = std::pair<std::string_view, const Class*>;
+
+/**
+ * @brief Un modelo fusionado por nombre calificado.
+ */
+struct Snapshot {
+    NamespaceNode root;
+};
+
+std::uint64_t spread(std::uint64_t value) {
+    return StructuralHasher::combine(0x2545F4914F6CDD1DULL, value);
+}
+
+void merge(const Namespace& ns, NamespaceNode& node) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class) {
+            node.classes.emplace_back(member->getName(), static_cast<const Class*>(member.get()));
+        } else if (member->getKind() == ElementKind::Namespace) {
+            auto& child = node.children[member->getName()];
+            if (!child) child = std::make_unique<NamespaceNode>();
+            merge(static_cast<const Namespace&>(*member), *child);
+        }
+    }
+}
+
+/**
+ * @brief Ordena las clases de cada namespace y descarta las repetidas.
+ *
+ * Una clase incluida desde varias TUs cuenta una vez (la primera). Un
+ * vector ordenado, en lugar de un mapa, evita cientos de miles de nodos
+ * en el montículo y permite comparar ambos lados con un recorrido conjunto.
+ */
+void finalize(NamespaceNode& node) {
+    std::stable_sort(node.classes.begin(), node.classes.end(), [](const ClassEntry& x, const ClassEntry& y) {
+        return x.first < y.first;
+    });
+    node.classes.erase(std::unique(node.classes.begin(), node.classes.end(),
+                                   [](const ClassEntry& x, const ClassEntry& y) { return x.first == y.first; }),
+                       node.classes.end());
+    for (auto& entry : node.children) finalize(*entry.second);
+}
+
+/// Hash de Merkle del namespace fusionado (conmutativo: no depende del orden de las TUs).
+std::uint64_t hashNode(NamespaceNode& node) {
+    std::uint64_t h = 0;
+    for (const auto& entry : node.classes) {
+        h += spread(entry.second->getStructuralHash());
+    }
+    for (auto& entry : node.children) {
+        h += spread(StructuralHasher::combine(StructuralHasher::hashString(std::string(entry.first)),
+                                              hashNode(*entry.second)));
+    }
+    node.hash = h;
+    return h;
+}
+
+void buildSnapshot(const Model& model, Snapshot& snapshot) {
+    for (const auto& tu : model.getTranslationUnits()) {
+        merge(*tu->getGlobalNamespace(), snapshot.root);
+    }
+    finalize(snapshot.root);
+    hashNode(snapshot.root);
+}
+
+// --- Relaciones ---
+
+using RelationSet = std::set<std::pair<RelationshipKind, std::string>>;
+
+/// Busca "a::b::C" recorriendo el árbol fusionado, sin construir cadenas.
+bool contains(const NamespaceNode& root, std::string_view qualified) {
+    const NamespaceNode* node = &root;
+    std::size_t begin = 0;
+    for (std::size_t sep = qualified.find("::"); sep != std::string_view::npos; sep = qualified.find("::", begin)) {
+        auto it = node->children.find(qualified.substr(begin, sep - begin));
+        if (it == node->children.end()) return false;
+        node = it->second.get();
+        begin = sep + 2;
+    }
+    const std::string_view name = qualified.substr(begin);
+    auto it = std::lower_bound(node->classes.begin(), node->classes.end(), name,
+                               [](const ClassEntry& entry, std::string_view key) { return entry.first < key; });
+    return it != node->classes.end() && it->first == name;
+}
+
+/**
+ * @brief Resuelve un nombre de tipo a una clase del modelo como lo haría
+ *        el compilador: desde el namespace de la clase que lo usa hacia
+ *        fuera ("a::b::Foo", "a::Foo", "Foo").
+ * @param scope Namespace de la clase que usa el nombre ("a::b::"; vacío = global).
+ * @return El nombre calificado, o vacío si no es una clase del modelo.
+ */
+std::string resolve(const Snapshot& snapshot, std::string scope, const std::string& name) {
+    for (;;) {
+        const std::string candidate = scope + name;
+        if (contains(snapshot.root, candidate)) return candidate;
+        if (scope.empty()) return std::string();
+        // "a::b::" -> "a::"
+        const auto sep = scope.rfind("::", scope.size() - 3);
+        scope.resize(sep == std::string::npos ? 0 : sep + 2);
+    }
+}
+
+RelationSet relationsOf(const Class& cls, const std::string& qualifiedName, const Snapshot& snapshot) {
+    const auto sep = qualifiedName.rfind("::");
+    const std::string scope = sep == std::string::npos ? std::string() : qualifiedName.substr(0, sep + 2);
+
+    RelationSet relations;
+    for (const auto& base : cls.getBaseClasses()) {
+        const std::string target = resolve(snapshot, scope, base.baseName);
+        relations.emplace(RelationshipKind::Inheritance, target.empty() ? base.baseName : target);
+    }
+    for (const auto& field : cls.getFields()) {
+        const std::string target = resolve(snapshot, scope, field->getType().getName());
+        if (!target.empty()) relations.emplace(RelationshipKind::Association, target);
+    }
+    return relations;
+}
+
+// --- Comparación ---
+
+class Differ {
+public:
+    Differ(const Snapshot& before, const Snapshot& after, ModelDiff& result)
+        : m_before(before), m_after(after), m_result(result) {}
+
+    void compareNamespaces(const NamespaceNode* a, const NamespaceNode* b, const std::string& prefix) {
+        if (a && b && a->hash == b->hash) {
+            ++m_result.skippedSubtrees;
+            return;
+        }
+
+        // Recorrido conjunto de las dos listas ordenadas de clases.
+        static const std::vector<ClassEntry> none;
+        const auto& left = a ? a->classes : none;
+        const auto& right = b ? b->classes : none;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < left.size() || j < right.size()) {
+            if (j == right.size() || (i < left.size() && left[i].first < right[j].first)) {
+                compareClass(prefix, left[i].first, left[i].second, nullptr);
+                ++i;
+            } else if (i == left.size() || right[j].first < left[i].first) {
+                compareClass(prefix, right[j].first, nullptr, right[j].second);
+                ++j;
+            } else {
+                compareClass(prefix, left[i].first, left[i].second, right[j].second);
+                ++i;
+                ++j;
+            }
+        }
+
+        if (a) {
+            for (const auto& entry : a->children) {
+                const NamespaceNode* other = nullptr;
+                if (b) {
+                    auto it = b->children.find(entry.first);
+                    if (it != b->children.end()) other = it->second.get();
+                }
+                compareNamespaces(entry.second.get(), other, prefix + std::string(entry.first) + "::");
+            }
+        }
+        if (b) {
+            for (const auto& entry : b->children) {
+                if (!a || !a->children.count(entry.first)) {
+                    compareNamespaces(nullptr, entry.second.get(), prefix + std::string(entry.first) + "::");
+                }
+            }
+        }
+    }
+
+private:
+    void compareClass(const std::string& prefix, std::string_view name, const Class* a, const Class* b) {
+        if (a && b && a->getStructuralHash() == b->getStructuralHash()) {
+            ++m_result.skippedSubtrees;
+            return;
+        }
+
+        std::string qualified = prefix;
+        qualified += name;
+        ClassChange change;
+        change.qualifiedName = qualified;
+        change.before = a;
+        change.after = b;
+        change.kind = !a ? ChangeKind::Added : !b ? ChangeKind::Removed : ChangeKind::Changed;
+        if (change.kind == ChangeKind::Changed) {
+            ++m_result.comparedClasses;
+            compareMembers(*a, *b, change);
+        }
+
+        const RelationSet before = a ? relationsOf(*a, qualified, m_before) : RelationSet();
+        const RelationSet after = b ? relationsOf(*b, qualified, m_after) : RelationSet();
+        for (const auto& relation : before) {
+            if (!after.count(relation)) {
+                m_result.relationships.push_back({ChangeKind::Removed, relation.first, qualified, relation.second});
+            }
+        }
+        for (const auto& relation : after) {
+            if (!before.count(relation)) {
+                m_result.relationships.push_back({ChangeKind::Added, relation.first, qualified, relation.second});
+            }
+        }
+
+        if (change.kind != ChangeKind::Changed || change.headerChanged || !change.members.empty()) {
+            m_result.classes.push_back(std::move(change));
+        }
+    }
+
+    template <typename Member, typename KeyFn>
+    static void compareList(const std::vector<std::unique_ptr<Member>>& a,
+                            const std::vector<std::unique_ptr<Member>>& b,
+                            KeyFn key, ClassChange& change) {
+        std::unordered_map<std::string, const Member*> byKey;
+        byKey.reserve(a.size());
+        for (const auto& member : a) byKey.emplace(key(*member), member.get());
+
+        for (const auto& member : b) {
+            auto it = byKey.find(key(*member));
+            if (it == byKey.end()) {
+                change.members.push_back({ChangeKind::Added, nullptr, member.get()});
+                continue;
+            }
+            if (it->second->getStructuralHash() != member->getStructuralHash()) {
+                change.members.push_back({ChangeKind::Changed, it->second, member.get()});
+            }
+            byKey.erase(it);
+        }
+        for (const auto& member : a) {
+            // Los que siguen en el mapa no tienen pareja en 'b'.
+            auto it = byKey.find(key(*member));
+            if (it != byKey.end() && it->second == member.get()) {
+                change.members.push_back({ChangeKind::Removed, member.get(), nullptr});
+            }
+        }
+    }
+
+    static void compareMembers(const Class& a, const Class& b, ClassChange& change) {
+        compareList(a.getFields(), b.getFields(), [](const Field& f) { return f.getName(); }, change);
+        compareList(a.getMethods(), b.getMethods(), [](const Method& m) { return StructuralHasher::methodKey(m); },
+                    change);
+
+        bool sameTemplate = a.getTemplateParameters().size() == b.getTemplateParameters().size();
+        for (std::size_t i = 0; sameTemplate && i < a.getTemplateParameters().size(); ++i) {
+            const auto& pa = a.getTemplateParameters()[i];
+            const auto& pb = b.getTemplateParameters()[i];
+            sameTemplate = pa.name == pb.name && pa.kind == pb.kind &&
+                           pa.defaultArgument == pb.defaultArgument && pa.isPack == pb.isPack;
+        }
+        change.headerChanged = !sameTemplate || a.getClassKind() != b.getClassKind() ||
+                               a.getVisibility() != b.getVisibility() ||
+                               a.getSpecializedTemplate() != b.getSpecializedTemplate();
+
+        // Un cambio solo en las bases se ve como relación; se marca la clase igualmente.
+        if (!change.headerChanged && change.members.empty()) {
+            const auto& ba = a.getBaseClasses();
+            const auto& bb = b.getBaseClasses();
+            change.headerChanged = ba.size() != bb.size();
+            for (std::size_t i = 0; !change.headerChanged && i < ba.size(); ++i) {
+                change.headerChanged = ba[i].baseName != bb[i].baseName || ba[i].visibility != bb[i].visibility;
+            }
+        }
+    }
+
+    const Snapshot& m_before;
+    const Snapshot& m_after;
+    ModelDiff& m_result;
+};
+
+const char* visibilitySymbol(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Public:    return "+ ";
+        case Visibility::Protected: return "# ";
+        case Visibility::Private:   return "- ";
+        default:                    return "";
+    }
+}
+
+} // namespace
+
+// --- API Pública ---
+
+ModelDiff ModelDiffer::compare(Model& before, Model& after) {
+    StructuralHasher::hash(before);
+    StructuralHasher::hash(after);
+
+    ModelDiff result;
+    if (before.getStructuralHash() == after.getStructuralHash()) {
+        return result; // Mismas TUs con el mismo contenido
+    }
+
+    Snapshot a;
+    Snapshot b;
+    buildSnapshot(before, a);
+    buildSnapshot(after, b);
+    Differ(a, b, result).compareNamespaces(&a.root, &b.root, "");
+
+    std::sort(result.classes.begin(), result.classes.end(), [](const ClassChange& x, const ClassChange& y) {
+        return x.qualifiedName < y.qualifiedName;
+    });
+    std::sort(result.relationships.begin(), result.relationships.end(),
+              [](const RelationshipChange& x, const RelationshipChange& y) {
+                  return std::tie(x.source, x.target, x.relationship) < std::tie(y.source, y.target, y.relationship);
+              });
+    return result;
+}
+
+std::string ModelDiffer::signature(const Element& member) {
+    std::string text = visibilitySymbol(member.getVisibility());
+    text += member.getName();
+    if (member.getKind() == ElementKind::Method) {
+        const auto& method = static_cast<const Method&>(member);
+        text += '(';
+        const auto& params = method.getParameters();
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) text += ", ";
+            text += params[i]->getName();
+            text += " : ";
+            text += params[i]->getType().getFullName();
+        }
+        text += ") : ";
+        text += method.getReturnType().getFullName();
+        if (method.isConst()) text += " const";
+    } else if (member.getKind() == ElementKind::Field) {
+        text += " : ";
+        text += static_cast<const Field&>(member).getType().getFullName();
+    }
+    return text;
+}
+
+} // namespace diff
+} // namespace cppuml
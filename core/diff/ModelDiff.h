@@ -0,0 +1,96 @@
+#ifndef CPP_UML_GENERATOR_CORE_DIFF_MODEL_DIFF_H
+#define CPP_UML_GENERATOR_CORE_DIFF_MODEL_DIFF_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Relationship.h"
+
+namespace cppuml {
+namespace diff {
+
+/**
+ * @brief Tipo de cambio entre dos instantáneas.
+ */
+enum class ChangeKind {
+    Added,
+    Removed,
+    Changed
+};
+
+/**
+ * @brief Cambio de un miembro (campo o método) de una clase modificada.
+ *
+ * Los campos se emparejan por nombre y los métodos por nombre y tipos de
+ * parámetros (ver StructuralHasher::methodKey).
+ */
+struct MemberChange {
+    ChangeKind kind = ChangeKind::Changed;
+    const Element* before = nullptr; ///< Field o Method (nullptr si se añadió)
+    const Element* after = nullptr;  ///< Field o Method (nullptr si se eliminó)
+};
+
+/**
+ * @brief Cambio de una clase, identificada por su nombre calificado.
+ */
+struct ClassChange {
+    ChangeKind kind = ChangeKind::Changed;
+    std::string qualifiedName;
+    const Class* before = nullptr;
+    const Class* after = nullptr;
+    bool headerChanged = false; ///< Tipo, visibilidad o parámetros de plantilla
+    std::vector<MemberChange> members;
+};
+
+/**
+ * @brief Una relación que aparece o desaparece (herencia o asociación por campo).
+ */
+struct RelationshipChange {
+    ChangeKind kind = ChangeKind::Added;
+    RelationshipKind relationship = RelationshipKind::Inheritance;
+    std::string source; ///< Nombre calificado (la clase derivada / la que tiene el campo)
+    std::string target; ///< Nombre calificado (la base / el tipo del campo)
+};
+
+/**
+ * @brief Resultado de comparar dos instantáneas. Los punteros apuntan a los
+ *        modelos comparados, que deben seguir vivos.
+ */
+struct ModelDiff {
+    std::vector<ClassChange> classes;             ///< Ordenado por nombre calificado
+    std::vector<RelationshipChange> relationships; ///< Ordenado por origen y destino
+    std::size_t comparedClasses = 0;  ///< Clases cuyo hash difería y se compararon miembro a miembro
+    std::size_t skippedSubtrees = 0;  ///< Namespaces y clases idénticos descartados en O(1)
+
+    bool empty() const { return classes.empty() && relationships.empty(); }
+};
+
+/**
+ * @class ModelDiffer
+ * @brief Diff estructural de dos modelos guiado por hashes de Merkle.
+ *
+ * Cada modelo se fusiona por nombre calificado (una clase incluida desde
+ * varias TUs cuenta una vez) y se compara de arriba abajo: un namespace o
+ * una clase con el mismo hash en ambos lados se salta sin recorrerlo.
+ * Las relaciones se informan desde las clases que cambiaron.
+ */
+class ModelDiffer {
+public:
+    /**
+     * @brief Compara dos modelos. Calcula sus hashes (StructuralHasher).
+     */
+    static ModelDiff compare(Model& before, Model& after);
+
+    /**
+     * @brief Firma UML legible de un miembro ("+ size() : size_t").
+     */
+    static std::string signature(const Element& member);
+};
+
+} // namespace diff
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_DIFF_MODEL_DIFF_H
@@ -0,0 +1,137 @@
+#include "diff/StructuralHasher.h"
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace diff {
+
+namespace {
+
+/// Finalizador de splitmix64: dispersa los bits antes de sumar.
+std::uint64_t mix(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+std::uint64_t hashClass(Class& cls) {
+    std::uint64_t h = StructuralHasher::hashString(cls.getName());
+    h = StructuralHasher::combine(h, static_cast<std::uint64_t>(cls.getClassKind()));
+    h = StructuralHasher::combine(h, static_cast<std::uint64_t>(cls.getVisibility()));
+    h = StructuralHasher::combine(h, StructuralHasher::hashString(cls.getSpecializedTemplate()));
+    for (const auto& param : cls.getTemplateParameters()) {
+        h = StructuralHasher::combine(h, StructuralHasher::hashString(param.name));
+        h = StructuralHasher::combine(h, StructuralHasher::hashString(param.kind));
+        h = StructuralHasher::combine(h, StructuralHasher::hashString(param.defaultArgument));
+        h = StructuralHasher::combine(h, param.isPack ? 1 : 0);
+    }
+    for (const auto& base : cls.getBaseClasses()) {
+        h = StructuralHasher::combine(h, static_cast<std::uint64_t>(base.visibility));
+        h = StructuralHasher::combine(h, StructuralHasher::hashString(base.baseName));
+    }
+
+    // Miembros: suma conmutativa, el orden de declaración no es estructural.
+    std::uint64_t members = 0;
+    for (const auto& field : cls.getFields()) {
+        const std::uint64_t fh = StructuralHasher::hashField(*field);
+        field->setStructuralHash(fh);
+        members += mix(fh);
+    }
+    for (const auto& method : cls.getMethods()) {
+        const std::uint64_t mh = StructuralHasher::hashMethod(*method);
+        method->setStructuralHash(mh);
+        members += mix(mh ^ 0x5555555555555555ULL);
+    }
+    h = StructuralHasher::combine(h, members);
+    cls.setStructuralHash(h);
+    return h;
+}
+
+std::uint64_t hashNamespace(Namespace& ns) {
+    std::uint64_t children = 0;
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class) {
+            children += mix(hashClass(static_cast<Class&>(*member)));
+        } else if (member->getKind() == ElementKind::Namespace) {
+            children += mix(hashNamespace(static_cast<Namespace&>(*member)));
+        }
+    }
+    const std::uint64_t h = StructuralHasher::combine(StructuralHasher::hashString(ns.getName()), children);
+    ns.setStructuralHash(h);
+    return h;
+}
+
+/// Hash de un tipo sin construir su nombre completo (getFullName usa un stringstream).
+void hashType(std::uint64_t& h, const Type& type) {
+    h = StructuralHasher::combine(h, StructuralHasher::hashString(type.getName()));
+    h = StructuralHasher::combine(h, (type.isConst() ? 1 : 0) | (type.isVolatile() ? 2 : 0) |
+                                     (type.isPointer() ? 4 : 0) | (type.isReference() ? 8 : 0) |
+                                     (type.isUnresolved() ? 16 : 0));
+    h = StructuralHasher::combine(h, type.getTemplateParameters().size());
+    for (const auto& param : type.getTemplateParameters()) hashType(h, param);
+}
+
+} // namespace
+
+std::uint64_t StructuralHasher::hashString(const std::string& text) {
+    std::uint64_t h = 0xCBF29CE484222325ULL;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+std::uint64_t StructuralHasher::combine(std::uint64_t seed, std::uint64_t value) {
+    return mix(seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)));
+}
+
+std::uint64_t StructuralHasher::hashField(const Field& field) {
+    std::uint64_t h = hashString(field.getName());
+    h = combine(h, static_cast<std::uint64_t>(field.getVisibility()));
+    hashType(h, field.getType());
+    return combine(h, field.isStatic() ? 1 : 0);
+}
+
+std::uint64_t StructuralHasher::hashMethod(const Method& method) {
+    // Mismos datos que methodKey(), sin construir la cadena.
+    std::uint64_t h = hashString(method.getName());
+    h = combine(h, method.getParameters().size());
+    for (const auto& param : method.getParameters()) hashType(h, param->getType());
+    h = combine(h, method.isConst() ? 1 : 0);
+    h = combine(h, static_cast<std::uint64_t>(method.getVisibility()));
+    hashType(h, method.getReturnType());
+    const std::uint64_t flags = (method.isStatic() ? 1 : 0) | (method.isVirtual() ? 2 : 0) |
+                                (method.isPureVirtual() ? 4 : 0);
+    return combine(h, flags);
+}
+
+std::string StructuralHasher::methodKey(const Method& method) {
+    std::string key = method.getName();
+    key += '(';
+    const auto& params = method.getParameters();
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        if (i > 0) key += ", ";
+        key += params[i]->getType().getFullName();
+    }
+    key += ')';
+    if (method.isConst()) key += " const";
+    return key;
+}
+
+void StructuralHasher::hash(Model& model) {
+    std::uint64_t units = 0;
+    for (const auto& tu : model.getTranslationUnits()) {
+        const std::uint64_t h = combine(hashString(tu->getName()), hashNamespace(*tu->getGlobalNamespace()));
+        tu->setStructuralHash(h);
+        units += mix(h);
+    }
+    model.setStructuralHash(units);
+}
+
+} // namespace diff
+} // namespace cppuml
@@ -0,0 +1,62 @@
+#ifndef CPP_UML_GENERATOR_CORE_DIFF_STRUCTURAL_HASHER_H
+#define CPP_UML_GENERATOR_CORE_DIFF_STRUCTURAL_HASHER_H
+
+#include <cstdint>
+#include <string>
+
+#include "model/Model.h"
+
+namespace cppuml {
+
+class Class;
+class Field;
+class Method;
+
+namespace diff {
+
+/**
+ * @class StructuralHasher
+ * @brief Calcula el hash estructural (Merkle) de cada subárbol del modelo.
+ *
+ * El hash de un miembro depende de su firma (nombre, visibilidad, tipos,
+ * modificadores); el de una clase, de su cabecera (tipo, bases, parámetros
+ * de plantilla) y de los hashes de sus miembros; el de un namespace o TU,
+ * de los hashes de sus hijos. Los nombres de parámetros no cuentan y el
+ * orden de los miembros tampoco (se combinan de forma conmutativa).
+ *
+ * El resultado se guarda en cada Element ('getStructuralHash').
+ */
+class StructuralHasher {
+public:
+    /**
+     * @brief Calcula y guarda los hashes de todo el modelo.
+     */
+    static void hash(Model& model);
+
+    /**
+     * @brief Hash de una firma de campo / método / clase (sin guardarlo).
+     */
+    static std::uint64_t hashField(const Field& field);
+    static std::uint64_t hashMethod(const Method& method);
+
+    /**
+     * @brief Clave que identifica a un método entre versiones: nombre y tipos
+     *        de los parámetros ("f(int, const Foo&) const").
+     */
+    static std::string methodKey(const Method& method);
+
+    /**
+     * @brief Mezcla dos hashes (no conmutativa).
+     */
+    static std::uint64_t combine(std::uint64_t seed, std::uint64_t value);
+
+    /**
+     * @brief FNV-1a de 64 bits (estable entre ejecuciones y plataformas).
+     */
+    static std::uint64_t hashString(const std::string& text);
+};
+
+} // namespace diff
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_DIFF_STRUCTURAL_HASHER_H
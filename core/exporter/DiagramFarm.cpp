@@ -0,0 +1,413 @@
+#include "exporter/DiagramFarm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+#include <system_error>
+#include <thread>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "diff/StructuralHasher.h"
+#include "layout/SugiyamaLayout.h"
+
+namespace cppuml {
+namespace exporter {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Relaciones que se dibujan además de la herencia (del propio diagrama hacia fuera).
+constexpr RelationshipKind kAssociationKinds[] = {RelationshipKind::Association, RelationshipKind::Composition,
+                                                 RelationshipKind::Aggregation};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned workerCount(unsigned requested) {
+    return requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Llama a 'task(i)' para cada i en [0, count) desde 'threads' hilos,
+ *        que toman los índices de uno en uno.
+ */
+template <typename F>
+void parallelFor(std::size_t count, unsigned threads, const F& task) {
+    const std::size_t workers = std::min<std::size_t>(threads, count);
+    std::atomic<std::size_t> next{0};
+    auto drain = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) task(i);
+    };
+    if (workers <= 1) {
+        drain();
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) pool.emplace_back(drain);
+    drain();
+    for (auto& th : pool) th.join();
+}
+
+bool safeChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+/// Componentes de un nombre calificado: "a::B<c::D>" -> {"a", "B<c::D>"}.
+std::vector<std::string> splitQualified(const std::string& name) {
+    std::vector<std::string> parts(1);
+    int depth = 0;
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        if (c == '<' || c == '(') ++depth;
+        if (c == '>' || c == ')') --depth;
+        if (depth == 0 && c == ':' && i + 1 < name.size() && name[i + 1] == ':') {
+            parts.emplace_back();
+            ++i;
+            continue;
+        }
+        parts.back() += c;
+    }
+    return parts;
+}
+
+/// true si el archivo ya tiene exactamente ese contenido.
+bool sameContents(const std::string& path, const std::string& text) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec || size != text.size()) return false;
+    std::ifstream in(path, std::ios::binary);
+    std::string current(static_cast<std::size_t>(size), '\0');
+    in.read(&current[0], static_cast<std::streamsize>(size));
+    return in && current == text;
+}
+
+bool writeFile(const std::string& path, const std::string& text) {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+// --- Nombres de Archivo ---
+
+std::string DiagramFarm::diagramPath(const std::string& qualifiedName) {
+    std::string path;
+    bool replaced = false;
+    for (const auto& component : splitQualified(qualifiedName)) {
+        if (!path.empty()) path += '/';
+        if (component.empty()) replaced = true;
+        for (char c : component) {
+            replaced = replaced || !safeChar(c);
+            path += safeChar(c) ? c : '_';
+        }
+    }
+    if (replaced) {
+        // "Box<int>" y "Box<int*>" darían el mismo nombre: el hash los separa.
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "-%08x",
+                      static_cast<unsigned>(diff::StructuralHasher::hashString(qualifiedName) & 0xffffffffu));
+        path += suffix;
+    }
+    return path;
+}
+
+// --- Generación ---
+
+std::vector<graph::NodeId> DiagramFarm::neighbourhood(const graph::RelationshipGraph& graph, graph::NodeId node) {
+    std::vector<graph::NodeId> nodes{node};
+    auto add = [&](graph::NodeId other) {
+        if (std::find(nodes.begin(), nodes.end(), other) == nodes.end()) nodes.push_back(other);
+    };
+    for (graph::NodeId base : graph.neighbours(node, RelationshipKind::Inheritance, graph::Direction::Outgoing)) {
+        add(base);
+    }
+    for (RelationshipKind kind : kAssociationKinds) {
+        for (graph::NodeId target : graph.neighbours(node, kind, graph::Direction::Outgoing)) add(target);
+    }
+    return nodes;
+}
+
+void DiagramFarm::writeDiagram(const graph::RelationshipGraph& graph, graph::NodeId node, std::ostream& out) const {
+    const PlantUmlExporter focus(m_options.diagram);
+    PlantUmlOptions namesOnly = m_options.diagram;
+    namesOnly.showMembers = false;
+    const PlantUmlExporter neighbour(namesOnly);
+
+    const std::vector<graph::NodeId> nodes = neighbourhood(graph, node);
+    PlantUmlExporter::beginDiagram(out);
+    focus.exportClass(graph.name(node), *graph.classOf(node), out);
+    for (std::size_t i = 1; i < nodes.size(); ++i) {
+        neighbour.exportClass(graph.name(nodes[i]), *graph.classOf(nodes[i]), out);
+    }
+    for (graph::NodeId base : graph.neighbours(node, RelationshipKind::Inheritance, graph::Direction::Outgoing)) {
+        PlantUmlExporter::exportInheritance(graph.name(node), graph.name(base), out);
+    }
+    for (RelationshipKind kind : kAssociationKinds) {
+        for (graph::NodeId target : graph.neighbours(node, kind, graph::Direction::Outgoing)) {
+            PlantUmlExporter::exportRelationship(graph.name(node), graph.name(target), kind, out);
+        }
+    }
+    PlantUmlExporter::endDiagram(out);
+}
+
+bool DiagramFarm::run(const graph::RelationshipGraph& graph, DiagramFarmReport* report) const {
+    DiagramFarmReport local;
+    DiagramFarmReport& result = report ? *report : local;
+    result = DiagramFarmReport();
+
+    std::error_code ec;
+    fs::create_directories(m_options.outputDirectory, ec);
+    if (ec) {
+        std::cerr << "Error: No se pudo crear " << m_options.outputDirectory << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // 1. Generar los .puml en paralelo (cada hilo escribe solo sus propios índices)
+    auto start = std::chrono::steady_clock::now();
+    const std::size_t count = graph.nodeCount();
+    const bool render = m_options.backend != RenderBackend::None;
+    const std::string imageExtension =
+        m_options.backend == RenderBackend::Svg ? std::string(".svg") : m_options.renderExtension;
+
+    std::vector<std::string> stems(count);
+    std::vector<char> needsRender(count, 0);
+    std::atomic<std::size_t> written{0};
+    std::atomic<std::size_t> unchanged{0};
+    std::atomic<std::size_t> failures{0};
+    std::mutex errors;
+    parallelFor(count, workerCount(m_options.threads), [&](std::size_t i) {
+        const auto node = static_cast<graph::NodeId>(i);
+        stems[i] = diagramPath(graph.name(node));
+        std::ostringstream text;
+        writeDiagram(graph, node, text);
+
+        const std::string base = (fs::path(m_options.outputDirectory) / stems[i]).string();
+        bool changed = false;
+        if (sameContents(base + ".puml", text.str())) {
+            ++unchanged;
+        } else if (writeFile(base + ".puml", text.str())) {
+            ++written;
+            changed = true;
+        } else {
+            ++failures;
+            std::lock_guard<std::mutex> lock(errors);
+            std::cerr << "Error: No se pudo escribir " << base << ".puml" << std::endl;
+            return;
+        }
+        std::error_code missing;
+        needsRender[i] = render && (changed || !fs::exists(base + imageExtension, missing));
+    });
+    result.classes = count;
+    result.written = written;
+    result.unchanged = unchanged;
+    result.writeFailures = failures;
+    result.generateSeconds = secondsSince(start);
+
+    // 2. Renderizar lo que cambió o no tiene imagen
+    std::vector<graph::NodeId> pending;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (needsRender[i]) pending.push_back(static_cast<graph::NodeId>(i));
+    }
+    start = std::chrono::steady_clock::now();
+    bool ok = result.writeFailures == 0;
+    if (m_options.backend == RenderBackend::Svg) {
+        ok = renderSvg(graph, pending, stems, result) && ok;
+    } else if (m_options.backend == RenderBackend::Command) {
+        ok = renderCommand(pending, stems, result) && ok;
+    }
+    result.renderSeconds = secondsSince(start);
+
+    // 3. Borrar los diagramas de clases que ya no existen
+    if (m_options.pruneStale) result.removed = pruneStale(stems);
+    return ok;
+}
+
+// --- Renderizado ---
+
+bool DiagramFarm::renderSvg(const graph::RelationshipGraph& graph, const std::vector<graph::NodeId>& nodes,
+                            const std::vector<std::string>& stems, DiagramFarmReport& report) const {
+    // Un hilo por diagrama: el layout de cada uno no se reparte. Los
+    // diagramas son una estrella pequeña, así que las asociaciones también
+    // asignan capas y quedan debajo de la clase.
+    SvgOptions options = m_options.svg;
+    options.layout.threads = 1;
+    options.layout.layerAssociations = true;
+    const SvgExporter svg(options);
+    const layout::SugiyamaLayout engine(options.layout);
+
+    std::atomic<std::size_t> rendered{0};
+    std::atomic<std::size_t> failures{0};
+    parallelFor(nodes.size(), workerCount(m_options.renderJobs), [&](std::size_t i) {
+        const graph::NodeId node = nodes[i];
+        const std::vector<graph::NodeId> members = neighbourhood(graph, node);
+        auto indexOf = [&](graph::NodeId other) {
+            return static_cast<std::size_t>(std::find(members.begin(), members.end(), other) - members.begin());
+        };
+
+        layout::LayoutGraph diagram;
+        for (graph::NodeId member : members) {
+            const Class* cls = graph.classOf(member);
+            const auto size = svg.measureClass(*cls);
+            diagram.nodes.push_back(layout::LayoutNode{cls, size.first, size.second});
+        }
+        // Como en buildClassGraph: la herencia va de la base a la derivada.
+        for (graph::NodeId base : graph.neighbours(node, RelationshipKind::Inheritance, graph::Direction::Outgoing)) {
+            if (base != node) diagram.edges.push_back({indexOf(base), 0, RelationshipKind::Inheritance});
+        }
+        for (RelationshipKind kind : kAssociationKinds) {
+            for (graph::NodeId target : graph.neighbours(node, kind, graph::Direction::Outgoing)) {
+                if (target != node) diagram.edges.push_back({0, indexOf(target), kind});
+            }
+        }
+
+        std::ostringstream out;
+        svg.write(diagram, engine.run(diagram), out);
+        const std::string path = (fs::path(m_options.outputDirectory) / stems[node]).string() + ".svg";
+        if (writeFile(path, out.str())) {
+            ++rendered;
+        } else {
+            ++failures;
+        }
+    });
+    report.rendered += rendered;
+    report.renderFailures += failures;
+    return failures == 0;
+}
+
+bool DiagramFarm::renderCommand(const std::vector<graph::NodeId>& nodes, const std::vector<std::string>& stems,
+                                DiagramFarmReport& report) const {
+    if (nodes.empty()) return true;
+    if (m_options.renderCommand.empty()) {
+        std::cerr << "Error: No se indicó el programa de renderizado" << std::endl;
+        report.renderFailures += nodes.size();
+        return false;
+    }
+
+    const std::size_t batch = std::max<std::size_t>(1, m_options.renderBatch);
+    const unsigned jobs = workerCount(m_options.renderJobs);
+    const fs::path directory(m_options.outputDirectory);
+    std::map<pid_t, std::size_t> running; ///< Proceso -> primer nodo de su lote
+    bool ok = true;
+
+    auto finish = [&](std::size_t first, bool success) {
+        const std::size_t last = std::min(nodes.size(), first + batch);
+        if (success) {
+            report.rendered += last - first;
+            return;
+        }
+        // Sin imagen, la siguiente ejecución vuelve a intentarlo.
+        ok = false;
+        report.renderFailures += last - first;
+        for (std::size_t i = first; i < last; ++i) {
+            std::error_code ec;
+            fs::remove((directory / stems[nodes[i]]).string() + m_options.renderExtension, ec);
+        }
+    };
+
+    // Solo se espera a los procesos de 'running': waitpid(-1) recogería
+    // también los hijos de otras partes del programa.
+    auto reapFinished = [&]() {
+        bool reaped = false;
+        for (auto it = running.begin(); it != running.end();) {
+            int status = 0;
+            const pid_t pid = ::waitpid(it->first, &status, WNOHANG);
+            if (pid == 0 || (pid < 0 && errno == EINTR)) {
+                ++it;
+                continue;
+            }
+            // pid < 0: otro lo recogió y no se sabe cómo terminó; se da por fallido.
+            finish(it->second, pid == it->first && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+            it = running.erase(it);
+            reaped = true;
+        }
+        return reaped;
+    };
+    auto waitOne = [&]() {
+        while (!reapFinished()) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    };
+
+    for (std::size_t first = 0; first < nodes.size(); first += batch) {
+        while (running.size() >= jobs) waitOne();
+
+        std::vector<std::string> args = m_options.renderCommand;
+        for (std::size_t i = first; i < std::min(nodes.size(), first + batch); ++i) {
+            args.push_back((directory / stems[nodes[i]]).string() + ".puml");
+        }
+        std::vector<char*> argv;
+        argv.reserve(args.size() + 1);
+        for (auto& arg : args) argv.push_back(&arg[0]);
+        argv.push_back(nullptr);
+
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::execvp(argv[0], argv.data());
+            ::_exit(127);
+        }
+        if (pid < 0) {
+            std::cerr << "Error: No se pudo lanzar " << args.front() << std::endl;
+            finish(first, false);
+            continue;
+        }
+        running.emplace(pid, first);
+    }
+    while (!running.empty()) waitOne();
+    return ok;
+}
+
+// --- Limpieza ---
+
+std::size_t DiagramFarm::pruneStale(const std::vector<std::string>& stems) const {
+    const std::unordered_set<std::string> current(stems.begin(), stems.end());
+    std::vector<std::string> extensions{".puml", ".svg"};
+    if (!m_options.renderExtension.empty() &&
+        std::find(extensions.begin(), extensions.end(), m_options.renderExtension) == extensions.end()) {
+        extensions.push_back(m_options.renderExtension);
+    }
+
+    const fs::path root(m_options.outputDirectory);
+    std::vector<fs::path> stale;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        const std::string relative = it->path().lexically_relative(root).generic_string();
+        for (const auto& extension : extensions) {
+            if (relative.size() <= extension.size() ||
+                relative.compare(relative.size() - extension.size(), extension.size(), extension) != 0) {
+                continue;
+            }
+            if (!current.count(relative.substr(0, relative.size() - extension.size()))) stale.push_back(it->path());
+            break;
+        }
+    }
+
+    std::size_t removed = 0;
+    for (const auto& path : stale) {
+        if (fs::remove(path, ec)) ++removed;
+        // Y los directorios que quedaron vacíos (un namespace que desapareció).
+        for (fs::path dir = path.parent_path(); dir != root && dir.has_relative_path(); dir = dir.parent_path()) {
+            if (!fs::is_empty(dir, ec) || ec || !fs::remove(dir, ec)) break;
+        }
+    }
+    return removed;
+}
+
+} // namespace exporter
+} // namespace cppuml
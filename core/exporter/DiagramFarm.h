@@ -0,0 +1,123 @@
+#ifndef CPP_UML_GENERATOR_CORE_EXPORTER_DIAGRAM_FARM_H
+#define CPP_UML_GENERATOR_CORE_EXPORTER_DIAGRAM_FARM_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exporter/PlantUmlExporter.h"
+#include "exporter/SvgExporter.h"
+#include "graph/RelationshipGraph.h"
+
+namespace cppuml {
+namespace exporter {
+
+/**
+ * @brief Cómo se convierten los .puml generados en imágenes.
+ */
+enum class RenderBackend {
+    None,    ///< Solo los .puml
+    Svg,     ///< SvgExporter en el propio proceso (sin JVM): <clase>.svg junto al .puml
+    Command  ///< Un programa externo (p.ej., "plantuml -tsvg") con lotes de .puml como argumentos
+};
+
+/**
+ * @brief Configuración de DiagramFarm.
+ */
+struct DiagramFarmOptions {
+    std::string outputDirectory;
+    unsigned threads = 0;           ///< Hilos que generan los .puml (0 = número de núcleos)
+    PlantUmlOptions diagram;        ///< Solo se aplica 'budget.maxMembersPerClass'
+
+    RenderBackend backend = RenderBackend::None;
+    unsigned renderJobs = 0;        ///< Renderizados simultáneos: hilos o procesos (0 = número de núcleos)
+    std::vector<std::string> renderCommand; ///< Programa y argumentos (Command); los .puml se añaden al final
+    std::size_t renderBatch = 64;   ///< .puml por invocación del programa (Command)
+    std::string renderExtension = ".svg"; ///< Lo que escribe el programa junto a cada .puml (Command)
+    SvgOptions svg;                 ///< Presentación (Svg)
+    bool pruneStale = true;         ///< Borrar los .puml e imágenes de clases que ya no están en el modelo
+};
+
+/**
+ * @brief Resultado de DiagramFarm::run.
+ */
+struct DiagramFarmReport {
+    std::size_t classes = 0;
+    std::size_t written = 0;        ///< .puml nuevos o con contenido distinto
+    std::size_t unchanged = 0;      ///< .puml idénticos al existente (no se reescriben)
+    std::size_t writeFailures = 0;
+    std::size_t removed = 0;        ///< .puml e imágenes obsoletos borrados
+    std::size_t rendered = 0;       ///< Diagramas renderizados
+    std::size_t renderFailures = 0;
+    double generateSeconds = 0.0;
+    double renderSeconds = 0.0;
+};
+
+/**
+ * @class DiagramFarm
+ * @brief Un diagrama pequeño por clase (para la documentación), a partir de
+ *        un solo modelo ya analizado.
+ *
+ * Cada diagrama muestra la clase con sus miembros, sus bases directas y
+ * las clases con las que se asocia (asociación, composición y agregación
+ * salientes del RelationshipGraph), estas solo con su nombre.
+ *
+ * 1. Generación: varios hilos se reparten las clases; el modelo y el grafo
+ *    se comparten de solo lectura. Cada .puml se compara con el que ya
+ *    existe y solo se escribe si cambió, así que la fecha de los archivos
+ *    sin cambios se conserva (y make, rsync o el sitio no los rehacen).
+ * 2. Renderizado, con a lo sumo 'renderJobs' a la vez: se renderizan los
+ *    diagramas que cambiaron y los que no tienen imagen. Si el programa
+ *    externo falla, se borran las imágenes de su lote para que la siguiente
+ *    ejecución lo reintente.
+ * 3. Limpieza ('pruneStale'): se borran los .puml y las imágenes (.svg y
+ *    'renderExtension') del directorio que no corresponden a ninguna clase
+ *    de esta ejecución (clases eliminadas o renombradas). Los demás
+ *    archivos del directorio no se tocan.
+ *
+ * Cada clase va en '<directorio>/<namespace>/.../<Clase>.puml'; los
+ * caracteres que no son seguros en un nombre de archivo se sustituyen
+ * por '_' y el nombre lleva un hash para no chocar con otra clase.
+ */
+class DiagramFarm {
+public:
+    explicit DiagramFarm(DiagramFarmOptions options) : m_options(std::move(options)) {}
+
+    /**
+     * @brief Genera (y renderiza) los diagramas de todas las clases del grafo.
+     * @return false si no se pudo crear el directorio, si algún archivo no
+     *         se pudo escribir o si algún renderizado falló.
+     */
+    bool run(const graph::RelationshipGraph& graph, DiagramFarmReport* report = nullptr) const;
+
+    /**
+     * @brief Ruta relativa (sin extensión) del diagrama de una clase: "ui/Window".
+     */
+    static std::string diagramPath(const std::string& qualifiedName);
+
+    /**
+     * @brief El diagrama de una clase.
+     */
+    void writeDiagram(const graph::RelationshipGraph& graph, graph::NodeId node, std::ostream& out) const;
+
+private:
+    /// Nodos del diagrama de una clase: ella primero, después sus vecinos sin repetir.
+    static std::vector<graph::NodeId> neighbourhood(const graph::RelationshipGraph& graph, graph::NodeId node);
+
+    /// 'stems': la ruta de cada nodo (sin extensión) dentro del directorio de salida.
+    bool renderSvg(const graph::RelationshipGraph& graph, const std::vector<graph::NodeId>& nodes,
+                   const std::vector<std::string>& stems, DiagramFarmReport& report) const;
+    bool renderCommand(const std::vector<graph::NodeId>& nodes, const std::vector<std::string>& stems,
+                       DiagramFarmReport& report) const;
+    /// Borra los diagramas cuya ruta no está en 'stems'; devuelve cuántos archivos borró.
+    std::size_t pruneStale(const std::vector<std::string>& stems) const;
+
+    DiagramFarmOptions m_options;
+};
+
+} // namespace exporter
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_EXPORTER_DIAGRAM_FARM_H
@@ -0,0 +1,70 @@
+#ifndef CPP_UML_GENERATOR_CORE_EXPORTER_GLYPH_METRICS_H
+#define CPP_UML_GENERATOR_CORE_EXPORTER_GLYPH_METRICS_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace cppuml {
+namespace exporter {
+
+/**
+ * @brief Métricas de glifos precalculadas para medir texto sin un motor de fuentes.
+ *
+ * Contiene los anchos de avance (en unidades de 1/1000 em) de la fuente
+ * Helvetica/Arial para ASCII imprimible. Es la familia por defecto de los
+ * visores SVG, por lo que las cajas calculadas coinciden con el texto
+ * renderizado sin depender de FreeType, Java ni procesos externos.
+ */
+class GlyphMetrics {
+public:
+    /**
+     * @brief Mide el ancho de una cadena UTF-8.
+     * @param text El texto a medir.
+     * @param fontSize Tamaño de fuente en píxeles.
+     * @param bold Si es true, aplica el ensanchamiento de la variante negrita.
+     * @return El ancho en píxeles.
+     */
+    static double measure(std::string_view text, double fontSize, bool bold = false) {
+        unsigned long units = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 32 && c < 127) {
+                units += kAdvance[c - 32];
+            } else if ((c & 0xC0) != 0x80) {
+                // Primer byte de un punto de código no ASCII: ancho medio.
+                units += kDefaultAdvance;
+            }
+        }
+        const double width = static_cast<double>(units) * fontSize / 1000.0;
+        return bold ? width * kBoldFactor : width;
+    }
+
+    /**
+     * @brief Altura de línea recomendada (ascendente + descendente + interlineado).
+     */
+    static double lineHeight(double fontSize) { return fontSize * 1.25; }
+
+    /**
+     * @brief Distancia desde la parte superior de la línea hasta la línea base.
+     */
+    static double ascent(double fontSize) { return fontSize * 0.905; }
+
+private:
+    static constexpr unsigned short kDefaultAdvance = 556;
+    static constexpr double kBoldFactor = 1.08;
+
+    // Anchos AFM de Helvetica para los caracteres 32 (' ') a 126 ('~').
+    static constexpr unsigned short kAdvance[95] = {
+        278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278, //  !"#$%&'()*+,-./
+        556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556, // 0-9 :;<=>?
+        1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778, // @A-O
+        667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556,  // P-Z [\]^_
+        333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556,  // `a-o
+        556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584        // p-z {|}~
+    };
+};
+
+} // namespace exporter
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_EXPORTER_GLYPH_METRICS_H
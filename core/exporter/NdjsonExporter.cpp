@@ -0,0 +1,789 @@
+#include "exporter/NdjsonExporter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace exporter {
+
+namespace {
+
+// --- Ids Estables ---
+//
+// FNV-1a se puede continuar: el hash de "a::b::C" se obtiene extendiendo el
+// de "a::b" con "::C", sin construir el nombre calificado de cada elemento.
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+/// Miembros del namespace global de una TU por partición.
+constexpr std::size_t kSliceMembers = 256;
+
+std::uint64_t fnv(std::uint64_t hash, const char* data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+std::uint64_t fnv(std::uint64_t hash, const std::string& text) {
+    return fnv(hash, text.data(), text.size());
+}
+
+/**
+ * @brief Un ámbito durante el recorrido: su nombre calificado y el hash de este.
+ */
+struct Scope {
+    std::string qualifiedName; ///< Vacío = namespace global
+    std::uint64_t hash = kFnvOffset;
+
+    bool isGlobal() const { return qualifiedName.empty(); }
+
+    /// Hash del nombre calificado de 'name' dentro de este ámbito.
+    std::uint64_t child(const std::string& name) const {
+        return fnv(isGlobal() ? kFnvOffset : fnv(hash, "::", 2), name);
+    }
+
+    Scope enter(const std::string& name) const {
+        return Scope{isGlobal() ? name : qualifiedName + "::" + name, child(name)};
+    }
+};
+
+/// Id de una clase a partir de su nombre calificado completo (p.ej., el de una base).
+std::uint64_t classIdFor(const std::string& qualifiedName) {
+    return fnv(kFnvOffset, qualifiedName);
+}
+
+// --- Particiones ---
+
+/**
+ * @brief Una porción del trabajo: un rango de miembros del namespace global
+ *        de una TU, o (global == nullptr) las relaciones del modelo.
+ */
+struct Partition {
+    const Namespace* global = nullptr;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+void appendPartitions(const TranslationUnit& tu, std::vector<Partition>& partitions) {
+    const Namespace* global = tu.getGlobalNamespace();
+    const std::size_t count = global->getMembers().size();
+    for (std::size_t begin = 0; begin < count; begin += kSliceMembers) {
+        partitions.push_back({global, begin, std::min(count, begin + kSliceMembers)});
+    }
+}
+
+std::vector<Partition> makePartitions(const Model& model) {
+    std::vector<Partition> partitions;
+    for (const auto& tu : model.getTranslationUnits()) {
+        appendPartitions(*tu, partitions);
+    }
+    partitions.push_back({}); // Relaciones del modelo, al final
+    return partitions;
+}
+
+/**
+ * @brief Qué partición escribe cada namespace y cada clase (la primera que
+ *        los contiene) y el id de cada clase del modelo.
+ *
+ * Se calcula en una pasada secuencial previa; durante la exportación los
+ * hilos solo la leen. Los índices de partición son globales: en una
+ * exportación incremental, las TUs posteriores continúan la numeración y
+ * nunca reclaman lo que ya escribió una anterior.
+ */
+struct Ownership {
+    std::unordered_map<std::uint64_t, std::uint32_t> namespaces;
+    std::unordered_map<std::uint64_t, std::uint32_t> classes;
+    std::unordered_map<const Element*, std::uint64_t> classIds;
+
+    void collect(const Namespace& ns, std::size_t begin, std::size_t end, const Scope& scope,
+                 std::uint32_t partition) {
+        const auto& members = ns.getMembers();
+        for (std::size_t i = begin; i < end; ++i) {
+            const Element& member = *members[i];
+            if (member.getKind() == ElementKind::Class) {
+                const std::uint64_t id = scope.child(member.getName());
+                classes.emplace(id, partition);
+                classIds.emplace(&member, id);
+            } else if (member.getKind() == ElementKind::Namespace) {
+                const Scope inner = scope.enter(member.getName());
+                namespaces.emplace(inner.hash, partition);
+                const auto& nested = static_cast<const Namespace&>(member);
+                collect(nested, 0, nested.getMembers().size(), inner, partition);
+            }
+        }
+    }
+
+    static bool owns(const std::unordered_map<std::uint64_t, std::uint32_t>& owners, std::uint64_t id,
+                     std::uint32_t partition) {
+        auto it = owners.find(id);
+        return it != owners.end() && it->second == partition;
+    }
+};
+
+// --- Escritor de Registros (estilo SAX) ---
+
+/**
+ * @brief Añade JSON directamente a un búfer, sin árbol intermedio.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : m_out(out) {}
+
+    void beginRecord(const char* type) {
+        m_out += "{\"type\":\"";
+        m_out += type;
+        m_out += '"';
+    }
+
+    void endRecord() { m_out += "}\n"; }
+
+    /// Clave de un registro (siempre después de "type", así que lleva coma).
+    void key(const char* name) {
+        m_out += ",\"";
+        m_out += name;
+        m_out += "\":";
+    }
+
+    /// Clave del primer campo de un objeto anidado.
+    void firstKey(const char* name) {
+        m_out += '"';
+        m_out += name;
+        m_out += "\":";
+    }
+
+    void raw(char c) { m_out += c; }
+
+    void string(const std::string& text) {
+        m_out += '"';
+        escape(text);
+        m_out += '"';
+    }
+
+    /// Dos fragmentos escritos como una sola cadena ("a::b" + "::" + "C").
+    void qualified(const std::string& scope, const std::string& name) {
+        m_out += '"';
+        if (!scope.empty()) {
+            escape(scope);
+            m_out += "::";
+        }
+        escape(name);
+        m_out += '"';
+    }
+
+    void id(char tag, std::uint64_t value) {
+        static const char* const kDigits = "0123456789abcdef";
+        char text[20] = {'"', tag, ':'};
+        for (int i = 0; i < 16; ++i) {
+            text[3 + i] = kDigits[(value >> (60 - 4 * i)) & 0xF];
+        }
+        text[19] = '"';
+        m_out.append(text, sizeof(text));
+    }
+
+    void boolean(bool value) { m_out += value ? "true" : "false"; }
+
+    void null() { m_out += "null"; }
+
+private:
+    void escape(const std::string& text) {
+        for (char c : text) {
+            switch (c) {
+                case '"':  m_out += "\\\""; break;
+                case '\\': m_out += "\\\\"; break;
+                case '\n': m_out += "\\n"; break;
+                case '\t': m_out += "\\t"; break;
+                case '\r': m_out += "\\r"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        static const char* const kDigits = "0123456789abcdef";
+                        m_out += "\\u00";
+                        m_out += kDigits[(c >> 4) & 0xF];
+                        m_out += kDigits[c & 0xF];
+                    } else {
+                        m_out += c;
+                    }
+            }
+        }
+    }
+
+    std::string& m_out;
+};
+
+/// Igual que Type::getFullName, pero añadiendo al búfer en lugar de crear un stringstream.
+void appendType(std::string& out, const Type& type) {
+    if (type.isConst()) out += "const ";
+    if (type.isVolatile()) out += "volatile ";
+    out += type.getName();
+    const auto& params = type.getTemplateParameters();
+    if (!params.empty()) {
+        out += '<';
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) out += ", ";
+            appendType(out, params[i]);
+        }
+        out += '>';
+    }
+    if (type.isPointer()) out += '*';
+    if (type.isReference()) out += '&';
+}
+
+/// true si el tipo, o alguno de sus argumentos de plantilla, no se pudo resolver.
+bool hasUnresolved(const Type& type) {
+    if (type.isUnresolved()) return true;
+    for (const auto& param : type.getTemplateParameters()) {
+        if (hasUnresolved(param)) return true;
+    }
+    return false;
+}
+
+const char* visibilityName(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Public:    return "public";
+        case Visibility::Protected: return "protected";
+        case Visibility::Private:   return "private";
+        default:                    return nullptr;
+    }
+}
+
+const char* classKindName(ClassKind kind) {
+    switch (kind) {
+        case ClassKind::Struct: return "struct";
+        case ClassKind::Union:  return "union";
+        default:                return "class";
+    }
+}
+
+const char* relationshipName(RelationshipKind kind) {
+    switch (kind) {
+        case RelationshipKind::Inheritance: return "inheritance";
+        case RelationshipKind::Association: return "association";
+        case RelationshipKind::Composition: return "composition";
+        case RelationshipKind::Aggregation: return "aggregation";
+        case RelationshipKind::Usage:       return "usage";
+        default:                            return "relationship";
+    }
+}
+
+// --- Bloques en Orden ---
+
+/**
+ * @brief Entrega a un único escritor los bloques de todas las particiones,
+ *        en el orden de las particiones, con memoria acotada.
+ *
+ * Las particiones en curso viven en un anillo de 'window' huecos y cada
+ * hueco guarda como máximo 'maxPending' bloques: un hilo que se adelanta
+ * demasiado espera a que el escritor lo alcance.
+ */
+class OrderedChunks {
+public:
+    OrderedChunks(std::size_t partitions, std::size_t window, std::size_t maxPending)
+        : m_partitions(partitions), m_slots(window), m_maxPending(std::max<std::size_t>(1, maxPending)) {}
+
+    /// Toma la siguiente partición a formatear; false si no quedan.
+    bool acquire(std::size_t& partition) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workerCv.wait(lock, [&] {
+            return m_aborted || m_next >= m_partitions || m_next < m_current + m_slots.size();
+        });
+        if (m_aborted || m_next >= m_partitions) return false;
+        partition = m_next++;
+        return true;
+    }
+
+    /// Entrega un bloque; false si la exportación se abortó.
+    bool push(std::size_t partition, std::string chunk) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Slot& slot = m_slots[partition % m_slots.size()];
+        m_workerCv.wait(lock, [&] { return m_aborted || slot.chunks.size() < m_maxPending; });
+        if (m_aborted) return false;
+        slot.chunks.push_back(std::move(chunk));
+        m_writerCv.notify_one();
+        return true;
+    }
+
+    void finish(std::size_t partition) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slots[partition % m_slots.size()].done = true;
+        m_writerCv.notify_one();
+    }
+
+    /**
+     * @brief El siguiente bloque en orden.
+     * @param wait Si es false, devuelve false en lugar de esperar.
+     * @return false al terminar todas las particiones (o si no hay nada y !wait).
+     */
+    bool pop(std::string& chunk, bool wait) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            if (m_aborted || m_current >= m_partitions) return false;
+            Slot& slot = m_slots[m_current % m_slots.size()];
+            if (!slot.chunks.empty()) {
+                chunk = std::move(slot.chunks.front());
+                slot.chunks.pop_front();
+                m_workerCv.notify_all();
+                return true;
+            }
+            if (slot.done) {
+                slot.done = false;
+                ++m_current;
+                m_workerCv.notify_all();
+                continue;
+            }
+            if (!wait) return false;
+            m_writerCv.wait(lock);
+        }
+    }
+
+    void abort() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_aborted = true;
+        m_workerCv.notify_all();
+        m_writerCv.notify_all();
+    }
+
+private:
+    struct Slot {
+        std::deque<std::string> chunks;
+        bool done = false;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_workerCv;
+    std::condition_variable m_writerCv;
+    const std::size_t m_partitions;
+    std::vector<Slot> m_slots;
+    const std::size_t m_maxPending;
+    std::size_t m_next = 0;    ///< Siguiente partición a repartir
+    std::size_t m_current = 0; ///< Partición que está escribiendo el escritor
+    bool m_aborted = false;
+};
+
+// --- Formateo de una Partición ---
+
+class PartitionWriter {
+public:
+    /// @param model Para la partición de relaciones (nullptr si no la hay).
+    PartitionWriter(const Model* model, const Ownership& ownership, OrderedChunks& chunks,
+                    std::size_t chunkBytes)
+        : m_model(model), m_ownership(ownership), m_chunks(chunks), m_chunkBytes(chunkBytes), m_json(m_buffer) {}
+
+    /**
+     * @brief Formatea una partición completa; false si la exportación se abortó.
+     * @param index Posición de la partición en esta llamada (orden de salida).
+     * @param owner Índice global de la partición (ver Ownership).
+     */
+    bool run(const Partition& partition, std::size_t index, std::uint32_t owner) {
+        m_index = index;
+        m_owner = owner;
+        m_ok = true;
+        m_buffer.reserve(m_chunkBytes + 4096);
+        if (partition.global) {
+            members(*partition.global, partition.begin, partition.end, Scope{}, nullptr);
+        } else if (m_model) {
+            relationships();
+        }
+        if (m_ok && !m_buffer.empty()) {
+            m_ok = m_chunks.push(m_index, std::move(m_buffer));
+            m_buffer.clear();
+        }
+        m_chunks.finish(m_index);
+        return m_ok;
+    }
+
+    std::size_t records() const { return m_records; }
+
+private:
+    void endRecord() {
+        m_json.endRecord();
+        ++m_records;
+        if (m_buffer.size() >= m_chunkBytes && m_ok) {
+            m_ok = m_chunks.push(m_index, std::move(m_buffer));
+            m_buffer.clear();
+            m_buffer.reserve(m_chunkBytes + 4096);
+        }
+    }
+
+    void members(const Namespace& ns, std::size_t begin, std::size_t end, const Scope& scope,
+                 const std::uint64_t* namespaceId) {
+        const auto& list = ns.getMembers();
+        for (std::size_t i = begin; i < end && m_ok; ++i) {
+            const Element& member = *list[i];
+            if (member.getKind() == ElementKind::Class) {
+                const std::uint64_t id = scope.child(member.getName());
+                if (Ownership::owns(m_ownership.classes, id, m_owner)) {
+                    classRecord(static_cast<const Class&>(member), id, scope, namespaceId);
+                }
+            } else if (member.getKind() == ElementKind::Namespace) {
+                const Scope inner = scope.enter(member.getName());
+                if (Ownership::owns(m_ownership.namespaces, inner.hash, m_owner)) {
+                    m_json.beginRecord("namespace");
+                    m_json.key("id");
+                    m_json.id('n', inner.hash);
+                    m_json.key("name");
+                    m_json.string(member.getName());
+                    m_json.key("qualifiedName");
+                    m_json.string(inner.qualifiedName);
+                    m_json.key("parent");
+                    if (namespaceId) m_json.id('n', *namespaceId); else m_json.null();
+                    endRecord();
+                }
+                const auto& nested = static_cast<const Namespace&>(member);
+                members(nested, 0, nested.getMembers().size(), inner, &inner.hash);
+            }
+        }
+    }
+
+    void visibility(Visibility value) {
+        if (const char* name = visibilityName(value)) {
+            m_json.key("visibility");
+            m_json.raw('"');
+            m_buffer += name;
+            m_json.raw('"');
+        }
+    }
+
+    void typeLink(const Type& type) {
+        if (hasUnresolved(type)) {
+            m_json.key("unresolved");
+            m_json.boolean(true);
+        }
+        if (!type.getCustomTypeElement()) return;
+        auto it = m_ownership.classIds.find(type.getCustomTypeElement());
+        if (it != m_ownership.classIds.end()) {
+            m_json.key("typeClass");
+            m_json.id('c', it->second);
+        }
+    }
+
+    void classRecord(const Class& cls, std::uint64_t id, const Scope& scope, const std::uint64_t* namespaceId) {
+        m_json.beginRecord("class");
+        m_json.key("id");
+        m_json.id('c', id);
+        m_json.key("name");
+        m_json.string(cls.getName());
+        m_json.key("qualifiedName");
+        m_json.qualified(scope.qualifiedName, cls.getName());
+        m_json.key("namespace");
+        if (namespaceId) m_json.id('n', *namespaceId); else m_json.null();
+        m_json.key("kind");
+        m_json.raw('"');
+        m_buffer += classKindName(cls.getClassKind());
+        m_json.raw('"');
+        visibility(cls.getVisibility());
+        if (cls.isTemplate()) {
+            m_json.key("templateParameters");
+            m_json.raw('[');
+            const auto& params = cls.getTemplateParameters();
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                if (i > 0) m_json.raw(',');
+                m_json.raw('{');
+                m_json.firstKey("name");
+                m_json.string(params[i].name);
+                m_json.raw(',');
+                m_json.firstKey("kind");
+                m_json.string(params[i].kind);
+                if (!params[i].defaultArgument.empty()) {
+                    m_json.raw(',');
+                    m_json.firstKey("default");
+                    m_json.string(params[i].defaultArgument);
+                }
+                m_json.raw(',');
+                m_json.firstKey("pack");
+                m_json.boolean(params[i].isPack);
+                m_json.raw('}');
+            }
+            m_json.raw(']');
+        }
+        if (!cls.getSpecializedTemplate().empty()) {
+            m_json.key("specializes");
+            m_json.string(cls.getSpecializedTemplate());
+        }
+        endRecord();
+
+        const std::uint64_t memberScope = fnv(id, "::", 2);
+        for (const auto& field : cls.getFields()) {
+            m_scratch.clear();
+            appendType(m_scratch, field->getType());
+            m_json.beginRecord("field");
+            m_json.key("id");
+            m_json.id('f', fnv(memberScope, field->getName()));
+            m_json.key("class");
+            m_json.id('c', id);
+            m_json.key("name");
+            m_json.string(field->getName());
+            m_json.key("valueType");
+            m_json.string(m_scratch);
+            typeLink(field->getType());
+            visibility(field->getVisibility());
+            m_json.key("static");
+            m_json.boolean(field->isStatic());
+            endRecord();
+        }
+
+        for (const auto& method : cls.getMethods()) {
+            // La firma forma parte del id: las sobrecargas no colisionan.
+            const auto& params = method->getParameters();
+            m_scratch.assign(1, '(');
+            m_spans.clear();
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                if (i > 0) m_scratch += ',';
+                const std::size_t start = m_scratch.size();
+                appendType(m_scratch, params[i]->getType());
+                m_spans.emplace_back(start, m_scratch.size() - start);
+            }
+            m_scratch += method->isConst() ? ") const" : ")";
+
+            m_json.beginRecord("method");
+            m_json.key("id");
+            m_json.id('m', fnv(fnv(memberScope, method->getName()), m_scratch));
+            m_json.key("class");
+            m_json.id('c', id);
+            m_json.key("name");
+            m_json.string(method->getName());
+            m_typeText.clear();
+            appendType(m_typeText, method->getReturnType());
+            m_json.key("returnType");
+            m_json.string(m_typeText);
+            m_json.key("parameters");
+            m_json.raw('[');
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                if (i > 0) m_json.raw(',');
+                m_json.raw('{');
+                m_json.firstKey("name");
+                m_json.string(params[i]->getName());
+                m_json.raw(',');
+                m_json.firstKey("valueType");
+                m_typeText.assign(m_scratch, m_spans[i].first, m_spans[i].second);
+                m_json.string(m_typeText);
+                m_json.raw('}');
+            }
+            m_json.raw(']');
+            visibility(method->getVisibility());
+            m_json.key("static");
+            m_json.boolean(method->isStatic());
+            m_json.key("const");
+            m_json.boolean(method->isConst());
+            m_json.key("virtual");
+            m_json.boolean(method->isVirtual());
+            m_json.key("pureVirtual");
+            m_json.boolean(method->isPureVirtual());
+            bool unresolved = hasUnresolved(method->getReturnType());
+            for (const auto& param : params) unresolved = unresolved || hasUnresolved(param->getType());
+            if (unresolved) {
+                m_json.key("unresolved");
+                m_json.boolean(true);
+            }
+            endRecord();
+        }
+
+        for (const auto& base : cls.getBaseClasses()) {
+            std::uint64_t target = 0;
+            if (!base.baseName.empty()) {
+                target = classIdFor(base.baseName);
+            } else if (base.baseClass) {
+                auto it = m_ownership.classIds.find(base.baseClass);
+                if (it == m_ownership.classIds.end()) continue;
+                target = it->second;
+            } else {
+                continue;
+            }
+            m_json.beginRecord("relationship");
+            m_json.key("kind");
+            m_json.string("inheritance");
+            m_json.key("source");
+            m_json.id('c', id);
+            m_json.key("target");
+            m_json.id('c', target);
+            visibility(base.visibility);
+            endRecord();
+        }
+    }
+
+    void relationships() {
+        for (const auto& rel : m_model->getRelationships()) {
+            if (!m_ok) return;
+            auto source = m_ownership.classIds.find(rel->getSource());
+            auto target = m_ownership.classIds.find(rel->getDestination());
+            if (source == m_ownership.classIds.end() || target == m_ownership.classIds.end()) continue;
+            m_json.beginRecord("relationship");
+            m_json.key("kind");
+            m_json.string(relationshipName(rel->getKind()));
+            m_json.key("source");
+            m_json.id('c', source->second);
+            m_json.key("target");
+            m_json.id('c', target->second);
+            endRecord();
+        }
+    }
+
+    const Model* m_model;
+    const Ownership& m_ownership;
+    OrderedChunks& m_chunks;
+    const std::size_t m_chunkBytes;
+    std::string m_buffer;
+    JsonWriter m_json;
+    std::string m_scratch;   ///< Firma del método en curso
+    std::string m_typeText;  ///< Un tipo suelto
+    std::vector<std::pair<std::size_t, std::size_t>> m_spans; ///< Tipos de los parámetros dentro de m_scratch
+    std::size_t m_index = 0;
+    std::uint32_t m_owner = 0;
+    std::size_t m_records = 0;
+    bool m_ok = true;
+};
+
+/**
+ * @brief Lo que una exportación incremental conserva entre llamadas.
+ */
+struct StreamState {
+    Ownership ownership;
+    std::uint32_t nextPartition = 0; ///< Índice global de la siguiente partición
+    NdjsonStats stats;
+};
+
+/**
+ * @brief Exporta unas particiones con 'threads' hilos formateando y el hilo
+ *        llamador escribiendo.
+ * @param model Para la partición de relaciones (nullptr si no la hay).
+ * @param write Escribe un bloque; devuelve false si falló.
+ */
+bool streamPartitions(const Model* model, const std::vector<Partition>& partitions, StreamState& state,
+                      const NdjsonOptions& options, const std::function<bool(const std::string&)>& write) {
+    if (partitions.empty()) return true;
+
+    const std::uint32_t first = state.nextPartition;
+    state.nextPartition += static_cast<std::uint32_t>(partitions.size());
+    for (std::size_t p = 0; p < partitions.size(); ++p) {
+        if (partitions[p].global) {
+            state.ownership.collect(*partitions[p].global, partitions[p].begin, partitions[p].end, Scope{},
+                                    first + static_cast<std::uint32_t>(p));
+        }
+    }
+
+    unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(partitions.size())));
+    const std::size_t chunkBytes = std::max<std::size_t>(options.chunkBytes, 4096);
+    OrderedChunks chunks(partitions.size(), 2 * threads, options.pendingChunks);
+
+    std::vector<std::size_t> records(threads, 0);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            PartitionWriter writer(model, state.ownership, chunks, chunkBytes);
+            for (std::size_t p; chunks.acquire(p);) {
+                if (!writer.run(partitions[p], p, first + static_cast<std::uint32_t>(p))) break;
+            }
+            records[t] = writer.records();
+        });
+    }
+
+    // Se agrupan los bloques ya listos para escribir en trozos grandes,
+    // pero sin esperar: el consumidor recibe datos en cuanto existen.
+    bool ok = true;
+    std::string pending;
+    for (std::string chunk; ok && chunks.pop(chunk, true);) {
+        pending = std::move(chunk);
+        while (pending.size() < chunkBytes && chunks.pop(chunk, false)) pending += chunk;
+        state.stats.bytes += pending.size();
+        ok = write(pending);
+    }
+    if (!ok) chunks.abort();
+    for (auto& worker : workers) worker.join();
+
+    for (std::size_t count : records) state.stats.records += count;
+    return ok;
+}
+
+/// Escribe cada bloque en un flujo y lo vacía.
+std::function<bool(const std::string&)> streamWriter(std::ostream& out) {
+    return [&out](const std::string& chunk) {
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        out.flush();
+        return static_cast<bool>(out);
+    };
+}
+
+bool streamModel(const Model& model, const NdjsonOptions& options,
+                 const std::function<bool(const std::string&)>& write, NdjsonStats* stats) {
+    StreamState state;
+    const bool ok = streamPartitions(&model, makePartitions(model), state, options, write);
+    if (stats) *stats = state.stats;
+    return ok;
+}
+
+} // namespace
+
+// --- Exportación ---
+
+bool NdjsonExporter::exportModel(const Model& model, std::ostream& out, NdjsonStats* stats) const {
+    return streamModel(model, m_options, streamWriter(out), stats);
+}
+
+bool NdjsonExporter::exportToFile(const Model& model, const std::string& path, NdjsonStats* stats) const {
+    const bool toStdout = path == "-";
+    std::FILE* file = toStdout ? stdout : std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: no se pudo abrir " << path << " para escribir" << std::endl;
+        return false;
+    }
+
+    // Cada bloque se vacía en cuanto se escribe: quien lee por una tubería
+    // recibe registros completos mientras la exportación continúa.
+    bool ok = streamModel(model, m_options, [&](const std::string& chunk) {
+        return std::fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size() && std::fflush(file) == 0;
+    }, stats);
+    if (!toStdout) {
+        ok = std::fclose(file) == 0 && ok;
+    }
+    if (!ok) {
+        std::cerr << "Error: no se pudo escribir " << path << std::endl;
+    }
+    return ok;
+}
+
+// --- Exportación Incremental ---
+
+struct NdjsonStreamWriter::State : StreamState {};
+
+NdjsonStreamWriter::NdjsonStreamWriter(std::ostream& out, NdjsonOptions options)
+    : m_out(out), m_options(options), m_state(std::make_unique<State>()) {}
+
+NdjsonStreamWriter::~NdjsonStreamWriter() = default;
+
+bool NdjsonStreamWriter::add(const TranslationUnit& tu) {
+    if (!m_ok) return false;
+    std::vector<Partition> partitions;
+    appendPartitions(tu, partitions);
+    m_ok = streamPartitions(nullptr, partitions, *m_state, m_options, streamWriter(m_out));
+    return m_ok;
+}
+
+bool NdjsonStreamWriter::finish(const Model& model) {
+    if (!m_ok) return false;
+    m_ok = streamPartitions(&model, std::vector<Partition>(1), *m_state, m_options, streamWriter(m_out));
+    return m_ok;
+}
+
+NdjsonStats NdjsonStreamWriter::stats() const {
+    return m_state->stats;
+}
+
+} // namespace exporter
+} // namespace cppuml
@@ -0,0 +1,116 @@
+#ifndef CPP_UML_GENERATOR_CORE_EXPORTER_NDJSON_EXPORTER_H
+#define CPP_UML_GENERATOR_CORE_EXPORTER_NDJSON_EXPORTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "model/Model.h"
+
+namespace cppuml {
+namespace exporter {
+
+/**
+ * @brief Opciones del exportador NDJSON.
+ */
+struct NdjsonOptions {
+    unsigned threads = 0;                  ///< Hilos que formatean registros (0 = número de núcleos)
+    std::size_t chunkBytes = 1 << 20;      ///< Tamaño de cada bloque de salida
+    std::size_t pendingChunks = 4;         ///< Bloques en espera por hilo antes de bloquearse
+};
+
+/**
+ * @brief Resumen de una exportación.
+ */
+struct NdjsonStats {
+    std::size_t records = 0;
+    std::size_t bytes = 0;
+};
+
+/**
+ * @class NdjsonExporter
+ * @brief Escribe el modelo como JSON delimitado por saltos de línea (un registro por línea).
+ *
+ * Tipos de registro: "namespace", "class", "field", "method" y
+ * "relationship". Cada elemento lleva un id estable ("c:" + 16 dígitos
+ * hexadecimales del hash de su nombre calificado; los métodos incluyen
+ * además su firma), de modo que dos exportaciones del mismo código
+ * producen los mismos ids y un consumidor puede unir registros sin
+ * esperar al final. Una relación puede aparecer antes que su destino.
+ *
+ * El modelo se reparte en particiones (porciones del namespace global de
+ * cada TU) que varios hilos formatean en bloques de 'chunkBytes'. Los
+ * bloques se escriben en el orden de las particiones en cuanto están
+ * listos: la salida es determinista y la memoria está acotada a
+ * threads x pendingChunks bloques, sea cual sea el tamaño del modelo.
+ * Una clase incluida desde varias TUs se escribe una sola vez.
+ */
+class NdjsonExporter {
+public:
+    explicit NdjsonExporter(NdjsonOptions options = {})
+        : m_options(options) {}
+
+    /**
+     * @brief Exporta el modelo a un flujo (se vacía tras cada bloque).
+     * @return false si la escritura falló.
+     */
+    bool exportModel(const Model& model, std::ostream& out, NdjsonStats* stats = nullptr) const;
+
+    /**
+     * @brief Exporta el modelo a un archivo, o a la salida estándar si 'path' es "-".
+     * @return false si el archivo no se pudo abrir o escribir.
+     */
+    bool exportToFile(const Model& model, const std::string& path, NdjsonStats* stats = nullptr) const;
+
+private:
+    NdjsonOptions m_options;
+};
+
+/**
+ * @class NdjsonStreamWriter
+ * @brief La misma exportación que NdjsonExporter, pero alimentada TU a TU.
+ *
+ * Cada add() escribe en seguida los registros de una TU recién analizada
+ * (sus particiones se formatean en paralelo) y recuerda qué clases y
+ * namespaces ya salieron, así que una clase compartida se escribe con la
+ * primera TU que la contiene. Con las mismas TUs en el mismo orden, la
+ * salida es idéntica a la de NdjsonExporter sobre el modelo completo.
+ *
+ * No es seguro llamarlo desde varios hilos a la vez; el formateo interno sí
+ * usa 'threads' hilos.
+ */
+class NdjsonStreamWriter {
+public:
+    NdjsonStreamWriter(std::ostream& out, NdjsonOptions options = {});
+    ~NdjsonStreamWriter();
+
+    NdjsonStreamWriter(const NdjsonStreamWriter&) = delete;
+    NdjsonStreamWriter& operator=(const NdjsonStreamWriter&) = delete;
+
+    /**
+     * @brief Escribe los registros de una TU (se vacía tras cada bloque).
+     * @return false si la escritura falló (las llamadas siguientes no escriben).
+     */
+    bool add(const TranslationUnit& tu);
+
+    /**
+     * @brief Escribe las relaciones del modelo y cierra la exportación.
+     */
+    bool finish(const Model& model);
+
+    NdjsonStats stats() const;
+
+private:
+    struct State;
+    std::ostream& m_out;
+    NdjsonOptions m_options;
+    std::unique_ptr<State> m_state;
+    bool m_ok = true;
+};
+
+} // namespace exporter
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_EXPORTER_NDJSON_EXPORTER_H
@@ -0,0 +1,601 @@
+#include "exporter/PlantUmlExporter.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace exporter {
+
+namespace {
+
+// --- Utilidades de Texto ---
+
+/// Alias válido para PlantUML: el nombre calificado sin caracteres especiales.
+std::string aliasFor(const std::string& qualifiedName) {
+    std::string alias;
+    alias.reserve(qualifiedName.size());
+    for (char c : qualifiedName) {
+        const bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        alias += word ? c : '_';
+    }
+    return alias;
+}
+
+/// Flecha PlantUML de una relación (del origen al destino).
+const char* arrowFor(RelationshipKind kind) {
+    switch (kind) {
+        case RelationshipKind::Inheritance: return "--|>";
+        case RelationshipKind::Composition: return "*--";
+        case RelationshipKind::Aggregation: return "o--";
+        case RelationshipKind::Usage:       return "..>";
+        default:                            return "-->";
+    }
+}
+
+/// Etiqueta entre comillas: se evitan las comillas dobles del propio nombre.
+std::string quoted(const std::string& label) {
+    std::string text = "\"";
+    for (char c : label) text += c == '"' ? '\'' : c;
+    text += '"';
+    return text;
+}
+
+int visibilityRank(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Public:    return 0;
+        case Visibility::Protected: return 1;
+        case Visibility::Private:   return 2;
+        default:                    return 3;
+    }
+}
+
+char visibilityChar(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Public:    return '+';
+        case Visibility::Protected: return '#';
+        case Visibility::Private:   return '-';
+        default:                    return '~';
+    }
+}
+
+/// Nombre a mostrar: los parámetros de una plantilla primaria se añaden ("Container<T, Alloc>").
+std::string displayName(const std::string& qualifiedName, const Class& cls) {
+    std::string name = qualifiedName;
+    if (cls.isTemplate() && cls.getSpecializedTemplate().empty()) {
+        name += '<';
+        const auto& params = cls.getTemplateParameters();
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) name += ", ";
+            name += params[i].name;
+            if (params[i].isPack) name += "...";
+        }
+        name += '>';
+    }
+    return name;
+}
+
+/**
+ * @brief Una línea de miembro en sintaxis PlantUML.
+ *
+ * La visibilidad va al principio y los modificadores al final, que es
+ * donde PlantUML los reconoce ambos.
+ */
+std::string memberLine(const Element& member) {
+    std::string line(1, visibilityChar(member.getVisibility()));
+    line += member.getName();
+    bool isStatic = false;
+    bool isAbstract = false;
+    if (member.getKind() == ElementKind::Method) {
+        const auto& method = static_cast<const Method&>(member);
+        line += '(';
+        const auto& params = method.getParameters();
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) line += ", ";
+            line += params[i]->getName();
+            line += " : ";
+            line += params[i]->getType().getFullName();
+        }
+        line += ") : ";
+        line += method.getReturnType().getFullName();
+        if (method.isConst()) line += " const";
+        isStatic = method.isStatic();
+        isAbstract = method.isPureVirtual();
+    } else if (member.getKind() == ElementKind::Field) {
+        const auto& field = static_cast<const Field&>(member);
+        line += " : ";
+        line += field.getType().getFullName();
+        isStatic = field.isStatic();
+    }
+    if (isStatic) line += " {static}";
+    if (isAbstract) line += " {abstract}";
+    return line;
+}
+
+/// Palabra clave y estereotipo de la declaración ("class", "struct", "abstract class"...).
+std::string declaration(const Class& cls) {
+    switch (cls.getClassKind()) {
+        case ClassKind::Struct: return "struct";
+        case ClassKind::Union:  return "class";
+        default: break;
+    }
+    for (const auto& method : cls.getMethods()) {
+        if (method->isPureVirtual()) return "abstract class";
+    }
+    return "class";
+}
+
+void writeClassHeader(std::ostream& out, const std::string& qualifiedName, const Class& cls, const char* color) {
+    out << declaration(cls) << ' ' << quoted(displayName(qualifiedName, cls)) << " as " << aliasFor(qualifiedName);
+    if (cls.getClassKind() == ClassKind::Union) out << " <<union>>";
+    if (color) out << ' ' << color;
+}
+
+void writeHeader(std::ostream& out) {
+    out << "@startuml\n"
+           "set separator none\n"
+           "hide empty members\n";
+}
+
+// --- Recolección ---
+
+struct QualifiedClass {
+    std::string qualifiedName;
+    const Class* cls;
+    std::string scope; ///< Namespace contenedor ("a::b"; vacío = global)
+};
+
+void collect(const Namespace& ns, const std::string& prefix, std::vector<QualifiedClass>& out,
+             std::unordered_set<std::string>& seen) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class) {
+            std::string qualified = prefix + member->getName();
+            if (seen.insert(qualified).second) { // Una clase incluida desde varias TUs se escribe una vez
+                const std::string scope = prefix.empty() ? prefix : prefix.substr(0, prefix.size() - 2);
+                out.push_back({std::move(qualified), static_cast<const Class*>(member.get()), scope});
+            }
+        } else if (member->getKind() == ElementKind::Namespace) {
+            collect(static_cast<const Namespace&>(*member), prefix + member->getName() + "::", out, seen);
+        }
+    }
+}
+
+// --- Presupuesto ---
+
+/**
+ * @brief Namespaces a plegar para que el diagrama no supere 'maxClasses' nodos.
+ * @return Por cada clase, el namespace plegado que la contiene ("" si se dibuja).
+ */
+std::vector<std::string> planFolding(const std::vector<QualifiedClass>& classes, std::size_t maxClasses,
+                                     BudgetReport& report) {
+    std::vector<std::string> foldedInto(classes.size());
+    if (maxClasses == 0 || classes.size() <= maxClasses) return foldedInto;
+
+    // Árbol de namespaces con clases (y sus contenedores).
+    struct Package {
+        std::string parent;
+        std::size_t direct = 0;     ///< Clases propias
+        std::size_t children = 0;   ///< Namespaces anidados
+        std::size_t unfolded = 0;   ///< Anidados aún sin plegar
+        std::size_t classes = 0;    ///< Clases del subárbol
+        bool folded = false;
+    };
+    std::map<std::string, Package> packages;
+    for (const auto& entry : classes) {
+        packages[entry.scope].direct++;
+    }
+    for (auto it = packages.begin(); it != packages.end(); ++it) {
+        // Los contenedores que faltan son claves menores: insertarlos no
+        // invalida el recorrido.
+        for (std::string child = it->first; !child.empty();) {
+            const auto sep = child.rfind("::");
+            std::string parent = sep == std::string::npos ? std::string() : child.substr(0, sep);
+            packages[child].parent = parent;
+            child = std::move(parent);
+        }
+    }
+    for (auto& entry : packages) {
+        if (!entry.first.empty()) packages[entry.second.parent].children++;
+    }
+    for (auto it = packages.rbegin(); it != packages.rend(); ++it) { // Los anidados son claves mayores
+        it->second.classes += it->second.direct;
+        if (!it->first.empty()) packages[it->second.parent].classes += it->second.classes;
+    }
+
+    // Candidatos: namespaces cuyos anidados ya están plegados, por reducción
+    // de nodos (propias + anidados plegados - 1).
+    auto reduction = [&](const Package& p) { return p.direct + p.children - 1; };
+    std::set<std::pair<std::size_t, std::string>> candidates;
+    for (auto& entry : packages) {
+        entry.second.unfolded = entry.second.children;
+        if (entry.second.children == 0) {
+            candidates.emplace(reduction(entry.second), entry.first);
+        }
+    }
+
+    std::size_t nodes = classes.size();
+    while (nodes > maxClasses && !candidates.empty()) {
+        const std::size_t excess = nodes - maxClasses;
+        auto pick = candidates.lower_bound({excess, std::string()});
+        if (pick == candidates.end()) --pick; // Ninguno basta: el que más reduce
+        const std::string name = pick->second;
+        candidates.erase(pick);
+
+        Package& package = packages[name];
+        package.folded = true;
+        nodes -= reduction(package);
+        if (!name.empty()) {
+            Package& parent = packages[package.parent];
+            if (--parent.unfolded == 0) candidates.emplace(reduction(parent), package.parent);
+        }
+    }
+
+    // Cada clase va al namespace plegado más externo que la contiene.
+    std::unordered_map<std::string, std::string> outermost;
+    for (const auto& entry : packages) {
+        std::string folded;
+        for (std::string scope = entry.first;; scope = packages[scope].parent) {
+            if (packages[scope].folded) folded = scope.empty() ? "*" : scope;
+            if (scope.empty()) break;
+        }
+        outermost.emplace(entry.first, folded);
+    }
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        foldedInto[i] = outermost[classes[i].scope];
+    }
+    for (const auto& entry : packages) {
+        const std::string shown = entry.first.empty() ? "*" : entry.first;
+        if (entry.second.folded && outermost[entry.first] == shown) {
+            report.foldedNamespaces++;
+            report.foldedClasses += entry.second.classes;
+            report.cuts.push_back("folded " + (entry.first.empty() ? std::string("(global)") : entry.first) +
+                                  " (" + std::to_string(entry.second.classes) + " classes)");
+        }
+    }
+    return foldedInto;
+}
+
+/// Nombre calificado del nodo de un namespace plegado ("app::net::*"; "*" = global).
+std::string foldedName(const std::string& scope) {
+    return scope == "*" ? scope : scope + "::*";
+}
+
+const char* colorFor(diff::ChangeKind kind) {
+    switch (kind) {
+        case diff::ChangeKind::Added:   return "#palegreen";
+        case diff::ChangeKind::Removed: return "#pink";
+        default:                        return "#lightyellow";
+    }
+}
+
+} // namespace
+
+// --- Diagrama del Modelo ---
+
+void PlantUmlExporter::exportModel(const Model& model, std::ostream& out, BudgetReport* report) const {
+    std::vector<QualifiedClass> classes;
+    std::unordered_set<std::string> seen;
+    for (const auto& tu : model.getTranslationUnits()) {
+        collect(*tu->getGlobalNamespace(), "", classes, seen);
+    }
+
+    const RenderBudget& budget = m_options.budget;
+    BudgetReport local;
+    BudgetReport& cuts = report ? *report : local;
+    cuts = BudgetReport();
+    const std::vector<std::string> foldedInto = planFolding(classes, budget.maxClasses, cuts);
+
+    // Alias del nodo de cada clase: el suyo o el de su namespace plegado.
+    std::unordered_map<const Element*, std::string> aliasOf;
+    aliasOf.reserve(classes.size());
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        const std::string& node = foldedInto[i].empty() ? classes[i].qualifiedName : foldedName(foldedInto[i]);
+        aliasOf.emplace(classes[i].cls, aliasFor(node));
+    }
+
+    std::ostringstream body; // La leyenda depende de lo que se recorte al escribir
+    std::unordered_map<std::string, std::size_t> foldedSizes;
+    for (const auto& scope : foldedInto) {
+        if (!scope.empty()) foldedSizes[scope]++;
+    }
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        const auto& entry = classes[i];
+        if (foldedInto[i].empty()) {
+            writeClassHeader(body, entry.qualifiedName, *entry.cls, nullptr);
+            if (!m_options.showMembers) {
+                body << '\n';
+            } else if (writeMembers(*entry.cls, body)) {
+                cuts.summarizedClasses++;
+            }
+            continue;
+        }
+        auto size = foldedSizes.find(foldedInto[i]);
+        if (size == foldedSizes.end()) continue; // Ya declarado
+        const std::string name = foldedName(foldedInto[i]);
+        body << "class " << quoted(name) << " as " << aliasFor(name) << " <<folded>>";
+        if (m_options.showMembers) body << " {\n  .. " << size->second << " classes ..\n}";
+        body << '\n';
+        foldedSizes.erase(size);
+    }
+    if (cuts.summarizedClasses > 0) {
+        cuts.cuts.push_back("summarized the members of " + std::to_string(cuts.summarizedClasses) +
+                            " class(es) (max " + std::to_string(budget.maxMembersPerClass) + " per class)");
+    }
+
+    // Flechas entre nodos; las de clases plegadas se agregan por extremo y tipo.
+    struct Edge {
+        std::string source;
+        std::string target;
+        const char* arrow;
+        bool inheritance;
+        std::size_t count;
+    };
+    std::vector<Edge> edges;
+    std::unordered_map<std::string, std::size_t> edgeIndex;
+    auto addEdge = [&](const std::string& source, const std::string& target, const char* arrow, bool inheritance,
+                       bool internal) {
+        if (internal) return;
+        auto inserted = edgeIndex.emplace(source + ' ' + arrow + ' ' + target, edges.size());
+        if (inserted.second) {
+            edges.push_back({source, target, arrow, inheritance, 1});
+        } else {
+            edges[inserted.first->second].count++;
+        }
+    };
+    std::unordered_map<const Element*, bool> isFolded;
+    for (std::size_t i = 0; i < classes.size(); ++i) isFolded.emplace(classes[i].cls, !foldedInto[i].empty());
+
+    for (const auto& entry : classes) {
+        const std::string& derived = aliasOf[entry.cls];
+        for (const auto& base : entry.cls->getBaseClasses()) {
+            auto it = aliasOf.find(base.baseClass);
+            if (it != aliasOf.end()) {
+                addEdge(it->second, derived, "<|--", true, it->second == derived && isFolded[entry.cls]);
+            }
+        }
+    }
+    for (const auto& rel : model.getRelationships()) {
+        auto src = aliasOf.find(rel->getSource());
+        auto dst = aliasOf.find(rel->getDestination());
+        if (src == aliasOf.end() || dst == aliasOf.end()) continue;
+        addEdge(src->second, dst->second, arrowFor(rel->getKind()), rel->getKind() == RelationshipKind::Inheritance,
+                src->second == dst->second && isFolded[rel->getSource()]);
+    }
+
+    std::vector<bool> keep(edges.size(), true);
+    if (budget.maxEdges > 0 && edges.size() > budget.maxEdges) {
+        // Primero las herencias (la estructura del diagrama), después las de más peso.
+        std::vector<std::size_t> order(edges.size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            if (edges[a].inheritance != edges[b].inheritance) return edges[a].inheritance;
+            return edges[a].count > edges[b].count;
+        });
+        for (std::size_t i = budget.maxEdges; i < order.size(); ++i) keep[order[i]] = false;
+        cuts.droppedEdges = edges.size() - budget.maxEdges;
+        cuts.cuts.push_back("dropped " + std::to_string(cuts.droppedEdges) + " of " + std::to_string(edges.size()) +
+                            " edges (max " + std::to_string(budget.maxEdges) + ")");
+    }
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (!keep[i]) continue;
+        body << edges[i].source << ' ' << edges[i].arrow << ' ' << edges[i].target;
+        if (edges[i].count > 1) body << " : x" << edges[i].count;
+        body << '\n';
+    }
+
+    beginDiagram(out);
+    if (!cuts.empty()) {
+        // Solo las primeras líneas: la leyenda también tiene que renderizarse rápido.
+        constexpr std::size_t kLegendLines = 12;
+        out << "legend bottom right\n  Render budget applied:\n";
+        for (std::size_t i = 0; i < cuts.cuts.size() && i < kLegendLines; ++i) {
+            out << "  - " << cuts.cuts[i] << '\n';
+        }
+        if (cuts.cuts.size() > kLegendLines) out << "  - ... and " << cuts.cuts.size() - kLegendLines << " more\n";
+        out << "endlegend\n";
+    }
+    out << body.str();
+    endDiagram(out);
+}
+
+// --- Escritura por Partes ---
+
+void PlantUmlExporter::beginDiagram(std::ostream& out) {
+    writeHeader(out);
+}
+
+void PlantUmlExporter::endDiagram(std::ostream& out) {
+    out << "@enduml\n";
+}
+
+void PlantUmlExporter::exportClass(const std::string& qualifiedName, const Class& cls, std::ostream& out) const {
+    writeClassHeader(out, qualifiedName, cls, nullptr);
+    if (!m_options.showMembers) {
+        out << '\n';
+        return;
+    }
+    writeMembers(cls, out);
+}
+
+bool PlantUmlExporter::writeMembers(const Class& cls, std::ostream& out) const {
+    const auto& fields = cls.getFields();
+    const auto& methods = cls.getMethods();
+    const std::size_t limit = m_options.budget.maxMembersPerClass;
+    out << " {\n";
+    if (limit == 0 || fields.size() + methods.size() <= limit) {
+        for (const auto& field : fields) out << "  " << memberLine(*field) << '\n';
+        for (const auto& method : methods) out << "  " << memberLine(*method) << '\n';
+        out << "}\n";
+        return false;
+    }
+
+    // Las sobrecargas se agrupan en una línea por nombre (con la visibilidad
+    // de la más visible).
+    struct Line {
+        const Element* member;
+        std::size_t overloads;
+        Visibility visibility;
+    };
+    std::vector<Line> lines;
+    for (const auto& field : fields) lines.push_back({field.get(), 1, field->getVisibility()});
+    std::unordered_map<std::string, std::size_t> byName;
+    for (const auto& method : methods) {
+        auto inserted = byName.emplace(method->getName(), lines.size());
+        if (inserted.second) {
+            lines.push_back({method.get(), 1, method->getVisibility()});
+            continue;
+        }
+        Line& line = lines[inserted.first->second];
+        line.overloads++;
+        if (visibilityRank(method->getVisibility()) < visibilityRank(line.visibility)) {
+            line.visibility = method->getVisibility();
+        }
+    }
+
+    // Si aún no caben, se conservan los más visibles (en su orden) y el resto se cuenta.
+    std::vector<bool> keep(lines.size(), true);
+    std::size_t hiddenFields = 0;
+    std::size_t hiddenMethods = 0;
+    if (lines.size() > limit) {
+        std::vector<std::size_t> order(lines.size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return visibilityRank(lines[a].visibility) < visibilityRank(lines[b].visibility);
+        });
+        for (std::size_t i = limit - 1; i < order.size(); ++i) {
+            const Line& line = lines[order[i]];
+            keep[order[i]] = false;
+            (line.member->getKind() == ElementKind::Field ? hiddenFields : hiddenMethods) += line.overloads;
+        }
+    }
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        if (!keep[i]) continue;
+        const Line& line = lines[i];
+        if (line.overloads == 1) {
+            out << "  " << memberLine(*line.member) << '\n';
+        } else {
+            out << "  " << visibilityChar(line.visibility) << line.member->getName() << "(...) : "
+                << line.overloads << " overloads\n";
+        }
+    }
+    if (hiddenFields + hiddenMethods > 0) {
+        out << "  .. ";
+        if (hiddenFields > 0) out << hiddenFields << " more fields" << (hiddenMethods > 0 ? ", " : "");
+        if (hiddenMethods > 0) out << hiddenMethods << " more methods";
+        out << " ..\n";
+    }
+    out << "}\n";
+    return true;
+}
+
+void PlantUmlExporter::exportInheritance(const std::string& derived, const std::string& base, std::ostream& out) {
+    out << aliasFor(base) << " <|-- " << aliasFor(derived) << '\n';
+}
+
+void PlantUmlExporter::exportRelationship(const std::string& source, const std::string& target,
+                                          RelationshipKind kind, std::ostream& out) {
+    out << aliasFor(source) << ' ' << arrowFor(kind) << ' ' << aliasFor(target) << '\n';
+}
+
+bool PlantUmlExporter::exportToFile(const Model& model, const std::string& path, BudgetReport* report) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: no se pudo abrir " << path << " para escribir" << std::endl;
+        return false;
+    }
+    exportModel(model, out, report);
+    return static_cast<bool>(out);
+}
+
+// --- Diagrama de Diferencias ---
+
+void PlantUmlExporter::exportDiff(const diff::ModelDiff& diff, std::ostream& out) const {
+    writeHeader(out);
+    out << "legend top left\n"
+           "  <back:palegreen> added </back> <back:pink> removed </back> <back:lightyellow> changed </back>\n"
+           "endlegend\n";
+
+    std::unordered_set<std::string> declared;
+    for (const auto& change : diff.classes) {
+        const Class& cls = change.after ? *change.after : *change.before;
+        declared.insert(change.qualifiedName);
+        writeClassHeader(out, change.qualifiedName, cls, colorFor(change.kind));
+        if (!m_options.showMembers) {
+            out << '\n';
+            continue;
+        }
+        out << " {\n";
+
+        if (change.kind != diff::ChangeKind::Changed) {
+            for (const auto& field : cls.getFields()) out << "  " << memberLine(*field) << '\n';
+            for (const auto& method : cls.getMethods()) out << "  " << memberLine(*method) << '\n';
+            out << "}\n";
+            continue;
+        }
+
+        // Clase modificada: los miembros actuales, con los cambios coloreados,
+        // seguidos de los eliminados tachados.
+        std::unordered_map<const Element*, diff::ChangeKind> changed;
+        for (const auto& member : change.members) {
+            if (member.after) changed.emplace(member.after, member.kind);
+        }
+        auto writeMember = [&](const Element& member) {
+            auto it = changed.find(&member);
+            if (it == changed.end()) {
+                out << "  " << memberLine(member) << '\n';
+            } else {
+                const char* color = it->second == diff::ChangeKind::Added ? "green" : "darkorange";
+                out << "  <color:" << color << ">" << memberLine(member) << "</color>\n";
+            }
+        };
+        for (const auto& field : cls.getFields()) writeMember(*field);
+        for (const auto& method : cls.getMethods()) writeMember(*method);
+        for (const auto& member : change.members) {
+            if (member.kind == diff::ChangeKind::Removed) {
+                out << "  <color:red><s>" << memberLine(*member.before) << "</s></color>\n";
+            }
+        }
+        out << "}\n";
+    }
+
+    for (const auto& rel : diff.relationships) {
+        // Los extremos que no cambiaron se declaran vacíos para dar contexto.
+        for (const std::string* end : {&rel.source, &rel.target}) {
+            if (declared.insert(*end).second) {
+                out << "class " << quoted(*end) << " as " << aliasFor(*end) << '\n';
+            }
+        }
+        const bool added = rel.kind == diff::ChangeKind::Added;
+        const char* style = added ? "#green" : "#red,dashed";
+        if (rel.relationship == RelationshipKind::Inheritance) {
+            out << aliasFor(rel.target) << " <|-[" << style << "]- " << aliasFor(rel.source) << '\n';
+        } else {
+            out << aliasFor(rel.source) << " -[" << style << "]-> " << aliasFor(rel.target) << '\n';
+        }
+    }
+    out << "@enduml\n";
+}
+
+bool PlantUmlExporter::exportDiffToFile(const diff::ModelDiff& diff, const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: no se pudo abrir " << path << " para escribir" << std::endl;
+        return false;
+    }
+    exportDiff(diff, out);
+    return static_cast<bool>(out);
+}
+
+} // namespace exporter
+} // namespace cppuml
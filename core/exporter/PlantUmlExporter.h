@@ -0,0 +1,138 @@
+#ifndef CPP_UML_GENERATOR_CORE_EXPORTER_PLANT_UML_EXPORTER_H
+#define CPP_UML_GENERATOR_CORE_EXPORTER_PLANT_UML_EXPORTER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "diff/ModelDiff.h"
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Relationship.h"
+
+namespace cppuml {
+namespace exporter {
+
+/**
+ * @brief Límites del diagrama: lo que los excede se resume (0 = sin límite).
+ *
+ * El tiempo de renderizado de PlantUML crece muy por encima de lo lineal
+ * con el número de nodos, miembros y flechas; con estos límites queda
+ * acotado sea cual sea el modelo.
+ */
+struct RenderBudget {
+    std::size_t maxClasses = 400;        ///< Nodos del diagrama (clases o namespaces plegados)
+    std::size_t maxMembersPerClass = 40; ///< Líneas de miembros por clase
+    std::size_t maxEdges = 1000;         ///< Flechas, tras agregar las de los namespaces plegados
+};
+
+/**
+ * @brief Opciones del exportador PlantUML.
+ */
+struct PlantUmlOptions {
+    bool showMembers = true; ///< Si es false, solo se escriben los nombres de las clases
+    RenderBudget budget;
+};
+
+/**
+ * @brief Recortes aplicados para respetar el presupuesto.
+ */
+struct BudgetReport {
+    std::size_t foldedNamespaces = 0;  ///< Namespaces dibujados como un solo nodo
+    std::size_t foldedClasses = 0;     ///< Clases dentro de ellos
+    std::size_t summarizedClasses = 0; ///< Clases con sobrecargas agrupadas o miembros resumidos
+    std::size_t droppedEdges = 0;      ///< Flechas omitidas
+    std::vector<std::string> cuts;     ///< Una línea legible por recorte
+
+    bool empty() const { return cuts.empty(); }
+};
+
+/**
+ * @class PlantUmlExporter
+ * @brief Escribe el modelo (o un diff entre dos modelos) como texto PlantUML.
+ *
+ * Cada clase se declara con su nombre calificado como etiqueta y un alias
+ * sin caracteres especiales, de modo que especializaciones como
+ * "Container<T*>" no se confunden con los genéricos de PlantUML.
+ *
+ * El diagrama del modelo respeta 'PlantUmlOptions::budget':
+ *   - Miembros: si una clase supera el límite, sus sobrecargas se agrupan
+ *     en una línea por nombre; si aún lo supera, se conservan los más
+ *     visibles y el resto se resume en una línea con los recuentos.
+ *   - Clases: se pliegan namespaces hoja (o cuyos anidados ya están
+ *     plegados) en un nodo "ns::*"; en cada paso, el más pequeño que basta
+ *     para entrar en el límite o, si ninguno basta, el que más reduce.
+ *   - Flechas: las de las clases plegadas se agregan por extremo y tipo
+ *     (con su número); si aún sobran, se conservan las herencias y las de
+ *     más peso.
+ * Los recortes se listan en una leyenda y en el BudgetReport opcional.
+ */
+class PlantUmlExporter {
+public:
+    explicit PlantUmlExporter(PlantUmlOptions options = {})
+        : m_options(options) {}
+
+    /**
+     * @brief Exporta el diagrama de clases completo.
+     * @param report Si no es nullptr, recibe los recortes del presupuesto.
+     */
+    void exportModel(const Model& model, std::ostream& out, BudgetReport* report = nullptr) const;
+
+    /**
+     * @brief Igual que exportModel, pero escribe en un archivo.
+     * @return false si el archivo no se pudo abrir o escribir.
+     */
+    bool exportToFile(const Model& model, const std::string& path, BudgetReport* report = nullptr) const;
+
+    /**
+     * @brief Exporta un diagrama de diferencias resaltado.
+     *
+     * Solo aparecen las clases que cambiaron (verde = añadida, rojo =
+     * eliminada, amarillo = modificada, con sus miembros coloreados) y las
+     * relaciones añadidas o eliminadas.
+     */
+    void exportDiff(const diff::ModelDiff& diff, std::ostream& out) const;
+
+    /**
+     * @brief Igual que exportDiff, pero escribe en un archivo.
+     */
+    bool exportDiffToFile(const diff::ModelDiff& diff, const std::string& path) const;
+
+    // --- Escritura por Partes ---
+    // Para generar el diagrama sin tener el Modelo completo en memoria
+    // (p.ej., el análisis en streaming): beginDiagram, las clases, las
+    // herencias y endDiagram, en ese orden.
+
+    static void beginDiagram(std::ostream& out);
+    static void endDiagram(std::ostream& out);
+
+    /**
+     * @brief Escribe la declaración de una clase (con sus miembros si 'showMembers',
+     *        dentro del límite 'budget.maxMembersPerClass').
+     */
+    void exportClass(const std::string& qualifiedName, const Class& cls, std::ostream& out) const;
+
+    /**
+     * @brief Escribe una flecha de herencia entre dos clases ya declaradas.
+     */
+    static void exportInheritance(const std::string& derived, const std::string& base, std::ostream& out);
+
+    /**
+     * @brief Escribe una flecha de otro tipo (asociación, composición, uso...)
+     *        entre dos clases ya declaradas.
+     */
+    static void exportRelationship(const std::string& source, const std::string& target, RelationshipKind kind,
+                                   std::ostream& out);
+
+private:
+    /// @return true si los miembros se resumieron para respetar el presupuesto.
+    bool writeMembers(const Class& cls, std::ostream& out) const;
+
+    PlantUmlOptions m_options;
+};
+
+} // namespace exporter
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_EXPORTER_PLANT_UML_EXPORTER_H
@@ -0,0 +1,318 @@
+#include "exporter/SvgExporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exporter/GlyphMetrics.h"
+
+namespace cppuml {
+namespace exporter {
+
+namespace {
+
+// --- Utilidades de Ayuda ---
+
+const char* visibilitySymbol(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Public:    return "+ ";
+        case Visibility::Protected: return "# ";
+        case Visibility::Private:   return "- ";
+        case Visibility::None:      break;
+    }
+    return "";
+}
+
+void appendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '&': out += "&amp;"; break;
+            case '"': out += "&quot;"; break;
+            default:  out += c; break;
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    const int len = std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+    out.append(buffer, static_cast<std::size_t>(len));
+}
+
+/**
+ * @brief Una línea de texto de un compartimento.
+ */
+struct Line {
+    std::string text;
+    bool isStatic = false;   ///< Subrayado (UML)
+    bool isAbstract = false; ///< Cursiva (UML)
+};
+
+/**
+ * @brief Contenido y geometría de la caja de una clase.
+ *
+ * Se calcula una sola vez y lo comparten la medición (para el layout)
+ * y el dibujo, de modo que ambos siempre coinciden.
+ */
+struct ClassBox {
+    std::string title;       ///< Nombre, con los parámetros si es plantilla ("Container<T, Alloc>")
+    std::string stereotype;
+    std::vector<Line> fields;
+    std::vector<Line> methods;
+    double width = 0.0;
+    double headerHeight = 0.0;
+    double fieldsHeight = 0.0;
+    double methodsHeight = 0.0;
+};
+
+ClassBox buildBox(const Class& cls, const SvgOptions& options) {
+    ClassBox box;
+    const double fs = options.fontSize;
+    const double lh = GlyphMetrics::lineHeight(fs);
+
+    if (cls.getClassKind() == ClassKind::Struct) box.stereotype = "«struct»";
+    if (cls.getClassKind() == ClassKind::Union) box.stereotype = "«union»";
+
+    box.title = cls.getName();
+    if (cls.isTemplate() && cls.getSpecializedTemplate().empty()) {
+        box.title += '<';
+        const auto& params = cls.getTemplateParameters();
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) box.title += ", ";
+            box.title += params[i].name;
+            if (params[i].isPack) box.title += "...";
+        }
+        box.title += '>';
+    }
+
+    double textWidth = GlyphMetrics::measure(box.title, fs, true);
+    if (!box.stereotype.empty()) {
+        textWidth = std::max(textWidth, GlyphMetrics::measure(box.stereotype, fs));
+    }
+
+    if (options.showMembers) {
+        for (const auto& field : cls.getFields()) {
+            Line line;
+            line.text = visibilitySymbol(field->getVisibility());
+            line.text += field->getName();
+            line.text += " : ";
+            line.text += field->getType().getFullName();
+            line.isStatic = field->isStatic();
+            textWidth = std::max(textWidth, GlyphMetrics::measure(line.text, fs));
+            box.fields.push_back(std::move(line));
+        }
+
+        for (const auto& method : cls.getMethods()) {
+            Line line;
+            line.text = visibilitySymbol(method->getVisibility());
+            line.text += method->getName();
+            line.text += '(';
+            const auto& params = method->getParameters();
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                if (i > 0) line.text += ", ";
+                line.text += params[i]->getName();
+                line.text += " : ";
+                line.text += params[i]->getType().getFullName();
+            }
+            line.text += ')';
+            line.text += " : ";
+            line.text += method->getReturnType().getFullName();
+            if (method->isConst()) line.text += " const";
+            line.isStatic = method->isStatic();
+            line.isAbstract = method->isPureVirtual();
+            textWidth = std::max(textWidth, GlyphMetrics::measure(line.text, fs));
+            box.methods.push_back(std::move(line));
+        }
+    }
+
+    const double pad = options.padding;
+    box.width = std::max(textWidth + 2 * pad, 4 * fs);
+    box.headerHeight = 2 * pad + lh * (box.stereotype.empty() ? 1 : 2);
+    if (options.showMembers) {
+        box.fieldsHeight = pad + lh * static_cast<double>(box.fields.size()) + (box.fields.empty() ? 0 : pad);
+        box.methodsHeight = pad + lh * static_cast<double>(box.methods.size()) + (box.methods.empty() ? 0 : pad);
+    }
+    return box;
+}
+
+void appendText(std::string& out, double x, double y, std::string_view text,
+                const char* extraAttributes) {
+    out += "<text x=\"";
+    appendNumber(out, x);
+    out += "\" y=\"";
+    appendNumber(out, y);
+    out += '"';
+    out += extraAttributes;
+    out += '>';
+    appendEscaped(out, text);
+    out += "</text>\n";
+}
+
+void appendCompartment(std::string& out, const std::vector<Line>& lines,
+                       double x, double top, const SvgOptions& options) {
+    const double lh = GlyphMetrics::lineHeight(options.fontSize);
+    double y = top + options.padding + GlyphMetrics::ascent(options.fontSize);
+    for (const auto& line : lines) {
+        const char* attrs = line.isStatic ? " text-decoration=\"underline\""
+                          : line.isAbstract ? " font-style=\"italic\""
+                          : "";
+        appendText(out, x + options.padding, y, line.text, attrs);
+        y += lh;
+    }
+}
+
+const char* edgeAttributes(RelationshipKind kind) {
+    switch (kind) {
+        case RelationshipKind::Inheritance: return " marker-start=\"url(#inherit)\"";
+        case RelationshipKind::Composition: return " marker-start=\"url(#compose)\"";
+        case RelationshipKind::Aggregation: return " marker-start=\"url(#aggregate)\"";
+        case RelationshipKind::Usage:       return " stroke-dasharray=\"6,4\" marker-end=\"url(#arrow)\"";
+        case RelationshipKind::Association: return " marker-end=\"url(#arrow)\"";
+        case RelationshipKind::Relationship: break;
+    }
+    return "";
+}
+
+} // namespace
+
+// --- Medición ---
+
+std::pair<double, double> SvgExporter::measureClass(const Class& cls) const {
+    const ClassBox box = buildBox(cls, m_options);
+    return {box.width, box.headerHeight + box.fieldsHeight + box.methodsHeight};
+}
+
+// --- Exportación ---
+
+void SvgExporter::exportModel(const Model& model, std::ostream& out) const {
+    const layout::LayoutGraph graph = layout::buildClassGraph(
+        model, [this](const Class& cls) { return measureClass(cls); });
+    const layout::LayoutResult result = layout::SugiyamaLayout(m_options.layout).run(graph);
+    write(graph, result, out);
+}
+
+bool SvgExporter::exportToFile(const Model& model, const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    exportModel(model, file);
+    return static_cast<bool>(file);
+}
+
+void SvgExporter::write(const layout::LayoutGraph& graph,
+                        const layout::LayoutResult& result,
+                        std::ostream& out) const {
+    const double margin = m_options.margin;
+    const double fs = m_options.fontSize;
+
+    std::string svg;
+    svg.reserve(512 + graph.nodes.size() * 1024 + graph.edges.size() * 160);
+
+    svg += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    svg += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+    appendNumber(svg, result.width + 2 * margin);
+    svg += "\" height=\"";
+    appendNumber(svg, result.height + 2 * margin);
+    svg += "\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"";
+    appendNumber(svg, fs);
+    svg += "\">\n";
+
+    // Terminaciones UML de las relaciones. Las de origen (herencia,
+    // composición, agregación) se orientan con la ruta, que sale de la caja
+    // del origen: la figura queda fuera de ella, con la punta en su borde.
+    svg +=
+        "<defs>\n"
+        "<marker id=\"inherit\" viewBox=\"0 0 12 12\" refX=\"0\" refY=\"6\" markerWidth=\"12\" markerHeight=\"12\" "
+        "markerUnits=\"userSpaceOnUse\" orient=\"auto\">"
+        "<path d=\"M12,0 L0,6 L12,12 Z\" fill=\"white\" stroke=\"black\"/></marker>\n"
+        "<marker id=\"arrow\" viewBox=\"0 0 12 12\" refX=\"12\" refY=\"6\" markerWidth=\"12\" markerHeight=\"12\" "
+        "markerUnits=\"userSpaceOnUse\" orient=\"auto\">"
+        "<path d=\"M0,0 L12,6 L0,12\" fill=\"none\" stroke=\"black\"/></marker>\n"
+        "<marker id=\"compose\" viewBox=\"0 0 16 10\" refX=\"0\" refY=\"5\" markerWidth=\"16\" markerHeight=\"10\" "
+        "markerUnits=\"userSpaceOnUse\" orient=\"auto\">"
+        "<path d=\"M0,5 L8,0 L16,5 L8,10 Z\" fill=\"black\" stroke=\"black\"/></marker>\n"
+        "<marker id=\"aggregate\" viewBox=\"0 0 16 10\" refX=\"0\" refY=\"5\" markerWidth=\"16\" markerHeight=\"10\" "
+        "markerUnits=\"userSpaceOnUse\" orient=\"auto\">"
+        "<path d=\"M0,5 L8,0 L16,5 L8,10 Z\" fill=\"white\" stroke=\"black\"/></marker>\n"
+        "</defs>\n"
+        "<style>.box{fill:#fefece;stroke:#a80036;stroke-width:1.2}"
+        ".sep{stroke:#a80036;stroke-width:1}.edge{fill:none;stroke:black;stroke-width:1}</style>\n";
+
+    // Aristas primero, para que las cajas queden por encima.
+    for (std::size_t e = 0; e < graph.edges.size(); ++e) {
+        const auto& route = result.edgeRoutes[e];
+        if (route.size() < 2) continue;
+        svg += "<polyline class=\"edge\" points=\"";
+        for (const auto& p : route) {
+            appendNumber(svg, p.x + margin);
+            svg += ',';
+            appendNumber(svg, p.y + margin);
+            svg += ' ';
+        }
+        svg.back() = '"';
+        svg += edgeAttributes(graph.edges[e].kind);
+        svg += "/>\n";
+    }
+
+    const double lh = GlyphMetrics::lineHeight(fs);
+    for (std::size_t v = 0; v < graph.nodes.size(); ++v) {
+        const Class* cls = graph.nodes[v].element;
+        if (!cls) continue;
+
+        const ClassBox box = buildBox(*cls, m_options);
+        const double x = result.positions[v].x + margin;
+        const double y = result.positions[v].y + margin;
+        const double w = graph.nodes[v].width;
+        const double h = graph.nodes[v].height;
+        const double cx = x + w / 2.0;
+
+        svg += "<g>\n<rect class=\"box\" x=\"";
+        appendNumber(svg, x);
+        svg += "\" y=\"";
+        appendNumber(svg, y);
+        svg += "\" width=\"";
+        appendNumber(svg, w);
+        svg += "\" height=\"";
+        appendNumber(svg, h);
+        svg += "\"/>\n";
+
+        // Compartimento del nombre
+        double baseline = y + m_options.padding + GlyphMetrics::ascent(fs);
+        if (!box.stereotype.empty()) {
+            appendText(svg, cx, baseline, box.stereotype, " text-anchor=\"middle\"");
+            baseline += lh;
+        }
+        appendText(svg, cx, baseline, box.title, " text-anchor=\"middle\" font-weight=\"bold\"");
+
+        if (m_options.showMembers) {
+            const double fieldsTop = y + box.headerHeight;
+            const double methodsTop = fieldsTop + box.fieldsHeight;
+            for (double top : {fieldsTop, methodsTop}) {
+                svg += "<line class=\"sep\" x1=\"";
+                appendNumber(svg, x);
+                svg += "\" y1=\"";
+                appendNumber(svg, top);
+                svg += "\" x2=\"";
+                appendNumber(svg, x + w);
+                svg += "\" y2=\"";
+                appendNumber(svg, top);
+                svg += "\"/>\n";
+            }
+            appendCompartment(svg, box.fields, x, fieldsTop, m_options);
+            appendCompartment(svg, box.methods, x, methodsTop, m_options);
+        }
+        svg += "</g>\n";
+    }
+
+    svg += "</svg>\n";
+    out.write(svg.data(), static_cast<std::streamsize>(svg.size()));
+}
+
+} // namespace exporter
+} // namespace cppuml
@@ -0,0 +1,78 @@
+#ifndef CPP_UML_GENERATOR_CORE_EXPORTER_SVG_EXPORTER_H
+#define CPP_UML_GENERATOR_CORE_EXPORTER_SVG_EXPORTER_H
+
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "layout/SugiyamaLayout.h"
+#include "model/Class.h"
+#include "model/Model.h"
+
+namespace cppuml {
+namespace exporter {
+
+/**
+ * @brief Opciones de presentación del exportador SVG.
+ */
+struct SvgOptions {
+    double fontSize = 12.0;
+    double padding = 6.0;       ///< Margen interior de cada compartimento
+    double margin = 20.0;       ///< Margen exterior del lienzo
+    bool showMembers = true;    ///< Si es false, solo se dibuja el compartimento del nombre
+    layout::LayoutOptions layout; ///< Parámetros del motor de layout
+};
+
+/**
+ * @class SvgExporter
+ * @brief Escribe un diagrama de clases SVG directamente desde el modelo.
+ *
+ * Sustituye la cadena modelo -> .puml -> JVM -> Graphviz -> SVG:
+ * la posición de las cajas la calcula SugiyamaLayout y el tamaño del texto
+ * se obtiene de GlyphMetrics, así que no se lanza ningún proceso externo.
+ *
+ * Cada clase se dibuja con los tres compartimentos UML (nombre, atributos,
+ * operaciones) y las relaciones con sus terminaciones estándar.
+ */
+class SvgExporter {
+public:
+    explicit SvgExporter(SvgOptions options = {})
+        : m_options(std::move(options)) {}
+
+    /**
+     * @brief Calcula el tamaño de la caja de una clase.
+     *
+     * Se puede pasar como 'NodeSizer' a layout::buildClassGraph.
+     */
+    std::pair<double, double> measureClass(const Class& cls) const;
+
+    /**
+     * @brief Distribuye y exporta el modelo completo.
+     * @param model El modelo a dibujar.
+     * @param out Flujo de salida donde se escribe el documento SVG.
+     */
+    void exportModel(const Model& model, std::ostream& out) const;
+
+    /**
+     * @brief Igual que exportModel, pero escribe en un archivo.
+     * @return false si el archivo no se pudo abrir o escribir.
+     */
+    bool exportToFile(const Model& model, const std::string& path) const;
+
+    /**
+     * @brief Escribe un grafo ya distribuido.
+     *
+     * Útil cuando el consumidor ya ejecutó el layout (p.ej., la escena de la UI).
+     */
+    void write(const layout::LayoutGraph& graph,
+               const layout::LayoutResult& result,
+               std::ostream& out) const;
+
+private:
+    SvgOptions m_options;
+};
+
+} // namespace exporter
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_EXPORTER_SVG_EXPORTER_H
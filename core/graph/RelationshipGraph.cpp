@@ -0,0 +1,369 @@
+#include "graph/RelationshipGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace graph {
+
+namespace {
+
+/// Por debajo de este tamaño un nivel del BFS se expande en un solo hilo.
+constexpr std::size_t kParallelFrontier = 4096;
+
+using Pairs = std::vector<std::pair<NodeId, NodeId>>;
+
+void sortUnique(Pairs& pairs) {
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
+
+/// Quita "class ", "struct "... que libclang antepone a algunos tipos.
+std::string_view bareTypeName(std::string_view name) {
+    for (std::string_view keyword : {"class ", "struct ", "union ", "enum "}) {
+        if (name.compare(0, keyword.size(), keyword) == 0) {
+            name.remove_prefix(keyword.size());
+            break;
+        }
+    }
+    if (name.compare(0, 2, "::") == 0) name.remove_prefix(2);
+    return name;
+}
+
+} // namespace
+
+// --- Construcción ---
+
+void RelationshipGraph::Csr::build(std::size_t nodeCount, const std::vector<std::pair<NodeId, NodeId>>& sortedPairs) {
+    offsets.assign(nodeCount + 1, 0);
+    for (const auto& p : sortedPairs) ++offsets[p.first + 1];
+    for (std::size_t v = 0; v < nodeCount; ++v) offsets[v + 1] += offsets[v];
+    targets.resize(sortedPairs.size());
+    for (std::size_t i = 0; i < sortedPairs.size(); ++i) targets[i] = sortedPairs[i].second; // Ya agrupados por origen
+}
+
+void RelationshipGraph::build(const Model& model) {
+    m_byName.clear();
+    m_names.clear();
+    m_scopes.clear();
+    m_classes.clear();
+    m_byElement.clear();
+
+    collectNodes(model);
+    collectEdges(model);
+    labelHierarchy();
+
+    m_scopes.clear();
+    m_scopes.shrink_to_fit();
+}
+
+void RelationshipGraph::collectNodes(const Model& model) {
+    // Recorrido explícito de los namespaces de todas las TUs; una clase
+    // incluida desde varias TUs es un solo nodo (la primera copia es la canónica).
+    struct Pending {
+        const Namespace* ns;
+        std::string prefix;
+    };
+    std::vector<Pending> stack;
+    for (const auto& tu : model.getTranslationUnits()) {
+        stack.push_back({tu->getGlobalNamespace(), std::string()});
+        while (!stack.empty()) {
+            Pending current = std::move(stack.back());
+            stack.pop_back();
+            for (const auto& member : current.ns->getMembers()) {
+                if (member->getKind() == ElementKind::Namespace) {
+                    stack.push_back({static_cast<const Namespace*>(member.get()),
+                                     current.prefix + member->getName() + "::"});
+                    continue;
+                }
+                if (member->getKind() != ElementKind::Class) continue;
+
+                const NodeId next = static_cast<NodeId>(m_names.size());
+                auto inserted = m_byName.emplace(current.prefix + member->getName(), next);
+                if (inserted.second) {
+                    m_names.push_back(&inserted.first->first);
+                    m_scopes.push_back(current.prefix);
+                    m_classes.push_back(static_cast<const Class*>(member.get()));
+                }
+                m_byElement.emplace(member.get(), inserted.first->second);
+            }
+        }
+    }
+}
+
+NodeId RelationshipGraph::resolveType(const Type& type, const std::string& scope) const {
+    if (const Element* element = type.getCustomTypeElement()) {
+        return nodeOf(element);
+    }
+    const std::string_view name = bareTypeName(type.getName());
+    if (name.empty()) return kInvalidNode;
+
+    // Como la búsqueda de nombres de C++: del namespace de la clase hacia fuera.
+    std::string candidate;
+    for (std::size_t length = scope.size();;) {
+        candidate.assign(scope, 0, length);
+        candidate.append(name.data(), name.size());
+        auto it = m_byName.find(candidate);
+        if (it != m_byName.end()) return it->second;
+        if (length == 0) return kInvalidNode;
+        // "a::b::" -> "a::"
+        const std::size_t previous = length >= 2 ? scope.rfind("::", length - 3) : std::string::npos;
+        length = previous == std::string::npos ? 0 : previous + 2;
+    }
+}
+
+void RelationshipGraph::addTypeEdges(const Type& type, NodeId from, const std::string& scope, Pairs& pairs) const {
+    const NodeId target = resolveType(type, scope);
+    if (target != kInvalidNode && target != from) {
+        pairs.emplace_back(from, target);
+    }
+    for (const auto& argument : type.getTemplateParameters()) {
+        addTypeEdges(argument, from, scope, pairs); // 'std::vector<Order>' también usa 'Order'
+    }
+}
+
+void RelationshipGraph::collectEdges(const Model& model) {
+    std::vector<Pairs> pairs(kKindCount);
+    Pairs& inheritance = pairs[index(RelationshipKind::Inheritance)];
+    Pairs& association = pairs[index(RelationshipKind::Association)];
+    Pairs& usage = pairs[index(RelationshipKind::Usage)];
+
+    for (NodeId v = 0; v < m_classes.size(); ++v) {
+        const Class& cls = *m_classes[v];
+        for (const auto& base : cls.getBaseClasses()) {
+            const NodeId target = nodeOf(base.baseClass);
+            if (target != kInvalidNode && target != v) inheritance.emplace_back(v, target);
+        }
+        for (const auto& field : cls.getFields()) {
+            addTypeEdges(field->getType(), v, m_scopes[v], association);
+        }
+        for (const auto& method : cls.getMethods()) {
+            addTypeEdges(method->getReturnType(), v, m_scopes[v], usage);
+            for (const auto& parameter : method->getParameters()) {
+                addTypeEdges(parameter->getType(), v, m_scopes[v], usage);
+            }
+        }
+    }
+    for (const auto& rel : model.getRelationships()) {
+        const NodeId source = nodeOf(rel->getSource());
+        const NodeId target = nodeOf(rel->getDestination());
+        if (source != kInvalidNode && target != kInvalidNode && source != target) {
+            pairs[index(rel->getKind())].emplace_back(source, target);
+        }
+    }
+
+    for (std::size_t k = 0; k < kKindCount; ++k) {
+        sortUnique(pairs[k]);
+        m_edges[k].forward.build(m_names.size(), pairs[k]);
+        for (auto& p : pairs[k]) std::swap(p.first, p.second);
+        std::sort(pairs[k].begin(), pairs[k].end());
+        m_edges[k].reverse.build(m_names.size(), pairs[k]);
+    }
+}
+
+void RelationshipGraph::labelHierarchy() {
+    const std::size_t n = m_names.size();
+    const Csr& bases = m_edges[index(RelationshipKind::Inheritance)].forward;
+    const Csr& derived = m_edges[index(RelationshipKind::Inheritance)].reverse;
+
+    m_post.assign(n, 0);
+    m_atPost.assign(n, 0);
+    m_labelOffsets.assign(n + 1, 0);
+    m_labels.clear();
+
+    // DFS iterativo de las bases hacia sus derivadas. 'low' es el primer
+    // número de postorden del subárbol: sus descendientes por el árbol de
+    // recubrimiento son exactamente [low, post].
+    enum : std::uint8_t { Unvisited, Active, Done };
+    std::vector<std::uint8_t> state(n, Unvisited);
+    std::vector<std::uint32_t> low(n, 0);
+    std::vector<std::pair<NodeId, std::uint32_t>> stack; // (nodo, siguiente hijo)
+    std::vector<Interval> scratch;
+    std::uint32_t counter = 0;
+
+    auto finish = [&](NodeId v) {
+        // Etiqueta = intervalo propio ∪ etiquetas de todas las derivadas
+        // (las de aristas que no son del árbol aportan intervalos ajenos).
+        scratch.clear();
+        scratch.push_back({low[v], counter});
+        for (NodeId child : derived.range(v)) {
+            if (state[child] != Done) continue; // Un ciclo (imposible en C++ válido) se corta aquí
+            const std::uint32_t p = m_post[child];
+            scratch.insert(scratch.end(), m_labels.begin() + m_labelOffsets[p], m_labels.begin() + m_labelOffsets[p + 1]);
+        }
+        std::sort(scratch.begin(), scratch.end(), [](const Interval& a, const Interval& b) { return a.first < b.first; });
+        const std::size_t start = m_labels.size();
+        for (const Interval& interval : scratch) {
+            if (m_labels.size() > start && interval.first <= m_labels.back().last + 1) {
+                m_labels.back().last = std::max(m_labels.back().last, interval.last);
+            } else {
+                m_labels.push_back(interval);
+            }
+        }
+        m_post[v] = counter;
+        m_atPost[counter] = v;
+        m_labelOffsets[counter + 1] = static_cast<std::uint32_t>(m_labels.size());
+        state[v] = Done;
+        ++counter;
+    };
+
+    auto visitFrom = [&](NodeId root) {
+        state[root] = Active;
+        low[root] = counter;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            const NeighbourRange children = derived.range(top.first);
+            if (top.second < children.size()) {
+                const NodeId child = children.begin()[top.second++];
+                if (state[child] == Unvisited) {
+                    state[child] = Active;
+                    low[child] = counter;
+                    stack.emplace_back(child, 0);
+                }
+                continue;
+            }
+            const NodeId v = top.first;
+            stack.pop_back();
+            finish(v);
+        }
+    };
+
+    for (NodeId v = 0; v < n; ++v) {
+        if (bases.range(v).empty() && state[v] == Unvisited) visitFrom(v);
+    }
+    for (NodeId v = 0; v < n; ++v) {
+        if (state[v] == Unvisited) visitFrom(v); // Solo quedan nodos en ciclos
+    }
+}
+
+// --- Consultas ---
+
+NodeId RelationshipGraph::find(std::string_view qualifiedName) const {
+    auto it = m_byName.find(std::string(qualifiedName));
+    return it == m_byName.end() ? kInvalidNode : it->second;
+}
+
+NodeId RelationshipGraph::nodeOf(const Element* element) const {
+    if (!element) return kInvalidNode;
+    auto it = m_byElement.find(element);
+    return it == m_byElement.end() ? kInvalidNode : it->second;
+}
+
+NeighbourRange RelationshipGraph::neighbours(NodeId node, RelationshipKind kind, Direction direction) const {
+    const EdgeSet& edges = m_edges[index(kind)];
+    return (direction == Direction::Outgoing ? edges.forward : edges.reverse).range(node);
+}
+
+bool RelationshipGraph::isDerivedFrom(NodeId derived, NodeId base) const {
+    if (derived == base || derived >= m_post.size() || base >= m_post.size()) return false;
+    const std::uint32_t p = m_post[derived];
+    const std::uint32_t b = m_post[base];
+    const Interval* first = m_labels.data() + m_labelOffsets[b];
+    const Interval* last = m_labels.data() + m_labelOffsets[b + 1];
+    // El último intervalo que empieza en o antes de p
+    const Interval* it = std::upper_bound(first, last, p, [](std::uint32_t value, const Interval& interval) {
+        return value < interval.first;
+    });
+    return it != first && p <= (it - 1)->last;
+}
+
+std::vector<NodeId> RelationshipGraph::descendants(NodeId base) const {
+    std::vector<NodeId> result;
+    if (base >= m_post.size()) return result;
+    const std::uint32_t b = m_post[base];
+    for (std::uint32_t i = m_labelOffsets[b]; i < m_labelOffsets[b + 1]; ++i) {
+        for (std::uint32_t p = m_labels[i].first; p <= m_labels[i].last; ++p) {
+            if (m_atPost[p] != base) result.push_back(m_atPost[p]);
+        }
+    }
+    return result;
+}
+
+std::vector<NodeId> RelationshipGraph::ancestors(NodeId derived) const {
+    // Las cadenas de bases son cortas: un BFS directo es más barato que etiquetarlas.
+    std::vector<NodeId> result;
+    if (derived >= m_names.size()) return result;
+    std::unordered_set<NodeId> seen{derived};
+    const Csr& bases = m_edges[index(RelationshipKind::Inheritance)].forward;
+    result.push_back(derived);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        for (NodeId base : bases.range(result[i])) {
+            if (seen.insert(base).second) result.push_back(base);
+        }
+    }
+    result.erase(result.begin());
+    return result;
+}
+
+std::vector<std::pair<NodeId, std::uint32_t>> RelationshipGraph::reachable(const std::vector<NodeId>& sources,
+                                                                           KindMask kinds, Direction direction,
+                                                                           std::uint32_t maxDepth,
+                                                                           unsigned threads) const {
+    std::vector<std::pair<NodeId, std::uint32_t>> result;
+    const std::size_t n = m_names.size();
+    std::unique_ptr<std::atomic<bool>[]> visited(new std::atomic<bool>[n]());
+
+    std::vector<const Csr*> csrs;
+    for (std::size_t k = 0; k < kKindCount; ++k) {
+        if (kinds & (KindMask(1) << k)) {
+            csrs.push_back(direction == Direction::Outgoing ? &m_edges[k].forward : &m_edges[k].reverse);
+        }
+    }
+
+    std::vector<NodeId> frontier;
+    for (NodeId source : sources) {
+        if (source < n && !visited[source].exchange(true)) frontier.push_back(source);
+    }
+
+    // El primero en marcar un nodo lo reclama; cada nivel se ordena para
+    // que el resultado no dependa del reparto entre hilos.
+    auto expand = [&](std::size_t begin, std::size_t end, std::vector<NodeId>& out) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (const Csr* csr : csrs) {
+                for (NodeId next : csr->range(frontier[i])) {
+                    if (!visited[next].load(std::memory_order_relaxed) && !visited[next].exchange(true)) {
+                        out.push_back(next);
+                    }
+                }
+            }
+        }
+    };
+
+    const unsigned workers = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<NodeId> next;
+    for (std::uint32_t depth = 1; !frontier.empty() && (maxDepth == 0 || depth <= maxDepth); ++depth) {
+        next.clear();
+        if (workers <= 1 || frontier.size() < kParallelFrontier) {
+            expand(0, frontier.size(), next);
+        } else {
+            const std::size_t chunks = std::min<std::size_t>(workers, frontier.size() / (kParallelFrontier / 4));
+            std::vector<std::vector<NodeId>> partial(chunks);
+            std::vector<std::thread> pool;
+            pool.reserve(chunks - 1);
+            const std::size_t step = (frontier.size() + chunks - 1) / chunks;
+            for (std::size_t c = 1; c < chunks; ++c) {
+                pool.emplace_back([&, c]() {
+                    expand(c * step, std::min(frontier.size(), (c + 1) * step), partial[c]);
+                });
+            }
+            expand(0, std::min(frontier.size(), step), partial[0]);
+            for (auto& th : pool) th.join();
+            for (const auto& part : partial) next.insert(next.end(), part.begin(), part.end());
+        }
+        std::sort(next.begin(), next.end());
+        for (NodeId node : next) result.emplace_back(node, depth);
+        frontier.swap(next);
+    }
+    return result;
+}
+
+} // namespace graph
+} // namespace cppuml
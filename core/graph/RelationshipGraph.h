@@ -0,0 +1,213 @@
+#ifndef CPP_UML_GENERATOR_CORE_GRAPH_RELATIONSHIP_GRAPH_H
+#define CPP_UML_GENERATOR_CORE_GRAPH_RELATIONSHIP_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Relationship.h"
+
+namespace cppuml {
+namespace graph {
+
+using NodeId = std::uint32_t;
+constexpr NodeId kInvalidNode = std::numeric_limits<NodeId>::max();
+
+/**
+ * @brief Conjunto de tipos de relación (un bit por RelationshipKind).
+ */
+using KindMask = std::uint32_t;
+
+constexpr KindMask maskOf(RelationshipKind kind) {
+    return KindMask(1) << static_cast<unsigned>(kind);
+}
+
+constexpr KindMask kAllKinds = maskOf(RelationshipKind::Relationship) | maskOf(RelationshipKind::Inheritance) |
+                               maskOf(RelationshipKind::Association) | maskOf(RelationshipKind::Composition) |
+                               maskOf(RelationshipKind::Aggregation) | maskOf(RelationshipKind::Usage);
+
+/**
+ * @brief Sentido de recorrido de las aristas.
+ */
+enum class Direction {
+    Outgoing, ///< Origen -> destino: de una derivada a sus bases, de un usuario a lo que usa
+    Incoming  ///< Destino -> origen: quién hereda de / depende de un nodo
+};
+
+/**
+ * @brief Vecinos de un nodo: una vista contigua dentro del arreglo CSR.
+ */
+class NeighbourRange {
+public:
+    NeighbourRange(const NodeId* first, const NodeId* last)
+        : m_first(first), m_last(last) {}
+
+    const NodeId* begin() const { return m_first; }
+    const NodeId* end() const { return m_last; }
+    std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+
+private:
+    const NodeId* m_first;
+    const NodeId* m_last;
+};
+
+/**
+ * @class RelationshipGraph
+ * @brief Grafo de relaciones entre clases en formato CSR, construido tras la resolución.
+ *
+ * Cada clase (por nombre calificado; las copias de varias TUs comparten
+ * nodo) es un NodeId denso. Por cada RelationshipKind se guardan dos
+ * arreglos CSR (salientes y entrantes), de modo que los vecinos de un
+ * nodo en cualquier sentido son un rango contiguo sin asignaciones.
+ *
+ * Aristas:
+ *   - Inheritance: de cada clase a sus bases enlazadas.
+ *   - Association: de una clase al tipo de sus campos.
+ *   - Usage: de una clase a los tipos de las firmas de sus métodos.
+ *   - El resto, de 'Model::getRelationships()'.
+ * Un tipo se enlaza por 'Type::getCustomTypeElement()' o, si no está
+ * enlazado, por su nombre buscado desde el namespace de la clase hacia
+ * fuera (también dentro de los argumentos de plantilla).
+ *
+ * Para la herencia (un DAG) se precalculan etiquetas de intervalos: con
+ * un árbol de recubrimiento en postorden, cada nodo guarda los intervalos
+ * de postorden de todos sus descendientes (uno solo si no hay herencia
+ * múltiple por debajo). 'isDerivedFrom' es una búsqueda binaria en esas
+ * etiquetas y 'descendants' recorre rangos contiguos, sin tocar aristas.
+ *
+ * El grafo guarda punteros al modelo: debe reconstruirse si el modelo cambia.
+ */
+class RelationshipGraph {
+public:
+    RelationshipGraph() = default;
+
+    /**
+     * @brief Construye el grafo de un modelo ya enlazado (SymbolResolver).
+     */
+    explicit RelationshipGraph(const Model& model) { build(model); }
+
+    // Los nombres apuntan a las claves de la tabla propia: mover es seguro
+    // (los nodos de la tabla se transfieren), copiar no.
+    RelationshipGraph(const RelationshipGraph&) = delete;
+    RelationshipGraph& operator=(const RelationshipGraph&) = delete;
+    RelationshipGraph(RelationshipGraph&&) = default;
+    RelationshipGraph& operator=(RelationshipGraph&&) = default;
+
+    /**
+     * @brief (Re)construye el grafo completo.
+     */
+    void build(const Model& model);
+
+    // --- Nodos ---
+
+    std::size_t nodeCount() const { return m_names.size(); }
+    std::size_t edgeCount(RelationshipKind kind) const { return m_edges[index(kind)].forward.targets.size(); }
+
+    /// El nodo de un nombre calificado (kInvalidNode si no es una clase del modelo).
+    NodeId find(std::string_view qualifiedName) const;
+
+    /// El nodo de una clase del modelo (cualquiera de sus copias).
+    NodeId nodeOf(const Element* element) const;
+
+    const std::string& name(NodeId node) const { return *m_names[node]; }
+
+    /// La copia canónica de la clase (la de la primera TU que la define).
+    const Class* classOf(NodeId node) const { return m_classes[node]; }
+
+    // --- Adyacencia ---
+
+    NeighbourRange neighbours(NodeId node, RelationshipKind kind, Direction direction) const;
+
+    // --- Jerarquía ---
+
+    /**
+     * @brief Indica si 'derived' hereda (directa o indirectamente) de 'base'.
+     */
+    bool isDerivedFrom(NodeId derived, NodeId base) const;
+
+    /**
+     * @brief Todas las subclases (directas e indirectas), en postorden.
+     */
+    std::vector<NodeId> descendants(NodeId base) const;
+
+    /**
+     * @brief Todas las bases (directas e indirectas), de la más cercana a la más lejana.
+     */
+    std::vector<NodeId> ancestors(NodeId derived) const;
+
+    // --- Recorrido General ---
+
+    /**
+     * @brief Nodos alcanzables desde 'sources' (excluidas) por las relaciones de 'kinds'.
+     *
+     * BFS por niveles; los niveles grandes se expanden en paralelo.
+     * Con Direction::Incoming y kAllKinds responde "todo lo que depende de X".
+     *
+     * @param maxDepth Número máximo de saltos (0 = sin límite).
+     * @param threads Hilos (0 = número de núcleos).
+     * @return Los nodos alcanzados con su distancia, en orden de BFS.
+     */
+    std::vector<std::pair<NodeId, std::uint32_t>> reachable(const std::vector<NodeId>& sources, KindMask kinds,
+                                                            Direction direction, std::uint32_t maxDepth = 0,
+                                                            unsigned threads = 0) const;
+
+private:
+    static constexpr std::size_t kKindCount = 6;
+    static std::size_t index(RelationshipKind kind) { return static_cast<std::size_t>(kind); }
+
+    /**
+     * @brief Adyacencia compacta: vecinos de v en [offsets[v], offsets[v+1]).
+     */
+    struct Csr {
+        std::vector<std::uint32_t> offsets;
+        std::vector<NodeId> targets;
+
+        void build(std::size_t nodeCount, const std::vector<std::pair<NodeId, NodeId>>& sortedPairs);
+        NeighbourRange range(NodeId v) const {
+            return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+        }
+    };
+
+    struct EdgeSet {
+        Csr forward;
+        Csr reverse;
+    };
+
+    struct Interval {
+        std::uint32_t first;
+        std::uint32_t last; ///< Inclusivo
+    };
+
+    void collectNodes(const Model& model);
+    void collectEdges(const Model& model);
+    void labelHierarchy();
+    NodeId resolveType(const Type& type, const std::string& scope) const;
+    void addTypeEdges(const Type& type, NodeId from, const std::string& scope,
+                      std::vector<std::pair<NodeId, NodeId>>& pairs) const;
+
+    std::unordered_map<std::string, NodeId> m_byName;
+    std::vector<const std::string*> m_names; ///< Claves de 'm_byName' (estables)
+    std::vector<std::string> m_scopes;       ///< Namespace de cada clase ("a::b::"), para enlazar tipos
+    std::vector<const Class*> m_classes;
+    std::unordered_map<const Element*, NodeId> m_byElement;
+    EdgeSet m_edges[kKindCount];
+
+    // Etiquetas de la jerarquía
+    std::vector<std::uint32_t> m_post;         ///< Número de postorden de cada nodo
+    std::vector<NodeId> m_atPost;              ///< Nodo con cada número de postorden
+    std::vector<std::uint32_t> m_labelOffsets; ///< Intervalos de v en [m_labelOffsets[v], m_labelOffsets[v+1])
+    std::vector<Interval> m_labels;            ///< Ordenados y disjuntos por nodo
+};
+
+} // namespace graph
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_GRAPH_RELATIONSHIP_GRAPH_H
@@ -0,0 +1,543 @@
+#include "layout/SugiyamaLayout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#include "graph/RelationshipGraph.h"
+
+namespace cppuml {
+namespace layout {
+
+namespace {
+
+// --- Utilidades de Ayuda ---
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Ejecuta fn(i) para i en [0, count) repartiendo el trabajo entre hilos.
+ *
+ * Los índices se reparten dinámicamente (contador atómico) porque las capas
+ * de un grafo real tienen tamaños muy desiguales.
+ */
+template <typename Fn>
+void parallelFor(std::size_t count, unsigned threads, Fn&& fn) {
+    if (threads <= 1 || count <= 1) {
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    const unsigned spawned = static_cast<unsigned>(std::min<std::size_t>(threads, count)) - 1;
+    std::vector<std::thread> pool;
+    pool.reserve(spawned);
+    for (unsigned t = 0; t < spawned; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+/**
+ * @brief Lista de adyacencia compacta (CSR): vecinos de v en [offsets[v], offsets[v+1]).
+ */
+struct Adjacency {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> targets;
+
+    template <typename PairRange>
+    void build(std::size_t vertexCount, const PairRange& pairs) {
+        offsets.assign(vertexCount + 1, 0);
+        for (const auto& p : pairs) ++offsets[p.first + 1];
+        for (std::size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+        targets.resize(offsets.back());
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& p : pairs) targets[fill[p.first]++] = p.second;
+    }
+
+    std::size_t begin(std::size_t v) const { return offsets[v]; }
+    std::size_t end(std::size_t v) const { return offsets[v + 1]; }
+};
+
+/**
+ * @brief Cuenta los cruces entre dos capas consecutivas.
+ *
+ * Algoritmo del árbol acumulador de Barth, Jünger y Mutzel: O(E log V).
+ */
+std::size_t countCrossings(const std::vector<std::size_t>& upper,
+                           const std::vector<std::size_t>& lower,
+                           const Adjacency& down,
+                           const std::vector<std::size_t>& pos,
+                           std::vector<std::pair<std::size_t, std::size_t>>& scratch) {
+    const std::size_t lowerSize = lower.size();
+    if (lowerSize < 2 || upper.size() < 2) return 0;
+
+    scratch.clear();
+    for (std::size_t u : upper) {
+        for (std::size_t i = down.begin(u); i < down.end(u); ++i) {
+            scratch.emplace_back(pos[u], pos[down.targets[i]]);
+        }
+    }
+    std::sort(scratch.begin(), scratch.end());
+
+    std::size_t firstIndex = 1;
+    while (firstIndex < lowerSize) firstIndex *= 2;
+    std::vector<std::size_t> tree(2 * firstIndex - 1, 0);
+    --firstIndex;
+
+    std::size_t crossings = 0;
+    for (const auto& edge : scratch) {
+        std::size_t index = edge.second + firstIndex;
+        ++tree[index];
+        while (index > 0) {
+            if (index % 2) crossings += tree[index + 1];
+            index = (index - 1) / 2;
+            ++tree[index];
+        }
+    }
+    return crossings;
+}
+
+/**
+ * @brief Estimación de tamaño por defecto (sin métricas de fuente reales).
+ */
+std::pair<double, double> estimateSize(const Class& cls) {
+    constexpr double kCharWidth = 7.0;
+    constexpr double kLineHeight = 16.0;
+    constexpr double kPadding = 16.0;
+
+    std::size_t longest = cls.getName().size();
+    for (const auto& field : cls.getFields()) {
+        longest = std::max(longest, field->getName().size() + field->getType().getFullName().size() + 4);
+    }
+    for (const auto& method : cls.getMethods()) {
+        longest = std::max(longest, method->getName().size() + method->getReturnType().getFullName().size() + 6);
+    }
+
+    const std::size_t lines = cls.getFields().size() + cls.getMethods().size();
+    return {longest * kCharWidth + kPadding,
+            kLineHeight * (1 + static_cast<double>(lines)) + kPadding};
+}
+
+/// Relaciones de asociación que se dibujan; el uso (Usage) queda fuera.
+constexpr RelationshipKind kAssociationKinds[] = {RelationshipKind::Association, RelationshipKind::Composition,
+                                                 RelationshipKind::Aggregation};
+
+} // namespace
+
+// --- Construcción del Grafo ---
+
+LayoutGraph buildClassGraph(const Model& model, const NodeSizer& sizer) {
+    // El grafo de relaciones ya une las copias de cada clase entre TUs y
+    // deduce las asociaciones de los tipos de los campos.
+    const graph::RelationshipGraph relationships(model);
+
+    LayoutGraph graph;
+    graph.nodes.reserve(relationships.nodeCount());
+    for (graph::NodeId v = 0; v < relationships.nodeCount(); ++v) {
+        const Class* cls = relationships.classOf(v);
+        auto size = sizer ? sizer(*cls) : estimateSize(*cls);
+        graph.nodes.push_back(LayoutNode{cls, size.first, size.second});
+    }
+
+    for (graph::NodeId v = 0; v < relationships.nodeCount(); ++v) {
+        for (graph::NodeId base : relationships.neighbours(v, RelationshipKind::Inheritance, graph::Direction::Outgoing)) {
+            graph.edges.push_back(LayoutEdge{base, v, RelationshipKind::Inheritance});
+        }
+        for (RelationshipKind kind : kAssociationKinds) {
+            for (graph::NodeId target : relationships.neighbours(v, kind, graph::Direction::Outgoing)) {
+                graph.edges.push_back(LayoutEdge{v, target, kind});
+            }
+        }
+    }
+
+    return graph;
+}
+
+// --- Algoritmo Principal ---
+
+LayoutResult SugiyamaLayout::run(const LayoutGraph& graph) const {
+    const std::size_t n = graph.nodes.size();
+    const std::size_t m = graph.edges.size();
+    const unsigned threads = m_options.threads
+        ? m_options.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    // Solo las aristas jerárquicas deciden las capas (ver LayoutOptions::layerAssociations).
+    std::vector<bool> layered(m, false);
+    for (std::size_t e = 0; e < m; ++e) {
+        const LayoutEdge& edge = graph.edges[e];
+        layered[e] = edge.source != edge.target &&
+                     (m_options.layerAssociations || edge.kind == RelationshipKind::Inheritance ||
+                      edge.kind == RelationshipKind::Relationship);
+    }
+
+    LayoutResult result;
+    result.positions.assign(n, Point{});
+    result.layers.assign(n, 0);
+    result.edgeRoutes.assign(m, {});
+    result.reversedEdges.assign(m, false);
+    if (n == 0) return result;
+
+    // 1. Ruptura de ciclos: DFS iterativo; las aristas de retroceso se invierten.
+    auto phaseStart = Clock::now();
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> outPairs;
+        outPairs.reserve(m);
+        for (std::size_t e = 0; e < m; ++e) {
+            if (layered[e]) outPairs.emplace_back(graph.edges[e].source, e);
+        }
+        Adjacency outEdges;
+        outEdges.build(n, outPairs);
+
+        enum : unsigned char { Unvisited, OnStack, Done };
+        std::vector<unsigned char> state(n, Unvisited);
+        std::vector<std::pair<std::size_t, std::size_t>> stack; // (vértice, siguiente arista)
+
+        for (std::size_t root = 0; root < n; ++root) {
+            if (state[root] != Unvisited) continue;
+            stack.emplace_back(root, outEdges.begin(root));
+            state[root] = OnStack;
+            while (!stack.empty()) {
+                auto& frame = stack.back();
+                const std::size_t v = frame.first;
+                if (frame.second == outEdges.end(v)) {
+                    state[v] = Done;
+                    stack.pop_back();
+                    continue;
+                }
+                const std::size_t e = outEdges.targets[frame.second++];
+                const std::size_t w = graph.edges[e].target;
+                if (state[w] == OnStack) {
+                    result.reversedEdges[e] = true;
+                } else if (state[w] == Unvisited) {
+                    state[w] = OnStack;
+                    stack.emplace_back(w, outEdges.begin(w));
+                }
+            }
+        }
+    }
+    result.cycleBreakingMs = elapsedMs(phaseStart);
+
+    auto upperOf = [&](std::size_t e) {
+        return result.reversedEdges[e] ? graph.edges[e].target : graph.edges[e].source;
+    };
+    auto lowerOf = [&](std::size_t e) {
+        return result.reversedEdges[e] ? graph.edges[e].source : graph.edges[e].target;
+    };
+
+    // 2. Asignación de capas (camino más largo sobre las aristas jerárquicas,
+    //    orden topológico de Kahn).
+    phaseStart = Clock::now();
+    std::vector<int> layer(n, 0);
+    std::vector<std::size_t> topoOrder;
+    topoOrder.reserve(n);
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> dagPairs;
+        dagPairs.reserve(m);
+        std::vector<std::size_t> inDegree(n, 0);
+        for (std::size_t e = 0; e < m; ++e) {
+            if (!layered[e]) continue;
+            dagPairs.emplace_back(upperOf(e), lowerOf(e));
+            ++inDegree[lowerOf(e)];
+        }
+        Adjacency dag;
+        dag.build(n, dagPairs);
+
+        for (std::size_t v = 0; v < n; ++v) {
+            if (inDegree[v] == 0) topoOrder.push_back(v);
+        }
+        for (std::size_t head = 0; head < topoOrder.size(); ++head) {
+            const std::size_t v = topoOrder[head];
+            for (std::size_t i = dag.begin(v); i < dag.end(v); ++i) {
+                const std::size_t w = dag.targets[i];
+                layer[w] = std::max(layer[w], layer[v] + 1);
+                if (--inDegree[w] == 0) topoOrder.push_back(w);
+            }
+        }
+
+        // Compactación: se baja cada nodo junto a su sucesor más alto para
+        // acortar las aristas (y con ello el número de nodos ficticios).
+        for (std::size_t k = topoOrder.size(); k-- > 0;) {
+            const std::size_t v = topoOrder[k];
+            if (dag.begin(v) == dag.end(v)) continue;
+            int closest = std::numeric_limits<int>::max();
+            for (std::size_t i = dag.begin(v); i < dag.end(v); ++i) {
+                closest = std::min(closest, layer[dag.targets[i]]);
+            }
+            layer[v] = closest - 1;
+        }
+    }
+
+    // Vértices del grafo por capas: nodos reales [0, n) y ficticios [n, total).
+    // Las aristas jerárquicas largas llevan una cadena de nodos ficticios; las
+    // demás solo entran en la reducción de cruces si unen capas contiguas, y
+    // si no se trazan directamente (sin ficticios) tras fijar las coordenadas.
+    std::vector<int> vertexLayer(layer.begin(), layer.end());
+    std::vector<std::vector<std::size_t>> chains(m); // Cadena de vértices de cada arista (de arriba a abajo)
+    std::vector<bool> upward(m, false); // Arista no jerárquica cuyo origen está debajo del destino
+    std::vector<std::pair<std::size_t, std::size_t>> segments; // (superior, inferior)
+    segments.reserve(m);
+    for (std::size_t e = 0; e < m; ++e) {
+        const LayoutEdge& edge = graph.edges[e];
+        if (edge.source == edge.target) continue;
+        if (!layered[e]) {
+            const int span = layer[edge.target] - layer[edge.source];
+            if (span == 1 || span == -1) {
+                upward[e] = span < 0;
+                const std::size_t top = upward[e] ? edge.target : edge.source;
+                const std::size_t bottom = upward[e] ? edge.source : edge.target;
+                segments.emplace_back(top, bottom);
+                chains[e] = {top, bottom};
+            } else {
+                ++result.directEdges;
+            }
+            continue;
+        }
+        const std::size_t top = upperOf(e);
+        const std::size_t bottom = lowerOf(e);
+        auto& chain = chains[e];
+        chain.push_back(top);
+        for (int l = layer[top] + 1; l < layer[bottom]; ++l) {
+            const std::size_t dummy = vertexLayer.size();
+            vertexLayer.push_back(l);
+            segments.emplace_back(chain.back(), dummy);
+            chain.push_back(dummy);
+        }
+        segments.emplace_back(chain.back(), bottom);
+        chain.push_back(bottom);
+    }
+
+    const std::size_t total = vertexLayer.size();
+    const std::size_t layerCount = static_cast<std::size_t>(
+        *std::max_element(layer.begin(), layer.end())) + 1;
+    result.layerCount = layerCount;
+    result.dummyCount = total - n;
+
+    // Orden inicial: orden topológico para los nodos reales, creación para los ficticios.
+    std::vector<std::vector<std::size_t>> layers(layerCount);
+    for (std::size_t v : topoOrder) layers[layer[v]].push_back(v);
+    for (std::size_t v = n; v < total; ++v) layers[vertexLayer[v]].push_back(v);
+
+    Adjacency down;
+    down.build(total, segments);
+    std::vector<std::pair<std::size_t, std::size_t>> reversedSegments;
+    reversedSegments.reserve(segments.size());
+    for (const auto& s : segments) reversedSegments.emplace_back(s.second, s.first);
+    Adjacency up;
+    up.build(total, reversedSegments);
+    result.layeringMs = elapsedMs(phaseStart);
+
+    // 3. Reducción de cruces por baricentros, paralela por paridad de capa.
+    phaseStart = Clock::now();
+    std::vector<std::size_t> pos(total, 0);
+    for (const auto& lv : layers) {
+        for (std::size_t i = 0; i < lv.size(); ++i) pos[lv[i]] = i;
+    }
+
+    auto totalCrossings = [&]() {
+        std::vector<std::size_t> perPair(layerCount, 0);
+        parallelFor(layerCount > 0 ? layerCount - 1 : 0, threads, [&](std::size_t l) {
+            std::vector<std::pair<std::size_t, std::size_t>> scratch;
+            perPair[l] = countCrossings(layers[l], layers[l + 1], down, pos, scratch);
+        });
+        std::size_t sum = 0;
+        for (std::size_t c : perPair) sum += c;
+        return sum;
+    };
+
+    std::size_t bestCrossings = totalCrossings();
+    std::vector<std::vector<std::size_t>> bestLayers = layers;
+    int stale = 0;
+
+    for (int it = 0; it < m_options.crossingIterations && bestCrossings > 0 && stale < 3; ++it) {
+        const bool useUpper = (it % 2 == 0);
+        for (std::size_t parity : {std::size_t{1}, std::size_t{0}}) {
+            const std::size_t count = (layerCount + 1 - parity) / 2;
+            parallelFor(count, threads, [&](std::size_t k) {
+                auto& lv = layers[2 * k + parity];
+                std::vector<std::pair<double, std::size_t>> keyed;
+                keyed.reserve(lv.size());
+                for (std::size_t v : lv) {
+                    const Adjacency& primary = useUpper ? up : down;
+                    const Adjacency& secondary = useUpper ? down : up;
+                    const Adjacency& adj = primary.begin(v) != primary.end(v) ? primary : secondary;
+                    double key = static_cast<double>(pos[v]);
+                    if (adj.begin(v) != adj.end(v)) {
+                        double sum = 0.0;
+                        for (std::size_t i = adj.begin(v); i < adj.end(v); ++i) sum += pos[adj.targets[i]];
+                        key = sum / static_cast<double>(adj.end(v) - adj.begin(v));
+                    }
+                    keyed.emplace_back(key, v);
+                }
+                std::stable_sort(keyed.begin(), keyed.end(),
+                                 [](const auto& a, const auto& b) { return a.first < b.first; });
+                for (std::size_t i = 0; i < keyed.size(); ++i) {
+                    lv[i] = keyed[i].second;
+                    pos[lv[i]] = i;
+                }
+            });
+        }
+
+        const std::size_t crossings = totalCrossings();
+        if (crossings < bestCrossings) {
+            bestCrossings = crossings;
+            bestLayers = layers;
+            stale = 0;
+        } else {
+            ++stale;
+        }
+    }
+
+    layers = std::move(bestLayers);
+    for (const auto& lv : layers) {
+        for (std::size_t i = 0; i < lv.size(); ++i) pos[lv[i]] = i;
+    }
+    result.crossings = bestCrossings;
+    result.crossingReductionMs = elapsedMs(phaseStart);
+
+    // 4. Asignación de coordenadas.
+    phaseStart = Clock::now();
+    auto widthOf = [&](std::size_t v) {
+        return v < n ? graph.nodes[v].width : m_options.dummyWidth;
+    };
+
+    std::vector<double> layerY(layerCount, 0.0);
+    std::vector<double> layerHeight(layerCount, 0.0);
+    for (std::size_t v = 0; v < n; ++v) {
+        layerHeight[layer[v]] = std::max(layerHeight[layer[v]], graph.nodes[v].height);
+    }
+    for (std::size_t l = 1; l < layerCount; ++l) {
+        layerY[l] = layerY[l - 1] + layerHeight[l - 1] + m_options.layerSpacing;
+    }
+
+    std::vector<double> centerX(total, 0.0);
+    for (const auto& lv : layers) {
+        double cursor = 0.0;
+        for (std::size_t v : lv) {
+            centerX[v] = cursor + widthOf(v) / 2.0;
+            cursor += widthOf(v) + m_options.nodeSpacing;
+        }
+    }
+
+    for (int it = 0; it < m_options.coordinateIterations; ++it) {
+        for (std::size_t parity : {std::size_t{1}, std::size_t{0}}) {
+            const std::size_t count = (layerCount + 1 - parity) / 2;
+            parallelFor(count, threads, [&](std::size_t k) {
+                const auto& lv = layers[2 * k + parity];
+                const std::size_t size = lv.size();
+                if (size == 0) return;
+
+                std::vector<double> desired(size), left(size), right(size);
+                for (std::size_t i = 0; i < size; ++i) {
+                    const std::size_t v = lv[i];
+                    double sum = 0.0;
+                    std::size_t degree = 0;
+                    for (const Adjacency* adj : {&up, &down}) {
+                        for (std::size_t j = adj->begin(v); j < adj->end(v); ++j) {
+                            sum += centerX[adj->targets[j]];
+                            ++degree;
+                        }
+                    }
+                    desired[i] = degree ? sum / static_cast<double>(degree) : centerX[v];
+                }
+
+                // Dos pasadas que respetan la separación mínima; su promedio también la respeta.
+                for (std::size_t i = 0; i < size; ++i) {
+                    left[i] = desired[i];
+                    if (i > 0) {
+                        const double gap = (widthOf(lv[i - 1]) + widthOf(lv[i])) / 2.0 + m_options.nodeSpacing;
+                        left[i] = std::max(left[i], left[i - 1] + gap);
+                    }
+                }
+                for (std::size_t i = size; i-- > 0;) {
+                    right[i] = desired[i];
+                    if (i + 1 < size) {
+                        const double gap = (widthOf(lv[i + 1]) + widthOf(lv[i])) / 2.0 + m_options.nodeSpacing;
+                        right[i] = std::min(right[i], right[i + 1] - gap);
+                    }
+                }
+                for (std::size_t i = 0; i < size; ++i) centerX[lv[i]] = (left[i] + right[i]) / 2.0;
+            });
+        }
+    }
+
+    double minX = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    for (std::size_t v = 0; v < total; ++v) {
+        minX = std::min(minX, centerX[v] - widthOf(v) / 2.0);
+        maxX = std::max(maxX, centerX[v] + widthOf(v) / 2.0);
+    }
+    for (double& x : centerX) x -= minX;
+
+    for (std::size_t v = 0; v < n; ++v) {
+        result.layers[v] = layer[v];
+        result.positions[v] = Point{centerX[v] - graph.nodes[v].width / 2.0, layerY[layer[v]]};
+    }
+    result.width = maxX - minX;
+    result.height = layerY.back() + layerHeight.back();
+
+    // Rutas de las aristas: borde inferior del origen, nodos ficticios, borde superior del destino.
+    auto bottomOf = [&](std::size_t v) { return layerY[layer[v]] + graph.nodes[v].height; };
+    for (std::size_t e = 0; e < m; ++e) {
+        auto& route = result.edgeRoutes[e];
+        const auto& edge = graph.edges[e];
+        if (edge.source == edge.target) {
+            const Point p = result.positions[edge.source];
+            const double w = graph.nodes[edge.source].width;
+            const double h = graph.nodes[edge.source].height;
+            route = {{p.x + w, p.y + h * 0.25}, {p.x + w + m_options.nodeSpacing / 2.0, p.y + h * 0.5},
+                     {p.x + w, p.y + h * 0.75}};
+            continue;
+        }
+        if (chains[e].empty()) {
+            // Arista directa. En la misma capa, por el pasillo bajo ella (la capa
+            // siguiente empieza a 'layerSpacing'); entre capas lejanas, en recta.
+            const std::size_t a = edge.source;
+            const std::size_t b = edge.target;
+            if (layer[a] == layer[b]) {
+                const int l = layer[a];
+                const double corridor = layerY[l] + layerHeight[l] + m_options.layerSpacing / 2.0;
+                route = {{centerX[a], bottomOf(a)}, {centerX[a], corridor}, {centerX[b], corridor},
+                         {centerX[b], bottomOf(b)}};
+                result.height = std::max(result.height, corridor);
+            } else if (layer[a] < layer[b]) {
+                route = {{centerX[a], bottomOf(a)}, {centerX[b], layerY[layer[b]]}};
+            } else {
+                route = {{centerX[a], layerY[layer[a]]}, {centerX[b], bottomOf(b)}};
+            }
+            continue;
+        }
+
+        const auto& chain = chains[e];
+        const std::size_t top = chain.front();
+        const std::size_t bottom = chain.back();
+        route.push_back({centerX[top], bottomOf(top)});
+        for (std::size_t i = 1; i + 1 < chain.size(); ++i) {
+            const std::size_t d = chain[i];
+            const int l = vertexLayer[d];
+            route.push_back({centerX[d], layerY[l]});
+            route.push_back({centerX[d], layerY[l] + layerHeight[l]});
+        }
+        route.push_back({centerX[bottom], layerY[layer[bottom]]});
+
+        if (result.reversedEdges[e] || upward[e]) std::reverse(route.begin(), route.end());
+    }
+    result.coordinateAssignmentMs = elapsedMs(phaseStart);
+
+    return result;
+}
+
+} // namespace layout
+} // namespace cppuml
@@ -0,0 +1,173 @@
+#ifndef CPP_UML_GENERATOR_CORE_LAYOUT_SUGIYAMA_LAYOUT_H
+#define CPP_UML_GENERATOR_CORE_LAYOUT_SUGIYAMA_LAYOUT_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Relationship.h"
+
+namespace cppuml {
+namespace layout {
+
+/**
+ * @brief Un punto en el plano del diagrama (unidades: píxeles).
+ */
+struct Point {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+/**
+ * @brief Un nodo del grafo a distribuir (típicamente una Clase).
+ *
+ * El tamaño lo decide el consumidor (escena de la UI, exportador SVG)
+ * antes de invocar el layout, ya que solo él conoce las métricas de texto.
+ */
+struct LayoutNode {
+    const Class* element = nullptr; ///< Puntero no propietario (puede ser nulo en grafos sintéticos)
+    double width = 0.0;
+    double height = 0.0;
+};
+
+/**
+ * @brief Una arista dirigida del grafo.
+ *
+ * La dirección es "de arriba hacia abajo": 'source' se dibujará en una
+ * capa superior a 'target' siempre que no forme parte de un ciclo.
+ * Para la herencia esto significa base -> derivada.
+ */
+struct LayoutEdge {
+    std::size_t source = 0;
+    std::size_t target = 0;
+    RelationshipKind kind = RelationshipKind::Relationship;
+};
+
+/**
+ * @brief Grafo de entrada del motor de layout.
+ */
+struct LayoutGraph {
+    std::vector<LayoutNode> nodes;
+    std::vector<LayoutEdge> edges;
+};
+
+/**
+ * @brief Parámetros del algoritmo.
+ */
+struct LayoutOptions {
+    double layerSpacing = 60.0;   ///< Separación vertical mínima entre capas
+    double nodeSpacing = 30.0;    ///< Separación horizontal mínima entre nodos
+    double dummyWidth = 10.0;     ///< Ancho reservado para las aristas largas
+    int crossingIterations = 12;  ///< Máximo de barridos de reducción de cruces
+    int coordinateIterations = 8; ///< Iteraciones de refinamiento de coordenadas
+    unsigned threads = 0;         ///< 0 = std::thread::hardware_concurrency()
+
+    /**
+     * @brief Si las asociaciones y composiciones también deciden las capas.
+     *
+     * Por defecto solo la herencia (y las aristas genéricas Relationship)
+     * asignan capas; el resto se traza entre las capas ya fijadas, sin
+     * nodos ficticios. Activarlo da diagramas más "dirigidos" en grafos
+     * pequeños, pero en modelos grandes las asociaciones encadenan miles de
+     * capas y millones de nodos ficticios.
+     */
+    bool layerAssociations = false;
+};
+
+/**
+ * @brief Resultado del layout, indexado igual que LayoutGraph.
+ */
+struct LayoutResult {
+    /// Esquina superior izquierda de cada nodo.
+    std::vector<Point> positions;
+
+    /// Capa asignada a cada nodo (0 = superior).
+    std::vector<int> layers;
+
+    /// Polilínea de cada arista, siempre desde el origen hasta el destino.
+    std::vector<std::vector<Point>> edgeRoutes;
+
+    /// Indica qué aristas se invirtieron para romper ciclos.
+    std::vector<bool> reversedEdges;
+
+    double width = 0.0;
+    double height = 0.0;
+
+    // --- Métricas (calidad y rendimiento) ---
+    std::size_t layerCount = 0;
+    std::size_t dummyCount = 0;
+    std::size_t directEdges = 0; ///< Aristas no jerárquicas trazadas sin pasar por capas contiguas
+    std::size_t crossings = 0;
+    double cycleBreakingMs = 0.0;
+    double layeringMs = 0.0;
+    double crossingReductionMs = 0.0;
+    double coordinateAssignmentMs = 0.0;
+};
+
+/**
+ * @brief Calcula el tamaño (ancho, alto) de la caja de una clase.
+ */
+using NodeSizer = std::function<std::pair<double, double>(const Class&)>;
+
+/**
+ * @brief Construye el grafo de clases y relaciones de un Modelo.
+ *
+ * Los nodos y aristas son los de graph::RelationshipGraph: cada clase
+ * aparece una vez aunque varias TUs la incluyan, y además de las herencias
+ * y las relaciones del Modelo se dibujan las asociaciones que se deducen
+ * de los tipos de los campos. Las relaciones de uso (parámetros y tipos
+ * de retorno) no se dibujan.
+ *
+ * @param model El modelo a recorrer.
+ * @param sizer Estimador de tamaño; si está vacío se usa una estimación
+ *              basada en el número de caracteres y miembros.
+ */
+LayoutGraph buildClassGraph(const Model& model, const NodeSizer& sizer = {});
+
+/**
+ * @class SugiyamaLayout
+ * @brief Motor de layout jerárquico (por capas) nativo.
+ *
+ * Implementa las cuatro fases clásicas de Sugiyama:
+ *   1. Ruptura de ciclos (DFS iterativo, invierte aristas de retroceso).
+ *   2. Asignación de capas (camino más largo) sobre las aristas
+ *      jerárquicas e inserción de nodos ficticios para las que cruzan
+ *      varias capas. Las asociaciones no añaden capas: entre capas
+ *      contiguas participan en la reducción de cruces; entre la misma capa
+ *      o capas lejanas se trazan directamente (ver layerAssociations).
+ *   3. Reducción de cruces por baricentros. Cada barrido reordena en
+ *      paralelo las capas impares y luego las pares, ya que las capas de
+ *      una misma paridad no dependen entre sí.
+ *   4. Asignación de coordenadas por relajación hacia los vecinos,
+ *      respetando el orden y la separación mínima.
+ *
+ * Todas las fases son O(V + E') o O(E' log V') por iteración, con V' y E'
+ * incluyendo los nodos ficticios.
+ * Con el grafo de layout_bench (~0,7 herencias y ~0,9 asociaciones por
+ * nodo, un núcleo) 2.000 nodos se distribuyen en ~4 ms y 20.000 en ~40 ms
+ * (6 capas, sin nodos ficticios). Con layerAssociations activado, 2.000
+ * nodos necesitan 484 capas, 167.000 ficticios y ~480 ms.
+ */
+class SugiyamaLayout {
+public:
+    explicit SugiyamaLayout(LayoutOptions options = {})
+        : m_options(options) {}
+
+    /**
+     * @brief Distribuye el grafo.
+     * @param graph El grafo de entrada (no se modifica).
+     * @return Posiciones, rutas de aristas y métricas.
+     */
+    LayoutResult run(const LayoutGraph& graph) const;
+
+private:
+    LayoutOptions m_options;
+};
+
+} // namespace layout
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_LAYOUT_SUGIYAMA_LAYOUT_H
@@ -30,6 +30,16 @@ enum class ClassKind {
     Union
 };
 
+/**
+ * @brief Un parámetro de una plantilla de clase (p.ej., 'typename T = int').
+ */
+struct TemplateParameter {
+    std::string name;            ///< "T" (vacío si el parámetro no tiene nombre)
+    std::string kind;            ///< "typename", "template" o el tipo de un parámetro no-tipo ("int")
+    std::string defaultArgument; ///< Texto del argumento por defecto; vacío si no tiene
+    bool isPack = false;         ///< 'typename... Ts'
+};
+
 /**
  * @brief Modela una 'class', 'struct' o 'union' de C++.
  *
@@ -47,6 +57,7 @@ public:
     struct InheritanceInfo {
         Class* baseClass = nullptr;
         Visibility visibility = Visibility::None;
+        std::string baseName; // Nombre calificado; permite resolver la base en otra TU
     };
 
     /**
@@ -55,21 +66,13 @@ public:
      * @param kind El tipo (class, struct, o union).
      */
     Class(std::string name, ClassKind kind = ClassKind::Class)
-        : Element(std::move(name)), m_kind(kind) {}
+        : Element(std::move(name), ElementKind::Class), m_kind(kind) {}
 
     /**
      * @brief Destructor virtual por defecto.
      */
     ~Class() override = default;
 
-    // --- Implementación de la Interfaz Element ---
-
-    /**
-     * @brief Obtiene el tipo de este elemento (para RTTI interno).
-     * @return ElementKind::Class.
-     */
-    ElementKind getKind() const override { return ElementKind::Class; } 
-
     // --- Acceso a Propiedades de Clase ---
 
     /**
@@ -82,6 +85,43 @@ public:
      */
     ClassKind getClassKind() const { return m_kind; } 
 
+    // --- Plantillas ---
+
+    /**
+     * @brief Añade un parámetro de plantilla (en orden de declaración).
+     *
+     * Una plantilla primaria se modela una sola vez con sus parámetros;
+     * sus usos ('Container<int>') son TemplateBinding ligeros en la TU.
+     */
+    void addTemplateParameter(TemplateParameter parameter) {
+        m_templateParameters.push_back(std::move(parameter));
+    }
+
+    /**
+     * @brief Obtiene los parámetros de plantilla (vacío si no es plantilla).
+     */
+    const std::vector<TemplateParameter>& getTemplateParameters() const {
+        return m_templateParameters;
+    }
+
+    /**
+     * @brief Indica si la clase es una plantilla (primaria o especialización parcial).
+     */
+    bool isTemplate() const { return !m_templateParameters.empty(); }
+
+    /**
+     * @brief Marca esta clase como especialización (parcial o explícita).
+     * @param primaryName Nombre calificado de la plantilla primaria.
+     */
+    void setSpecializedTemplate(std::string primaryName) {
+        m_specializedTemplate = std::move(primaryName);
+    }
+
+    /**
+     * @brief Nombre calificado de la plantilla primaria; vacío si no es especialización.
+     */
+    const std::string& getSpecializedTemplate() const { return m_specializedTemplate; }
+
     // --- Gestión de Miembros
 
     /**
@@ -122,7 +162,29 @@ public:
      * @param visibility La visibilidad de la herencia (public, protected, private).
      */
     void addBaseClass(Class* base, Visibility visibility) {
-        m_baseClasses.push_back(InheritanceInfo{base, visibility});
+        m_baseClasses.push_back(InheritanceInfo{base, visibility, base ? base->getName() : std::string()});
+    }
+
+    /**
+     * @brief Registra una clase base conocida solo por su nombre.
+     *
+     * El Parser usa esta variante porque la definición de la base puede
+     * estar en otra TU; el puntero se enlaza después (ver SymbolResolver).
+     *
+     * @param baseName Nombre calificado de la base (p.ej., "ui::Window").
+     * @param visibility La visibilidad de la herencia.
+     */
+    void addBaseClass(std::string baseName, Visibility visibility) {
+        m_baseClasses.push_back(InheritanceInfo{nullptr, visibility, std::move(baseName)});
+    }
+
+    /**
+     * @brief Enlaza la base 'index' con su definición.
+     * @param index Posición en getBaseClasses().
+     * @param base Puntero no propietario a la definición encontrada.
+     */
+    void resolveBaseClass(std::size_t index, Class* base) {
+        m_baseClasses[index].baseClass = base;
     }
 
     /**
@@ -134,7 +196,8 @@ public:
 
 private:
     ClassKind m_kind;
-    std::string m_templateParameters; // Para soporte futuro de plantillas
+    std::vector<TemplateParameter> m_templateParameters;
+    std::string m_specializedTemplate;
 
     std::vector<std::unique_ptr<Field>> m_fields;
     std::vector<std::unique_ptr<Method>> m_methods;
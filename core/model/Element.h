@@ -1,6 +1,7 @@
 #ifndef CPP_UML_GENERATOR_CORE_MODEL_ELEMENT_H
 #define CPP_UML_GENERATOR_CORE_MODEL_ELEMENT_H
 
+#include <cstdint>
 #include <string>
 #include <utility> // Para std::move
 
@@ -20,7 +21,8 @@ enum class Visibility {
  * @brief Define el tipo de un elemento del modelo (para "RTTI" interno).
  *
  * Esto nos permite realizar conversiones seguras (p.ej., de Element* a Class*)
- * sin depender de dynamic_cast.
+ * sin depender de dynamic_cast. Se guarda en el propio Element: consultarlo
+ * no es una llamada virtual (ver ModelVisitor.h).
  */
 enum class ElementKind {
     Element,
@@ -43,13 +45,6 @@ enum class ElementKind {
  */
 class Element {
 public:
-    /**
-     * @brief Constructor que inicializa el elemento con un nombre.
-     * @param name El nombre del elemento (p.ej., "MyClass", "m_member").
-     */
-    explicit Element(std::string name)
-        : m_name(std::move(name)), m_visibility(Visibility::None) {}
-
     /**
      * @brief Destructor virtual por defecto.
      * Crítico para la eliminación polimórfica (Lineamiento P2).
@@ -77,7 +72,7 @@ public:
      * @brief Obtiene el tipo de este elemento (p.ej., Class, Method).
      * @return El ElementKind de la clase derivada.
      */
-    virtual ElementKind getKind() const = 0;
+    ElementKind getKind() const { return m_kind; }
 
     /**
      * @brief Obtiene el nombre del elemento.
@@ -99,9 +94,33 @@ public:
      */
     void setVisibility(Visibility visibility) { m_visibility = visibility; }
 
+    /**
+     * @brief Obtiene el hash estructural del subárbol (0 = no calculado).
+     *
+     * Lo calcula StructuralHasher (árbol de Merkle): dos subárboles con el
+     * mismo hash tienen la misma estructura y el diff los salta en O(1).
+     */
+    std::uint64_t getStructuralHash() const { return m_structuralHash; }
+
+    /**
+     * @brief Establece el hash estructural (ver StructuralHasher).
+     */
+    void setStructuralHash(std::uint64_t hash) { m_structuralHash = hash; }
+
+protected:
+    /**
+     * @brief Constructor que inicializa el elemento con un nombre.
+     * @param name El nombre del elemento (p.ej., "MyClass", "m_member").
+     * @param kind El tipo de la clase derivada que lo construye.
+     */
+    Element(std::string name, ElementKind kind)
+        : m_name(std::move(name)), m_visibility(Visibility::None), m_kind(kind) {}
+
 private:
     std::string m_name;
     Visibility m_visibility;
+    ElementKind m_kind;
+    std::uint64_t m_structuralHash = 0;
 };
 
 } // namespace cppuml
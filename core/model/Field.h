@@ -22,21 +22,13 @@ public:
      * @param type El objeto Type que describe este campo (p.ej., "int", "std::string").
      */
     Field(std::string name, Type type)
-        : Element(std::move(name)), m_type(std::move(type)), m_isStatic(false) {}
+        : Element(std::move(name), ElementKind::Field), m_type(std::move(type)), m_isStatic(false) {}
 
     /**
      * @brief Destructor virtual por defecto.
      */
     ~Field() override = default;
 
-    // --- Implementación de la Interfaz Element ---
-
-    /**
-     * @brief Obtiene el tipo de este elemento.
-     * @return ElementKind::Field.
-     */
-    ElementKind getKind() const override { return ElementKind::Field; }
-
     // --- Acceso Público ---
 
     /**
@@ -26,7 +26,7 @@ public:
      * @param returnType El objeto Type del valor de retorno (p.ej., "void", "int").
      */
     Method(std::string name, Type returnType)
-        : Element(std::move(name)),
+        : Element(std::move(name), ElementKind::Method),
           m_returnType(std::move(returnType)),
           m_isStatic(false),
           m_isConst(false),
@@ -38,14 +38,6 @@ public:
      */
     ~Method() override = default;
 
-    // --- Implementación de la Interfaz Element ---
-
-    /**
-     * @brief Obtiene el tipo de este elemento.
-     * @return ElementKind::Method.
-     */
-    ElementKind getKind() const override { return ElementKind::Method; }
-
     // --- Acceso Público ---
 
     /**
@@ -0,0 +1,126 @@
+#ifndef CPP_UML_GENERATOR_CORE_MODEL_MODEL_H
+#define CPP_UML_GENERATOR_CORE_MODEL_MODEL_H
+
+#include <string>
+#include <vector>
+#include <memory>  // Para std::unique_ptr
+#include <utility> // Para std::move
+
+#include "Element.h"
+#include "Relationship.h"
+#include "TranslationUnit.h"
+
+namespace cppuml {
+
+/**
+ * @brief Modela un proyecto completo: la raíz de todo el modelo.
+ *
+ * Posee las Unidades de Traducción producidas por el Parser y las
+ * relaciones UML (Asociación, Composición, ...) que conectan sus clases.
+ *
+ * Es la entrada común de los consumidores globales (layout, exportadores,
+ * búsqueda), que necesitan ver el grafo de clases completo.
+ */
+class Model : public Element {
+public:
+    /**
+     * @brief Constructor para un Modelo.
+     * @param name Nombre descriptivo del proyecto (p.ej., "cpp-uml-generator").
+     */
+    explicit Model(std::string name = "model")
+        : Element(std::move(name), ElementKind::Model) {
+        setVisibility(Visibility::None);
+    }
+
+    /**
+     * @brief Destructor virtual por defecto.
+     */
+    ~Model() override = default;
+
+    // --- Gestión de Unidades de Traducción ---
+
+    /**
+     * @brief Añade una unidad de traducción al modelo.
+     * El modelo toma posesión de la unidad.
+     */
+    void addTranslationUnit(std::unique_ptr<TranslationUnit> tu) {
+        m_translationUnits.push_back(std::move(tu));
+    }
+
+    /**
+     * @brief Obtiene una vista de solo lectura de las unidades de traducción.
+     */
+    const std::vector<std::unique_ptr<TranslationUnit>>& getTranslationUnits() const {
+        return m_translationUnits;
+    }
+
+    /**
+     * @brief Busca una unidad de traducción por su ruta (su nombre).
+     * @return Un puntero no propietario, o nullptr si no existe.
+     */
+    TranslationUnit* findTranslationUnit(const std::string& filepath) const {
+        for (const auto& tu : m_translationUnits) {
+            if (tu->getName() == filepath) return tu.get();
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Sustituye la unidad con el mismo nombre, o la añade si no existe.
+     *
+     * Solo se reemplazan los elementos que provenían de esa TU; las
+     * referencias cruzadas hacia ella deben volver a enlazarse después
+     * (SymbolResolver con 'relink').
+     *
+     * @return true si se reemplazó una unidad existente.
+     */
+    bool replaceTranslationUnit(std::unique_ptr<TranslationUnit> tu) {
+        for (auto& existing : m_translationUnits) {
+            if (existing->getName() == tu->getName()) {
+                existing = std::move(tu);
+                return true;
+            }
+        }
+        m_translationUnits.push_back(std::move(tu));
+        return false;
+    }
+
+    /**
+     * @brief Elimina la unidad con esa ruta (p.ej., el archivo fue borrado).
+     * @return true si existía.
+     */
+    bool removeTranslationUnit(const std::string& filepath) {
+        for (auto it = m_translationUnits.begin(); it != m_translationUnits.end(); ++it) {
+            if ((*it)->getName() == filepath) {
+                m_translationUnits.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // --- Gestión de Relaciones ---
+
+    /**
+     * @brief Añade una relación (Asociación, Composición, ...) al modelo.
+     * El modelo toma posesión de la relación.
+     */
+    void addRelationship(std::unique_ptr<Relationship> relationship) {
+        m_relationships.push_back(std::move(relationship));
+    }
+
+    /**
+     * @brief Obtiene una vista de solo lectura de las relaciones.
+     */
+    const std::vector<std::unique_ptr<Relationship>>& getRelationships() const {
+        return m_relationships;
+    }
+
+private:
+    std::vector<std::unique_ptr<TranslationUnit>> m_translationUnits;
+    std::vector<std::unique_ptr<Relationship>> m_relationships;
+};
+
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_MODEL_MODEL_H
@@ -0,0 +1,138 @@
+#ifndef CPP_UML_GENERATOR_CORE_MODEL_MODEL_VISITOR_H
+#define CPP_UML_GENERATOR_CORE_MODEL_MODEL_VISITOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "Class.h"
+#include "Field.h"
+#include "Method.h"
+#include "Model.h"
+#include "Namespace.h"
+#include "TranslationUnit.h"
+
+namespace cppuml {
+
+// --- Recorrido CRTP ---
+
+/**
+ * @class ModelVisitor
+ * @brief Recorrido en profundidad del modelo con manejadores resueltos en
+ *        compilación (CRTP).
+ *
+ * Un pase hereda de ModelVisitor<Pase> y declara (públicos) solo los
+ * manejadores que necesita; los demás son los de esta clase, que no hacen
+ * nada:
+ *
+ *   struct Contador : ModelVisitor<Contador> {
+ *       std::size_t methods = 0;
+ *       void visitMethod(const Method&, const Class&) { ++methods; }
+ *   };
+ *   Contador contador;
+ *   contador.traverse(model);
+ *
+ * - enterNamespace / enterClass devuelven false para no bajar a sus miembros
+ *   (el leave correspondiente no se llama).
+ * - Las TUs se recorren en orden y, dentro de cada una, los miembros en el
+ *   orden de getMembers() / getFields() / getMethods().
+ *
+ * El recorrido es de solo lectura y todo el estado vive en el pase: una
+ * instancia por TU puede recorrer varias TUs en paralelo (ver
+ * 'forEachUnitParallel') y los resultados se unen después en el orden de
+ * las TUs.
+ */
+template <typename Derived>
+class ModelVisitor {
+public:
+    void traverse(const Model& model) {
+        for (const auto& tu : model.getTranslationUnits()) {
+            traverse(*tu);
+        }
+    }
+
+    /// El namespace global de la TU se recorre como cualquier otro.
+    void traverse(const TranslationUnit& tu) {
+        if (self().enterUnit(tu)) {
+            traverse(*tu.getGlobalNamespace());
+            self().leaveUnit(tu);
+        }
+    }
+
+    void traverse(const Namespace& ns) {
+        if (!self().enterNamespace(ns)) return;
+        for (const auto& member : ns.getMembers()) {
+            // El tipo se lee del ElementKind guardado: sin dynamic_cast.
+            if (member->getKind() == ElementKind::Namespace) {
+                traverse(static_cast<const Namespace&>(*member));
+            } else if (member->getKind() == ElementKind::Class) {
+                traverse(static_cast<const Class&>(*member));
+            }
+        }
+        self().leaveNamespace(ns);
+    }
+
+    void traverse(const Class& cls) {
+        if (!self().enterClass(cls)) return;
+        for (const auto& field : cls.getFields()) {
+            self().visitField(*field, cls);
+        }
+        for (const auto& method : cls.getMethods()) {
+            self().visitMethod(*method, cls);
+        }
+        self().leaveClass(cls);
+    }
+
+    // --- Manejadores por Defecto ---
+
+    bool enterUnit(const TranslationUnit&) { return true; }
+    void leaveUnit(const TranslationUnit&) {}
+    bool enterNamespace(const Namespace&) { return true; }
+    void leaveNamespace(const Namespace&) {}
+    bool enterClass(const Class&) { return true; }
+    void leaveClass(const Class&) {}
+    void visitField(const Field&, const Class&) {}
+    void visitMethod(const Method&, const Class&) {}
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+// --- Recorrido en Paralelo ---
+
+/**
+ * @brief Llama a 'task(tu, index)' con cada TU del modelo desde 'threads'
+ *        hilos (0 = número de núcleos).
+ *
+ * Las TUs se reparten de una en una a medida que los hilos quedan libres.
+ * 'task' no debe modificar el modelo; lo habitual es que escriba en una
+ * posición propia de un vector indexado por 'index' y unir después.
+ */
+template <typename F>
+void forEachUnitParallel(const Model& model, unsigned threads, F&& task) {
+    const auto& units = model.getTranslationUnits();
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min<std::size_t>(threads ? threads : cores, units.size());
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < units.size(); ++i) task(*units[i], i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto drain = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < units.size();) {
+            task(*units[i], i);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) pool.emplace_back(drain);
+    drain();
+    for (auto& th : pool) th.join();
+}
+
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_MODEL_MODEL_VISITOR_H
@@ -23,7 +23,7 @@ public:
      * @param name El nombre del namespace (p.ej., "std", "::" para el global).
      */
     explicit Namespace(std::string name)
-        : Element(std::move(name)) {
+        : Element(std::move(name), ElementKind::Namespace) {
         // Los Namespaces generalmente no tienen visibilidad (son contenedores)
         setVisibility(Visibility::None);
     }
@@ -33,14 +33,6 @@ public:
      */
     ~Namespace() override = default;
 
-    // --- Implementación de la Interfaz Element ---
-
-    /**
-     * @brief Obtiene el tipo de este elemento.
-     * @return ElementKind::Namespace.
-     */
-    ElementKind getKind() const override { return ElementKind::Namespace; }
-
     // --- Gestión de Miembros ---
 
     /**
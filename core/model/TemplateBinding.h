@@ -0,0 +1,47 @@
+#ifndef CPP_UML_GENERATOR_CORE_MODEL_TEMPLATE_BINDING_H
+#define CPP_UML_GENERATOR_CORE_MODEL_TEMPLATE_BINDING_H
+
+#include <string>
+#include <vector>
+
+#include "Type.h"
+
+namespace cppuml {
+
+/**
+ * @brief Modela un uso concreto de una plantilla (p.ej., 'Container<int>').
+ *
+ * No es un Element ni una Class: las instanciaciones no se copian como
+ * clases completas, solo se registra qué plantilla se usa y con qué
+ * argumentos. Es inmutable y se comparte entre TUs (el Parser la memoriza
+ * por tipo canónico), así que la misma especialización vista en miles de
+ * TUs ocupa memoria una sola vez por proceso.
+ */
+struct TemplateBinding {
+    std::string canonicalName;   ///< Tipo canónico, p.ej. "Container<int, std::allocator<int>>"
+    std::string templateName;    ///< Nombre calificado de la plantilla primaria
+    std::vector<Type> arguments; ///< Argumentos (los no-tipo se guardan como texto en el nombre)
+};
+
+// --- Accesores de Type que leen la instanciación ---
+
+inline const std::string& Type::getName() const {
+    return m_binding ? m_binding->templateName : m_name;
+}
+
+inline const std::vector<Type>& Type::getTemplateParameters() const {
+    return m_binding ? m_binding->arguments : m_templateParameters;
+}
+
+inline void Type::addTemplateParameter(Type param) {
+    if (m_binding) {
+        m_name = m_binding->templateName;
+        m_templateParameters = m_binding->arguments;
+        m_binding.reset();
+    }
+    m_templateParameters.push_back(std::move(param));
+}
+
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_MODEL_TEMPLATE_BINDING_H
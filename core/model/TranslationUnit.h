@@ -2,11 +2,13 @@
 #define CPP_UML_GENERATOR_CORE_MODEL_TRANSLATION_UNIT_H
 
 #include <string>
+#include <vector>
 #include <memory>  // Para std::unique_ptr
 #include <utility> // Para std::move
 
 #include "Element.h"
 #include "Namespace.h"
+#include "TemplateBinding.h"
 
 namespace cppuml {
 
@@ -26,7 +28,7 @@ public:
      * @param filepath La ruta completa al archivo, que se usará como nombre.
      */
     explicit TranslationUnit(std::string filepath)
-        : Element(std::move(filepath)) {
+        : Element(std::move(filepath), ElementKind::TranslationUnit) {
         
         // Cada TU tiene un namespace global (::) que posee todo.
         // Lo creamos aquí para asegurar que nunca sea nulo.
@@ -41,14 +43,6 @@ public:
      */
     ~TranslationUnit() override = default;
 
-    // --- Implementación de la Interfaz Element ---
-
-    /**
-     * @brief Obtiene el tipo de este elemento.
-     * @return ElementKind::TranslationUnit.
-     */
-    ElementKind getKind() const override { return ElementKind::TranslationUnit; }
-
     // --- Acceso Público ---
 
     /**
@@ -63,8 +57,46 @@ public:
         return m_globalNamespace.get();
     }
 
+    // --- Dependencias ---
+
+    /**
+     * @brief Establece los archivos (no del sistema) que esta TU incluye.
+     *
+     * Lo rellena el Parser con rutas reales; incluye el propio archivo
+     * principal. IncludeGraph lo usa para invalidar solo las TUs afectadas.
+     */
+    void setIncludedFiles(std::vector<std::string> files) {
+        m_includedFiles = std::move(files);
+    }
+
+    /**
+     * @brief Obtiene los archivos incluidos por esta TU.
+     */
+    const std::vector<std::string>& getIncludedFiles() const {
+        return m_includedFiles;
+    }
+
+    // --- Instanciaciones de Plantillas ---
+
+    /**
+     * @brief Registra un uso de plantilla (una vez por tipo canónico en la TU).
+     * La instancia es compartida: otras TUs pueden apuntar a la misma.
+     */
+    void addTemplateBinding(std::shared_ptr<const TemplateBinding> binding) {
+        m_templateBindings.push_back(std::move(binding));
+    }
+
+    /**
+     * @brief Obtiene los usos de plantillas de esta TU.
+     */
+    const std::vector<std::shared_ptr<const TemplateBinding>>& getTemplateBindings() const {
+        return m_templateBindings;
+    }
+
 private:
     std::unique_ptr<Namespace> m_globalNamespace;
+    std::vector<std::string> m_includedFiles;
+    std::vector<std::shared_ptr<const TemplateBinding>> m_templateBindings;
 };
 
 } // namespace cppuml
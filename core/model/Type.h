@@ -1,6 +1,7 @@
 #ifndef CPP_UML_GENERATOR_CORE_MODEL_TYPE_H
 #define CPP_UML_GENERATOR_CORE_MODEL_TYPE_H
 
+#include <memory>  // Para std::shared_ptr
 #include <string>
 #include <vector>
 #include <utility> // Para std::move
@@ -11,6 +12,7 @@
 namespace cppuml {
 
 class LibclangParser; 
+struct TemplateBinding; // Definida en TemplateBinding.h (incluido al final)
 
 /**
  * @brief Modela un tipo de C++ de forma semántica.
@@ -27,7 +29,7 @@ public:
     explicit Type(std::string name)
         : m_name(std::move(name)), m_customTypeElement(nullptr),
           m_isConst(false), m_isVolatile(false), 
-          m_isPointer(false), m_isReference(false) {}
+          m_isPointer(false), m_isReference(false), m_isUnresolved(false) {}
 
     // --- Semántica de Copia y Movimiento ---
     
@@ -53,6 +55,15 @@ public:
     void setReference(bool val = true) { m_isReference = val; }
     bool isReference() const { return m_isReference; }
 
+    /**
+     * @brief Marca un tipo que el compilador no pudo resolver (p.ej., en un
+     *        análisis 'skim', sin las cabeceras que lo declaran).
+     *
+     * El nombre es entonces el texto tal como se escribió en el código.
+     */
+    void setUnresolved(bool val = true) { m_isUnresolved = val; }
+    bool isUnresolved() const { return m_isUnresolved; }
+
     // --- Enlace del Modelo ---
 
     /**
@@ -72,18 +83,39 @@ public:
     /**
      * @brief Añade un parámetro de plantilla a este tipo.
      * @param param El tipo del parámetro de plantilla.
+     *
+     * En un tipo enlazado a una instanciación, primero copia sus argumentos
+     * (el tipo deja de compartirla).
      */
-    void addTemplateParameter(Type param) {
-        m_templateParameters.push_back(std::move(param));
-    }
+    inline void addTemplateParameter(Type param);
+
+    /**
+     * @brief Los argumentos de plantilla: los de la instanciación compartida
+     *        si el tipo está enlazado a una, o los propios.
+     */
+    inline const std::vector<Type>& getTemplateParameters() const;
 
-    const std::vector<Type>& getTemplateParameters() const {
-        return m_templateParameters;
+    /**
+     * @brief Enlaza el tipo a una instanciación compartida ('Container<int>').
+     *
+     * El nombre y los argumentos se leen de ella, sin copiarlos: los miles de
+     * campos y parámetros que usan la misma especialización apuntan al mismo
+     * TemplateBinding.
+     */
+    void setBinding(std::shared_ptr<const TemplateBinding> binding) {
+        m_binding = std::move(binding);
+        m_name.clear();
+        m_templateParameters.clear();
     }
 
+    /**
+     * @brief La instanciación compartida (nullptr si el tipo no está enlazado).
+     */
+    const std::shared_ptr<const TemplateBinding>& getBinding() const { return m_binding; }
+
     // --- Acceso y Utilidades ---
 
-    const std::string& getName() const { return m_name; }
+    inline const std::string& getName() const;
 
     /**
      * @brief Reconstruye la cadena completa del tipo (para exportadores y depuración).
@@ -94,13 +126,14 @@ public:
         if (m_isConst) ss << "const ";
         if (m_isVolatile) ss << "volatile ";
         
-        ss << m_name;
+        ss << getName();
 
-        if (!m_templateParameters.empty()) {
+        const std::vector<Type>& params = getTemplateParameters();
+        if (!params.empty()) {
             ss << "<";
-            for (size_t i = 0; i < m_templateParameters.size(); ++i) {
-                ss << m_templateParameters[i].getFullName();
-                if (i < m_templateParameters.size() - 1) ss << ", ";
+            for (size_t i = 0; i < params.size(); ++i) {
+                ss << params[i].getFullName();
+                if (i < params.size() - 1) ss << ", ";
             }
             ss << ">";
         }
@@ -116,12 +149,14 @@ private:
     Element* m_customTypeElement; // Puntero no propietario
 
     std::vector<Type> m_templateParameters;
+    std::shared_ptr<const TemplateBinding> m_binding; // Compartido; si no es nulo sustituye a nombre y argumentos
 
     // Calificadores y modificadores
     bool m_isConst;
     bool m_isVolatile;
     bool m_isPointer;
     bool m_isReference;
+    bool m_isUnresolved;
 
     // Amistad: Opcionalmente, permite al parser acceder a los miembros
     // privados para construir el tipo de manera eficiente.
@@ -130,4 +165,7 @@ private:
 
 } // namespace cppuml
 
+// Los accesores en línea que leen la instanciación necesitan su definición.
+#include "TemplateBinding.h"
+
 #endif // CPP_UML_GENERATOR_CORE_MODEL_TYPE_H
\ No newline at end of file
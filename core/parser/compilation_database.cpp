@@ -0,0 +1,124 @@
+#include "compilation_database.h"
+
+#include <clang-c/CXCompilationDatabase.h>
+
+#include <filesystem>
+#include <iostream>
+
+#include "include_graph.h"
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+std::string takeString(CXString cx) {
+    const char* c_str = clang_getCString(cx);
+    std::string result = c_str ? c_str : "";
+    clang_disposeString(cx);
+    return result;
+}
+
+/// Opciones que no afectan al análisis y llevan un valor en el argumento siguiente.
+bool dropsNextArgument(const std::string& arg) {
+    return arg == "-o" || arg == "-MF" || arg == "-MT" || arg == "-MQ";
+}
+
+/// Opciones que no afectan al análisis (salida, dependencias).
+bool isDropped(const std::string& arg) {
+    if (arg == "-c" || arg == "-M" || arg == "-MM" || arg == "-MD" || arg == "-MMD" || arg == "-MP") {
+        return true;
+    }
+    return arg.size() > 2 && (arg.compare(0, 2, "-o") == 0 || arg.compare(0, 3, "-MF") == 0 ||
+                              arg.compare(0, 3, "-MT") == 0 || arg.compare(0, 3, "-MQ") == 0);
+}
+
+} // namespace
+
+// --- Carga ---
+
+bool CompilationDatabase::load(const std::string& buildDirectory) {
+    CXCompilationDatabase_Error error = CXCompilationDatabase_NoError;
+    CXCompilationDatabase database = clang_CompilationDatabase_fromDirectory(buildDirectory.c_str(), &error);
+    if (error != CXCompilationDatabase_NoError || !database) {
+        std::cerr << "Error: no se pudo cargar compile_commands.json de " << buildDirectory << std::endl;
+        return false;
+    }
+
+    m_jobs.clear();
+    m_byFile.clear();
+    CXCompileCommands commands = clang_CompilationDatabase_getAllCompileCommands(database);
+    const unsigned count = clang_CompileCommands_getSize(commands);
+    for (unsigned i = 0; i < count; ++i) {
+        CXCompileCommand command = clang_CompileCommands_getCommand(commands, i);
+        const std::string directory = takeString(clang_CompileCommand_getDirectory(command));
+        std::filesystem::path file = takeString(clang_CompileCommand_getFilename(command));
+        if (file.is_relative()) {
+            file = std::filesystem::path(directory) / file;
+        }
+        const std::string sourceFile = file.lexically_normal().string();
+        if (m_byFile.count(IncludeGraph::normalize(sourceFile))) {
+            continue; // Varias configuraciones del mismo archivo: basta la primera
+        }
+
+        std::vector<std::string> commandLine;
+        const unsigned numArgs = clang_CompileCommand_getNumArgs(command);
+        commandLine.reserve(numArgs);
+        for (unsigned a = 0; a < numArgs; ++a) {
+            commandLine.push_back(takeString(clang_CompileCommand_getArg(command, a)));
+        }
+
+        m_byFile.emplace(IncludeGraph::normalize(sourceFile), m_jobs.size());
+        m_jobs.push_back({sourceFile, cleanArguments(commandLine, sourceFile, directory)});
+    }
+    clang_CompileCommands_dispose(commands);
+    clang_CompilationDatabase_dispose(database);
+    return true;
+}
+
+std::vector<ParseJob> CompilationDatabase::jobsFor(const std::vector<std::string>& files) const {
+    std::vector<ParseJob> selected;
+    selected.reserve(files.size());
+    for (const auto& file : files) {
+        auto it = m_byFile.find(IncludeGraph::normalize(file));
+        if (it == m_byFile.end()) {
+            std::cerr << "Aviso: " << file << " no está en la base de compilación; se omite" << std::endl;
+            continue;
+        }
+        selected.push_back(m_jobs[it->second]);
+    }
+    return selected;
+}
+
+// --- Limpieza de Argumentos ---
+
+std::vector<std::string> CompilationDatabase::cleanArguments(const std::vector<std::string>& commandLine,
+                                                             const std::string& sourceFile,
+                                                             const std::string& directory) {
+    std::vector<std::string> args;
+    args.reserve(commandLine.size() + 1);
+    args.push_back("-working-directory=" + directory);
+
+    const std::filesystem::path source(sourceFile);
+    for (std::size_t i = 1; i < commandLine.size(); ++i) { // argv[0] es el compilador
+        const std::string& arg = commandLine[i];
+        if (dropsNextArgument(arg)) {
+            ++i;
+            continue;
+        }
+        if (isDropped(arg)) {
+            continue;
+        }
+        // El propio archivo fuente: libclang lo recibe por separado
+        std::filesystem::path candidate(arg);
+        if (candidate.is_relative()) candidate = std::filesystem::path(directory) / candidate;
+        if (candidate.lexically_normal() == source) {
+            continue;
+        }
+        args.push_back(arg);
+    }
+    return args;
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "process_pool.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @class CompilationDatabase
+ * @brief Lee un 'compile_commands.json' y lo convierte en trabajos de análisis.
+ *
+ * Usa la API de bases de compilación de libclang. De cada comando se
+ * eliminan el compilador, el propio archivo, '-c', '-o' y las opciones de
+ * dependencias; el directorio de trabajo se conserva con
+ * '-working-directory=' para que las rutas relativas ('-I../include')
+ * sigan resolviéndose igual que en la compilación real.
+ */
+class CompilationDatabase {
+public:
+    /**
+     * @brief Carga la base de datos del directorio de compilación.
+     * @param buildDirectory El directorio que contiene 'compile_commands.json'.
+     * @return false si no existe o libclang no pudo leerla.
+     */
+    bool load(const std::string& buildDirectory);
+
+    /**
+     * @brief Todos los trabajos, uno por archivo (la primera entrada gana).
+     */
+    const std::vector<ParseJob>& jobs() const { return m_jobs; }
+
+    /**
+     * @brief Los trabajos de los archivos indicados, en ese orden.
+     *
+     * Un archivo ausente de la base se omite con un aviso.
+     */
+    std::vector<ParseJob> jobsFor(const std::vector<std::string>& files) const;
+
+    /**
+     * @brief Limpia una línea de compilación para pasarla a libclang.
+     * @param commandLine La línea completa (argv[0] es el compilador).
+     * @param sourceFile La ruta absoluta del archivo que compila.
+     * @param directory El directorio de trabajo del comando.
+     */
+    static std::vector<std::string> cleanArguments(const std::vector<std::string>& commandLine,
+                                                   const std::string& sourceFile,
+                                                   const std::string& directory);
+
+private:
+    std::vector<ParseJob> m_jobs;
+    std::unordered_map<std::string, std::size_t> m_byFile; ///< ruta normalizada -> índice en m_jobs
+};
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,197 @@
+#include "include_graph.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+constexpr const char* kHeader = "cppuml-include-graph 1";
+
+} // namespace
+
+// --- Rutas ---
+
+std::string IncludeGraph::normalize(const std::string& path) {
+    // Las rutas del Parser ya son reales y absolutas: normalizarlas sin tocar
+    // el disco evita millones de stat() al registrar o cargar grafos grandes.
+    const std::filesystem::path raw(path);
+    if (raw.is_absolute()) {
+        return raw.lexically_normal().string();
+    }
+    std::error_code ec;
+    std::filesystem::path normalized = std::filesystem::weakly_canonical(raw, ec);
+    if (ec) {
+        normalized = std::filesystem::absolute(raw, ec).lexically_normal();
+    }
+    return ec ? path : normalized.string();
+}
+
+IncludeGraph::FileId IncludeGraph::intern(const std::string& normalizedPath) {
+    auto inserted = m_ids.emplace(normalizedPath, static_cast<FileId>(m_paths.size()));
+    if (inserted.second) {
+        m_paths.push_back(normalizedPath);
+        m_dependents.emplace_back();
+    }
+    return inserted.first->second;
+}
+
+const IncludeGraph::FileId* IncludeGraph::lookup(const std::string& normalizedPath) const {
+    auto it = m_ids.find(normalizedPath);
+    return it == m_ids.end() ? nullptr : &it->second;
+}
+
+// --- Registro ---
+
+void IncludeGraph::record(const std::string& unit, const std::vector<std::string>& includes) {
+    std::vector<std::string> normalized;
+    normalized.reserve(includes.size());
+    for (const auto& include : includes) {
+        normalized.push_back(normalize(include));
+    }
+    recordNormalized(unit, normalize(unit), normalized);
+}
+
+void IncludeGraph::recordNormalized(const std::string& unit, const std::string& normalizedUnit,
+                                    const std::vector<std::string>& normalizedIncludes) {
+    forgetNormalized(normalizedUnit);
+
+    const FileId unitId = intern(normalizedUnit);
+    std::vector<FileId> files;
+    files.reserve(normalizedIncludes.size() + 1);
+    files.push_back(unitId); // Editar la propia TU también la invalida
+    for (const auto& include : normalizedIncludes) {
+        files.push_back(intern(include));
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    for (FileId file : files) {
+        m_dependents[file].push_back(unitId);
+    }
+    m_unitIncludes[unitId] = std::move(files);
+    m_unitNames[unitId] = unit;
+}
+
+void IncludeGraph::record(const Model& model) {
+    for (const auto& tu : model.getTranslationUnits()) {
+        record(tu->getName(), tu->getIncludedFiles());
+    }
+}
+
+void IncludeGraph::forget(const std::string& unit) {
+    forgetNormalized(normalize(unit));
+}
+
+void IncludeGraph::forgetNormalized(const std::string& normalizedUnit) {
+    const FileId* id = lookup(normalizedUnit);
+    if (!id) return;
+    const FileId unitId = *id;
+
+    auto it = m_unitIncludes.find(unitId);
+    if (it == m_unitIncludes.end()) return;
+    for (FileId file : it->second) {
+        auto& dependents = m_dependents[file];
+        dependents.erase(std::remove(dependents.begin(), dependents.end(), unitId), dependents.end());
+    }
+    m_unitIncludes.erase(it);
+    m_unitNames.erase(unitId);
+}
+
+// --- Consulta ---
+
+std::vector<std::string> IncludeGraph::affectedUnits(const std::vector<std::string>& changedFiles) const {
+    std::vector<FileId> units;
+    for (const auto& file : changedFiles) {
+        const FileId* id = lookup(normalize(file));
+        if (!id) continue; // Ninguna TU conocida incluye este archivo
+        const auto& dependents = m_dependents[*id];
+        units.insert(units.end(), dependents.begin(), dependents.end());
+    }
+    std::sort(units.begin(), units.end());
+    units.erase(std::unique(units.begin(), units.end()), units.end());
+
+    std::vector<std::string> names;
+    names.reserve(units.size());
+    for (FileId unit : units) {
+        names.push_back(m_unitNames.at(unit));
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::size_t IncludeGraph::includeCount(const std::string& unit) const {
+    const FileId* id = lookup(normalize(unit));
+    if (!id) return 0;
+    auto it = m_unitIncludes.find(*id);
+    return it == m_unitIncludes.end() ? 0 : it->second.size();
+}
+
+// --- Persistencia ---
+//
+// Formato (texto):
+//   cppuml-include-graph 1
+//   <nombre de la TU>
+//   <ruta normalizada de la TU>
+//   <N>
+//   <archivo 1>
+//   ...
+//   <archivo N>
+//   (se repite por cada TU)
+
+bool IncludeGraph::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: no se pudo escribir el grafo de inclusiones en " << path << std::endl;
+        return false;
+    }
+
+    out << kHeader << '\n';
+    for (const auto& entry : m_unitIncludes) {
+        out << m_unitNames.at(entry.first) << '\n' << m_paths[entry.first] << '\n'
+            << entry.second.size() << '\n';
+        for (FileId file : entry.second) {
+            out << m_paths[file] << '\n';
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool IncludeGraph::load(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kHeader) {
+        return false;
+    }
+
+    // Las rutas guardadas ya están normalizadas: se registran tal cual.
+    IncludeGraph loaded;
+    std::string unit;
+    std::string normalizedUnit;
+    std::vector<std::string> includes;
+    while (std::getline(in, unit)) {
+        if (!std::getline(in, normalizedUnit) || !std::getline(in, line)) return false;
+        std::size_t count = 0;
+        try {
+            count = static_cast<std::size_t>(std::stoul(line));
+        } catch (const std::exception&) {
+            return false;
+        }
+        includes.assign(count, std::string());
+        for (auto& include : includes) {
+            if (!std::getline(in, include)) return false;
+        }
+        loaded.recordNormalized(unit, normalizedUnit, includes);
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "model/Model.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @class IncludeGraph
+ * @brief Grafo de dependencias inverso: archivo -> TUs que lo incluyen.
+ *
+ * Se alimenta con el conjunto de inclusiones que el Parser guarda en cada
+ * TranslationUnit ('getIncludedFiles'). Dado un conjunto de archivos
+ * modificados, devuelve el conjunto mínimo de TUs a volver a analizar:
+ * editar una cabecera hoja afecta solo a las TUs que la incluyen.
+ *
+ * Las rutas se interna una sola vez (id de 32 bits), así que miles de TUs
+ * que incluyen las mismas cabeceras no duplican cadenas.
+ */
+class IncludeGraph {
+public:
+    /**
+     * @brief Registra (o reemplaza) las inclusiones de una TU.
+     * @param unit El nombre de la TU en el Modelo (su ruta, tal como se analizó).
+     * @param includes Los archivos que incluye, incluido el principal.
+     */
+    void record(const std::string& unit, const std::vector<std::string>& includes);
+
+    /**
+     * @brief Registra todas las TUs de un modelo.
+     */
+    void record(const Model& model);
+
+    /**
+     * @brief Olvida una TU (p.ej., el archivo fue eliminado).
+     */
+    void forget(const std::string& unit);
+
+    /**
+     * @brief Calcula las TUs afectadas por un conjunto de archivos modificados.
+     *
+     * Un archivo que es en sí una TU conocida se incluye siempre.
+     * @return Los nombres de las TUs, ordenados y sin repetir.
+     */
+    std::vector<std::string> affectedUnits(const std::vector<std::string>& changedFiles) const;
+
+    /**
+     * @brief Número de archivos que incluye una TU (0 si no está registrada).
+     */
+    std::size_t includeCount(const std::string& unit) const;
+
+    /**
+     * @brief Número de TUs registradas.
+     */
+    std::size_t unitCount() const { return m_unitIncludes.size(); }
+
+    /**
+     * @brief Guarda el grafo en disco (texto, una ruta por línea).
+     * @return false si no se pudo escribir el archivo.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Carga un grafo guardado con save(), reemplazando el actual.
+     * @return false si el archivo no existe o no tiene el formato esperado.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Normaliza una ruta para compararla (absoluta, sin '.' ni '..').
+     */
+    static std::string normalize(const std::string& path);
+
+private:
+    using FileId = std::uint32_t;
+
+    void recordNormalized(const std::string& unit, const std::string& normalizedUnit,
+                          const std::vector<std::string>& normalizedIncludes);
+    void forgetNormalized(const std::string& normalizedUnit);
+
+    FileId intern(const std::string& normalizedPath);
+    const FileId* lookup(const std::string& normalizedPath) const;
+
+    std::unordered_map<std::string, FileId> m_ids;
+    std::vector<std::string> m_paths;
+
+    /// TU -> archivos que incluye
+    std::unordered_map<FileId, std::vector<FileId>> m_unitIncludes;
+    /// TU -> nombre con el que se registró (el del Modelo)
+    std::unordered_map<FileId, std::string> m_unitNames;
+    /// archivo -> TUs que lo incluyen (índice = FileId)
+    std::vector<std::vector<FileId>> m_dependents;
+};
+
+} // namespace parser
+} // namespace cppuml
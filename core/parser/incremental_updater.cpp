@@ -0,0 +1,56 @@
+#include "incremental_updater.h"
+
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include "symbol_resolver.h"
+
+namespace cppuml {
+namespace parser {
+
+IncrementalUpdateReport IncrementalUpdater::update(
+    Model& model,
+    IncludeGraph& graph,
+    LibClangParser& parser,
+    const std::vector<std::string>& changedFiles,
+    const std::vector<std::string>& compileArgs) {
+    return update(model, graph, parser, changedFiles,
+                  [&](const std::string&) { return compileArgs; });
+}
+
+IncrementalUpdateReport IncrementalUpdater::update(
+    Model& model,
+    IncludeGraph& graph,
+    LibClangParser& parser,
+    const std::vector<std::string>& changedFiles,
+    const CompileArgsLookup& argsFor) {
+
+    IncrementalUpdateReport report;
+    for (const auto& unit : graph.affectedUnits(changedFiles)) {
+        std::error_code ec;
+        if (!std::filesystem::exists(unit, ec)) {
+            model.removeTranslationUnit(unit);
+            graph.forget(unit);
+            report.removedUnits.push_back(unit);
+            continue;
+        }
+
+        auto tu = parser.parse(unit, argsFor(unit));
+        if (!tu) {
+            report.failedUnits.push_back(unit);
+            continue;
+        }
+        graph.record(unit, tu->getIncludedFiles());
+        model.replaceTranslationUnit(std::move(tu));
+        report.reparsedUnits.push_back(unit);
+    }
+
+    if (!report.reparsedUnits.empty() || !report.removedUnits.empty()) {
+        SymbolResolver::resolve(model, /*relink=*/true);
+    }
+    return report;
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include_graph.h"
+#include "libclang_parser.h"
+#include "model/Model.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Resultado de una actualización incremental.
+ */
+struct IncrementalUpdateReport {
+    std::vector<std::string> reparsedUnits; ///< TUs reemplazadas en el modelo
+    std::vector<std::string> removedUnits;  ///< TUs cuyo archivo ya no existe
+    std::vector<std::string> failedUnits;   ///< libclang falló; se conserva la versión anterior
+};
+
+/**
+ * @class IncrementalUpdater
+ * @brief Reanaliza solo las TUs afectadas por un conjunto de archivos modificados.
+ *
+ * Consulta el IncludeGraph, vuelve a analizar las TUs afectadas, reemplaza
+ * en el Modelo únicamente los elementos que provenían de ellas y actualiza
+ * el grafo con sus nuevas inclusiones. Al final vuelve a enlazar las bases
+ * de todo el modelo, ya que otras TUs podían apuntar a clases reemplazadas.
+ */
+class IncrementalUpdater {
+public:
+    static IncrementalUpdateReport update(
+        Model& model,
+        IncludeGraph& graph,
+        LibClangParser& parser,
+        const std::vector<std::string>& changedFiles,
+        const std::vector<std::string>& compileArgs = {});
+
+    /**
+     * @brief Argumentos de compilación de una TU (p.ej., de una base de compilación).
+     */
+    using CompileArgsLookup = std::function<std::vector<std::string>(const std::string& unit)>;
+
+    /**
+     * @brief Igual que update(), con argumentos distintos para cada TU.
+     */
+    static IncrementalUpdateReport update(
+        Model& model,
+        IncludeGraph& graph,
+        LibClangParser& parser,
+        const std::vector<std::string>& changedFiles,
+        const CompileArgsLookup& argsFor);
+};
+
+} // namespace parser
+} // namespace cppuml
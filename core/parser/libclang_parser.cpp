@@ -3,32 +3,691 @@
 #include <clang-c/Index.h>
 
 // --- Registros / Utilidades ---
+#include <array>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <string>
-#include <stack> // <--- Necesario para el estado
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <set>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // --- Inclusiones del Modelo ---
 #include "model/Class.h"
 #include "model/Method.h"
 #include "model/Field.h"
 #include "model/Namespace.h"
+#include "model/Type.h"
 
 namespace cppuml {
 namespace parser {
 
-// --- Utilidad de Ayuda ---
-// (Sin cambios)
+// --- Utilidades de Ayuda ---
+
 static std::string cx_to_std(CXString cx) {
     const char* c_str = clang_getCString(cx);
-    if (!c_str) {
-        return "";
-    }
-    std::string str(c_str);
+    std::string str(c_str ? c_str : "");
     clang_disposeString(cx);
     return str;
 }
 
-// --- Clase Visitante de AST (NUEVA) ---
+/**
+ * @brief Como 'cx_to_std', pero reutiliza la memoria ya reservada de 'out'.
+ */
+static void cx_assign(CXString cx, std::string& out) {
+    const char* c_str = clang_getCString(cx);
+    out.assign(c_str ? c_str : "");
+    clang_disposeString(cx);
+}
+
+static Visibility toVisibility(CX_CXXAccessSpecifier access) {
+    switch (access) {
+        case CX_CXXPublic:    return Visibility::Public;
+        case CX_CXXProtected: return Visibility::Protected;
+        case CX_CXXPrivate:   return Visibility::Private;
+        default:              return Visibility::None;
+    }
+}
+
+/**
+ * @brief Separa los modificadores (referencia, puntero) de un CXType.
+ * @return El tipo apuntado/referenciado (aún con su calificador const).
+ */
+static CXType stripModifiers(CXType cxType, bool& isReference, bool& isPointer) {
+    isReference = false;
+    isPointer = false;
+    if (cxType.kind == CXType_LValueReference || cxType.kind == CXType_RValueReference) {
+        isReference = true;
+        cxType = clang_getPointeeType(cxType);
+    }
+    if (cxType.kind == CXType_Pointer) {
+        isPointer = true;
+        cxType = clang_getPointeeType(cxType);
+    }
+    return cxType;
+}
+
+/**
+ * @brief Convierte un CXType en nuestro objeto de valor 'Type'.
+ *
+ * Separa los modificadores (referencia, puntero, const) del nombre base,
+ * ya que 'Type::getFullName' los vuelve a componer.
+ */
+static Type makeType(CXType cxType) {
+    bool isReference = false;
+    bool isPointer = false;
+    cxType = stripModifiers(cxType, isReference, isPointer);
+
+    const bool isConst = clang_isConstQualifiedType(cxType) != 0;
+    std::string name = cx_to_std(clang_getTypeSpelling(cxType));
+    const std::string constPrefix = "const ";
+    if (isConst && name.compare(0, constPrefix.size(), constPrefix) == 0) {
+        name.erase(0, constPrefix.size());
+    }
+
+    Type type(std::move(name));
+    type.setConst(isConst);
+    type.setPointer(isPointer);
+    type.setReference(isReference);
+    return type;
+}
+
+/**
+ * @brief Divide la lista de argumentos de "Plantilla<A, B<C, D>, 3>" en
+ *        sus argumentos de primer nivel ("A", "B<C, D>", "3").
+ */
+static std::vector<std::string> splitTemplateArguments(const std::string& spelling) {
+    std::vector<std::string> arguments;
+    const auto open = spelling.find('<');
+    if (open == std::string::npos || spelling.back() != '>') return arguments;
+
+    int depth = 0;
+    std::string current;
+    for (std::size_t i = open + 1; i + 1 < spelling.size(); ++i) {
+        const char c = spelling[i];
+        if (c == '<' || c == '(') ++depth;
+        if (c == '>' || c == ')') --depth;
+        if (c == ',' && depth == 0) {
+            arguments.push_back(std::move(current));
+            current.clear();
+            continue;
+        }
+        if (!(current.empty() && c == ' ')) current += c;
+    }
+    arguments.push_back(std::move(current));
+    return arguments;
+}
+
+/**
+ * @brief Construye el nombre calificado (p.ej., "ui::Window") de una declaración.
+ */
+static std::string qualifiedName(CXCursor cursor) {
+    std::string name = cx_to_std(clang_getCursorSpelling(cursor));
+    for (CXCursor parent = clang_getCursorSemanticParent(cursor);
+         !clang_Cursor_isNull(parent) && clang_getCursorKind(parent) != CXCursor_TranslationUnit;
+         parent = clang_getCursorSemanticParent(parent)) {
+        std::string parentName = cx_to_std(clang_getCursorSpelling(parent));
+        if (!parentName.empty()) {
+            name = parentName + "::" + name;
+        }
+    }
+    return name;
+}
+
+static CXChildVisitResult visitorTrampoline(CXCursor cursor, CXCursor parent, CXClientData client_data);
+
+/**
+ * @brief Lee un parámetro de plantilla ('typename T = int', 'int N', ...).
+ *
+ * libclang no expone los argumentos por defecto ni los packs, así que se
+ * obtienen de los tokens del cursor.
+ */
+static TemplateParameter makeTemplateParameter(CXCursor cursor) {
+    TemplateParameter parameter;
+    parameter.name = cx_to_std(clang_getCursorSpelling(cursor));
+    switch (clang_getCursorKind(cursor)) {
+        case CXCursor_TemplateTypeParameter:     parameter.kind = "typename"; break;
+        case CXCursor_TemplateTemplateParameter: parameter.kind = "template"; break;
+        default: parameter.kind = cx_to_std(clang_getTypeSpelling(clang_getCursorType(cursor))); break;
+    }
+
+    CXTranslationUnit tu = clang_Cursor_getTranslationUnit(cursor);
+    CXToken* tokens = nullptr;
+    unsigned count = 0;
+    clang_tokenize(tu, clang_getCursorExtent(cursor), &tokens, &count);
+    bool inDefault = false;
+    bool previousIsWord = false;
+    for (unsigned i = 0; i < count; ++i) {
+        const std::string token = cx_to_std(clang_getTokenSpelling(tu, tokens[i]));
+        const bool isWord = clang_getTokenKind(tokens[i]) != CXToken_Punctuation;
+        if (inDefault) {
+            // Solo hace falta un espacio entre dos palabras ("unsigned int").
+            if (isWord && previousIsWord) parameter.defaultArgument += ' ';
+            parameter.defaultArgument += token;
+        } else if (token == "...") {
+            parameter.isPack = true;
+        } else if (token == "=") {
+            inDefault = true;
+            previousIsWord = false;
+            continue;
+        }
+        previousIsWord = isWord;
+    }
+    clang_disposeTokens(tu, tokens, count);
+    return parameter;
+}
+
+// --- Memoria de Plantillas ---
+
+/**
+ * @brief Instanciaciones ya descompuestas, por tipo canónico.
+ *
+ * Vive en LibClangParser (entre llamadas a 'parse'), por lo que cada
+ * especialización se descompone y se almacena una sola vez por proceso.
+ */
+struct TemplateCache {
+    struct Entry {
+        std::shared_ptr<const TemplateBinding> binding;
+        bool fromSystemHeader = false; ///< p.ej., std::vector<int>: se descompone pero no se registra
+    };
+    std::unordered_map<std::string, Entry> bindings;
+};
+
+// --- TUs Retenidas ---
+
+/**
+ * @brief Caché LRU de las TUs de libclang que se mantienen vivas.
+ *
+ * Cada TU se guarda junto con los argumentos con los que se creó (si
+ * cambian, ya no sirve) y la memoria que libclang declara para ella, que
+ * incluye el AST y el preámbulo precompilado.
+ */
+struct LiveUnits {
+    struct Unit {
+        CXTranslationUnit tu = nullptr;
+        std::vector<std::string> compileArgs;
+        std::size_t bytes = 0;
+        std::list<std::string>::iterator recent; ///< Posición en 'recency'
+    };
+    std::unordered_map<std::string, Unit> units;
+    std::list<std::string> recency; ///< La más reciente al principio
+    std::size_t maxBytes = LibClangParser::kDefaultLiveUnitBytes;
+    LiveUnitStats stats;
+
+    Unit* find(const std::string& path) {
+        auto it = units.find(path);
+        if (it == units.end()) return nullptr;
+        recency.splice(recency.begin(), recency, it->second.recent);
+        return &it->second;
+    }
+
+    void insert(const std::string& path, CXTranslationUnit tu, const std::vector<std::string>& compileArgs) {
+        recency.push_front(path);
+        units[path] = Unit{tu, compileArgs, 0, recency.begin()};
+    }
+
+    /// Vuelve a medir una TU (su AST cambia tras cada re-análisis).
+    void measure(Unit& unit) {
+        stats.bytes -= unit.bytes;
+        unit.bytes = 0;
+        CXTUResourceUsage usage = clang_getCXTUResourceUsage(unit.tu);
+        for (unsigned i = 0; i < usage.numEntries; ++i) {
+            unit.bytes += usage.entries[i].amount;
+        }
+        clang_disposeCXTUResourceUsage(usage);
+        stats.bytes += unit.bytes;
+    }
+
+    /**
+     * @brief Libera las TUs menos usadas hasta respetar el límite.
+     * @return false si 'keep' excede el límite por sí sola (y se quitó de la caché).
+     */
+    bool evict(const std::string& keep) {
+        while (stats.bytes > maxBytes && recency.size() > 1) {
+            const std::string victim = recency.back() == keep ? *std::prev(recency.end(), 2) : recency.back();
+            dispose(victim);
+            ++stats.evictions;
+        }
+        if (stats.bytes <= maxBytes) return true;
+        forget(keep);
+        ++stats.evictions;
+        return false;
+    }
+
+    /// Quita una TU de la caché sin liberarla (su dueño pasa a ser el llamador).
+    void forget(const std::string& path) {
+        auto it = units.find(path);
+        if (it == units.end()) return;
+        stats.bytes -= it->second.bytes;
+        recency.erase(it->second.recent);
+        units.erase(it);
+    }
+
+    void dispose(const std::string& path) {
+        auto it = units.find(path);
+        if (it == units.end()) return;
+        clang_disposeTranslationUnit(it->second.tu);
+        forget(path);
+    }
+
+    void clear() {
+        for (auto& entry : units) clang_disposeTranslationUnit(entry.second.tu);
+        units.clear();
+        recency.clear();
+        stats.bytes = 0;
+    }
+};
+
+/// Vista 'CXUnsavedFile' de los buffers (apunta a sus cadenas, no las copia).
+static std::vector<CXUnsavedFile> toUnsavedFiles(const std::vector<SourceBuffer>& buffers) {
+    std::vector<CXUnsavedFile> unsaved;
+    unsaved.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+        unsaved.push_back({buffer.path.c_str(), buffer.contents.data(),
+                           static_cast<unsigned long>(buffer.contents.size())});
+    }
+    return unsaved;
+}
+
+// --- Tipos Escritos (modo 'skim') ---
+
+/// Los tokens de un cursor, como texto.
+static std::vector<std::string> cursorTokens(CXCursor cursor) {
+    CXTranslationUnit tu = clang_Cursor_getTranslationUnit(cursor);
+    CXToken* tokens = nullptr;
+    unsigned count = 0;
+    clang_tokenize(tu, clang_getCursorExtent(cursor), &tokens, &count);
+    std::vector<std::string> spelled;
+    spelled.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        spelled.push_back(cx_to_std(clang_getTokenSpelling(tu, tokens[i])));
+    }
+    clang_disposeTokens(tu, tokens, count);
+    return spelled;
+}
+
+static bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+/// Une tokens como los escribe clang: "unsigned long", "std::map<K, V>".
+static std::string joinTokens(const std::vector<std::string>& tokens, std::size_t first, std::size_t last) {
+    std::string text;
+    for (std::size_t i = first; i < last; ++i) {
+        const std::string& token = tokens[i];
+        if (!text.empty() && (text.back() == ',' || (isWordChar(text.back()) && isWordChar(token.front())))) {
+            text += ' ';
+        }
+        text += token;
+    }
+    return text;
+}
+
+/**
+ * @brief Un tipo tal como se escribió ("const ns::Map<K, V>*&"), marcado
+ *        como no resuelto. Se descompone igual que 'makeType'.
+ */
+static Type writtenType(std::string text) {
+    auto trim = [](std::string& value) {
+        const auto first = value.find_first_not_of(' ');
+        const auto last = value.find_last_not_of(' ');
+        value = first == std::string::npos ? std::string() : value.substr(first, last - first + 1);
+    };
+    trim(text);
+    bool isConst = false;
+    bool isReference = false;
+    bool isPointer = false;
+    if (text.compare(0, 6, "const ") == 0) {
+        isConst = true;
+        text.erase(0, 6);
+    }
+    while (!text.empty() && text.back() == '&') {
+        isReference = true;
+        text.pop_back();
+    }
+    trim(text);
+    if (!text.empty() && text.back() == '*') {
+        isPointer = true;
+        text.pop_back();
+        trim(text);
+    }
+    if (text.size() > 6 && text.compare(text.size() - 6, 6, " const") == 0) {
+        isConst = true; // "Foo const&"
+        text.erase(text.size() - 6);
+    }
+
+    const auto open = text.find('<');
+    std::vector<std::string> arguments;
+    if (open != std::string::npos && text.back() == '>') {
+        arguments = splitTemplateArguments(text);
+        text.erase(open);
+        trim(text);
+    }
+
+    Type type(text.empty() ? std::string("?") : text);
+    type.setConst(isConst);
+    type.setPointer(isPointer);
+    type.setReference(isReference);
+    type.setUnresolved();
+    for (auto& argument : arguments) {
+        type.addTemplateParameter(writtenType(std::move(argument)));
+    }
+    return type;
+}
+
+/**
+ * @brief El tipo escrito en una declaración (campo, parámetro o método):
+ *        los tokens anteriores a su nombre, sin especificadores.
+ */
+static Type declaredType(CXCursor cursor, const std::string& name) {
+    static const std::unordered_set<std::string> kSpecifiers = {
+        "virtual", "static", "inline", "explicit", "constexpr", "consteval", "mutable", "friend", "extern"};
+
+    const std::vector<std::string> tokens = cursorTokens(cursor);
+    std::size_t end = 0;
+    int depth = 0;
+    for (; end < tokens.size(); ++end) {
+        const std::string& token = tokens[end];
+        if (token == "<") {
+            ++depth;
+        } else if (token == ">") {
+            --depth;
+        } else if (token == ">>") {
+            depth -= 2;
+        } else if (depth <= 0 && (token == "(" || token == "=" || token == "[" ||
+                                  (token == name && (end + 1 == tokens.size() || tokens[end + 1] != "::")))) {
+            break;
+        }
+    }
+    std::size_t begin = 0;
+    while (begin < end && kSpecifiers.count(tokens[begin])) {
+        ++begin;
+    }
+    return writtenType(joinTokens(tokens, begin, end));
+}
+
+/**
+ * @brief Las bases escritas en la cabecera de una clase ("class A : public B,
+ *        ns::C<int>"), con su acceso (por defecto, el de 'defaultAccess').
+ */
+static std::vector<std::pair<std::string, Visibility>> writtenBases(CXCursor cursor, Visibility defaultAccess) {
+    std::vector<std::pair<std::string, Visibility>> bases;
+    const std::vector<std::string> tokens = cursorTokens(cursor);
+
+    // La lista de bases va del primer ':' de nivel 0 hasta el '{'.
+    std::size_t i = 0;
+    int depth = 0;
+    for (; i < tokens.size() && tokens[i] != "{"; ++i) {
+        if (tokens[i] == "<" || tokens[i] == "(") ++depth;
+        else if (tokens[i] == ">" || tokens[i] == ")") --depth;
+        else if (tokens[i] == ">>") depth -= 2;
+        else if (tokens[i] == ":" && depth <= 0) break;
+    }
+    if (i >= tokens.size() || tokens[i] != ":") {
+        return bases;
+    }
+
+    Visibility access = defaultAccess;
+    std::size_t start = ++i;
+    depth = 0;
+    for (; i <= tokens.size(); ++i) {
+        const bool atEnd = i == tokens.size() || (depth <= 0 && (tokens[i] == "," || tokens[i] == "{"));
+        if (!atEnd) {
+            const std::string& token = tokens[i];
+            if (token == "<" || token == "(") ++depth;
+            else if (token == ">" || token == ")") --depth;
+            else if (token == ">>") depth -= 2;
+            else if (i == start && (token == "public" || token == "protected" || token == "private")) {
+                access = token == "public" ? Visibility::Public
+                       : token == "protected" ? Visibility::Protected
+                       : Visibility::Private;
+                ++start;
+            } else if (i == start && token == "virtual") {
+                ++start;
+            }
+            continue;
+        }
+        std::string name = joinTokens(tokens, start, i);
+        if (!name.empty()) {
+            bases.emplace_back(std::move(name), access);
+        }
+        if (i == tokens.size() || tokens[i] == "{") break;
+        access = defaultAccess;
+        start = i + 1;
+    }
+    return bases;
+}
+
+/**
+ * @brief Namespaces de relleno para el modo 'skim'.
+ *
+ * Sin inclusiones, un nombre calificado desconocido ('ns::Tipo x;') es un
+ * error del que clang se recupera descartando la declaración entera; con
+ * 'ns' declarado la conserva con un tipo inválido, y el visitante recupera
+ * el texto escrito. Se declaran los prefijos de los nombres calificados del
+ * archivo, salvo a partir de un nombre que el propio archivo declara como
+ * clase, struct, union o enum (declararlo como namespace lo rompería).
+ *
+ * Dentro de un argumento de plantilla ('std::map<std::string, V>') clang no
+ * se recupera de un nombre desconocido y descarta la declaración, así que
+ * el último componente también se declara cuando puede ser un tipo:
+ * 'template <class...> class map;' si le sigue '<', 'class string;' si le
+ * sigue un nombre, '*', '&', ',', '>', ')' o ';' ('using Id = ns::Id;'). Si
+ * en realidad era un valor, la expresión sigue siendo un error del que clang
+ * se recupera igual. El visitante trata los tipos que usan estas
+ * declaraciones como no resueltos.
+ */
+static std::string skimPrelude(const std::string& text) {
+    static const std::unordered_set<std::string> kKeywords = {
+        "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch", "char", "char8_t", "char16_t",
+        "char32_t", "class", "concept", "const", "consteval", "constexpr", "constinit", "const_cast",
+        "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double",
+        "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend",
+        "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "nullptr",
+        "operator", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return",
+        "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+        "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+        "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while"};
+
+    struct Node {
+        std::map<std::string, Node> children;
+        std::map<std::string, bool> types; ///< Nombre -> es una plantilla
+    };
+    struct Chain {
+        std::vector<std::string> scopes;
+        std::string name;
+        char next = 0; ///< Carácter que sigue al nombre (0 = ninguno que indique un tipo)
+    };
+    Node root;
+    std::unordered_set<std::string> declared;
+    std::vector<Chain> chains;
+    std::vector<std::string> chain;
+    bool afterScope = false;
+    bool pendingDeclaration = false;
+
+    auto flush = [&](char next) {
+        if (chain.size() > 1) {
+            Chain qualified;
+            qualified.name = std::move(chain.back()); // El último componente es el nombre, no un namespace
+            chain.pop_back();
+            qualified.scopes = std::move(chain);
+            qualified.next = next;
+            chains.push_back(std::move(qualified));
+        }
+        chain.clear();
+        afterScope = false;
+    };
+
+    const std::size_t size = text.size();
+    for (std::size_t i = 0; i < size;) {
+        const char c = text[i];
+        if (c == '/' && i + 1 < size && text[i + 1] == '/') {
+            i = text.find('\n', i);
+            if (i == std::string::npos) break;
+        } else if (c == '/' && i + 1 < size && text[i + 1] == '*') {
+            i = text.find("*/", i + 2);
+            if (i == std::string::npos) break;
+            i += 2;
+        } else if (c == '"' || c == '\'') {
+            flush(0);
+            for (++i; i < size && text[i] != c && text[i] != '\n'; ++i) {
+                if (text[i] == '\\') ++i;
+            }
+            ++i;
+        } else if (c == '#') {
+            // Directivas del preprocesador (con sus líneas de continuación)
+            flush(0);
+            while (i < size && text[i] != '\n') {
+                i += (text[i] == '\\' && i + 1 < size) ? 2 : 1;
+            }
+        } else if (c == ':' && i + 1 < size && text[i + 1] == ':') {
+            afterScope = true;
+            i += 2;
+        } else if (isWordChar(c) && !std::isdigit(static_cast<unsigned char>(c))) {
+            const std::size_t start = i;
+            while (i < size && isWordChar(text[i])) ++i;
+            std::string word = text.substr(start, i - start);
+            if (word == "class" || word == "struct" || word == "union" || word == "enum") {
+                pendingDeclaration = true;
+            } else if (pendingDeclaration && !kKeywords.count(word)) {
+                declared.insert(word);
+                pendingDeclaration = false;
+            }
+            if (!afterScope) flush('a');
+            afterScope = false;
+            chain.push_back(std::move(word));
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else {
+            flush(c);
+            if (c != '[' && c != ']') pendingDeclaration = false; // 'class [[attr]] X'
+            ++i;
+        }
+    }
+    flush(0);
+
+    for (const auto& qualified : chains) {
+        Node* node = &root;
+        bool complete = true;
+        for (const auto& component : qualified.scopes) {
+            if (kKeywords.count(component) || declared.count(component)) {
+                complete = false;
+                break;
+            }
+            node = &node->children[component];
+        }
+        const char next = qualified.next;
+        const bool isType = next == '<' || next == 'a' || next == '*' || next == '&' || next == ',' || next == '>' ||
+                            next == ';' || next == ')';
+        if (complete && isType && !kKeywords.count(qualified.name) && !declared.count(qualified.name)) {
+            node->types[qualified.name] = node->types[qualified.name] || next == '<';
+        }
+    }
+
+    std::string prelude;
+    std::function<void(const Node&)> emit = [&](const Node& node) {
+        for (const auto& child : node.children) {
+            prelude += "namespace " + child.first + " { ";
+            emit(child.second);
+            prelude += "} ";
+        }
+        for (const auto& type : node.types) {
+            if (node.children.count(type.first)) continue; // Ya es un namespace
+            prelude += (type.second ? "template <class...> class " : "class ") + type.first + "; ";
+        }
+    };
+    emit(root);
+    return prelude;
+}
+
+// --- Conjunto de Inclusiones ---
+
+/**
+ * @brief Estado para 'clang_getInclusions': los archivos del proyecto
+ *        (no del sistema) que forman la TU, por ruta real y sin repetir.
+ */
+struct InclusionCollector {
+    CXTranslationUnit tu;
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> files;
+};
+
+static void inclusionVisitor(CXFile includedFile, CXSourceLocation* /*stack*/, unsigned /*depth*/,
+                             CXClientData client_data) {
+    auto* collector = static_cast<InclusionCollector*>(client_data);
+    if (clang_Location_isInSystemHeader(clang_getLocation(collector->tu, includedFile, 1, 1))) {
+        return;
+    }
+    std::string path = cx_to_std(clang_File_tryGetRealPathName(includedFile));
+    if (path.empty()) {
+        path = cx_to_std(clang_getFileName(includedFile));
+    }
+    if (collector->seen.insert(path).second) {
+        collector->files.push_back(std::move(path));
+    }
+}
+
+// --- Análisis Unity ---
+
+/**
+ * @brief Reparte las clases de un análisis unity entre las TUs de sus cabeceras.
+ *
+ * Cada cabecera del lote es dueña de sí misma; cualquier otro archivo del
+ * proyecto pertenece a la cabecera del lote que lo incluyó primero.
+ */
+struct UnitRouter {
+    std::unordered_map<CXFile, TranslationUnit*> owners;
+    TranslationUnit* fallback = nullptr; ///< Para lo que no cae en ningún archivo conocido
+
+    TranslationUnit* route(CXCursor cursor) const {
+        CXFile file = nullptr;
+        clang_getExpansionLocation(clang_getCursorLocation(cursor), &file, nullptr, nullptr, nullptr);
+        auto it = owners.find(file);
+        return it != owners.end() ? it->second : fallback;
+    }
+};
+
+/**
+ * @brief Estado para 'clang_getInclusions' en un lote unity: el conjunto de
+ *        inclusiones del lote y el dueño de cada archivo.
+ */
+struct UnityInclusions {
+    InclusionCollector collector;
+    UnitRouter& router;
+};
+
+static void unityInclusionVisitor(CXFile includedFile, CXSourceLocation* stack, unsigned depth,
+                                  CXClientData client_data) {
+    auto* state = static_cast<UnityInclusions*>(client_data);
+    if (depth == 0) {
+        return; // El archivo sintético no existe en disco
+    }
+    inclusionVisitor(includedFile, stack, depth, &state->collector);
+
+    // La pila va del #include más interno al del archivo sintético: el
+    // penúltimo está en la cabecera del lote que lo incluyó.
+    if (depth < 2) {
+        return;
+    }
+    CXFile includer = nullptr;
+    clang_getExpansionLocation(stack[depth - 2], &includer, nullptr, nullptr, nullptr);
+    auto owner = state->router.owners.find(includer);
+    if (owner != state->router.owners.end()) {
+        TranslationUnit* unit = owner->second;
+        state->router.owners.emplace(includedFile, unit);
+    }
+}
+
+// --- Clase Visitante de AST ---
 
 /**
  * @class AstVisitor
@@ -44,142 +703,784 @@ public:
     /**
      * @brief Construye el visitante.
      * @param tu Puntero al modelo de TranslationUnit que se está poblando.
+     * @param templates Instanciaciones memorizadas (compartidas entre TUs).
+     * @param filter Alcance del modelo (nullptr = todo).
+     * @param router Solo en un análisis unity: la TU de cada declaración de
+     *        primer nivel ('tu' es entonces solo la inicial).
+     */
+    AstVisitor(TranslationUnit* tu, TemplateCache& templates, const ScopeFilter* filter,
+               const UnitRouter* router = nullptr)
+        : m_tu(tu), m_templates(templates), m_filter(filter),
+          m_globalScope(filter ? filter->globalDecision() : ScopeDecision::Include), m_router(router) {}
+
+    /**
+     * @brief Modo 'skim': los tipos que clang no resolvió se toman del texto
+     *        escrito y las bases que descartó, de la cabecera de la clase.
+     * @param preludeBytes Longitud de los namespaces de relleno al principio
+     *        del archivo principal (no son parte del modelo).
      */
-    explicit AstVisitor(model::TranslationUnit* tu) : m_tu(tu) {}
+    void setSkim(unsigned preludeBytes) {
+        m_skim = true;
+        m_skimPrelude = preludeBytes;
+    }
 
     /**
-     * @brief El método de visita real que contiene la lógica.
+     * @brief El método de visita real: despacha el cursor a su manejador.
      * * Esta función es llamada por el "trampolín" estático.
+     *
+     * Se llama una vez por cursor del AST (millones en una TU grande, casi
+     * todos expresiones y sentencias que se ignoran), así que aquí solo se
+     * lee el tipo del cursor: el nombre, el tipo, el acceso y la ubicación
+     * los pide cada manejador, y solo si los necesita.
      */
-    CXChildVisitResult visitNode(CXCursor cursor, CXCursor parent) {
-        // 1. Obtener información básica del nodo
-        CXCursorKind kind = clang_getCursorKind(cursor);
-        std::string name = cx_to_std(clang_getCursorSpelling(cursor));
-        
-        // (Opcional: depuración)
-        // int depth = m_namespaceStack.size();
-        // std::cout << std::string(depth * 2, ' ') 
-        //           << "[Visit] Kind: " << clang_getCursorKindSpelling(kind)
-        //           << ", Name: " << name << "\n";
-
-        // 2. Lógica del Visitante basada en el estado
-        switch (kind) {
-            
-            case CXCursor_Namespace: {
-                auto ns = std::make_unique<model::Namespace>(name);
-                model::Namespace* nsPtr = ns.get();
-
-                // Añadir al padre (ya sea la TU o el namespace en la cima de la pila)
-                if (m_namespaceStack.empty()) {
-                    m_tu->addNamespace(std::move(ns));
-                } else {
-                    m_namespaceStack.top()->addNamespace(std::move(ns));
-                }
+    CXChildVisitResult visitNode(CXCursor cursor, CXCursor parent);
+
+private:
+    // --- Manejadores por Tipo de Cursor ---
+
+    using Handler = CXChildVisitResult (AstVisitor::*)(CXCursor cursor, CXCursor parent);
 
-                // --- Manejo de Estado y Recursión ---
-                m_namespaceStack.push(nsPtr); // PUSH
-                // Recurrimos manualmente
-                clang_visitChildren(cursor, LibClangParser::visitor, this); 
-                m_namespaceStack.pop(); // POP
-                // Le decimos a libclang que no vuelva a recurrir (ya lo hicimos)
+    /// Un manejador por CXCursorKind (los tipos más allá de la tabla se recorren).
+    using HandlerTable = std::array<Handler, CXCursor_OverloadCandidate + 1>;
+    static const HandlerTable s_handlers;
+
+    static constexpr HandlerTable makeHandlerTable() {
+        HandlerTable table{};
+        auto fill = [&table](int first, int last, Handler handler) {
+            for (int kind = first; kind <= last; ++kind) {
+                table[static_cast<std::size_t>(kind)] = handler;
+            }
+        };
+        // Expresiones, sentencias y el resto: pueden contener una clase local.
+        fill(0, CXCursor_OverloadCandidate, &AstVisitor::recurse);
+        // Hojas: nunca contienen declaraciones.
+        fill(CXCursor_FirstRef, CXCursor_LastRef, &AstVisitor::skip);
+        fill(CXCursor_FirstInvalid, CXCursor_LastInvalid, &AstVisitor::skip);
+        fill(CXCursor_FirstAttr, CXCursor_LastAttr, &AstVisitor::skip);
+        fill(CXCursor_FirstPreprocessing, CXCursor_LastPreprocessing, &AstVisitor::skip);
+        // Declaraciones sin manejador propio: se recorren salvo en cabeceras del sistema.
+        fill(CXCursor_FirstDecl, CXCursor_LastDecl, &AstVisitor::visitDeclaration);
+        fill(CXCursor_FirstExtraDecl, CXCursor_LastExtraDecl, &AstVisitor::visitDeclaration);
+
+        table[CXCursor_Namespace] = &AstVisitor::visitNamespace;
+        table[CXCursor_ClassDecl] = &AstVisitor::visitRecord;
+        table[CXCursor_StructDecl] = &AstVisitor::visitRecord;
+        table[CXCursor_UnionDecl] = &AstVisitor::visitRecord;
+        table[CXCursor_ClassTemplate] = &AstVisitor::visitRecord;
+        table[CXCursor_ClassTemplatePartialSpecialization] = &AstVisitor::visitRecord;
+        table[CXCursor_TemplateTypeParameter] = &AstVisitor::visitTemplateParameter;
+        table[CXCursor_NonTypeTemplateParameter] = &AstVisitor::visitTemplateParameter;
+        table[CXCursor_TemplateTemplateParameter] = &AstVisitor::visitTemplateParameter;
+        table[CXCursor_FieldDecl] = &AstVisitor::visitVariable;
+        table[CXCursor_VarDecl] = &AstVisitor::visitVariable;
+        table[CXCursor_CXXMethod] = &AstVisitor::visitMethod;
+        table[CXCursor_CXXBaseSpecifier] = &AstVisitor::visitBaseSpecifier;
+        return table;
+    }
+
+    static bool inSystemHeader(CXCursor cursor) {
+        // Las cabeceras del sistema (STL, etc.) no forman parte del diagrama.
+        return clang_Location_isInSystemHeader(clang_getCursorLocation(cursor)) != 0;
+    }
+
+    CXChildVisitResult recurse(CXCursor, CXCursor) { return CXChildVisit_Recurse; }
+    CXChildVisitResult skip(CXCursor, CXCursor) { return CXChildVisit_Continue; }
+
+    CXChildVisitResult visitDeclaration(CXCursor cursor, CXCursor) {
+        // No estamos manejando este nodo, pero queremos
+        // seguir visitando a sus hijos (ej. funciones, 'extern "C"')
+        return inSystemHeader(cursor) ? CXChildVisit_Continue : CXChildVisit_Recurse;
+    }
+
+    CXChildVisitResult visitNamespace(CXCursor cursor, CXCursor) {
+        if (inSystemHeader(cursor) || (m_skim && inPrelude(cursor))) {
+            return CXChildVisit_Continue;
+        }
+
+        // El marco de esta profundidad se reutiliza (con la memoria de sus
+        // nombres); solo cuenta como abierto al subir 'm_namespaceDepth'.
+        if (m_namespaceDepth == m_namespaceFrames.size()) {
+            m_namespaceFrames.emplace_back();
+        }
+        NamespaceFrame& frame = m_namespaceFrames[m_namespaceDepth];
+        cx_assign(clang_getCursorSpelling(cursor), frame.name);
+        frame.ns = nullptr;
+        frame.owner = nullptr;
+        frame.scope = ScopeDecision::Include;
+        if (m_filter) {
+            // Un namespace excluido se poda entero, sin crear nada.
+            if (m_namespaceDepth == 0) {
+                frame.qualifiedName.assign(frame.name);
+            } else {
+                frame.qualifiedName.assign(m_namespaceFrames[m_namespaceDepth - 1].qualifiedName)
+                                   .append("::").append(frame.name);
+            }
+            frame.scope = m_filter->namespaceDecision(frame.qualifiedName, currentScope());
+            if (frame.scope == ScopeDecision::Exclude) {
                 return CXChildVisit_Continue;
             }
+        }
+
+        if (m_router) {
+            m_tu = m_router->route(cursor);
+        }
+
+        // --- Manejo de Estado y Recursión ---
+        ++m_namespaceDepth; // PUSH
+        if (!m_filter) {
+            currentNamespace(); // Sin filtro se crea siempre (aunque quede vacío)
+        }
+        // Recurrimos manualmente ('frame' puede invalidarse: los hijos añaden marcos)
+        clang_visitChildren(cursor, visitorTrampoline, this);
+        --m_namespaceDepth; // POP
+        // Le decimos a libclang que no vuelva a recurrir (ya lo hicimos)
+        return CXChildVisit_Continue;
+    }
+
+    CXChildVisitResult visitRecord(CXCursor cursor, CXCursor) {
+        // Las declaraciones adelantadas no aportan miembros al diagrama.
+        if (inSystemHeader(cursor) || !clang_isCursorDefinition(cursor)) {
+            return CXChildVisit_Continue;
+        }
+        // El nombre se lee en un búfer reutilizado: una clase descartada
+        // por el filtro no reserva memoria.
+        cx_assign(clang_getCursorSpelling(cursor), m_spelling);
+
+        // Fuera del alcance: se descarta antes de crear la clase.
+        if (m_filter && !inScope(cursor, m_spelling)) {
+            return CXChildVisit_Continue;
+        }
+
+        // Una plantilla se modela una vez, como la clase que declara.
+        const CXCursorKind kind = clang_getCursorKind(cursor);
+        const bool isTemplate = kind == CXCursor_ClassTemplate ||
+                                kind == CXCursor_ClassTemplatePartialSpecialization;
+        const CXCursorKind declKind = isTemplate ? clang_getTemplateCursorKind(cursor) : kind;
+        const ClassKind classKind = declKind == CXCursor_StructDecl ? ClassKind::Struct
+                                  : declKind == CXCursor_UnionDecl  ? ClassKind::Union
+                                  : ClassKind::Class;
+
+        // Especializaciones (parciales o explícitas): se nombran con
+        // sus argumentos ("Container<T*>") y se enlazan a la primaria.
+        CXCursor primary = clang_getSpecializedCursorTemplate(cursor);
+        const bool isSpecialization = !clang_Cursor_isNull(primary);
+        auto newClass = std::make_unique<Class>(
+            isSpecialization ? cx_to_std(clang_getCursorDisplayName(cursor)) : m_spelling, classKind);
+        newClass->setVisibility(toVisibility(clang_getCXXAccessSpecifier(cursor)));
+        if (isSpecialization) {
+            newClass->setSpecializedTemplate(qualifiedName(primary));
+        }
+        Class* classPtr = newClass.get();
+
+        // Añadir al padre (el namespace en la cima de la pila), en la
+        // TU del archivo que la declara si el análisis es unity.
+        if (m_router && !m_currentClass) {
+            m_tu = m_router->route(cursor);
+        }
+        currentNamespace()->addMember(std::move(newClass));
+
+        // --- Manejo de Estado y Recursión ---
+        // Guardar el estado de la clase padre (para clases anidadas)
+        Class* stashedParentClass = m_currentClass;
+        m_currentClass = classPtr; // SET
+        ++m_classDepth;             // PUSH (su nombre calificado ya está en m_classNames)
+
+        clang_visitChildren(cursor, visitorTrampoline, this);
+        if (m_skim) {
+            addWrittenBases(cursor, classKind);
+        }
 
-            case CXCursor_ClassDecl:
-            case CXCursor_StructDecl: {
-                // TODO: Manejar declaraciones adelantadas (forward declarations)
-                // if (clang_isCursorDefinition(cursor) == 0) { ... }
-                
-                auto newClass = std::make_unique<model::Class>(name);
-                // TODO: newClass->setKind(kind == CXCursor_StructDecl ? ...);
-                model::Class* classPtr = newClass.get();
+        --m_classDepth;                     // POP
+        m_currentClass = stashedParentClass; // RESET
+        return CXChildVisit_Continue;
+    }
 
-                // Añadir al padre (ya sea la TU o el namespace en la cima de la pila)
-                if (m_namespaceStack.empty()) {
-                    m_tu->addClass(std::move(newClass));
+    CXChildVisitResult visitTemplateParameter(CXCursor cursor, CXCursor parent) {
+        // Solo los parámetros de la propia clase (no los de sus
+        // métodos plantilla, cuyo padre es un FunctionTemplate).
+        if (!m_currentClass) {
+            return CXChildVisit_Continue;
+        }
+        const CXCursorKind parentKind = clang_getCursorKind(parent);
+        if ((parentKind == CXCursor_ClassTemplate || parentKind == CXCursor_ClassTemplatePartialSpecialization) &&
+            !inSystemHeader(cursor)) {
+            m_currentClass->addTemplateParameter(makeTemplateParameter(cursor));
+        }
+        return CXChildVisit_Continue;
+    }
+
+    CXChildVisitResult visitVariable(CXCursor cursor, CXCursor parent) {
+        // Un VarDecl cuyo padre directo es la clase es un miembro estático
+        // (los VarDecl locales de constructores, etc. se ignoran).
+        if (!m_currentClass) {
+            return CXChildVisit_Continue;
+        }
+        const CXCursorKind kind = clang_getCursorKind(cursor);
+        const CXCursorKind parentKind = clang_getCursorKind(parent);
+        const bool isMember = kind == CXCursor_FieldDecl ||
+            parentKind == CXCursor_ClassDecl || parentKind == CXCursor_StructDecl ||
+            parentKind == CXCursor_UnionDecl || parentKind == CXCursor_ClassTemplate ||
+            parentKind == CXCursor_ClassTemplatePartialSpecialization;
+        if (isMember && !inSystemHeader(cursor) && memberVisible(cursor)) {
+            std::string name = cx_to_std(clang_getCursorSpelling(cursor));
+            Type type = declType(cursor, clang_getCursorType(cursor), name);
+            auto newField = std::make_unique<Field>(std::move(name), std::move(type));
+            newField->setVisibility(toVisibility(clang_getCXXAccessSpecifier(cursor)));
+            newField->setStatic(kind == CXCursor_VarDecl);
+            m_currentClass->addField(std::move(newField));
+        }
+        // (Nodo hoja, no hay recursión)
+        return CXChildVisit_Continue;
+    }
+
+    CXChildVisitResult visitMethod(CXCursor cursor, CXCursor) {
+        if (!m_currentClass || inSystemHeader(cursor) || !memberVisible(cursor)) {
+            return CXChildVisit_Continue;
+        }
+        std::string name = cx_to_std(clang_getCursorSpelling(cursor));
+        Type returnType = declType(cursor, clang_getCursorResultType(cursor), name);
+        auto newMethod = std::make_unique<Method>(std::move(name), std::move(returnType));
+        newMethod->setVisibility(toVisibility(clang_getCXXAccessSpecifier(cursor)));
+        newMethod->setStatic(clang_CXXMethod_isStatic(cursor) != 0);
+        newMethod->setConst(clang_CXXMethod_isConst(cursor) != 0);
+        newMethod->setVirtual(clang_CXXMethod_isVirtual(cursor) != 0);
+        if (clang_CXXMethod_isPureVirtual(cursor)) {
+            newMethod->setPureVirtual();
+        }
+
+        const int numArgs = clang_Cursor_getNumArguments(cursor);
+        for (int i = 0; i < numArgs; ++i) {
+            CXCursor arg = clang_Cursor_getArgument(cursor, static_cast<unsigned>(i));
+            std::string argName = cx_to_std(clang_getCursorSpelling(arg));
+            Type argType = declType(arg, clang_getCursorType(arg), argName);
+            newMethod->addParameter(std::make_unique<Field>(std::move(argName), std::move(argType)));
+        }
+        m_currentClass->addMethod(std::move(newMethod));
+        // (Nodo hoja, no hay recursión)
+        return CXChildVisit_Continue;
+    }
+
+    CXChildVisitResult visitBaseSpecifier(CXCursor cursor, CXCursor) {
+        if (!m_currentClass || inSystemHeader(cursor)) {
+            return CXChildVisit_Continue;
+        }
+        // Este nodo representa 'public BaseClass'
+        // El *nombre* está en el tipo; se guarda calificado para
+        // que SymbolResolver lo enlace aunque la base esté en otra TU.
+        const CXType baseType = clang_getCursorType(cursor);
+        if (m_skim && usesPrelude(baseType)) {
+            return CXChildVisit_Continue; // La añade 'addWrittenBases', como se escribió
+        }
+        typeOf(baseType); // Registra 'Base<int>' como instanciación
+        CXCursor baseDecl = clang_getTypeDeclaration(baseType);
+        std::string baseName = clang_Cursor_isNull(baseDecl)
+            ? cx_to_std(clang_getTypeSpelling(baseType))
+            : qualifiedName(baseDecl);
+        m_currentClass->addBaseClass(std::move(baseName),
+                                     toVisibility(clang_getCXXAccessSpecifier(cursor)));
+        return CXChildVisit_Continue;
+    }
+
+    /**
+     * @brief Un namespace abierto en el recorrido.
+     *
+     * Con filtro, el Namespace del modelo se crea al añadirle la primera
+     * clase: los namespaces que solo se atraviesan no dejan rastro.
+     */
+    struct NamespaceFrame {
+        std::string name;
+        Namespace* ns = nullptr;
+        ScopeDecision scope = ScopeDecision::Include;
+        std::string qualifiedName; ///< Solo con filtro
+        TranslationUnit* owner = nullptr; ///< TU en la que vive 'ns'
+    };
+
+    Namespace* currentNamespace() {
+        Namespace* parent = m_tu->getGlobalNamespace();
+        for (std::size_t depth = 0; depth < m_namespaceDepth; ++depth) {
+            NamespaceFrame& frame = m_namespaceFrames[depth];
+            if (!frame.ns || frame.owner != m_tu) {
+                // En un análisis unity el mismo bloque 'namespace' puede
+                // repartirse entre varias TUs: en cada una se abre una vez.
+                Namespace* existing = frame.ns ? findNamespace(parent, frame.name) : nullptr;
+                if (existing) {
+                    frame.ns = existing;
                 } else {
-                    m_namespaceStack.top()->addClass(std::move(newClass));
+                    auto ns = std::make_unique<Namespace>(frame.name);
+                    frame.ns = ns.get();
+                    parent->addMember(std::move(ns));
                 }
-                
-                // --- Manejo de Estado y Recursión ---
-                // Guardar el estado de la clase padre (para clases anidadas)
-                model::Class* stashedParentClass = m_currentClass; 
-                m_currentClass = classPtr; // SET
-                
-                clang_visitChildren(cursor, LibClangParser::visitor, this); 
-                
-                m_currentClass = stashedParentClass; // RESET
-                return CXChildVisit_Continue;
+                frame.owner = m_tu;
             }
+            parent = frame.ns;
+        }
+        return parent;
+    }
 
-            case CXCursor_FieldDecl: {
-                if (m_currentClass) {
-                    auto newField = std::make_unique<model::Field>(name);
-                    // TODO: Obtener visibilidad (clang_getCXXAccessSpecifier)
-                    // TODO: Obtener tipo (clang_getCursorType)
-                    m_currentClass->addField(std::move(newField));
-                }
-                // (Nodo hoja, no hay recursión)
-                return CXChildVisit_Continue;
+    static Namespace* findNamespace(Namespace* parent, const std::string& name) {
+        const auto& members = parent->getMembers();
+        for (auto it = members.rbegin(); it != members.rend(); ++it) {
+            if ((*it)->getKind() == ElementKind::Namespace && (*it)->getName() == name) {
+                return static_cast<Namespace*>(it->get());
             }
+        }
+        return nullptr;
+    }
 
-            case CXCursor_CXXMethod: {
-                if (m_currentClass) {
-                    auto newMethod = std::make_unique<model::Method>(name);
-                    // TODO: Obtener visibilidad, parámetros, tipo de retorno, etc.
-                    m_currentClass->addMethod(std::move(newMethod));
-                }
-                // (Nodo hoja, no hay recursión)
-                return CXChildVisit_Continue;
+    ScopeDecision currentScope() const {
+        return m_namespaceDepth == 0 ? m_globalScope : m_namespaceFrames[m_namespaceDepth - 1].scope;
+    }
+
+    // --- Filtro de Alcance ---
+
+    /**
+     * @brief Decide si una definición de clase entra en el modelo.
+     *
+     * Su nombre calificado queda en 'm_classNames[m_classDepth]' (para sus
+     * clases anidadas); los búferes de cada profundidad se reutilizan.
+     *
+     * De la comprobación más barata a la más cara: namespace (ya decidido),
+     * visibilidad, archivo (memorizado por CXFile) y expresiones regulares.
+     */
+    bool inScope(CXCursor cursor, const std::string& name) {
+        if (m_classDepth == m_classNames.size()) {
+            m_classNames.emplace_back();
+        }
+        std::string& qualified = m_classNames[m_classDepth];
+        if (m_currentClass) {
+            // Anidada: hereda el namespace y el archivo de la clase que la contiene.
+            if (!m_filter->acceptsVisibility(toVisibility(clang_getCXXAccessSpecifier(cursor)))) return false;
+            qualified.assign(m_classNames[m_classDepth - 1]).append("::").append(name);
+        } else {
+            if (currentScope() != ScopeDecision::Include) return false;
+            if (m_filter->filtersPaths() && !pathInScope(cursor)) return false;
+            if (m_namespaceDepth == 0) {
+                qualified.assign(name);
+            } else {
+                qualified.assign(m_namespaceFrames[m_namespaceDepth - 1].qualifiedName).append("::").append(name);
             }
-            
-            case CXCursor_CXXBaseSpecifier: {
-                 if (m_currentClass) {
-                    // Este nodo representa 'public BaseClass'
-                    // El *nombre* está en el tipo
-                    std::string baseName = cx_to_std(clang_getCursorTypeName(clang_getCursorType(cursor)));
-                    // TODO: Añadir relación de herencia al modelo
-                    // m_currentClass->addBaseClass(baseName, clang_getCXXAccessSpecifier(cursor));
-                    std::cout << "DEBUG: Clase " << m_currentClass->m_name << " hereda de " << baseName << std::endl;
-                 }
-                return CXChildVisit_Continue;
+        }
+        return !m_filter->filtersClasses() || m_filter->acceptsClass(qualified);
+    }
+
+    bool pathInScope(CXCursor cursor) {
+        CXFile file = nullptr;
+        clang_getExpansionLocation(clang_getCursorLocation(cursor), &file, nullptr, nullptr, nullptr);
+        auto it = m_pathDecisions.find(file);
+        if (it == m_pathDecisions.end()) {
+            const std::string path = file ? cx_to_std(clang_getFileName(file)) : std::string();
+            it = m_pathDecisions.emplace(file, m_filter->acceptsPath(path)).first;
+        }
+        return it->second;
+    }
+
+    // --- Modo 'skim' ---
+
+    bool inPrelude(CXCursor cursor) const {
+        unsigned offset = 0;
+        clang_getExpansionLocation(clang_getCursorLocation(cursor), nullptr, nullptr, nullptr, &offset);
+        return offset < m_skimPrelude;
+    }
+
+    /// Si el tipo (o uno de sus argumentos de plantilla) es una declaración de relleno.
+    bool usesPrelude(CXType type) const {
+        while (type.kind == CXType_LValueReference || type.kind == CXType_RValueReference ||
+               type.kind == CXType_Pointer) {
+            type = clang_getPointeeType(type);
+        }
+        const CXCursor decl = clang_getTypeDeclaration(type);
+        if (clang_isDeclaration(clang_getCursorKind(decl)) && inPrelude(decl)) {
+            return true;
+        }
+        const int count = clang_Type_getNumTemplateArguments(type);
+        for (int i = 0; i < count; ++i) {
+            const CXType argument = clang_Type_getTemplateArgumentAsType(type, static_cast<unsigned>(i));
+            if (argument.kind != CXType_Invalid && usesPrelude(argument)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief El tipo de una declaración. En modo 'skim', si la declaración es
+     *        inválida o usa el relleno, y lo escrito no coincide con lo que
+     *        entendió clang (que se recupera con 'int'), el texto escrito
+     *        marcado como no resuelto.
+     */
+    Type declType(CXCursor decl, CXType type, const std::string& name) {
+        if (!m_skim) {
+            return typeOf(type);
+        }
+        const bool known = type.kind != CXType_Invalid && !usesPrelude(type);
+        if (known && !clang_isInvalidDeclaration(decl)) {
+            return typeOf(type);
+        }
+        Type written = declaredType(decl, name);
+        if (known) {
+            Type parsed = typeOf(type);
+            if (parsed.getFullName() == written.getFullName()) {
+                return parsed; // Inválida por otra parte (p.ej., un parámetro)
+            }
+        }
+        return written;
+    }
+
+    /**
+     * @brief Añade las bases escritas que clang descartó por no conocerlas.
+     */
+    void addWrittenBases(CXCursor cursor, ClassKind kind) {
+        const Visibility defaultAccess = kind == ClassKind::Class ? Visibility::Private : Visibility::Public;
+        for (auto& base : writtenBases(cursor, defaultAccess)) {
+            // Las que clang resolvió ya están, con su nombre calificado
+            // (se comparan sin argumentos de plantilla).
+            const std::string written = base.first.substr(0, base.first.find('<'));
+            bool known = false;
+            for (const auto& existing : m_currentClass->getBaseClasses()) {
+                const std::string qualified = existing.baseName.substr(0, existing.baseName.find('<'));
+                known = qualified == written ||
+                        (qualified.size() > written.size() + 2 &&
+                         qualified.compare(qualified.size() - written.size(), written.size(), written) == 0 &&
+                         qualified.compare(qualified.size() - written.size() - 2, 2, "::") == 0);
+                if (known) break;
             }
+            if (!known) {
+                m_currentClass->addBaseClass(std::move(base.first), base.second);
+            }
+        }
+    }
+
+    bool memberVisible(CXCursor cursor) const {
+        return !m_filter || m_filter->acceptsVisibility(toVisibility(clang_getCXXAccessSpecifier(cursor)));
+    }
 
-            default:
-                // No estamos manejando este nodo, pero queremos
-                // seguir visitando a sus hijos (ej. TranslationUnit)
-                return CXChildVisit_Recurse;
+    /**
+     * @brief Como 'makeType', pero un uso de plantilla ('Container<int>') se
+     *        enlaza a su instanciación memorizada (plantilla primaria y
+     *        argumentos), sin copiarla.
+     */
+    Type typeOf(CXType cxType) {
+        Type type = makeType(cxType);
+        bool isReference = false;
+        bool isPointer = false;
+        std::shared_ptr<const TemplateBinding> binding = bindingFor(stripModifiers(cxType, isReference, isPointer));
+        if (!binding) {
+            return type;
         }
+
+        Type bound(std::string{});
+        bound.setBinding(std::move(binding));
+        bound.setConst(type.isConst());
+        bound.setPointer(type.isPointer());
+        bound.setReference(type.isReference());
+        return bound;
     }
 
-private:
-    model::TranslationUnit* m_tu;
-    std::stack<model::Namespace*> m_namespaceStack;
-    model::Class* m_currentClass = nullptr;
+    /**
+     * @brief Busca (o crea y memoriza) la instanciación de un tipo plantilla.
+     *
+     * La clave es el tipo canónico, así que 'Container<int>' escrito con
+     * alias o con los argumentos por defecto explícitos comparte entrada.
+     * Se registra en la TU una sola vez.
+     *
+     * @return nullptr si el tipo no es una especialización concreta.
+     */
+    std::shared_ptr<const TemplateBinding> bindingFor(CXType type) {
+        const int numArgs = clang_Type_getNumTemplateArguments(type);
+        if (numArgs <= 0) {
+            return nullptr;
+        }
+
+        const std::string canonical = cx_to_std(clang_getTypeSpelling(clang_getCanonicalType(type)));
+        auto it = m_templates.bindings.find(canonical);
+        if (it == m_templates.bindings.end()) {
+            // Los tipos dependientes ('Container<T>' dentro de otra plantilla)
+            // no son instanciaciones: se dejan como texto.
+            if (canonical.find("type-parameter-") != std::string::npos) {
+                return nullptr;
+            }
+            CXCursor primary = clang_getSpecializedCursorTemplate(clang_getTypeDeclaration(type));
+            if (clang_Cursor_isNull(primary)) {
+                return nullptr;
+            }
+
+            auto binding = std::make_shared<TemplateBinding>();
+            binding->canonicalName = canonical;
+            binding->templateName = qualifiedName(primary);
+            const std::vector<std::string> texts = splitTemplateArguments(canonical);
+            for (int i = 0; i < numArgs; ++i) {
+                CXType argument = clang_Type_getTemplateArgumentAsType(type, static_cast<unsigned>(i));
+                if (argument.kind != CXType_Invalid) {
+                    binding->arguments.push_back(typeOf(argument));
+                } else {
+                    // Argumento no-tipo (p.ej., '3'): solo se conserva su texto.
+                    const auto index = static_cast<std::size_t>(i);
+                    binding->arguments.emplace_back(index < texts.size() ? texts[index] : std::string("?"));
+                }
+            }
+
+            TemplateCache::Entry entry;
+            entry.binding = std::move(binding);
+            entry.fromSystemHeader = clang_Location_isInSystemHeader(clang_getCursorLocation(primary)) != 0;
+            it = m_templates.bindings.emplace(canonical, std::move(entry)).first;
+        }
+
+        const TemplateCache::Entry& entry = it->second;
+        if (!entry.fromSystemHeader && m_recordedBindings.emplace(m_tu, entry.binding.get()).second) {
+            m_tu->addTemplateBinding(entry.binding);
+        }
+        return entry.binding;
+    }
+
+    TranslationUnit* m_tu;
+    TemplateCache& m_templates;
+    std::set<std::pair<const TranslationUnit*, const TemplateBinding*>> m_recordedBindings; ///< Ya añadidas a cada TU
+    const ScopeFilter* m_filter;
+    ScopeDecision m_globalScope;
+    std::unordered_map<CXFile, bool> m_pathDecisions; ///< Filtro de rutas, una vez por archivo
+    std::vector<NamespaceFrame> m_namespaceFrames; ///< Por profundidad; solo crece y se reutiliza
+    std::size_t m_namespaceDepth = 0;              ///< Namespaces abiertos: los primeros marcos
+    Class* m_currentClass = nullptr;
+    std::vector<std::string> m_classNames; ///< Nombre calificado de cada clase abierta (solo con filtro); se reutiliza
+    std::size_t m_classDepth = 0;          ///< Clases abiertas (anidadas): los primeros nombres
+    std::string m_spelling;                ///< Búfer del nombre de la clase que se visita
+    const UnitRouter* m_router;
+    bool m_skim = false;
+    unsigned m_skimPrelude = 0; ///< Bytes de relleno al principio del archivo principal
 };
 
+// La tabla se construye en compilación: sin inicialización dinámica.
+const AstVisitor::HandlerTable AstVisitor::s_handlers = AstVisitor::makeHandlerTable();
+
+inline CXChildVisitResult AstVisitor::visitNode(CXCursor cursor, CXCursor parent) {
+    const auto kind = static_cast<std::size_t>(clang_getCursorKind(cursor));
+    if (kind >= s_handlers.size()) {
+        return CXChildVisit_Recurse; // Un tipo de cursor más nuevo que esta tabla
+    }
+    return (this->*s_handlers[kind])(cursor, parent);
+}
+
 
 // --- Constructor / Destructor ---
-// (Sin cambios)
 
-LibClangParser::LibClangParser() {
+LibClangParser::LibClangParser()
+    : m_templateCache(std::make_unique<TemplateCache>()),
+      m_liveUnits(std::make_unique<LiveUnits>()) {
     m_index = clang_createIndex(0, 1);
 }
 
 LibClangParser::~LibClangParser() {
+    m_liveUnits->clear(); // Las TUs deben liberarse antes que su índice
     clang_disposeIndex(m_index);
+    if (m_skimIndex) {
+        clang_disposeIndex(m_skimIndex);
+    }
+}
+
+void LibClangParser::setSkim(bool enabled) {
+    m_skim = enabled;
+    if (enabled && !m_skimIndex) {
+        // Sin mostrar diagnósticos: sin las inclusiones, los errores son lo esperado.
+        m_skimIndex = clang_createIndex(0, 0);
+    }
+}
+
+void LibClangParser::setKeepAlive(bool enabled, std::size_t maxBytes) {
+    m_keepAlive = enabled;
+    m_liveUnits->maxBytes = maxBytes;
+    if (!enabled) {
+        m_liveUnits->clear();
+    }
+}
+
+LiveUnitStats LibClangParser::liveUnitStats() const {
+    LiveUnitStats stats = m_liveUnits->stats;
+    stats.units = m_liveUnits->units.size();
+    return stats;
+}
+
+void LibClangParser::release(const std::string& sourceFile) {
+    m_liveUnits->dispose(sourceFile);
 }
 
 
-// --- Método de Análisis Principal (MODIFICADO) ---
+// --- Método de Análisis Principal ---
 
-std::unique_ptr<model::TranslationUnit> LibClangParser::parse(
+std::unique_ptr<TranslationUnit> LibClangParser::parse(
     const std::string& sourceFile,
     const std::vector<std::string>& compileArgs) {
+    return parse(sourceFile, std::vector<SourceBuffer>{}, compileArgs);
+}
 
-    // 1. Crear el objeto de modelo raíz
-    auto tuModel = std::make_unique<model::TranslationUnit>();
-    tuModel->m_name = sourceFile;
+std::unique_ptr<TranslationUnit> LibClangParser::parse(
+    const std::string& sourceFile,
+    const std::vector<SourceBuffer>& buffers,
+    const std::vector<std::string>& compileArgs) {
+
+    if (m_skim) {
+        return parseSkim(sourceFile, buffers, compileArgs);
+    }
+
+    bool owned = true;
+    CXTranslationUnit tu = acquireUnit(sourceFile, buffers, compileArgs, owned);
+    if (!tu) {
+        std::cerr << "Error: No se pudo analizar (parse) " << sourceFile << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<TranslationUnit> tuModel = buildModel(tu, sourceFile);
+
+    // Liberar la unidad de traducción (salvo que quede retenida)
+    if (owned) {
+        clang_disposeTranslationUnit(tu);
+    }
+    return tuModel;
+}
+
+std::unique_ptr<TranslationUnit> LibClangParser::parseSkim(
+    const std::string& sourceFile,
+    const std::vector<SourceBuffer>& buffers,
+    const std::vector<std::string>& compileArgs) {
+
+    // 1. El texto del archivo principal (de los buffers o del disco)
+    std::string text;
+    std::vector<SourceBuffer> skimBuffers;
+    bool inMemory = false;
+    for (const auto& buffer : buffers) {
+        if (buffer.path == sourceFile) {
+            text = buffer.contents;
+            inMemory = true;
+        } else {
+            skimBuffers.push_back(buffer);
+        }
+    }
+    if (!inMemory) {
+        std::ifstream in(sourceFile, std::ios::binary);
+        if (!in) {
+            std::cerr << "Error: No se pudo leer " << sourceFile << std::endl;
+            return nullptr;
+        }
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        text = contents.str();
+    }
+
+    // 2. Las declaraciones de relleno, delante del código ('#line' conserva
+    //    los números de línea del archivo).
+    std::string prelude = skimPrelude(text);
+    prelude += "\n#line 1\n";
+    const auto preludeBytes = static_cast<unsigned>(prelude.size());
+    skimBuffers.push_back({sourceFile, prelude + text});
+
+    // 3. Argumentos: C++ aunque sea un '.h', un estándar reciente si no se
+    //    indicó ninguno y sin advertencias (solo interesan las declaraciones).
+    std::vector<std::string> args = compileArgs;
+    bool hasLanguage = false;
+    bool hasStandard = false;
+    for (const auto& arg : args) {
+        hasLanguage = hasLanguage || arg.compare(0, 2, "-x") == 0;
+        hasStandard = hasStandard || arg.compare(0, 5, "-std=") == 0;
+    }
+    if (!hasLanguage) {
+        args.insert(args.begin(), {"-x", "c++"});
+    }
+    if (!hasStandard) {
+        args.push_back("-std=c++17");
+    }
+    args.push_back("-w");
+
+    std::vector<const char*> cArgs;
+    cArgs.reserve(args.size());
+    for (const auto& arg : args) {
+        cArgs.push_back(arg.c_str());
+    }
+    std::vector<CXUnsavedFile> unsaved = toUnsavedFiles(skimBuffers);
+
+    // 4. Sin inclusiones (SingleFileParse), sin cuerpos de funciones y sin
+    //    detenerse ante errores fatales.
+    const unsigned options = CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing |
+                             CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_SingleFileParse;
+    CXTranslationUnit tu = clang_parseTranslationUnit(
+        m_skimIndex,
+        sourceFile.c_str(),
+        cArgs.data(), static_cast<int>(cArgs.size()),
+        unsaved.data(), static_cast<unsigned>(unsaved.size()),
+        options
+    );
+    if (!tu) {
+        std::cerr << "Error: No se pudo analizar (parse) " << sourceFile << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<TranslationUnit> tuModel = buildModel(tu, sourceFile, preludeBytes);
+    clang_disposeTranslationUnit(tu);
+    return tuModel;
+}
+
+std::vector<std::unique_ptr<TranslationUnit>> LibClangParser::parseUnity(
+    const std::vector<std::string>& headers,
+    const std::vector<std::string>& compileArgs) {
+
+    std::vector<std::unique_ptr<TranslationUnit>> units;
+    if (headers.empty()) {
+        return units;
+    }
+
+    // 1. El archivo sintético: un #include por cabecera, con su ruta absoluta
+    //    (así no depende de dónde se ubique el archivo ni de los -I).
+    std::vector<std::string> paths;
+    paths.reserve(headers.size());
+    SourceBuffer unity;
+    for (const auto& header : headers) {
+        std::error_code ec;
+        const auto absolute = std::filesystem::absolute(header, ec);
+        paths.push_back(ec ? header : absolute.lexically_normal().string());
+        unity.contents += "#include \"" + paths.back() + "\"\n";
+    }
+    // Junto a la primera cabecera: las búsquedas relativas al archivo
+    // principal ven el mismo directorio que al analizarla sola.
+    unity.path = (std::filesystem::path(paths.front()).parent_path() /
+                  ("cppuml-unity-" + std::to_string(std::hash<std::string>{}(unity.contents)) + ".cpp")).string();
+
+    bool owned = true;
+    CXTranslationUnit tu = acquireUnit(unity.path, {unity}, compileArgs, owned);
+    if (!tu) {
+        std::cerr << "Error: No se pudo analizar (parse) el lote unity de " << headers.front()
+                  << " (" << headers.size() << " cabeceras)" << std::endl;
+        return units;
+    }
+
+    units = buildUnityModels(tu, headers, paths);
+
+    if (owned) {
+        clang_disposeTranslationUnit(tu);
+    }
+    return units;
+}
+
+CXTranslationUnit LibClangParser::acquireUnit(const std::string& sourceFile,
+                                              const std::vector<SourceBuffer>& buffers,
+                                              const std::vector<std::string>& compileArgs,
+                                              bool& owned) {
+    std::vector<CXUnsavedFile> unsaved = toUnsavedFiles(buffers);
+
+    // 1. Reutilizar una TU retenida: solo se relee lo que cambió
+    if (m_keepAlive) {
+        LiveUnits::Unit* unit = m_liveUnits->find(sourceFile);
+        if (unit && unit->compileArgs == compileArgs) {
+            CXTranslationUnit tu = unit->tu;
+            const int error = clang_reparseTranslationUnit(
+                tu, static_cast<unsigned>(unsaved.size()), unsaved.data(), clang_defaultReparseOptions(tu));
+            if (error == 0) {
+                ++m_liveUnits->stats.hits;
+                m_liveUnits->measure(*unit);
+                owned = !m_liveUnits->evict(sourceFile);
+                return tu;
+            }
+            // Tras un fallo la TU queda inservible: se descarta y se crea otra
+            m_liveUnits->dispose(sourceFile);
+        } else if (unit) {
+            m_liveUnits->dispose(sourceFile);
+        }
+    }
 
     // 2. Convertir argumentos
     std::vector<const char*> cArgs;
@@ -188,42 +1489,97 @@ std::unique_ptr<model::TranslationUnit> LibClangParser::parse(
         cArgs.push_back(arg.c_str());
     }
 
-    // 3. Analizar el archivo
+    // 3. Analizar el archivo. Las TUs retenidas precompilan su preámbulo ya en
+    //    el primer análisis, de modo que el segundo ya lo aprovecha.
+    const unsigned options = m_keepAlive
+        ? static_cast<unsigned>(CXTranslationUnit_PrecompiledPreamble | CXTranslationUnit_CreatePreambleOnFirstParse |
+                                CXTranslationUnit_CacheCompletionResults)
+        : static_cast<unsigned>(CXTranslationUnit_None);
     CXTranslationUnit tu = clang_parseTranslationUnit(
         m_index,
         sourceFile.c_str(),
         cArgs.data(), static_cast<int>(cArgs.size()),
-        nullptr, 0,
-        CXTranslationUnit_None
+        unsaved.data(), static_cast<unsigned>(unsaved.size()),
+        options
     );
 
-    if (!tu) {
-        std::cerr << "Error: No se pudo analizar (parse) " << sourceFile << std::endl;
-        return nullptr;
+    if (tu && m_keepAlive) {
+        ++m_liveUnits->stats.misses;
+        m_liveUnits->insert(sourceFile, tu, compileArgs);
+        m_liveUnits->measure(*m_liveUnits->find(sourceFile));
+        owned = !m_liveUnits->evict(sourceFile);
     }
+    return tu;
+}
+
+std::unique_ptr<TranslationUnit> LibClangParser::buildModel(CXTranslationUnit tu, const std::string& sourceFile,
+                                                            unsigned skimPrelude) {
 
-    // 4. Obtener el cursor raíz
+    // 1. Crear el objeto de modelo raíz
+    auto tuModel = std::make_unique<TranslationUnit>(sourceFile);
+
+    // 2. Obtener el cursor raíz
     CXCursor rootCursor = clang_getTranslationUnitCursor(tu);
 
-    // 5. *** CAMBIO PRINCIPAL ***
-    // Crear nuestro objeto visitante C++ con estado
-    AstVisitor visitorContext(tuModel.get());
+    // 3. Crear nuestro objeto visitante C++ con estado
+    AstVisitor visitorContext(tuModel.get(), *m_templateCache, m_filter.get());
+    if (m_skim) {
+        visitorContext.setSkim(skimPrelude);
+    }
 
     // Iniciar la visita recursiva.
     // Pasamos un puntero a nuestro 'visitorContext' como 'client_data'.
-    clang_visitChildren(rootCursor, visitor, &visitorContext);
+    clang_visitChildren(rootCursor, visitorTrampoline, &visitorContext);
 
-    // 6. Liberar la unidad de traducción
-    clang_disposeTranslationUnit(tu);
+    // 4. Registrar el conjunto de inclusiones (para la invalidación incremental)
+    InclusionCollector inclusions{tu, {}, {}};
+    clang_getInclusions(tu, inclusionVisitor, &inclusions);
+    tuModel->setIncludedFiles(std::move(inclusions.files));
 
     return tuModel;
 }
 
 
-// --- VISITOR (Trampolín) (MODIFICADO) ---
+std::vector<std::unique_ptr<TranslationUnit>> LibClangParser::buildUnityModels(
+    CXTranslationUnit tu,
+    const std::vector<std::string>& headers,
+    const std::vector<std::string>& paths) {
+
+    // 1. Una TU por cabecera, dueña de su propio archivo
+    std::vector<std::unique_ptr<TranslationUnit>> units;
+    units.reserve(headers.size());
+    UnitRouter router;
+    for (std::size_t i = 0; i < headers.size(); ++i) {
+        units.push_back(std::make_unique<TranslationUnit>(headers[i]));
+        CXFile file = clang_getFile(tu, paths[i].c_str());
+        if (file) {
+            router.owners.emplace(file, units.back().get());
+        }
+    }
+    router.fallback = units.front().get();
+
+    // 2. Inclusiones: el resto de archivos del proyecto se asignan a la
+    //    cabecera del lote que los incluyó primero.
+    UnityInclusions inclusions{{tu, {}, {}}, router};
+    clang_getInclusions(tu, unityInclusionVisitor, &inclusions);
+
+    // 3. Un solo recorrido del AST, repartiendo cada declaración de primer nivel
+    AstVisitor visitorContext(units.front().get(), *m_templateCache, m_filter.get(), &router);
+    clang_visitChildren(clang_getTranslationUnitCursor(tu), visitorTrampoline, &visitorContext);
+
+    // 4. Cada TU registra las inclusiones de todo el lote: un cambio en
+    //    cualquiera de ellas obliga a volver a analizar el lote entero.
+    for (auto& unit : units) {
+        unit->setIncludedFiles(inclusions.collector.files);
+    }
+    return units;
+}
+
+
+// --- VISITOR (Trampolín) ---
+
+static CXChildVisitResult visitorTrampoline(CXCursor cursor, CXCursor parent, CXClientData client_data) {
 
-CXChildVisitResult LibClangParser::visitor(CXCursor cursor, CXCursor parent, void* client_data) {
-    
     // 1. Re-castear el 'client_data' a nuestro objeto visitante C++
     AstVisitor* context = static_cast<AstVisitor*>(client_data);
 
@@ -233,4 +1589,4 @@ CXChildVisitResult LibClangParser::visitor(CXCursor cursor, CXCursor parent, voi
 
 
 } // namespace parser
-} // namespace cppuml
\ No newline at end of file
+} // namespace cppuml
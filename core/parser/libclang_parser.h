@@ -1,21 +1,46 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <memory>
 #include "model/TranslationUnit.h"
+#include "scope_filter.h"
 
 // --- Ocultación de la API de C ---
 // Declaramos por adelantado los tipos opacos de libclang.
-typedef struct CXIndexImpl* CXIndex;
+// (Deben coincidir exactamente con <clang-c/Index.h>.)
+typedef void* CXIndex;
 typedef struct CXTranslationUnitImpl* CXTranslationUnit;
-// Usamos una definición de puntero vacío para el cursor
-typedef struct CXCursor { void* _data[3]; } CXCursor; 
-enum CXChildVisitResult; // Declaración por adelantado de la enumeración
 
 namespace cppuml {
 namespace parser {
 
+struct TemplateCache; // Memoria de instanciaciones (definida en el .cpp)
+struct LiveUnits;     // TUs de libclang mantenidas vivas (definida en el .cpp)
+
+/**
+ * @brief Contenido en memoria de un archivo, que reemplaza al del disco.
+ *
+ * Se entrega a libclang como 'CXUnsavedFile': un editor puede analizar el
+ * texto que el usuario aún no guardó sin escribir archivos temporales.
+ */
+struct SourceBuffer {
+    std::string path;     ///< Ruta del archivo que se reemplaza (la misma que ve el #include)
+    std::string contents; ///< Texto completo del archivo
+};
+
+/**
+ * @brief Estado de la caché de TUs vivas (ver 'setKeepAlive').
+ */
+struct LiveUnitStats {
+    std::size_t units = 0;     ///< TUs retenidas
+    std::size_t bytes = 0;     ///< Memoria que libclang declara para ellas
+    std::size_t hits = 0;      ///< Análisis resueltos con 'clang_reparseTranslationUnit'
+    std::size_t misses = 0;    ///< Análisis que crearon una TU nueva
+    std::size_t evictions = 0; ///< TUs liberadas por exceder el límite de memoria
+};
+
 /**
  * @class LibClangParser
  * @brief Un adaptador que envuelve la API C de libclang.
@@ -52,25 +77,179 @@ public:
      * @param compileArgs Una lista de argumentos del compilador (ej. "-I/include").
      * @return Un puntero único a nuestro modelo de TranslationUnit poblado.
      */
-    std::unique_ptr<model::TranslationUnit> parse(
+    std::unique_ptr<TranslationUnit> parse(
         const std::string& sourceFile,
         const std::vector<std::string>& compileArgs = {});
 
-private:
     /**
-     * @brief El 'callback' visitante de libclang.
+     * @brief Analiza un archivo usando contenidos en memoria.
+     *
+     * Cada buffer reemplaza al archivo del disco con la misma ruta; puede ser
+     * el propio 'sourceFile' o cualquier cabecera que incluya. El resto de
+     * archivos se leen del disco como siempre.
+     *
+     * @param sourceFile La ruta del archivo principal (aunque no exista en disco).
+     * @param buffers Los archivos reemplazados.
+     * @param compileArgs Los argumentos del compilador.
+     * @return El modelo de la TU, o nullptr si libclang no pudo analizarla.
+     */
+    std::unique_ptr<TranslationUnit> parse(
+        const std::string& sourceFile,
+        const std::vector<SourceBuffer>& buffers,
+        const std::vector<std::string>& compileArgs = {});
+
+    /**
+     * @brief Analiza un lote de cabeceras como una sola TU sintética ("unity").
      *
-     * Función estática que se llama por cada nodo en el AST.
-     * Redirige al visitante C++orientado a objetos ('AstVisitor').
+     * Las cabeceras sin un .cpp que las incluya se analizan una a una, y
+     * cada análisis vuelve a leer las mismas cabeceras del sistema. Aquí se
+     * entrega a libclang un archivo en memoria que solo hace '#include' de
+     * cada cabecera del lote, de modo que lo común se analiza una vez.
      *
-     * @param client_data Un puntero a nuestro objeto 'AstVisitor'.
+     * Cada clase se atribuye a la TU de la cabecera que la declara (por la
+     * ubicación de su cursor); las de otros archivos del proyecto, a la
+     * cabecera del lote que los incluyó primero. Todas las TUs registran las
+     * inclusiones del lote entero.
+     *
+     * Las cabeceras deben poder compilarse juntas con los mismos argumentos:
+     * dos con la misma guarda de inclusión, o que definen macros que alteran
+     * a las siguientes, no dan el mismo resultado que por separado.
+     *
+     * @param headers Las cabeceras del lote.
+     * @param compileArgs Los argumentos del compilador (comunes a todo el lote).
+     * @return Una TU por cabecera, en el orden de 'headers'; vacío si libclang
+     *         no pudo analizar el lote.
+     */
+    std::vector<std::unique_ptr<TranslationUnit>> parseUnity(
+        const std::vector<std::string>& headers,
+        const std::vector<std::string>& compileArgs = {});
+
+    /**
+     * @brief Mantiene vivas las TUs de libclang entre llamadas a 'parse'.
+     *
+     * Con el modo activo, volver a analizar el mismo archivo (con los mismos
+     * argumentos) usa 'clang_reparseTranslationUnit': el preámbulo de
+     * cabeceras no modificadas se reutiliza en lugar de volver a leerse.
+     * Desactivarlo libera las TUs retenidas.
+     *
+     * Las TUs se guardan en una caché LRU: cuando la memoria que libclang
+     * declara para ellas supera 'maxBytes', se liberan las menos usadas.
+     * Solo las cabeceras del bloque inicial de #include forman el preámbulo
+     * precompilado; un #include tras código se vuelve a leer en cada análisis.
+     */
+    void setKeepAlive(bool enabled, std::size_t maxBytes = kDefaultLiveUnitBytes);
+
+    /**
+     * @brief Límite por defecto de la caché de TUs vivas (1 GiB).
+     */
+    static constexpr std::size_t kDefaultLiveUnitBytes = std::size_t(1) << 30;
+
+    /**
+     * @brief Estadísticas de la caché de TUs vivas.
+     */
+    LiveUnitStats liveUnitStats() const;
+
+    /**
+     * @brief Indica si el modo de TUs vivas está activo.
      */
-    static CXChildVisitResult visitor(CXCursor cursor, CXCursor parent, void* client_data);
+    bool keepAlive() const { return m_keepAlive; }
+
+    /**
+     * @brief Libera una TU retenida (p.ej., el editor cerró el archivo).
+     */
+    void release(const std::string& sourceFile);
+
+    /**
+     * @brief Modo 'skim': un diagrama estructural rápido sin una configuración
+     *        de compilación que funcione.
+     *
+     * Cada archivo se analiza solo, sin sus inclusiones (SingleFileParse),
+     * sin cuerpos de funciones y sin detenerse ante errores (Incomplete,
+     * KeepGoing); los diagnósticos no se muestran. Se conservan las clases,
+     * sus miembros y los nombres de sus bases declarados en el propio
+     * archivo:
+     *   - un tipo que clang no conoce se guarda como se escribió, marcado
+     *     con 'Type::isUnresolved';
+     *   - una base desconocida, que clang descarta, se lee de la cabecera
+     *     de la clase;
+     *   - los prefijos de los nombres calificados ('ns::' en 'ns::Tipo') se
+     *     declaran como namespaces delante del código, y 'Tipo' dentro de
+     *     ellos como clase o plantilla sin definir, para que clang no
+     *     descarte la declaración entera; los tipos que las usan se guardan
+     *     también como se escribieron.
+     * Sin '-x' ni '-std' en los argumentos se analiza como C++17. Las TUs
+     * vivas y los lotes unity no se usan en este modo.
+     */
+    void setSkim(bool enabled);
+
+    bool skim() const { return m_skim; }
+
+    /**
+     * @brief Limita el modelo a un alcance (namespaces, rutas, clases, visibilidad).
+     *
+     * El filtro se aplica durante el recorrido del AST: lo excluido no llega
+     * a crearse. nullptr (por defecto) = todo.
+     */
+    void setFilter(std::shared_ptr<const ScopeFilter> filter) { m_filter = std::move(filter); }
+
+private:
+    /**
+     * @brief Obtiene la TU de libclang para 'sourceFile': una retenida
+     *        (re-analizada con los buffers) o una nueva.
+     * @param owned Se pone a true si el llamador debe liberar la TU.
+     */
+    CXTranslationUnit acquireUnit(const std::string& sourceFile,
+                                  const std::vector<SourceBuffer>& buffers,
+                                  const std::vector<std::string>& compileArgs,
+                                  bool& owned);
+
+    /**
+     * @brief Análisis en modo 'skim' (ver 'setSkim').
+     */
+    std::unique_ptr<TranslationUnit> parseSkim(const std::string& sourceFile,
+                                               const std::vector<SourceBuffer>& buffers,
+                                               const std::vector<std::string>& compileArgs);
+
+    /**
+     * @brief Recorre una TU ya analizada y construye el modelo.
+     * @param skimPrelude En modo 'skim', los bytes de relleno al principio del archivo.
+     */
+    std::unique_ptr<TranslationUnit> buildModel(CXTranslationUnit tu, const std::string& sourceFile,
+                                                unsigned skimPrelude = 0);
+
+    /**
+     * @brief Recorre la TU de un lote unity y reparte sus clases por cabecera.
+     * @param paths Las rutas absolutas con que el archivo sintético incluye cada cabecera.
+     */
+    std::vector<std::unique_ptr<TranslationUnit>> buildUnityModels(CXTranslationUnit tu,
+                                                                  const std::vector<std::string>& headers,
+                                                                  const std::vector<std::string>& paths);
+
+    // El 'callback' visitante de libclang (trampolín hacia 'AstVisitor')
+    // vive en el .cpp para no exponer CXCursor en esta cabecera.
 
     /**
      * @brief El índice principal de libclang, inicializado en el constructor.
      */
     CXIndex m_index;
+
+    /**
+     * @brief Instanciaciones de plantillas ya descompuestas, por tipo canónico.
+     * Persiste entre llamadas a 'parse': una especialización vista en miles
+     * de TUs se analiza y se almacena una sola vez.
+     */
+    std::unique_ptr<TemplateCache> m_templateCache;
+
+    /**
+     * @brief TUs retenidas por ruta (solo con 'setKeepAlive(true)').
+     */
+    std::unique_ptr<LiveUnits> m_liveUnits;
+    bool m_keepAlive = false;
+
+    std::shared_ptr<const ScopeFilter> m_filter;
+
+    bool m_skim = false;
+    CXIndex m_skimIndex = nullptr; ///< Sin diagnósticos en pantalla (solo en modo 'skim')
 };
 
 } // namespace parser
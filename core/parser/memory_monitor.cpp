@@ -0,0 +1,100 @@
+#include "memory_monitor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace cppuml {
+namespace parser {
+namespace memory {
+
+namespace {
+
+/// Valor en kB de un campo "Nombre:   123 kB" de /proc, en bytes.
+std::size_t readKilobytesField(const std::string& path, const std::string& field) {
+    std::ifstream in(path);
+    for (std::string line; std::getline(in, line);) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return static_cast<std::size_t>(std::strtoull(line.c_str() + field.size(), nullptr, 10)) << 10;
+        }
+    }
+    return 0;
+}
+
+/// Un límite de cgroup en bytes ("max" o un valor enorme = sin límite).
+std::size_t readLimit(const std::string& path) {
+    std::ifstream in(path);
+    std::string value;
+    if (!(in >> value) || value == "max") return 0;
+    const unsigned long long limit = std::strtoull(value.c_str(), nullptr, 10);
+    return limit >= (1ULL << 60) ? 0 : static_cast<std::size_t>(limit);
+}
+
+} // namespace
+
+std::size_t residentBytes(pid_t pid) {
+    const std::string proc = "/proc/" + std::to_string(pid);
+    if (const std::size_t pss = readKilobytesField(proc + "/smaps_rollup", "Pss:")) {
+        return pss;
+    }
+    std::ifstream statm(proc + "/statm");
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    if (!(statm >> size >> resident)) return 0;
+    return static_cast<std::size_t>(resident) * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+std::size_t currentResidentBytes() {
+    return readKilobytesField("/proc/self/status", "VmRSS:");
+}
+
+std::size_t peakResidentBytes() {
+    return readKilobytesField("/proc/self/status", "VmHWM:");
+}
+
+bool resetPeakResident() {
+    std::ofstream out("/proc/self/clear_refs");
+    out << "5"; // Linux >= 4.0: reinicia VmHWM al RSS actual
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+void trimHeap() {
+#if defined(__GLIBC__)
+    ::malloc_trim(0);
+#endif
+}
+
+std::size_t containerLimitBytes() {
+    std::size_t limit = readKilobytesField("/proc/meminfo", "MemTotal:");
+    auto tighten = [&](std::size_t candidate) {
+        if (candidate > 0 && (limit == 0 || candidate < limit)) limit = candidate;
+    };
+
+    // cgroup v2: el límite efectivo es el menor de la jerarquía del proceso.
+    std::ifstream cgroups("/proc/self/cgroup");
+    for (std::string line; std::getline(cgroups, line);) {
+        if (line.compare(0, 3, "0::") == 0) {
+            for (std::string path = line.substr(3); !path.empty();) {
+                tighten(readLimit("/sys/fs/cgroup" + (path == "/" ? std::string() : path) + "/memory.max"));
+                if (path == "/") break;
+                const auto slash = path.rfind('/');
+                path = slash == 0 ? "/" : path.substr(0, slash);
+            }
+        }
+    }
+    // cgroup v1 (dentro del contenedor, la jerarquía propia se monta en la raíz).
+    tighten(readLimit("/sys/fs/cgroup/memory/memory.limit_in_bytes"));
+    return limit;
+}
+
+} // namespace memory
+} // namespace parser
+} // namespace cppuml
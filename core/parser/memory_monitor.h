@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+#include <sys/types.h>
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Lectura de la memoria de procesos y del límite del contenedor (Linux, /proc y cgroups).
+ *
+ * Todas las funciones devuelven 0 si el dato no está disponible, de modo
+ * que en otros sistemas el control de admisión se apoya solo en las
+ * estimaciones.
+ */
+namespace memory {
+
+/**
+ * @brief Memoria residente de un proceso, en bytes.
+ *
+ * Usa el PSS (las páginas compartidas se reparten entre quienes las
+ * comparten) si el kernel lo expone: los trabajadores creados con fork()
+ * comparten las páginas del padre y sumar su RSS las contaría varias veces.
+ */
+std::size_t residentBytes(pid_t pid);
+
+/**
+ * @brief Memoria residente del proceso actual (VmRSS), en bytes.
+ */
+std::size_t currentResidentBytes();
+
+/**
+ * @brief Pico de memoria residente del proceso actual (VmHWM), en bytes.
+ */
+std::size_t peakResidentBytes();
+
+/**
+ * @brief Reinicia el pico de memoria residente del proceso actual.
+ * @return false si el kernel no lo permite (el pico es entonces acumulado).
+ */
+bool resetPeakResident();
+
+/**
+ * @brief Devuelve al sistema la memoria libre del heap (tras liberar una TU).
+ */
+void trimHeap();
+
+/**
+ * @brief Límite de memoria del contenedor (cgroup v2 o v1) o, si no tiene,
+ *        la memoria física total.
+ */
+std::size_t containerLimitBytes();
+
+} // namespace memory
+
+} // namespace parser
+} // namespace cppuml
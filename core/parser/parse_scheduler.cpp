@@ -0,0 +1,213 @@
+#include "parse_scheduler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <system_error>
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+constexpr const char* kHeader = "cppuml-parse-timings 2";
+constexpr const char* kHeaderV1 = "cppuml-parse-timings 1"; ///< Sin columna de memoria
+
+/// Peso de la medición nueva en la media móvil.
+constexpr double kSmoothing = 0.5;
+
+/// Ratio por defecto cuando aún no hay ninguna TU con historial.
+constexpr double kDefaultSecondsPerByte = 1e-6;
+
+struct Simulation {
+    double makespan = 0.0;
+    double tailIdle = 0.0;
+};
+
+/**
+ * @brief Simula el despacho voraz del ProcessPool: cada trabajo va al
+ *        primer trabajador que queda libre.
+ */
+Simulation simulate(const std::vector<std::size_t>& order, const std::vector<double>& cost, unsigned workers) {
+    std::priority_queue<double, std::vector<double>, std::greater<double>> finish;
+    for (unsigned i = 0; i < workers; ++i) finish.push(0.0);
+    for (std::size_t index : order) {
+        const double start = finish.top();
+        finish.pop();
+        finish.push(start + cost[index]);
+    }
+
+    std::vector<double> ends;
+    while (!finish.empty()) {
+        ends.push_back(finish.top());
+        finish.pop();
+    }
+    Simulation result;
+    result.makespan = ends.empty() ? 0.0 : ends.back();
+    for (double end : ends) result.tailIdle += result.makespan - end;
+    return result;
+}
+
+} // namespace
+
+// --- Persistencia ---
+//
+// Formato (texto): cabecera y una línea "<segundos>\t<bytes>\t<ruta normalizada>"
+// por TU. La versión 1 no tenía la columna de bytes.
+
+bool ParseScheduler::load(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || (line != kHeader && line != kHeaderV1)) {
+        return false;
+    }
+    const bool withBytes = line == kHeader;
+
+    std::unordered_map<std::string, History> loaded;
+    while (std::getline(in, line)) {
+        const auto tab = line.find('\t');
+        const auto second = withBytes && tab != std::string::npos ? line.find('\t', tab + 1) : tab;
+        if (second == std::string::npos) return false;
+        try {
+            History& entry = loaded[line.substr(second + 1)];
+            entry.seconds = std::stod(line.substr(0, tab));
+            if (withBytes) entry.bytes = std::stod(line.substr(tab + 1, second - tab - 1));
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    m_history = std::move(loaded);
+    return true;
+}
+
+bool ParseScheduler::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: no se pudieron guardar los tiempos de análisis en " << path << std::endl;
+        return false;
+    }
+    out << kHeader << '\n';
+    for (const auto& entry : m_history) {
+        out << entry.second.seconds << '\t' << static_cast<unsigned long long>(entry.second.bytes) << '\t'
+            << entry.first << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+// --- Planificación ---
+
+ParseSchedule ParseScheduler::plan(const std::vector<ParseJob>& jobs, unsigned workers,
+                                   const IncludeGraph* graph) const {
+    ParseSchedule schedule;
+    const std::size_t n = jobs.size();
+    schedule.estimates.assign(n, 0.0);
+    schedule.memoryEstimates.assign(n, 0);
+    if (workers == 0) workers = 1;
+
+    // 1. Coste histórico y medidas de respaldo (tamaño, inclusiones).
+    std::vector<bool> known(n, false);
+    std::vector<double> bytes(n, 0.0);
+    std::vector<double> includes(n, 0.0);
+    double knownSeconds = 0.0, knownBytes = 0.0;
+    double includeSeconds = 0.0, knownIncludes = 0.0;
+    double knownMemory = 0.0, memoryBytes = 0.0; // Solo las TUs con pico medido
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!jobs[i].unityHeaders.empty()) {
+            // Lote unity: sin historial propio; el tiempo escala con el de sus
+            // cabeceras por separado (una cota superior) y la memoria es la
+            // prevista por el UnityBatcher.
+            for (const auto& header : jobs[i].unityHeaders) {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(header, ec);
+                bytes[i] += ec ? 0.0 : static_cast<double>(size);
+                if (graph) includes[i] += static_cast<double>(graph->includeCount(header));
+            }
+            schedule.memoryEstimates[i] = jobs[i].expectedBytes;
+            continue;
+        }
+
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(jobs[i].sourceFile, ec);
+        bytes[i] = ec ? 0.0 : static_cast<double>(size);
+        if (graph) includes[i] = static_cast<double>(graph->includeCount(jobs[i].sourceFile));
+
+        auto it = m_history.find(IncludeGraph::normalize(jobs[i].sourceFile));
+        if (it == m_history.end()) continue;
+        known[i] = true;
+        schedule.estimates[i] = it->second.seconds;
+        ++schedule.estimatedFromHistory;
+        knownSeconds += it->second.seconds;
+        knownBytes += bytes[i];
+        if (includes[i] > 0) {
+            includeSeconds += it->second.seconds;
+            knownIncludes += includes[i];
+        }
+        if (it->second.bytes > 0) {
+            schedule.memoryEstimates[i] = static_cast<std::size_t>(it->second.bytes);
+            knownMemory += it->second.bytes;
+            memoryBytes += bytes[i];
+        }
+    }
+
+    // 2. TUs nuevas: se escalan con el ratio observado en las conocidas.
+    const double perByte = knownBytes > 0 ? knownSeconds / knownBytes : kDefaultSecondsPerByte;
+    const double perInclude = knownIncludes > 0 ? includeSeconds / knownIncludes : 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (known[i]) continue;
+        schedule.estimates[i] = (includes[i] > 0 && perInclude > 0) ? includes[i] * perInclude
+                                                                     : bytes[i] * perByte;
+    }
+    // Memoria: las TUs sin pico medido escalan el de las medidas con el tamaño
+    // del archivo (sin ninguna medida queda en 0 y el pool reparte a partes iguales).
+    if (knownMemory > 0 && memoryBytes > 0) {
+        const double memoryPerByte = knownMemory / memoryBytes;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (schedule.memoryEstimates[i] == 0) {
+                schedule.memoryEstimates[i] = static_cast<std::size_t>(bytes[i] * memoryPerByte);
+            }
+        }
+    }
+
+    // 3. Orden LPT (estable: a igual coste se respeta el orden de entrada).
+    std::vector<std::size_t> naive(n);
+    std::iota(naive.begin(), naive.end(), 0);
+    schedule.order = naive;
+    std::stable_sort(schedule.order.begin(), schedule.order.end(), [&](std::size_t a, std::size_t b) {
+        return schedule.estimates[a] > schedule.estimates[b];
+    });
+
+    const Simulation lpt = simulate(schedule.order, schedule.estimates, workers);
+    schedule.expectedMakespanSeconds = lpt.makespan;
+    schedule.expectedTailIdleSeconds = lpt.tailIdle;
+    schedule.naiveMakespanSeconds = simulate(naive, schedule.estimates, workers).makespan;
+    return schedule;
+}
+
+void ParseScheduler::record(const std::vector<ParseJob>& jobs, const ProcessPoolReport& report) {
+    const std::size_t n = std::min(jobs.size(), report.jobSeconds.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const double measured = report.jobSeconds[i];
+        if (measured <= 0.0) continue; // No llegó a ejecutarse
+        if (!jobs[i].unityHeaders.empty()) continue; // Un lote no dice cuánto cuesta cada cabecera sola
+        const double peak = i < report.jobPeakBytes.size() ? static_cast<double>(report.jobPeakBytes[i]) : 0.0;
+
+        auto inserted = m_history.emplace(IncludeGraph::normalize(jobs[i].sourceFile), History{measured, peak});
+        if (!inserted.second) {
+            History& entry = inserted.first->second;
+            entry.seconds = (1.0 - kSmoothing) * entry.seconds + kSmoothing * measured;
+            if (peak > 0) {
+                // La memoria no se suaviza hacia abajo: subestimarla es lo que provoca un OOM.
+                entry.bytes = entry.bytes > 0 ? std::max(peak, (1.0 - kSmoothing) * entry.bytes + kSmoothing * peak)
+                                              : peak;
+            }
+        }
+    }
+}
+
+} // namespace parser
+} // namespace cppuml
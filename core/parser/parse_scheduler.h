@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include_graph.h"
+#include "process_pool.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Un plan de ejecución: el orden de despacho y su coste previsto.
+ */
+struct ParseSchedule {
+    std::vector<std::size_t> order;     ///< Índices de los trabajos originales, en orden de despacho
+    std::vector<double> estimates;      ///< Segundos estimados por trabajo (orden original)
+    std::vector<std::size_t> memoryEstimates; ///< Bytes estimados por trabajo (orden original; 0 = sin datos)
+    std::size_t estimatedFromHistory = 0;
+    double expectedMakespanSeconds = 0.0;
+    double expectedTailIdleSeconds = 0.0;
+    double naiveMakespanSeconds = 0.0;  ///< El mismo cálculo con el orden de entrada
+};
+
+/**
+ * @class ParseScheduler
+ * @brief Ordena las TUs de mayor a menor coste (LPT) usando tiempos históricos.
+ *
+ * Con N trabajadores, unas pocas TUs gigantes que empiezan tarde dejan a los
+ * demás núcleos ociosos al final. Despachar primero las más costosas acota
+ * el makespan a ~4/3 del óptimo.
+ *
+ * El coste de cada TU es el tiempo medido en ejecuciones anteriores
+ * (media móvil). Para las TUs nunca vistas se estima a partir del número de
+ * inclusiones (si el IncludeGraph lo conoce) o del tamaño del archivo,
+ * con el ratio segundos/unidad observado en las TUs conocidas.
+ *
+ * Igual se estima la memoria de cada TU (el pico medido por el trabajador
+ * que la analizó), que el ProcessPool usa para admitir análisis dentro de
+ * un presupuesto de memoria.
+ */
+class ParseScheduler {
+public:
+    /**
+     * @brief Carga los tiempos guardados por save().
+     * @return false si el archivo no existe o no es válido (se empieza vacío).
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Guarda los tiempos en disco.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Calcula el orden LPT para 'workers' trabajadores.
+     * @param graph Opcional: aporta el número de inclusiones de TUs sin historial.
+     */
+    ParseSchedule plan(const std::vector<ParseJob>& jobs, unsigned workers,
+                       const IncludeGraph* graph = nullptr) const;
+
+    /**
+     * @brief Incorpora los tiempos y picos de memoria medidos por el ProcessPool.
+     * @param jobs Los trabajos, en el mismo orden que 'report.jobSeconds'.
+     *
+     * Los lotes unity no se registran: no dicen cuánto cuesta cada cabecera sola.
+     */
+    void record(const std::vector<ParseJob>& jobs, const ProcessPoolReport& report);
+
+    /**
+     * @brief Número de TUs con historial.
+     */
+    std::size_t size() const { return m_history.size(); }
+
+private:
+    struct History {
+        double seconds = 0.0;
+        double bytes = 0.0; ///< Pico de memoria (0 = sin medir)
+    };
+    std::unordered_map<std::string, History> m_history; ///< ruta normalizada -> coste medido
+};
+
+} // namespace parser
+} // namespace cppuml
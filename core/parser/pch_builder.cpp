@@ -0,0 +1,266 @@
+#include "pch_builder.h"
+
+#include <clang-c/Index.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Analiza un archivo y devuelve los segundos empleados (-1 si falló).
+double timeParse(CXIndex index, const std::string& file, const std::vector<std::string>& args,
+                 unsigned options, CXTranslationUnit* keep = nullptr) {
+    std::vector<const char*> cArgs;
+    cArgs.reserve(args.size());
+    for (const auto& arg : args) cArgs.push_back(arg.c_str());
+
+    const auto start = Clock::now();
+    CXTranslationUnit tu = clang_parseTranslationUnit(index, file.c_str(), cArgs.data(),
+                                                      static_cast<int>(cArgs.size()), nullptr, 0, options);
+    const double seconds = secondsSince(start);
+    if (!tu) return -1.0;
+    if (keep) {
+        *keep = tu;
+    } else {
+        clang_disposeTranslationUnit(tu);
+    }
+    return seconds;
+}
+
+/// Clave de un grupo: los argumentos unidos por un separador que no aparece en ellos.
+std::string groupKey(const std::vector<std::string>& args) {
+    std::string key;
+    for (const auto& arg : args) {
+        key += arg;
+        key += '\0';
+    }
+    return key;
+}
+
+bool containsAll(const std::vector<std::string>& includes, const std::vector<std::string>& headers) {
+    const std::unordered_set<std::string> present(includes.begin(), includes.end());
+    for (const auto& header : headers) {
+        if (!present.count(header)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Elige las cabeceras del PCH a partir de la muestra.
+ *
+ * Ordena por frecuencia y toma el prefijo de tamaño k que maximiza
+ * k x (TUs de la muestra que incluyen las k).
+ */
+std::vector<std::string> chooseHeaders(const std::vector<std::vector<std::string>>& sample,
+                                       std::size_t maxHeaders, std::size_t minUnits) {
+    std::unordered_map<std::string, std::size_t> frequency;
+    std::vector<std::string> ranked;
+    for (const auto& includes : sample) {
+        for (const auto& header : includes) {
+            if (frequency[header]++ == 0) ranked.push_back(header);
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [&](const std::string& a, const std::string& b) {
+        return frequency[a] > frequency[b];
+    });
+
+    std::vector<std::unordered_set<std::string>> sets;
+    sets.reserve(sample.size());
+    for (const auto& includes : sample) sets.emplace_back(includes.begin(), includes.end());
+    std::vector<bool> alive(sample.size(), true);
+    std::size_t aliveCount = sample.size();
+
+    std::size_t bestK = 0;
+    std::size_t bestScore = 0;
+    for (std::size_t k = 1; k <= std::min(maxHeaders, ranked.size()); ++k) {
+        for (std::size_t i = 0; i < sets.size(); ++i) {
+            if (alive[i] && !sets[i].count(ranked[k - 1])) {
+                alive[i] = false;
+                --aliveCount;
+            }
+        }
+        if (aliveCount < minUnits) break;
+        if (k * aliveCount > bestScore) {
+            bestScore = k * aliveCount;
+            bestK = k;
+        }
+    }
+    ranked.resize(bestK);
+    return ranked;
+}
+
+/// Las cabeceras elegidas, en el orden en que las incluye una TU que las tiene todas.
+std::vector<std::string> inclusionOrder(const std::vector<std::string>& chosen,
+                                        const std::vector<std::string>& coveredIncludes) {
+    const std::unordered_set<std::string> wanted(chosen.begin(), chosen.end());
+    std::vector<std::string> ordered;
+    ordered.reserve(chosen.size());
+    for (const auto& header : coveredIncludes) {
+        if (wanted.count(header)) ordered.push_back(header);
+    }
+    return ordered;
+}
+
+} // namespace
+
+// --- Lectura de Inclusiones ---
+
+std::vector<std::string> PchBuilder::leadingSystemIncludes(const std::string& sourceFile) {
+    std::vector<std::string> includes;
+    std::ifstream in(sourceFile);
+    bool inComment = false;
+    for (std::string line; std::getline(in, line);) {
+        // Saltar comentarios de bloque al principio de la línea
+        std::size_t pos = 0;
+        for (;;) {
+            if (inComment) {
+                const std::size_t end = line.find("*/", pos);
+                if (end == std::string::npos) break;
+                inComment = false;
+                pos = end + 2;
+            }
+            pos = line.find_first_not_of(" \t\r", pos);
+            if (pos == std::string::npos || line.compare(pos, 2, "/*") != 0) break;
+            inComment = true;
+            pos += 2;
+        }
+        if (inComment || pos == std::string::npos || line.compare(pos, 2, "//") == 0) continue;
+        if (line[pos] != '#') break;
+
+        pos = line.find_first_not_of(" \t", pos + 1);
+        if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) break;
+        pos = line.find_first_not_of(" \t", pos + 7);
+        if (pos == std::string::npos) break;
+        if (line[pos] == '<') {
+            const std::size_t end = line.find('>', pos);
+            if (end == std::string::npos) break;
+            includes.push_back(line.substr(pos + 1, end - pos - 1));
+        }
+    }
+    return includes;
+}
+
+// --- Construcción ---
+
+PchReport PchBuilder::apply(std::vector<ParseJob>& jobs) const {
+    PchReport report;
+
+    // 1. Agrupar por argumentos idénticos (en orden de aparición)
+    std::map<std::string, std::vector<std::size_t>> groups;
+    std::vector<const std::vector<std::size_t>*> order;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        auto inserted = groups.emplace(groupKey(jobs[i].compileArgs), std::vector<std::size_t>());
+        if (inserted.second) order.push_back(&inserted.first->second);
+        inserted.first->second.push_back(i);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_options.outputDirectory, ec);
+    if (ec) {
+        std::cerr << "Error: no se pudo crear " << m_options.outputDirectory << ": " << ec.message() << std::endl;
+        return report;
+    }
+
+    CXIndex index = clang_createIndex(0, 0);
+    for (const std::vector<std::size_t>* members : order) {
+        if (members->size() < m_options.minUnits) continue;
+        const std::vector<std::string>& args = jobs[members->front()].compileArgs;
+        if (std::find(args.begin(), args.end(), "-include-pch") != args.end()) continue;
+
+        // 2. Leer las inclusiones de todo el grupo (texto, sin analizar) y muestrear
+        std::vector<std::vector<std::string>> includes;
+        includes.reserve(members->size());
+        for (std::size_t job : *members) includes.push_back(leadingSystemIncludes(jobs[job].sourceFile));
+
+        std::vector<std::vector<std::string>> sample;
+        const std::size_t stride = std::max<std::size_t>(1, members->size() / std::max<std::size_t>(1, m_options.sampleSize));
+        for (std::size_t i = 0; i < includes.size() && sample.size() < m_options.sampleSize; i += stride) {
+            sample.push_back(includes[i]);
+        }
+
+        const std::vector<std::string> chosen = chooseHeaders(sample, m_options.maxHeaders, m_options.minUnits);
+        if (chosen.empty()) continue;
+
+        std::vector<std::size_t> covered;
+        for (std::size_t i = 0; i < members->size(); ++i) {
+            if (containsAll(includes[i], chosen)) covered.push_back(i);
+        }
+        if (covered.size() < m_options.minUnits) continue;
+
+        // 3. Escribir la cabecera y precompilarla con los flags del grupo
+        PchGroupReport group;
+        group.units = members->size();
+        group.headers = inclusionOrder(chosen, includes[covered.front()]);
+        const std::string stem = (std::filesystem::path(m_options.outputDirectory) /
+                                  ("cppuml-pch-" + std::to_string(report.groups.size()))).string();
+        const std::string headerPath = stem + ".hpp";
+        {
+            std::ofstream header(headerPath, std::ios::trunc);
+            for (const auto& name : group.headers) header << "#include <" << name << ">\n";
+            if (!header) {
+                std::cerr << "Error: no se pudo escribir " << headerPath << std::endl;
+                continue;
+            }
+        }
+
+        std::vector<std::string> headerArgs = args;
+        headerArgs.push_back("-x");
+        headerArgs.push_back("c++-header");
+        const auto start = Clock::now();
+        CXTranslationUnit pch = nullptr;
+        if (timeParse(index, headerPath, headerArgs,
+                      CXTranslationUnit_ForSerialization | CXTranslationUnit_Incomplete, &pch) < 0) {
+            std::cerr << "Error: no se pudo precompilar " << headerPath << std::endl;
+            continue;
+        }
+        const std::string pchPath = stem + ".pch";
+        const int saved = clang_saveTranslationUnit(pch, pchPath.c_str(), clang_defaultSaveOptions(pch));
+        clang_disposeTranslationUnit(pch);
+        group.buildSeconds = secondsSince(start);
+        if (saved != 0) {
+            std::cerr << "Error: no se pudo guardar " << pchPath << std::endl;
+            continue;
+        }
+        group.pchPath = pchPath;
+        report.buildSeconds += group.buildSeconds;
+
+        // 4. Medir el ahorro en una TU cubierta
+        const ParseJob& probe = jobs[(*members)[covered.front()]];
+        std::vector<std::string> withPch = {"-include-pch", pchPath};
+        withPch.insert(withPch.end(), args.begin(), args.end());
+        if (m_options.measure) {
+            group.sampleSecondsWithout = timeParse(index, probe.sourceFile, args, CXTranslationUnit_None);
+            group.sampleSecondsWith = timeParse(index, probe.sourceFile, withPch, CXTranslationUnit_None);
+            if (group.sampleSecondsWith < 0) {
+                std::cerr << "Error: " << probe.sourceFile << " no se pudo analizar con " << pchPath
+                          << "; el grupo se analiza sin PCH" << std::endl;
+                continue;
+            }
+        }
+
+        // 5. Inyectar el PCH en las TUs cubiertas
+        for (std::size_t i : covered) jobs[(*members)[i]].compileArgs = withPch;
+        group.coveredUnits = covered.size();
+        report.groups.push_back(std::move(group));
+    }
+    clang_disposeIndex(index);
+    return report;
+}
+
+} // namespace parser
+} // namespace cppuml
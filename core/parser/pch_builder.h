@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "process_pool.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Configuración del PchBuilder.
+ */
+struct PchOptions {
+    std::string outputDirectory;  ///< Dónde escribir las cabeceras y los .pch generados
+    std::size_t sampleSize = 64;  ///< TUs de cada grupo que se examinan para elegir cabeceras
+    std::size_t maxHeaders = 200; ///< Cabeceras como máximo en un PCH
+    std::size_t minUnits = 2;     ///< Un grupo con menos TUs no compensa el PCH
+    bool measure = true;          ///< Analizar una TU con y sin PCH para medir el ahorro
+};
+
+/**
+ * @brief Resultado para un grupo de TUs con los mismos argumentos.
+ */
+struct PchGroupReport {
+    std::size_t units = 0;             ///< TUs del grupo
+    std::size_t coveredUnits = 0;      ///< TUs que reciben el PCH
+    std::vector<std::string> headers;  ///< Cabeceras precompiladas, en orden de inclusión
+    std::string pchPath;               ///< Vacío si no se generó
+    double buildSeconds = 0.0;
+    double sampleSecondsWithout = 0.0; ///< Una TU del grupo sin PCH (si 'measure')
+    double sampleSecondsWith = 0.0;    ///< La misma TU con PCH
+};
+
+/**
+ * @brief Resultado de 'PchBuilder::apply'.
+ */
+struct PchReport {
+    std::vector<PchGroupReport> groups; ///< Solo los grupos con PCH
+    double buildSeconds = 0.0;          ///< Total de construcción de PCHs
+};
+
+/**
+ * @class PchBuilder
+ * @brief Genera un PCH por grupo de flags e inyecta '-include-pch' en sus TUs.
+ *
+ * Las TUs se agrupan por argumentos de compilación idénticos: un PCH solo
+ * es válido con los mismos flags. De una muestra de cada grupo se leen las
+ * inclusiones '<...>' del bloque inicial del archivo (sin analizarlo) y se
+ * eligen las k cabeceras más frecuentes que maximizan
+ * k x (TUs que incluyen todas ellas). El PCH se construye con libclang y
+ * solo se inyecta en las TUs que incluyen todas sus cabeceras, de modo que
+ * ninguna TU ve declaraciones que no vería sin él.
+ *
+ * Limitación: el PCH se incluye antes que todo el archivo. Si una TU define
+ * macros antes de sus inclusiones '<...>' que alteren esas cabeceras, el
+ * resultado puede diferir del análisis sin PCH.
+ */
+class PchBuilder {
+public:
+    explicit PchBuilder(PchOptions options) : m_options(std::move(options)) {}
+
+    /**
+     * @brief Construye los PCHs y añade '-include-pch' a los trabajos cubiertos.
+     */
+    PchReport apply(std::vector<ParseJob>& jobs) const;
+
+    /**
+     * @brief Las inclusiones '<...>' del bloque inicial de un archivo.
+     *
+     * Se detiene en la primera línea que no sea vacía, un comentario o un
+     * #include.
+     */
+    static std::vector<std::string> leadingSystemIncludes(const std::string& sourceFile);
+
+private:
+    PchOptions m_options;
+};
+
+} // namespace parser
+} // namespace cppuml
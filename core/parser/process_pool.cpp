@@ -0,0 +1,638 @@
+#include "process_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "libclang_parser.h"
+#include "memory_monitor.h"
+#include "serialization/ModelSerializer.h"
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+// --- Protocolo de Tuberías ---
+//
+// Cada mensaje es una trama: longitud (uint32, orden del host) + bytes.
+// Solicitud: [n][cabeceras][len ruta][ruta][len arg1][arg1]...[len cabecera1][cabecera1]...
+// Respuesta: [estado (1 = ok, 0 = fallo de libclang)][pico de memoria (uint64)][TranslationUnit serializada]
+//            (un lote unity: [len TU1][TU1][len TU2][TU2]..., una por cabecera)
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::read(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return false; // EOF: el otro extremo murió
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool writeFrame(int fd, const std::string& payload) {
+    const auto size = static_cast<std::uint32_t>(payload.size());
+    return writeAll(fd, reinterpret_cast<const char*>(&size), sizeof(size)) &&
+           writeAll(fd, payload.data(), payload.size());
+}
+
+bool readFrame(int fd, std::string& payload) {
+    std::uint32_t size = 0;
+    if (!readAll(fd, reinterpret_cast<char*>(&size), sizeof(size))) return false;
+    payload.resize(size);
+    return readAll(fd, &payload[0], size);
+}
+
+void appendString(std::string& out, const std::string& value) {
+    const auto size = static_cast<std::uint32_t>(value.size());
+    out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    out += value;
+}
+
+bool takeString(const std::string& in, std::size_t& pos, std::string& value) {
+    std::uint32_t size = 0;
+    if (in.size() - pos < sizeof(size)) return false;
+    std::memcpy(&size, in.data() + pos, sizeof(size));
+    pos += sizeof(size);
+    if (in.size() - pos < size) return false;
+    value.assign(in, pos, size);
+    pos += size;
+    return true;
+}
+
+std::string encodeJob(const ParseJob& job) {
+    std::string out;
+    const auto argc = static_cast<std::uint32_t>(job.compileArgs.size());
+    const auto headers = static_cast<std::uint32_t>(job.unityHeaders.size());
+    out.append(reinterpret_cast<const char*>(&argc), sizeof(argc));
+    out.append(reinterpret_cast<const char*>(&headers), sizeof(headers));
+    appendString(out, job.sourceFile);
+    for (const auto& arg : job.compileArgs) appendString(out, arg);
+    for (const auto& header : job.unityHeaders) appendString(out, header);
+    return out;
+}
+
+bool decodeJob(const std::string& in, ParseJob& job) {
+    std::uint32_t argc = 0;
+    std::uint32_t headers = 0;
+    if (in.size() < sizeof(argc) + sizeof(headers)) return false;
+    std::memcpy(&argc, in.data(), sizeof(argc));
+    std::memcpy(&headers, in.data() + sizeof(argc), sizeof(headers));
+    std::size_t pos = sizeof(argc) + sizeof(headers);
+    if (!takeString(in, pos, job.sourceFile)) return false;
+    job.compileArgs.assign(argc, std::string());
+    for (auto& arg : job.compileArgs) {
+        if (!takeString(in, pos, arg)) return false;
+    }
+    job.unityHeaders.assign(headers, std::string());
+    for (auto& header : job.unityHeaders) {
+        if (!takeString(in, pos, header)) return false;
+    }
+    return true;
+}
+
+// --- Proceso Trabajador ---
+
+[[noreturn]] void workerMain(int requestFd, int responseFd, const ProcessPoolOptions& options) {
+    // Cada trabajador tiene su propio CXIndex (creado después del fork).
+    LibClangParser parser;
+    parser.setFilter(options.filter);
+    parser.setSkim(options.skim);
+
+    std::string frame;
+    std::string response;
+    std::string serialized;
+    while (readFrame(requestFd, frame)) {
+        ParseJob job;
+        if (!decodeJob(frame, job)) break;
+
+        // Pico del análisis sobre lo que el trabajador ya ocupaba.
+        memory::trimHeap();
+        const bool measured = memory::resetPeakResident();
+        const std::size_t baseline = memory::currentResidentBytes();
+
+        std::uint64_t footprint = 0;
+        response.assign(1 + sizeof(footprint), '\0');
+        if (job.unityHeaders.empty()) {
+            auto tu = parser.parse(job.sourceFile, job.compileArgs);
+            response[0] = tu ? '\1' : '\0';
+            if (tu) serialization::ModelSerializer::serialize(*tu, response);
+        } else {
+            auto units = parser.parseUnity(job.unityHeaders, job.compileArgs);
+            response[0] = units.empty() ? '\0' : '\1';
+            for (const auto& tu : units) {
+                serialized.clear();
+                serialization::ModelSerializer::serialize(*tu, serialized);
+                appendString(response, serialized);
+            }
+            serialized.clear();
+            serialized.shrink_to_fit();
+        }
+
+        const std::size_t peak = measured ? memory::peakResidentBytes() : 0;
+        footprint = peak > baseline ? peak - baseline : 0;
+        std::memcpy(&response[1], &footprint, sizeof(footprint));
+        if (!writeFrame(responseFd, response)) break;
+        response.clear();
+        response.shrink_to_fit();
+    }
+    // _exit: no ejecutar destructores estáticos ni vaciar búferes del padre.
+    ::_exit(0);
+}
+
+/**
+ * @brief Estado del lado del padre para un trabajador.
+ */
+struct Worker {
+    pid_t pid = -1;
+    int requestFd = -1;
+    int responseFd = -1;
+    long job = -1; ///< Índice del trabajo en curso, -1 si está libre
+    std::chrono::steady_clock::time_point started; ///< Despacho del trabajo en curso
+    std::size_t reserved = 0;          ///< Memoria prevista del trabajo en curso
+    std::size_t residentAtDispatch = 0; ///< Memoria del trabajador al despacharlo
+    double lastFinish = 0.0; ///< Segundos desde el inicio hasta su última respuesta
+    bool ownChild = true;    ///< false si lo creó el lanzador (él lo recoge, no el padre)
+};
+
+void closeWorker(Worker& worker) {
+    if (worker.requestFd >= 0) ::close(worker.requestFd);
+    if (worker.responseFd >= 0) ::close(worker.responseFd);
+    worker.requestFd = worker.responseFd = -1;
+    if (worker.pid > 0 && worker.ownChild) {
+        int status = 0;
+        while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+    }
+    worker.pid = -1;
+    worker.job = -1;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @param inheritedFd Otro descriptor que el hijo debe cerrar (-1 = ninguno):
+ *        el socket del lanzador.
+ */
+bool spawnWorker(Worker& worker, const std::vector<Worker>& siblings, const ProcessPoolOptions& options,
+                 int inheritedFd = -1) {
+    int request[2];
+    int response[2];
+    if (::pipe(request) != 0) return false;
+    if (::pipe(response) != 0) {
+        ::close(request[0]);
+        ::close(request[1]);
+        return false;
+    }
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        for (int fd : {request[0], request[1], response[0], response[1]}) ::close(fd);
+        return false;
+    }
+
+    if (pid == 0) {
+        // Hijo: cerrar los extremos del padre y los de los demás trabajadores,
+        // para que el padre detecte EOF cuando un trabajador muera.
+        ::close(request[1]);
+        ::close(response[0]);
+        for (const auto& sibling : siblings) {
+            if (sibling.requestFd >= 0) ::close(sibling.requestFd);
+            if (sibling.responseFd >= 0) ::close(sibling.responseFd);
+        }
+        if (inheritedFd >= 0) ::close(inheritedFd);
+        ::signal(SIGCHLD, SIG_DFL); // El lanzador los ignora; el trabajador no lo necesita
+        workerMain(request[0], response[1], options);
+    }
+
+    ::close(request[0]);
+    ::close(response[1]);
+    ::fcntl(request[1], F_SETFD, FD_CLOEXEC);
+    ::fcntl(response[0], F_SETFD, FD_CLOEXEC);
+    worker.pid = pid;
+    worker.requestFd = request[1];
+    worker.responseFd = response[0];
+    worker.job = -1;
+    worker.ownChild = true;
+    return true;
+}
+
+// --- Proceso Lanzador ---
+//
+// Los trabajadores que sustituyen a uno caído se crean a mitad de run(),
+// cuando el llamador puede tener ya otros hilos (AnalysisPipeline). Un
+// fork() desde ahí copiaría solo el hilo actual, con los mutex de los demás
+// posiblemente tomados. Por eso run() crea al empezar, aún con un solo
+// hilo, un proceso lanzador: por cada byte recibido en su socket crea un
+// trabajador con fork() y devuelve su pid y los extremos de sus tuberías
+// (SCM_RIGHTS). Los trabajadores son hijos del lanzador, que los recoge.
+
+struct Spawner {
+    pid_t pid = -1;
+    int socket = -1; ///< Extremo del padre
+};
+
+bool sendWorker(int socket, pid_t pid, int requestFd, int responseFd) {
+    iovec data{&pid, sizeof(pid)};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))] = {};
+    if (pid > 0) {
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(2 * sizeof(int));
+        const int fds[2] = {requestFd, responseFd};
+        std::memcpy(CMSG_DATA(header), fds, sizeof(fds));
+    }
+    while (::sendmsg(socket, &message, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    return true;
+}
+
+[[noreturn]] void spawnerMain(int socket, const ProcessPoolOptions& options) {
+    // Los trabajadores se recogen solos: el padre no es su padre.
+    struct sigaction reap {};
+    reap.sa_handler = SIG_IGN;
+    ::sigemptyset(&reap.sa_mask);
+    ::sigaction(SIGCHLD, &reap, nullptr);
+
+    for (;;) {
+        char request = 0;
+        const ssize_t n = ::read(socket, &request, 1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break; // El padre cerró el socket: run() terminó
+
+        Worker worker;
+        const bool spawned = spawnWorker(worker, {}, options, socket);
+        const bool sent = sendWorker(socket, spawned ? worker.pid : -1, worker.requestFd, worker.responseFd);
+        if (spawned) {
+            // El padre tiene ya sus copias; las del lanzador no deben retrasar el EOF.
+            ::close(worker.requestFd);
+            ::close(worker.responseFd);
+        }
+        if (!sent) break;
+    }
+    ::_exit(0);
+}
+
+bool startSpawner(Spawner& spawner, const ProcessPoolOptions& options) {
+    int ends[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, ends) != 0) return false;
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(ends[0]);
+        ::close(ends[1]);
+        return false;
+    }
+    if (pid == 0) {
+        ::close(ends[0]);
+        spawnerMain(ends[1], options);
+    }
+    ::close(ends[1]);
+    ::fcntl(ends[0], F_SETFD, FD_CLOEXEC);
+    spawner.pid = pid;
+    spawner.socket = ends[0];
+    return true;
+}
+
+/// Pide un trabajador al lanzador.
+bool spawnFromSpawner(const Spawner& spawner, Worker& worker) {
+    const char request = 'W';
+    if (!writeAll(spawner.socket, &request, 1)) return false;
+
+    pid_t pid = -1;
+    iovec data{&pid, sizeof(pid)};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))] = {};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t n;
+    while ((n = ::recvmsg(spawner.socket, &message, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {}
+    if (n != static_cast<ssize_t>(sizeof(pid)) || pid <= 0) return false;
+
+    const cmsghdr* header = CMSG_FIRSTHDR(&message);
+    if (!header || header->cmsg_type != SCM_RIGHTS || header->cmsg_len != CMSG_LEN(2 * sizeof(int))) {
+        return false;
+    }
+    int fds[2];
+    std::memcpy(fds, CMSG_DATA(header), sizeof(fds));
+    worker.pid = pid;
+    worker.requestFd = fds[0];
+    worker.responseFd = fds[1];
+    worker.job = -1;
+    worker.ownChild = false;
+    return true;
+}
+
+void stopSpawner(Spawner& spawner) {
+    if (spawner.socket >= 0) ::close(spawner.socket);
+    spawner.socket = -1;
+    if (spawner.pid > 0) {
+        int status = 0;
+        while (::waitpid(spawner.pid, &status, 0) < 0 && errno == EINTR) {}
+    }
+    spawner.pid = -1;
+}
+
+/**
+ * @brief Ignora SIGPIPE mientras vive (escribir a un trabajador muerto
+ *        debe devolver EPIPE, no matar al proceso principal).
+ */
+class ScopedIgnoreSigpipe {
+public:
+    ScopedIgnoreSigpipe() {
+        struct sigaction ignore {};
+        ignore.sa_handler = SIG_IGN;
+        ::sigemptyset(&ignore.sa_mask);
+        ::sigaction(SIGPIPE, &ignore, &m_previous);
+    }
+    ~ScopedIgnoreSigpipe() { ::sigaction(SIGPIPE, &m_previous, nullptr); }
+
+private:
+    struct sigaction m_previous {};
+};
+
+/// Intervalo de nuevo muestreo de la memoria mientras hay trabajos retenidos.
+constexpr int kMemoryPollMilliseconds = 100;
+
+} // namespace
+
+// --- Ejecución ---
+
+std::vector<std::unique_ptr<TranslationUnit>> ProcessPool::run(
+    const std::vector<ParseJob>& jobs,
+    ProcessPoolReport* report) const {
+
+    std::size_t outputs = 0;
+    for (const auto& job : jobs) outputs += outputCount(job);
+    std::vector<std::unique_ptr<TranslationUnit>> results(outputs);
+    run(jobs, [&](std::size_t index, std::unique_ptr<TranslationUnit> tu) {
+        results[index] = std::move(tu);
+    }, report);
+    return results;
+}
+
+void ProcessPool::run(
+    const std::vector<ParseJob>& jobs,
+    const ResultCallback& onResult,
+    ProcessPoolReport* report) const {
+
+    ProcessPoolReport localReport;
+    ProcessPoolReport& stats = report ? *report : localReport;
+    stats.jobSeconds.assign(jobs.size(), 0.0);
+    stats.jobPeakBytes.assign(jobs.size(), 0);
+    if (jobs.empty()) return;
+    const auto runStart = std::chrono::steady_clock::now();
+
+    ScopedIgnoreSigpipe sigpipeGuard;
+
+    unsigned count = m_options.workers ? m_options.workers
+                                       : static_cast<unsigned>(std::max(1L, ::sysconf(_SC_NPROCESSORS_ONLN)));
+    count = static_cast<unsigned>(std::min<std::size_t>(count, jobs.size()));
+
+    // Primero el lanzador, para que no herede los extremos de ningún trabajador.
+    Spawner spawner;
+    if (!startSpawner(spawner, m_options)) {
+        std::cerr << "Error: no se pudo crear el proceso lanzador: " << std::strerror(errno) << std::endl;
+    }
+
+    std::vector<Worker> workers;
+    workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        Worker worker;
+        if (!spawnWorker(worker, workers, m_options, spawner.socket)) {
+            std::cerr << "Error: no se pudo crear el proceso trabajador: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        workers.push_back(worker);
+    }
+    if (workers.empty()) {
+        stopSpawner(spawner);
+        return;
+    }
+
+    std::deque<std::size_t> pending;
+    for (std::size_t i = 0; i < jobs.size(); ++i) pending.push_back(i);
+    std::size_t finished = 0;
+
+    // Posición de la primera TU de cada trabajo (los lotes unity ocupan varias).
+    std::vector<std::size_t> firstOutput(jobs.size(), 0);
+    for (std::size_t i = 1; i < jobs.size(); ++i) {
+        firstOutput[i] = firstOutput[i - 1] + outputCount(jobs[i - 1]);
+    }
+
+    // Un trabajo sin resultado: se registra cada archivo y se notifica cada TU.
+    auto fail = [&](std::size_t index, std::vector<std::string>& files) {
+        const ParseJob& job = jobs[index];
+        if (job.unityHeaders.empty()) {
+            files.push_back(job.sourceFile);
+        } else {
+            files.insert(files.end(), job.unityHeaders.begin(), job.unityHeaders.end());
+        }
+        for (std::size_t k = 0; k < outputCount(job); ++k) onResult(firstOutput[index] + k, nullptr);
+    };
+
+    // Reemplaza un trabajador muerto por uno nuevo (solo si queda trabajo).
+    // Lo crea el lanzador: aquí puede haber ya otros hilos (ver Spawner).
+    auto respawn = [&](Worker& worker) {
+        closeWorker(worker);
+        if (pending.empty() || spawner.socket < 0) return;
+        if (spawnFromSpawner(spawner, worker)) {
+            ++stats.respawnedWorkers;
+        } else {
+            stopSpawner(spawner); // Sin lanzador, el trabajo restante se reparte entre los vivos
+        }
+    };
+
+    // Control de admisión por memoria (solo con presupuesto).
+    const std::size_t budget = m_options.memoryBytes;
+    const std::size_t defaultEstimate = budget / count;
+    auto estimateOf = [&](std::size_t index) {
+        return jobs[index].expectedBytes ? jobs[index].expectedBytes : defaultEstimate;
+    };
+    std::vector<bool> deferred(jobs.size(), false);
+    std::size_t headSkips = 0; ///< Trabajos adelantados a la cabeza de la cola mientras no cabía
+
+    // Memoria real ahora más lo que aún se espera que crezcan los análisis en curso.
+    auto projectedBytes = [&](std::size_t& running) {
+        std::size_t total = memory::residentBytes(::getpid());
+        std::size_t growth = 0;
+        running = 0;
+        for (const auto& worker : workers) {
+            if (worker.pid <= 0) continue;
+            const std::size_t resident = memory::residentBytes(worker.pid);
+            total += resident;
+            if (worker.job < 0) continue;
+            ++running;
+            const std::size_t grown = resident > worker.residentAtDispatch ? resident - worker.residentAtDispatch : 0;
+            if (worker.reserved > grown) growth += worker.reserved - grown;
+        }
+        stats.peakResidentBytes = std::max(stats.peakResidentBytes, total);
+        return total + growth;
+    };
+
+    // El siguiente trabajo admisible de la cola (end() si ninguno).
+    auto admit = [&](std::size_t projected, std::size_t running) {
+        if (budget == 0 || running == 0 || pending.empty()) return pending.begin();
+        const std::size_t headroom = budget > projected ? budget - projected : 0;
+        for (auto it = pending.begin(); it != pending.end(); ++it) {
+            if (estimateOf(*it) <= headroom) {
+                headSkips = it == pending.begin() ? 0 : headSkips + 1;
+                return it;
+            }
+            if (!deferred[*it]) {
+                deferred[*it] = true;
+                ++stats.deferredJobs;
+            }
+            if (headSkips >= count) break; // Se deja drenar hasta que quepa la cabeza
+        }
+        return pending.end();
+    };
+
+    auto dispatch = [&]() {
+        std::size_t running = 0;
+        std::size_t projected = budget ? projectedBytes(running) : 0;
+        for (auto& worker : workers) {
+            while (worker.pid > 0 && worker.job < 0 && !pending.empty()) {
+                auto next = admit(projected, running);
+                if (next == pending.end()) return;
+                const std::size_t index = *next;
+                pending.erase(next);
+                if (writeFrame(worker.requestFd, encodeJob(jobs[index]))) {
+                    worker.job = static_cast<long>(index);
+                    worker.started = std::chrono::steady_clock::now();
+                    worker.reserved = budget ? estimateOf(index) : 0;
+                    worker.residentAtDispatch = budget ? memory::residentBytes(worker.pid) : 0;
+                    projected += worker.reserved;
+                    ++running;
+                } else {
+                    // El trabajador murió estando libre: el archivo no es culpable.
+                    pending.push_front(index);
+                    respawn(worker);
+                }
+            }
+        }
+    };
+
+    dispatch();
+    std::vector<pollfd> fds;
+    std::vector<Worker*> polled;
+    std::string frame;
+
+    while (finished < jobs.size()) {
+        fds.clear();
+        polled.clear();
+        for (auto& worker : workers) {
+            if (worker.pid > 0 && worker.job >= 0) {
+                fds.push_back(pollfd{worker.responseFd, POLLIN, 0});
+                polled.push_back(&worker);
+            }
+        }
+        if (fds.empty()) {
+            // Sin trabajadores vivos ni forma de crearlos: el resto se da por fallido.
+            for (std::size_t index : pending) fail(index, stats.failedFiles);
+            break;
+        }
+
+        // Con trabajos retenidos por memoria se vuelve a medir periódicamente.
+        const bool holding = budget > 0 && !pending.empty() && fds.size() < workers.size();
+        if (::poll(fds.data(), fds.size(), holding ? kMemoryPollMilliseconds : -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            Worker& worker = *polled[i];
+            const auto index = static_cast<std::size_t>(worker.job);
+            ++finished;
+            stats.jobSeconds[index] = secondsSince(worker.started);
+            worker.lastFinish = secondsSince(runStart);
+
+            std::uint64_t footprint = 0;
+            if (readFrame(worker.responseFd, frame) && frame.size() > sizeof(footprint)) {
+                worker.job = -1;
+                std::memcpy(&footprint, frame.data() + 1, sizeof(footprint));
+                stats.jobPeakBytes[index] = static_cast<std::size_t>(footprint);
+                const ParseJob& job = jobs[index];
+                if (frame[0] != '\1') {
+                    fail(index, stats.failedFiles);
+                } else if (job.unityHeaders.empty()) {
+                    auto tu = serialization::ModelSerializer::deserializeTranslationUnit(
+                        std::string_view(frame).substr(1 + sizeof(footprint)));
+                    if (!tu) stats.failedFiles.push_back(job.sourceFile);
+                    onResult(firstOutput[index], std::move(tu));
+                } else {
+                    std::size_t pos = 1 + sizeof(footprint);
+                    std::string serialized;
+                    for (std::size_t k = 0; k < job.unityHeaders.size(); ++k) {
+                        std::unique_ptr<TranslationUnit> tu;
+                        if (takeString(frame, pos, serialized)) {
+                            tu = serialization::ModelSerializer::deserializeTranslationUnit(serialized);
+                        }
+                        if (!tu) stats.failedFiles.push_back(job.unityHeaders[k]);
+                        onResult(firstOutput[index] + k, std::move(tu));
+                    }
+                }
+            } else {
+                // El trabajador murió analizando este archivo: se registra y se omite.
+                std::cerr << "Error: el trabajador se detuvo analizando " << jobs[index].sourceFile
+                          << "; se omite el archivo" << std::endl;
+                fail(index, stats.crashedFiles);
+                respawn(worker);
+            }
+        }
+        dispatch();
+    }
+
+    // Ocio de cola: lo que cada trabajador esperó a que terminase el más lento.
+    for (const auto& worker : workers) {
+        stats.makespanSeconds = std::max(stats.makespanSeconds, worker.lastFinish);
+    }
+    for (const auto& worker : workers) {
+        stats.tailIdleSeconds += stats.makespanSeconds - worker.lastFinish;
+    }
+
+    for (auto& worker : workers) closeWorker(worker);
+    stopSpawner(spawner);
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model/TranslationUnit.h"
+#include "scope_filter.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Un trabajo de análisis: un archivo y sus argumentos de compilación.
+ *
+ * Un trabajo con 'unityHeaders' es un lote unity (ver UnityBatcher): sus
+ * cabeceras se analizan juntas con LibClangParser::parseUnity, producen
+ * una TU cada una y 'sourceFile' solo lo nombra en los mensajes.
+ */
+struct ParseJob {
+    std::string sourceFile;
+    std::vector<std::string> compileArgs;
+    std::size_t expectedBytes = 0; ///< Memoria prevista del análisis (0 = desconocida; ver ParseScheduler)
+    std::vector<std::string> unityHeaders = {}; ///< No vacío: las cabeceras de un lote unity
+};
+
+/**
+ * @brief Número de TUs que produce un trabajo (una por cabecera en un lote unity).
+ */
+inline std::size_t outputCount(const ParseJob& job) {
+    return job.unityHeaders.empty() ? 1 : job.unityHeaders.size();
+}
+
+/**
+ * @brief Configuración del ProcessPool.
+ */
+struct ProcessPoolOptions {
+    unsigned workers = 0; ///< Procesos trabajadores (0 = número de núcleos)
+    std::shared_ptr<const ScopeFilter> filter; ///< Alcance del modelo (los trabajadores lo heredan con fork())
+    std::size_t memoryBytes = 0; ///< Presupuesto de memoria de todo el proceso (0 = solo limita 'workers')
+    bool skim = false; ///< Análisis rápido sin inclusiones (ver LibClangParser::setSkim)
+};
+
+/**
+ * @brief Resumen de una ejecución del ProcessPool.
+ */
+struct ProcessPoolReport {
+    std::vector<std::string> crashedFiles; ///< El trabajador murió (segfault, assert, ...); las cabeceras de un lote, todas
+    std::vector<std::string> failedFiles;  ///< libclang no pudo analizar el archivo
+    std::size_t respawnedWorkers = 0;
+
+    std::vector<double> jobSeconds; ///< Segundos de análisis de cada trabajo (orden de 'jobs'; 0 = no se ejecutó)
+    double makespanSeconds = 0.0;   ///< Desde el primer despacho hasta la última respuesta
+    double tailIdleSeconds = 0.0;   ///< Suma del tiempo que cada trabajador pasó ocioso al final
+
+    std::vector<std::size_t> jobPeakBytes; ///< Memoria que añadió cada análisis a su trabajador (0 = sin dato)
+    std::size_t peakResidentBytes = 0;     ///< Máximo observado del padre y los trabajadores juntos
+    std::size_t deferredJobs = 0;          ///< Trabajos que esperaron por memoria con un trabajador libre
+};
+
+/**
+ * @class ProcessPool
+ * @brief Analiza TUs en procesos hijos aislados.
+ *
+ * libclang puede abortar o provocar un segfault con código inusual. Como
+ * LibClangParser se ejecuta dentro del proceso, un solo archivo problemático
+ * puede tumbar una ejecución de horas. Este pool:
+ *   - Crea N procesos con fork(); cada uno tiene su propio LibClangParser
+ *     (y por tanto su propio CXIndex), sin compartir el heap.
+ *   - Envía trabajos por una tubería y recibe de vuelta la TranslationUnit
+ *     serializada con ModelSerializer.
+ *   - Si un trabajador muere, registra el archivo culpable, no lo reintenta
+ *     y crea un trabajador nuevo para el resto de la cola.
+ *
+ * Con 'memoryBytes', 'workers' es solo el máximo de análisis simultáneos:
+ * cada trabajo se admite si la memoria real (PSS del padre y de los
+ * trabajadores) más lo que aún se espera que crezcan los análisis en curso
+ * más su propia previsión ('ParseJob::expectedBytes'; sin previsión, una
+ * parte igual del presupuesto) cabe en el presupuesto. Si la TU siguiente
+ * no cabe, se adelantan otras más pequeñas de la cola; tras 'workers'
+ * adelantamientos se deja de admitir hasta que quepa, para que una TU
+ * enorme no quede para el final. Sin ningún análisis en curso siempre se
+ * admite uno, aunque supere el presupuesto. Cada trabajador mide el pico
+ * de memoria de cada análisis (VmHWM) y lo devuelve con el resultado.
+ *
+ * Un lote unity se despacha como un solo trabajo y devuelve una TU por
+ * cabecera. Los resultados se numeran por TU: los trabajos en orden, cada
+ * lote ocupando tantas posiciones como cabeceras (sin lotes, la posición
+ * de cada TU es la de su trabajo). Si el trabajador muere con un lote, se
+ * pierden todas sus cabeceras.
+ *
+ * Solo disponible en sistemas POSIX. run() debe llamarse sin otros hilos
+ * en el proceso, ya que fork() solo duplica el hilo que lo invoca: al
+ * empezar crea los trabajadores y un proceso lanzador de un solo hilo. Los
+ * trabajadores que sustituyen a uno caído los crea ese lanzador, no el
+ * proceso principal, así que el callback de resultados sí puede entregar
+ * las TUs a otros hilos (como hace AnalysisPipeline) mientras run() sigue.
+ */
+class ProcessPool {
+public:
+    explicit ProcessPool(ProcessPoolOptions options = {})
+        : m_options(options) {}
+
+    /**
+     * @brief Ejecuta todos los trabajos.
+     * @param jobs La cola de trabajos, en el orden en que se despacharán.
+     * @param report Opcional: recibe los archivos fallidos y las estadísticas.
+     * @return Un modelo por TU (ver 'outputCount'), en el mismo orden; nullptr si falló.
+     */
+    std::vector<std::unique_ptr<TranslationUnit>> run(
+        const std::vector<ParseJob>& jobs,
+        ProcessPoolReport* report = nullptr) const;
+
+    /**
+     * @brief Recibe cada TU analizada en cuanto llega.
+     * @param index Posición de la TU: la del trabajo en 'jobs', contando
+     *        una por cabecera en los lotes unity.
+     */
+    using ResultCallback = std::function<void(std::size_t index, std::unique_ptr<TranslationUnit> tu)>;
+
+    /**
+     * @brief Igual que run(), pero entrega cada resultado en cuanto llega
+     *        (en orden de finalización) en lugar de acumularlos.
+     *
+     * Los trabajos fallidos llaman a 'onResult' con nullptr, una vez por TU
+     * (además de constar en el informe), para que quien espera los resultados en orden
+     * no se quede esperando. Útil cuando el modelo completo no cabe en
+     * memoria: el llamador reduce cada TU y la libera.
+     */
+    void run(const std::vector<ParseJob>& jobs,
+             const ResultCallback& onResult,
+             ProcessPoolReport* report = nullptr) const;
+
+private:
+    ProcessPoolOptions m_options;
+};
+
+} // namespace parser
+} // namespace cppuml
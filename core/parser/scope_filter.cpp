@@ -0,0 +1,192 @@
+#include "scope_filter.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+int visibilityRank(Visibility visibility) {
+    switch (visibility) {
+        case Visibility::Protected: return 1;
+        case Visibility::Private:   return 2;
+        default:                    return 0; // Public y None
+    }
+}
+
+/// Une las expresiones en una alternativa: una sola búsqueda por clase.
+bool compileAlternatives(const std::vector<std::string>& patterns, std::regex& out) {
+    std::string combined;
+    for (const auto& pattern : patterns) {
+        if (!combined.empty()) combined += '|';
+        combined += "(?:" + pattern + ")";
+    }
+    try {
+        out.assign(combined, std::regex::ECMAScript | std::regex::optimize | std::regex::nosubs);
+    } catch (const std::regex_error& error) {
+        std::cerr << "Error: expresión de clase no válida '" << combined << "': " << error.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool anyGlob(const std::vector<std::string>& patterns, const std::string& text) {
+    for (const auto& pattern : patterns) {
+        if (ScopeFilter::globMatch(pattern, text)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// --- Compilación ---
+
+bool ScopeFilter::compile(const ScopeFilterSpec& spec) {
+    m_includeNamespaces = spec.includeNamespaces;
+    m_excludeNamespaces = spec.excludeNamespaces;
+    m_includePaths = spec.includePaths;
+    m_excludePaths = spec.excludePaths;
+    m_hasIncludeClasses = !spec.includeClasses.empty();
+    m_hasExcludeClasses = !spec.excludeClasses.empty();
+    m_maximumRank = visibilityRank(spec.minimumVisibility);
+    return (!m_hasIncludeClasses || compileAlternatives(spec.includeClasses, m_includeClasses)) &&
+           (!m_hasExcludeClasses || compileAlternatives(spec.excludeClasses, m_excludeClasses));
+}
+
+// --- Decisiones ---
+
+ScopeDecision ScopeFilter::namespaceDecision(const std::string& qualifiedName, ScopeDecision parent) const {
+    if (anyGlob(m_excludeNamespaces, qualifiedName)) {
+        return ScopeDecision::Exclude;
+    }
+    if (parent == ScopeDecision::Include || anyGlob(m_includeNamespaces, qualifiedName)) {
+        return ScopeDecision::Include;
+    }
+    // Solo merece la pena entrar si un namespace anidado aún puede coincidir.
+    const std::string nested = qualifiedName + "::";
+    for (const auto& pattern : m_includeNamespaces) {
+        if (globMatchesPrefix(pattern, nested)) return ScopeDecision::Descend;
+    }
+    return ScopeDecision::Exclude;
+}
+
+bool ScopeFilter::acceptsPath(const std::string& path) const {
+    if (anyGlob(m_excludePaths, path)) return false;
+    return m_includePaths.empty() || anyGlob(m_includePaths, path);
+}
+
+bool ScopeFilter::acceptsClass(const std::string& qualifiedName) const {
+    if (m_hasExcludeClasses && std::regex_search(qualifiedName, m_excludeClasses)) return false;
+    return !m_hasIncludeClasses || std::regex_search(qualifiedName, m_includeClasses);
+}
+
+bool ScopeFilter::acceptsVisibility(Visibility visibility) const {
+    return visibilityRank(visibility) <= m_maximumRank;
+}
+
+// --- Globs ---
+
+bool ScopeFilter::globMatch(const std::string& pattern, const std::string& text) {
+    // Algoritmo lineal con retroceso al último '*'.
+    std::size_t p = 0;
+    std::size_t t = 0;
+    std::size_t star = std::string::npos;
+    std::size_t resume = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+bool ScopeFilter::globMatchesPrefix(const std::string& pattern, const std::string& prefix) {
+    // Basta con que el patrón pueda consumir todo el prefijo: el resto del
+    // patrón siempre puede satisfacerse con algún sufijo.
+    std::vector<char> reachable(pattern.size() + 1, 0);
+    auto close = [&]() { // Un '*' también puede no consumir nada
+        for (std::size_t p = 0; p < pattern.size(); ++p) {
+            if (reachable[p] && pattern[p] == '*') reachable[p + 1] = 1;
+        }
+    };
+    reachable[0] = 1;
+    close();
+    for (char c : prefix) {
+        std::vector<char> next(pattern.size() + 1, 0);
+        bool any = false;
+        for (std::size_t p = 0; p < pattern.size(); ++p) {
+            if (!reachable[p]) continue;
+            if (pattern[p] == '*') {
+                next[p] = 1;
+                any = true;
+            } else if (pattern[p] == '?' || pattern[p] == c) {
+                next[p + 1] = 1;
+                any = true;
+            }
+        }
+        if (!any) return false;
+        reachable.swap(next);
+        close();
+    }
+    return true;
+}
+
+// --- Especificación ---
+
+bool ScopeFilter::addRule(const std::string& key, const std::string& value, ScopeFilterSpec& spec) {
+    if (key == "include-namespace") spec.includeNamespaces.push_back(value);
+    else if (key == "exclude-namespace") spec.excludeNamespaces.push_back(value);
+    else if (key == "include-path") spec.includePaths.push_back(value);
+    else if (key == "exclude-path") spec.excludePaths.push_back(value);
+    else if (key == "include-class") spec.includeClasses.push_back(value);
+    else if (key == "exclude-class") spec.excludeClasses.push_back(value);
+    else if (key == "min-visibility") {
+        if (value == "public") spec.minimumVisibility = Visibility::Public;
+        else if (value == "protected") spec.minimumVisibility = Visibility::Protected;
+        else if (value == "private") spec.minimumVisibility = Visibility::Private;
+        else return false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ScopeFilter::loadSpec(const std::string& path, ScopeFilterSpec& spec) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: no se pudo abrir el filtro " << path << std::endl;
+        return false;
+    }
+    std::size_t lineNumber = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++lineNumber;
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        const auto keyEnd = line.find_first_of(" \t", first);
+        const auto valueStart = keyEnd == std::string::npos ? keyEnd : line.find_first_not_of(" \t", keyEnd);
+        const auto valueEnd = line.find_last_not_of(" \t\r");
+        const std::string key = line.substr(first, keyEnd - first);
+        const std::string value = valueStart == std::string::npos ? std::string()
+                                                                  : line.substr(valueStart, valueEnd + 1 - valueStart);
+        if (value.empty() || !addRule(key, value, spec)) {
+            std::cerr << "Error: regla no válida en " << path << ":" << lineNumber << ": " << line << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "model/Element.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Qué incluir en el modelo. Todas las listas vacías = todo.
+ *
+ * Los globs admiten '*' (cualquier secuencia, "::" y '/' incluidos) y '?'.
+ * Las expresiones de clase son ECMAScript y se buscan en cualquier parte
+ * del nombre calificado (se anclan con '^' y '$').
+ */
+struct ScopeFilterSpec {
+    std::vector<std::string> includeNamespaces; ///< p.ej., "myco::trading" (incluye sus anidados)
+    std::vector<std::string> excludeNamespaces; ///< p.ej., "*::detail", "*::test"
+    std::vector<std::string> includePaths;      ///< Globs sobre la ruta del archivo de la clase
+    std::vector<std::string> excludePaths;      ///< p.ej., "*/generated/*", "*.pb.h"
+    std::vector<std::string> includeClasses;    ///< Regex sobre el nombre calificado
+    std::vector<std::string> excludeClasses;
+    Visibility minimumVisibility = Visibility::Private; ///< Los miembros menos visibles se omiten
+
+    bool empty() const {
+        return includeNamespaces.empty() && excludeNamespaces.empty() && includePaths.empty() &&
+               excludePaths.empty() && includeClasses.empty() && excludeClasses.empty() &&
+               minimumVisibility == Visibility::Private;
+    }
+};
+
+/**
+ * @brief Estado de un namespace durante el recorrido.
+ */
+enum class ScopeDecision {
+    Exclude, ///< Se poda con todo su contenido
+    Include, ///< Dentro del alcance: sus clases se modelan
+    Descend  ///< Fuera del alcance, pero un namespace anidado podría estar dentro
+};
+
+/**
+ * @class ScopeFilter
+ * @brief Filtro de alcance compilado una vez y evaluado dentro de AstVisitor.
+ *
+ * Las decisiones se toman sobre los cursores, antes de crear ningún
+ * objeto del modelo, y en orden de coste: el namespace se decide al
+ * entrar en él (y una exclusión poda todo el subárbol), la ruta se decide
+ * una vez por archivo y las expresiones regulares (unidas en una sola
+ * alternativa por lista) solo se evalúan para las clases que pasaron lo
+ * anterior. Un análisis acotado a una parte del repositorio construye
+ * solo esa parte del modelo.
+ */
+class ScopeFilter {
+public:
+    /**
+     * @brief Compila la especificación.
+     * @return false si alguna expresión regular no es válida.
+     */
+    bool compile(const ScopeFilterSpec& spec);
+
+    /**
+     * @brief Decide un namespace al entrar en él.
+     * @param qualifiedName p.ej., "myco::trading::detail".
+     * @param parent La decisión de su namespace contenedor.
+     */
+    ScopeDecision namespaceDecision(const std::string& qualifiedName, ScopeDecision parent) const;
+
+    /**
+     * @brief La decisión del namespace global (Include si no hay namespaces incluidos).
+     */
+    ScopeDecision globalDecision() const {
+        return m_includeNamespaces.empty() ? ScopeDecision::Include : ScopeDecision::Descend;
+    }
+
+    bool filtersPaths() const { return !m_includePaths.empty() || !m_excludePaths.empty(); }
+    bool filtersClasses() const { return m_hasIncludeClasses || m_hasExcludeClasses; }
+
+    /// ¿Se modelan las clases declaradas en este archivo?
+    bool acceptsPath(const std::string& path) const;
+
+    /// ¿Se modela esta clase? (solo las expresiones regulares)
+    bool acceptsClass(const std::string& qualifiedName) const;
+
+    /// ¿Alcanza esta visibilidad el umbral? (None cuenta como pública)
+    bool acceptsVisibility(Visibility visibility) const;
+
+    /**
+     * @brief Añade una regla a una especificación.
+     * @param key "include-namespace", "exclude-namespace", "include-path",
+     *        "exclude-path", "include-class", "exclude-class" o
+     *        "min-visibility" (public | protected | private).
+     * @return false si la clave o el valor no son válidos.
+     */
+    static bool addRule(const std::string& key, const std::string& value, ScopeFilterSpec& spec);
+
+    /**
+     * @brief Lee un archivo con una regla por línea ("clave valor"; '#' comenta).
+     * @return false si no se pudo leer o contiene una regla no válida.
+     */
+    static bool loadSpec(const std::string& path, ScopeFilterSpec& spec);
+
+    /**
+     * @brief Coincidencia glob completa ('*' y '?').
+     */
+    static bool globMatch(const std::string& pattern, const std::string& text);
+
+    /**
+     * @brief Indica si el glob podría coincidir con algún texto que empiece por 'prefix'.
+     */
+    static bool globMatchesPrefix(const std::string& pattern, const std::string& prefix);
+
+private:
+    std::vector<std::string> m_includeNamespaces;
+    std::vector<std::string> m_excludeNamespaces;
+    std::vector<std::string> m_includePaths;
+    std::vector<std::string> m_excludePaths;
+    std::regex m_includeClasses;
+    std::regex m_excludeClasses;
+    bool m_hasIncludeClasses = false;
+    bool m_hasExcludeClasses = false;
+    int m_maximumRank = 2; ///< Rango de 'minimumVisibility' (0 = público, 2 = privado)
+};
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,140 @@
+#include "symbol_resolver.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+struct ClassTable {
+    std::unordered_map<std::string, Class*> byQualifiedName;
+    std::unordered_map<std::string, Class*> bySimpleName; // nullptr = ambiguo
+    std::vector<Class*> all;
+};
+
+void collect(const Namespace& ns, const std::string& prefix, ClassTable& table) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class) {
+            Class* cls = static_cast<Class*>(member.get());
+            table.byQualifiedName.emplace(prefix + cls->getName(), cls);
+            auto inserted = table.bySimpleName.emplace(cls->getName(), cls);
+            if (!inserted.second && inserted.first->second != cls) {
+                inserted.first->second = nullptr;
+            }
+            table.all.push_back(cls);
+        } else if (member->getKind() == ElementKind::Namespace) {
+            collect(*static_cast<const Namespace*>(member.get()), prefix + member->getName() + "::", table);
+        }
+    }
+}
+
+/// Nombre simple de un nombre calificado ("a::b::C" -> "C").
+std::string simpleName(const std::string& qualified) {
+    const auto sep = qualified.rfind("::");
+    return sep == std::string::npos ? qualified : qualified.substr(sep + 2);
+}
+
+} // namespace
+
+std::size_t SymbolResolver::resolve(Model& model, bool relink) {
+    ClassTable table;
+    for (const auto& tu : model.getTranslationUnits()) {
+        collect(*tu->getGlobalNamespace(), "", table);
+    }
+
+    std::size_t unresolved = 0;
+    for (Class* cls : table.all) {
+        const auto& bases = cls->getBaseClasses();
+        for (std::size_t i = 0; i < bases.size(); ++i) {
+            if (bases[i].baseClass && !relink) continue;
+
+            Class* target = nullptr;
+            auto exact = table.byQualifiedName.find(bases[i].baseName);
+            if (exact != table.byQualifiedName.end()) {
+                target = exact->second;
+            } else {
+                // Las clases anidadas se guardan en su namespace, no en la clase
+                // contenedora: se recurre al nombre simple si no es ambiguo.
+                auto loose = table.bySimpleName.find(simpleName(bases[i].baseName));
+                if (loose != table.bySimpleName.end()) target = loose->second;
+            }
+
+            cls->resolveBaseClass(i, target);
+            if (!target) ++unresolved;
+        }
+    }
+    return unresolved;
+}
+
+// --- Enlace Incremental ---
+
+void IncrementalResolver::collect(const Namespace& ns, const std::string& prefix, std::vector<Class*>& added) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class) {
+            Class* cls = static_cast<Class*>(member.get());
+            m_byQualifiedName.emplace(prefix + cls->getName(), cls);
+            auto inserted = m_bySimpleName.emplace(cls->getName(), cls);
+            if (!inserted.second && inserted.first->second != cls) {
+                inserted.first->second = nullptr;
+            }
+            added.push_back(cls);
+        } else if (member->getKind() == ElementKind::Namespace) {
+            collect(*static_cast<const Namespace*>(member.get()), prefix + member->getName() + "::", added);
+        }
+    }
+}
+
+std::size_t IncrementalResolver::add(TranslationUnit& tu) {
+    std::vector<Class*> added;
+    collect(*tu.getGlobalNamespace(), "", added);
+
+    const std::size_t before = m_pending.size();
+    for (Class* cls : added) {
+        const auto& bases = cls->getBaseClasses();
+        for (std::size_t i = 0; i < bases.size(); ++i) {
+            if (bases[i].baseClass) continue;
+
+            auto exact = m_byQualifiedName.find(bases[i].baseName);
+            if (exact != m_byQualifiedName.end()) {
+                cls->resolveBaseClass(i, exact->second);
+                continue;
+            }
+            // Provisional: un diagrama parcial ya ve la herencia, pero una
+            // TU posterior puede traer el nombre exacto o hacerlo ambiguo.
+            auto loose = m_bySimpleName.find(simpleName(bases[i].baseName));
+            if (loose != m_bySimpleName.end() && loose->second) {
+                cls->resolveBaseClass(i, loose->second);
+            }
+            m_pending.push_back({cls, i});
+        }
+    }
+    return m_pending.size() - before;
+}
+
+std::size_t IncrementalResolver::finish() {
+    std::size_t unresolved = 0;
+    for (const PendingBase& base : m_pending) {
+        const std::string& name = base.cls->getBaseClasses()[base.index].baseName;
+        Class* target = nullptr;
+        auto exact = m_byQualifiedName.find(name);
+        if (exact != m_byQualifiedName.end()) {
+            target = exact->second;
+        } else {
+            auto loose = m_bySimpleName.find(simpleName(name));
+            if (loose != m_bySimpleName.end()) target = loose->second;
+        }
+        base.cls->resolveBaseClass(base.index, target);
+        if (!target) ++unresolved;
+    }
+    m_pending.clear();
+    return unresolved;
+}
+
+} // namespace parser
+} // namespace cppuml
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @class SymbolResolver
+ * @brief Enlaza las referencias por nombre que el Parser deja pendientes.
+ *
+ * Cada TU se analiza de forma aislada, así que una clase base definida en
+ * otra TU solo se conoce por su nombre calificado. Tras el análisis, este
+ * paso recorre el Modelo completo y rellena 'InheritanceInfo::baseClass'.
+ */
+class SymbolResolver {
+public:
+    /**
+     * @brief Resuelve todas las bases pendientes del modelo.
+     * @param model El modelo a enlazar (se modifica en el lugar).
+     * @param relink Si es true, también se recalculan las bases ya enlazadas
+     *        (necesario tras reemplazar TUs: sus punteros antiguos quedan colgando).
+     * @return El número de bases que quedaron sin resolver (p.ej., de la STL).
+     */
+    static std::size_t resolve(Model& model, bool relink = false);
+};
+
+/**
+ * @class IncrementalResolver
+ * @brief El mismo enlace que SymbolResolver, pero alimentado TU a TU
+ *        mientras el resto sigue analizándose.
+ *
+ * add() registra las clases de una TU y enlaza sus bases con lo visto
+ * hasta entonces. Una coincidencia exacta del nombre calificado es
+ * definitiva (la primera clase registrada con ese nombre gana, igual que en
+ * SymbolResolver); las que se resolvieron por nombre simple o no se
+ * encontraron quedan pendientes, porque una TU posterior puede cambiar el
+ * resultado. finish() las enlaza con la tabla completa: el modelo final es
+ * el mismo que tras SymbolResolver::resolve.
+ *
+ * add() solo escribe en la TU que recibe, de modo que otro hilo puede leer
+ * las TUs anteriores (p.ej., para exportarlas) mientras tanto.
+ */
+class IncrementalResolver {
+public:
+    /**
+     * @brief Registra y enlaza una TU.
+     * @return El número de sus bases que quedaron pendientes.
+     */
+    std::size_t add(TranslationUnit& tu);
+
+    /**
+     * @brief Enlaza las bases pendientes con todas las clases registradas.
+     * @return El número de bases que quedaron sin resolver.
+     */
+    std::size_t finish();
+
+    /**
+     * @brief Bases a la espera de finish().
+     */
+    std::size_t pending() const { return m_pending.size(); }
+
+private:
+    struct PendingBase {
+        Class* cls;
+        std::size_t index;
+    };
+
+    void collect(const Namespace& ns, const std::string& prefix, std::vector<Class*>& added);
+
+    std::unordered_map<std::string, Class*> m_byQualifiedName;
+    std::unordered_map<std::string, Class*> m_bySimpleName; ///< nullptr = ambiguo
+    std::vector<PendingBase> m_pending;
+};
+
+} // namespace parser
+} // namespace cppuml
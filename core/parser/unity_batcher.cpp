@@ -0,0 +1,191 @@
+#include "unity_batcher.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unordered_set>
+
+namespace cppuml {
+namespace parser {
+
+namespace {
+
+/// Parte del coste de una cabecera que se atribuye a sus inclusiones del sistema.
+constexpr double kIncludeShare = 0.8;
+
+/// Clave de un grupo: los argumentos unidos por un separador que no aparece en ellos.
+std::string groupKey(const std::vector<std::string>& args) {
+    std::string key;
+    for (const auto& arg : args) {
+        key += arg;
+        key += '\0';
+    }
+    return key;
+}
+
+/// Una cabecera candidata y lo que se sabe de ella.
+struct Candidate {
+    std::size_t job;
+    std::vector<std::string> includes; ///< Ordenadas
+    std::string signature;             ///< Las inclusiones unidas: cabeceras iguales quedan juntas
+    std::size_t bytes;                 ///< Memoria prevista por separado (0 = sin datos)
+};
+
+/// El lote en construcción.
+struct Batch {
+    std::vector<const Candidate*> members;
+    std::unordered_set<std::string> includes;
+    std::size_t bytes = 0;
+    bool measured = true; ///< false si alguna cabecera no tiene previsión de memoria
+};
+
+} // namespace
+
+// --- Clasificación ---
+
+bool UnityBatcher::isHeader(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".h" || extension == ".hh" || extension == ".hpp" || extension == ".hxx" ||
+           extension == ".h++";
+}
+
+std::vector<std::string> UnityBatcher::systemIncludes(const std::string& path) {
+    std::vector<std::string> includes;
+    std::ifstream in(path);
+    for (std::string line; std::getline(in, line);) {
+        std::size_t pos = line.find_first_not_of(" \t");
+        if (pos == std::string::npos || line[pos] != '#') continue;
+        pos = line.find_first_not_of(" \t", pos + 1);
+        if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) continue;
+        pos = line.find_first_not_of(" \t", pos + 7);
+        if (pos == std::string::npos || line[pos] != '<') continue;
+        const std::size_t end = line.find('>', pos);
+        if (end != std::string::npos) includes.push_back(line.substr(pos + 1, end - pos - 1));
+    }
+    std::sort(includes.begin(), includes.end());
+    includes.erase(std::unique(includes.begin(), includes.end()), includes.end());
+    return includes;
+}
+
+// --- Formación de Lotes ---
+
+UnityReport UnityBatcher::apply(std::vector<ParseJob>& jobs,
+                                const std::vector<std::size_t>* memoryEstimates) const {
+    UnityReport report;
+
+    // 1. Agrupar las cabeceras por argumentos idénticos (en orden de aparición)
+    std::map<std::string, std::vector<Candidate>> groups;
+    std::vector<std::vector<Candidate>*> order;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        if (!jobs[i].unityHeaders.empty() || !isHeader(jobs[i].sourceFile)) continue;
+        auto inserted = groups.emplace(groupKey(jobs[i].compileArgs), std::vector<Candidate>());
+        if (inserted.second) order.push_back(&inserted.first->second);
+
+        Candidate candidate{i, systemIncludes(jobs[i].sourceFile), {}, 0};
+        for (const auto& include : candidate.includes) {
+            candidate.signature += include;
+            candidate.signature += '\0';
+        }
+        if (memoryEstimates && i < memoryEstimates->size()) candidate.bytes = (*memoryEstimates)[i];
+        report.systemIncludes += candidate.includes.size();
+        inserted.first->second.push_back(std::move(candidate));
+        ++report.headers;
+    }
+    if (report.headers < 2) {
+        report.unityIncludes = report.systemIncludes;
+        return report;
+    }
+
+    // 2. Tope de cabeceras por lote: al menos un lote por trabajador
+    const unsigned workers = std::max(1u, m_options.workers);
+    const std::size_t perWorker = (report.headers + workers - 1) / workers;
+    const std::size_t cap = std::max<std::size_t>(2, std::min(m_options.maxHeaders, perWorker));
+
+    // 3. Formar los lotes de cada grupo
+    std::vector<Batch> batches;
+    auto close = [&](Batch& batch) {
+        report.unityIncludes += batch.includes.size();
+        if (batch.members.size() > 1) {
+            ++report.batches;
+            report.batchedHeaders += batch.members.size();
+            if (batch.measured) report.largestBatchBytes = std::max(report.largestBatchBytes, batch.bytes);
+            batches.push_back(std::move(batch));
+        }
+        batch = Batch();
+    };
+
+    for (std::vector<Candidate>* group : order) {
+        std::stable_sort(group->begin(), group->end(), [&](const Candidate& a, const Candidate& b) {
+            if (a.signature != b.signature) return a.signature < b.signature;
+            return jobs[a.job].sourceFile < jobs[b.job].sourceFile;
+        });
+
+        Batch batch;
+        for (const Candidate& candidate : *group) {
+            std::size_t present = 0;
+            for (const auto& include : candidate.includes) present += batch.includes.count(include);
+            const double shared = candidate.includes.empty()
+                ? 1.0
+                : static_cast<double>(present) / static_cast<double>(candidate.includes.size());
+            // Lo compartido ya está en memoria; el resto de la cabecera se suma.
+            const auto marginal = static_cast<std::size_t>(static_cast<double>(candidate.bytes) *
+                                                           (1.0 - shared * kIncludeShare));
+            const bool measured = batch.measured && candidate.bytes > 0;
+
+            const bool joins = !batch.members.empty() && batch.members.size() < cap &&
+                               shared >= m_options.minShared &&
+                               (!measured || batch.bytes + marginal <= m_options.batchBytes);
+            if (!joins) {
+                if (!batch.members.empty()) close(batch);
+                batch.bytes = candidate.bytes;
+                batch.measured = candidate.bytes > 0;
+            } else {
+                batch.bytes += marginal;
+                batch.measured = measured;
+            }
+            batch.members.push_back(&candidate);
+            batch.includes.insert(candidate.includes.begin(), candidate.includes.end());
+        }
+        if (!batch.members.empty()) close(batch);
+    }
+
+    // 4. Cada lote sustituye a su primera cabecera (en el orden original)
+    std::vector<long> batchAt(jobs.size(), -1); ///< Lote que empieza en cada trabajo
+    std::vector<bool> absorbed(jobs.size(), false);
+    for (std::size_t b = 0; b < batches.size(); ++b) {
+        std::size_t first = batches[b].members.front()->job;
+        for (const Candidate* member : batches[b].members) {
+            first = std::min(first, member->job);
+            absorbed[member->job] = true;
+        }
+        batchAt[first] = static_cast<long>(b);
+    }
+
+    std::vector<ParseJob> result;
+    result.reserve(jobs.size() - report.batchedHeaders + report.batches);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        if (batchAt[i] >= 0) {
+            const Batch& formed = batches[static_cast<std::size_t>(batchAt[i])];
+            ParseJob batch;
+            batch.sourceFile = "unity:" + jobs[formed.members.front()->job].sourceFile + " (+" +
+                               std::to_string(formed.members.size() - 1) + ")";
+            batch.compileArgs = jobs[formed.members.front()->job].compileArgs;
+            batch.expectedBytes = formed.measured ? formed.bytes : 0;
+            for (const Candidate* member : formed.members) {
+                batch.unityHeaders.push_back(jobs[member->job].sourceFile);
+            }
+            result.push_back(std::move(batch));
+        } else if (!absorbed[i]) {
+            result.push_back(std::move(jobs[i]));
+        }
+    }
+    jobs = std::move(result);
+    return report;
+}
+
+} // namespace parser
+} // namespace cppuml
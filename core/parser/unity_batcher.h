@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "process_pool.h"
+
+namespace cppuml {
+namespace parser {
+
+/**
+ * @brief Configuración del UnityBatcher.
+ */
+struct UnityOptions {
+    unsigned workers = 1;       ///< Análisis simultáneos: se forman al menos tantos lotes como sea posible
+    std::size_t batchBytes = std::size_t(512) << 20; ///< Memoria prevista máxima de un lote
+    std::size_t maxHeaders = 32; ///< Cabeceras como máximo en un lote
+    double minShared = 0.5;     ///< Fracción de las inclusiones '<...>' de una cabecera que el lote ya debe tener
+};
+
+/**
+ * @brief Resultado de 'UnityBatcher::apply'.
+ */
+struct UnityReport {
+    std::size_t headers = 0;          ///< Trabajos de cabeceras candidatos
+    std::size_t batches = 0;          ///< Lotes formados (de 2 o más cabeceras)
+    std::size_t batchedHeaders = 0;   ///< Cabeceras dentro de un lote
+    std::size_t systemIncludes = 0;   ///< Inclusiones '<...>' analizadas cabecera a cabecera
+    std::size_t unityIncludes = 0;    ///< Las mismas, analizadas una vez por lote
+    std::size_t largestBatchBytes = 0; ///< Mayor memoria prevista de un lote (0 = sin datos)
+};
+
+/**
+ * @class UnityBatcher
+ * @brief Sustituye los trabajos de cabeceras por lotes que se analizan juntos.
+ *
+ * Una cabecera sin .cpp propio se analiza como su propia TU y vuelve a leer
+ * las mismas cabeceras del sistema que las demás. Las cabeceras se agrupan
+ * por argumentos de compilación idénticos (como en PchBuilder) y, dentro de
+ * cada grupo, se ordenan por sus inclusiones '<...>' para que las que
+ * comparten más queden juntas; cada lote es un trabajo que
+ * LibClangParser::parseUnity analiza una sola vez.
+ *
+ * El tamaño de cada lote se ajusta solo. Una cabecera se une al lote
+ * abierto si:
+ *   - comparte al menos 'minShared' de sus inclusiones '<...>' con él (si
+ *     no, el lote no ahorra nada y solo ocupa memoria);
+ *   - la memoria prevista del lote sigue dentro de 'batchBytes': la de la
+ *     cabecera más la parte no compartida de las demás, con las
+ *     previsiones del ParseScheduler (sin historial no hay límite);
+ *   - no supera 'maxHeaders' ni deja menos lotes que 'workers', para no
+ *     perder paralelismo ni más de unas pocas cabeceras si libclang cae.
+ * Un lote de una sola cabecera se queda como el trabajo original.
+ *
+ * Las inclusiones se leen del texto (sin analizar ni evaluar '#if'): es
+ * solo una estimación de lo que comparten.
+ */
+class UnityBatcher {
+public:
+    explicit UnityBatcher(UnityOptions options) : m_options(options) {}
+
+    /**
+     * @brief Reemplaza los trabajos de cabeceras por lotes unity.
+     *
+     * Cada lote ocupa el lugar de su primera cabecera; el resto de trabajos
+     * conserva su orden.
+     *
+     * @param memoryEstimates Opcional: memoria prevista de cada trabajo
+     *        (ParseSchedule::memoryEstimates, en el orden de 'jobs').
+     */
+    UnityReport apply(std::vector<ParseJob>& jobs,
+                      const std::vector<std::size_t>* memoryEstimates = nullptr) const;
+
+    /**
+     * @brief true si la ruta tiene extensión de cabecera (.h, .hh, .hpp, .hxx, .h++).
+     */
+    static bool isHeader(const std::string& path);
+
+    /**
+     * @brief Las inclusiones '<...>' de un archivo, ordenadas y sin repetir.
+     */
+    static std::vector<std::string> systemIncludes(const std::string& path);
+
+private:
+    UnityOptions m_options;
+};
+
+} // namespace parser
+} // namespace cppuml
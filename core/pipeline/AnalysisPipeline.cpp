@@ -0,0 +1,133 @@
+#include "pipeline/AnalysisPipeline.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace cppuml {
+namespace pipeline {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+AnalysisPipeline::AnalysisPipeline(Model& model, PipelineOptions options)
+    : m_model(model),
+      m_options(std::move(options)),
+      m_start(Clock::now()),
+      m_parsed(std::max<std::size_t>(1, m_options.queueCapacity)),
+      m_resolved(std::max<std::size_t>(1, m_options.queueCapacity)) {}
+
+AnalysisPipeline::~AnalysisPipeline() {
+    if (!m_finished) finish();
+}
+
+double AnalysisPipeline::elapsed() const {
+    return secondsSince(m_start);
+}
+
+void AnalysisPipeline::start() {
+    if (m_started) return;
+    m_started = true;
+    m_resolveThread = std::thread([this] { resolveStage(); });
+    if (m_options.ndjson) {
+        m_writer = std::make_unique<exporter::NdjsonStreamWriter>(*m_options.ndjson, m_options.ndjsonOptions);
+        m_exportThread = std::thread([this] { exportStage(); });
+    }
+}
+
+void AnalysisPipeline::push(std::size_t index, std::unique_ptr<TranslationUnit> tu) {
+    start();
+    m_parsed.push(Item(index, std::move(tu)));
+}
+
+// --- Etapas ---
+
+void AnalysisPipeline::release(std::unique_ptr<TranslationUnit> tu) {
+    if (!tu) return;
+    m_resolver.add(*tu);
+    TranslationUnit* raw = tu.get();
+    m_model.addTranslationUnit(std::move(tu));
+    ++m_resolveMetrics.items;
+    if (m_options.ndjson) m_resolved.push(raw);
+}
+
+void AnalysisPipeline::resolveStage() {
+    for (Item item; m_parsed.pop(item);) {
+        const auto start = Clock::now();
+        if (!m_options.ordered) {
+            release(std::move(item.second));
+        } else {
+            m_reorder.emplace(item.first, std::move(item.second));
+            m_maxReordered = std::max(m_maxReordered, m_reorder.size());
+            for (auto it = m_reorder.begin(); it != m_reorder.end() && it->first == m_nextIndex;
+                 it = m_reorder.erase(it), ++m_nextIndex) {
+                release(std::move(it->second));
+            }
+        }
+        m_resolveMetrics.busySeconds += secondsSince(start);
+    }
+
+    // Los huecos de trabajos fallidos no notificados ya no se llenarán.
+    const auto start = Clock::now();
+    for (auto& entry : m_reorder) release(std::move(entry.second));
+    m_reorder.clear();
+    m_resolveMetrics.busySeconds += secondsSince(start);
+    m_resolveMetrics.finishedSeconds = elapsed();
+    m_resolved.close();
+}
+
+void AnalysisPipeline::exportStage() {
+    for (TranslationUnit* tu; m_resolved.pop(tu);) {
+        const auto start = Clock::now();
+        // Tras un error de escritura se sigue vaciando la cola: el enlace no debe quedarse esperando.
+        if (m_exportOk) m_exportOk = m_writer->add(*tu);
+        ++m_exportMetrics.items;
+        m_exportMetrics.busySeconds += secondsSince(start);
+    }
+    // El enlace ya terminó: las relaciones del modelo no cambian más.
+    const auto start = Clock::now();
+    if (m_exportOk) m_exportOk = m_writer->finish(m_model);
+    m_exportMetrics.busySeconds += secondsSince(start);
+    m_exportMetrics.finishedSeconds = elapsed();
+}
+
+bool AnalysisPipeline::finish(PipelineReport* report) {
+    if (m_finished) return m_exportOk;
+    const double parseSeconds = elapsed();
+    start();
+    m_parsed.close();
+    m_resolveThread.join();
+    if (m_exportThread.joinable()) m_exportThread.join();
+    m_finished = true;
+
+    // Las bases que apuntan a TUs posteriores se enlazan ahora que nadie
+    // lee el modelo (la exportación escribe el nombre, no el puntero).
+    const std::size_t deferred = m_resolver.pending();
+    const std::size_t unresolved = m_resolver.finish();
+
+    if (!m_exportOk) {
+        std::cerr << "Error: no se pudo escribir la exportación NDJSON" << std::endl;
+    }
+    if (report) {
+        report->resolve = m_resolveMetrics;
+        report->exportStage = m_exportMetrics;
+        report->parsed = m_parsed.metrics();
+        report->resolved = m_resolved.metrics();
+        report->maxReordered = m_maxReordered;
+        report->parseSeconds = parseSeconds;
+        report->totalSeconds = elapsed();
+        report->unresolvedBases = unresolved;
+        report->deferredBases = deferred;
+        if (m_writer) report->ndjson = m_writer->stats();
+    }
+    return m_exportOk;
+}
+
+} // namespace pipeline
+} // namespace cppuml
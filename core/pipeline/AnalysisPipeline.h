@@ -0,0 +1,144 @@
+#ifndef CPP_UML_GENERATOR_CORE_PIPELINE_ANALYSIS_PIPELINE_H
+#define CPP_UML_GENERATOR_CORE_PIPELINE_ANALYSIS_PIPELINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+#include "exporter/NdjsonExporter.h"
+#include "model/Model.h"
+#include "parser/symbol_resolver.h"
+#include "pipeline/SpscQueue.h"
+
+namespace cppuml {
+namespace pipeline {
+
+/**
+ * @brief Configuración de las etapas posteriores al análisis.
+ */
+struct PipelineOptions {
+    std::size_t queueCapacity = 16;     ///< TUs en espera entre dos etapas
+    bool ordered = true;                ///< Entregar las TUs en el orden de los trabajos (salida determinista)
+    std::ostream* ndjson = nullptr;     ///< Si no es nullptr, se exporta en NDJSON a este flujo
+    exporter::NdjsonOptions ndjsonOptions;
+};
+
+/**
+ * @brief Actividad de una etapa.
+ */
+struct StageMetrics {
+    std::size_t items = 0;
+    double busySeconds = 0.0;     ///< Tiempo procesando (el resto, esperando a la etapa anterior)
+    double finishedSeconds = 0.0; ///< Desde el inicio del pipeline hasta que la etapa terminó
+};
+
+/**
+ * @brief Resumen de una ejecución.
+ */
+struct PipelineReport {
+    StageMetrics resolve;
+    StageMetrics exportStage;
+    QueueMetrics parsed;          ///< Análisis -> enlace
+    QueueMetrics resolved;        ///< Enlace -> exportación
+    std::size_t maxReordered = 0; ///< TUs retenidas a la vez para respetar el orden de los trabajos
+    double parseSeconds = 0.0;    ///< Desde el inicio hasta finish() (la fase de análisis)
+    double totalSeconds = 0.0;    ///< Desde el inicio hasta la última etapa
+    std::size_t unresolvedBases = 0;
+    std::size_t deferredBases = 0; ///< Bases que esperaron al final para enlazarse
+    exporter::NdjsonStats ndjson;
+};
+
+/**
+ * @class AnalysisPipeline
+ * @brief Enlaza y exporta cada TU mientras el resto del repositorio se sigue analizando.
+ *
+ * El analizador (el hilo que llama a push(), normalmente desde el
+ * callback del ProcessPool) entrega cada TU en cuanto termina. Dos hilos
+ * la procesan a continuación, unidos por colas acotadas SpscQueue:
+ *
+ *   análisis -> [parsed] -> enlace -> [resolved] -> exportación NDJSON
+ *
+ * El enlace registra la TU en un IncrementalResolver y la añade al
+ * modelo; la exportación escribe sus registros con un NdjsonStreamWriter.
+ * Cuando el análisis termina solo quedan las últimas TUs en vuelo, las
+ * relaciones del modelo y las bases que apuntaban a TUs posteriores: la
+ * latencia total es la del análisis más el procesado de una TU.
+ *
+ * Con 'ordered', una TU que llega antes que las anteriores espera en el
+ * enlace hasta que le toca, y el modelo y la salida son los mismos que con
+ * el análisis por lotes. Los trabajos que fallan deben notificarse con
+ * skip() (o push() con nullptr, como hace el ProcessPool) para no retener
+ * a los siguientes hasta el final.
+ *
+ * Los hilos se crean con el primer push(), así que el ProcessPool ya ha
+ * creado sus trabajadores y su lanzador con fork(); los que se reinicien
+ * después los crea el lanzador, que no tiene estos hilos.
+ */
+class AnalysisPipeline {
+public:
+    AnalysisPipeline(Model& model, PipelineOptions options);
+    ~AnalysisPipeline();
+
+    AnalysisPipeline(const AnalysisPipeline&) = delete;
+    AnalysisPipeline& operator=(const AnalysisPipeline&) = delete;
+
+    /**
+     * @brief Entrega una TU analizada (siempre desde el mismo hilo).
+     * @param index Índice del trabajo; fija su posición con 'ordered'.
+     *
+     * Espera si la cola de enlace está llena.
+     */
+    void push(std::size_t index, std::unique_ptr<TranslationUnit> tu);
+
+    /**
+     * @brief Indica que el trabajo 'index' no producirá ninguna TU.
+     */
+    void skip(std::size_t index) { push(index, nullptr); }
+
+    /**
+     * @brief Cierra la entrada, espera a las etapas y enlaza las bases restantes.
+     * @return false si la exportación no se pudo escribir.
+     */
+    bool finish(PipelineReport* report = nullptr);
+
+private:
+    using Item = std::pair<std::size_t, std::unique_ptr<TranslationUnit>>;
+
+    void start();
+    void resolveStage();
+    void exportStage();
+    void release(std::unique_ptr<TranslationUnit> tu);
+    double elapsed() const;
+
+    Model& m_model;
+    PipelineOptions m_options;
+    std::chrono::steady_clock::time_point m_start;
+
+    SpscQueue<Item> m_parsed;
+    SpscQueue<TranslationUnit*> m_resolved;
+    std::thread m_resolveThread;
+    std::thread m_exportThread;
+    bool m_started = false;
+    bool m_finished = false;
+
+    // Solo los usa el hilo de enlace
+    parser::IncrementalResolver m_resolver;
+    std::map<std::size_t, std::unique_ptr<TranslationUnit>> m_reorder; ///< nullptr = trabajo fallido
+    std::size_t m_nextIndex = 0;
+    std::size_t m_maxReordered = 0;
+    StageMetrics m_resolveMetrics;
+
+    // Solo los usa el hilo de exportación
+    std::unique_ptr<exporter::NdjsonStreamWriter> m_writer;
+    bool m_exportOk = true;
+    StageMetrics m_exportMetrics;
+};
+
+} // namespace pipeline
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_PIPELINE_ANALYSIS_PIPELINE_H
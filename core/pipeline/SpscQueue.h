@@ -0,0 +1,176 @@
+#ifndef CPP_UML_GENERATOR_CORE_PIPELINE_SPSC_QUEUE_H
+#define CPP_UML_GENERATOR_CORE_PIPELINE_SPSC_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace cppuml {
+namespace pipeline {
+
+/**
+ * @brief Estado de una cola entre dos etapas.
+ */
+struct QueueMetrics {
+    std::size_t capacity = 0;
+    std::size_t items = 0;          ///< Elementos que pasaron por la cola
+    std::size_t maxDepth = 0;       ///< Profundidad máxima vista al encolar
+    double meanDepth = 0.0;         ///< Profundidad media vista al encolar
+    std::size_t fullWaits = 0;      ///< Veces que el productor esperó por falta de hueco
+    std::size_t emptyWaits = 0;     ///< Veces que el consumidor esperó por falta de datos
+    double producerWaitSeconds = 0.0;
+    double consumerWaitSeconds = 0.0;
+};
+
+/**
+ * @class SpscQueue
+ * @brief Cola acotada sin bloqueos para un único productor y un único consumidor.
+ *
+ * Un anillo de 'capacity' huecos (redondeado a potencia de dos) con dos
+ * contadores atómicos: el productor solo escribe 'tail' y el consumidor
+ * solo escribe 'head', así que ninguno toma un mutex. Cuando la cola está
+ * llena (o vacía) el lado que espera gira un momento, luego cede el núcleo
+ * y al final duerme en intervalos cortos: entre etapas que tardan
+ * milisegundos por elemento, la espera no cuesta CPU apreciable.
+ *
+ * Los contadores de metrics() son atómicos relajados: se pueden leer desde
+ * cualquier hilo mientras la cola está en uso.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : m_slots(roundUp(capacity)), m_mask(m_slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Encola un elemento, esperando si la cola está llena (solo el productor).
+     * @return false si la cola ya estaba cerrada.
+     */
+    bool push(T value) {
+        if (m_closed.load(std::memory_order_acquire)) return false;
+        const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size()) {
+            m_fullWaits.fetch_add(1, std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            for (unsigned round = 0; tail - m_head.load(std::memory_order_acquire) >= m_slots.size(); ++round) {
+                backoff(round);
+            }
+            addSeconds(m_producerWaitMicros, start);
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        const std::size_t depth = static_cast<std::size_t>(tail + 1 - m_head.load(std::memory_order_relaxed));
+        m_items.fetch_add(1, std::memory_order_relaxed);
+        m_depthSum.fetch_add(depth, std::memory_order_relaxed);
+        if (depth > m_maxDepth.load(std::memory_order_relaxed)) {
+            m_maxDepth.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Desencola un elemento, esperando si la cola está vacía (solo el consumidor).
+     * @return false si la cola está cerrada y vacía.
+     */
+    bool pop(T& value) {
+        const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (m_tail.load(std::memory_order_acquire) == head) {
+            m_emptyWaits.fetch_add(1, std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            for (unsigned round = 0; m_tail.load(std::memory_order_acquire) == head; ++round) {
+                // 'closed' se publica después del último 'tail': si está
+                // cerrada y aún vacía, no llegará nada más.
+                if (m_closed.load(std::memory_order_acquire) && m_tail.load(std::memory_order_acquire) == head) {
+                    addSeconds(m_consumerWaitMicros, start);
+                    return false;
+                }
+                backoff(round);
+            }
+            addSeconds(m_consumerWaitMicros, start);
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Indica que no habrá más elementos (solo el productor).
+     */
+    void close() { m_closed.store(true, std::memory_order_release); }
+
+    std::size_t capacity() const { return m_slots.size(); }
+
+    std::size_t depth() const {
+        return static_cast<std::size_t>(m_tail.load(std::memory_order_acquire) -
+                                        m_head.load(std::memory_order_acquire));
+    }
+
+    QueueMetrics metrics() const {
+        QueueMetrics metrics;
+        metrics.capacity = m_slots.size();
+        metrics.items = m_items.load(std::memory_order_relaxed);
+        metrics.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+        if (metrics.items > 0) {
+            metrics.meanDepth = static_cast<double>(m_depthSum.load(std::memory_order_relaxed)) /
+                                static_cast<double>(metrics.items);
+        }
+        metrics.fullWaits = m_fullWaits.load(std::memory_order_relaxed);
+        metrics.emptyWaits = m_emptyWaits.load(std::memory_order_relaxed);
+        metrics.producerWaitSeconds = m_producerWaitMicros.load(std::memory_order_relaxed) / 1e6;
+        metrics.consumerWaitSeconds = m_consumerWaitMicros.load(std::memory_order_relaxed) / 1e6;
+        return metrics;
+    }
+
+private:
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    static void backoff(unsigned round) {
+        if (round < 64) {
+            // Giro corto: el otro lado suele estar a punto de terminar.
+        } else if (round < 128) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(round < 1024 ? 50 : 500));
+        }
+    }
+
+    static void addSeconds(std::atomic<std::uint64_t>& micros, std::chrono::steady_clock::time_point start) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        micros.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    }
+
+    std::vector<T> m_slots;
+    const std::uint64_t m_mask;
+
+    // Cada contador en su propia línea de caché: el productor y el
+    // consumidor no se invalidan mutuamente al avanzar.
+    alignas(64) std::atomic<std::uint64_t> m_head{0}; ///< Siguiente hueco a leer (consumidor)
+    alignas(64) std::atomic<std::uint64_t> m_tail{0}; ///< Siguiente hueco a escribir (productor)
+    alignas(64) std::atomic<bool> m_closed{false};
+
+    std::atomic<std::size_t> m_items{0};
+    std::atomic<std::size_t> m_depthSum{0};
+    std::atomic<std::size_t> m_maxDepth{0};
+    std::atomic<std::size_t> m_fullWaits{0};
+    std::atomic<std::size_t> m_emptyWaits{0};
+    std::atomic<std::uint64_t> m_producerWaitMicros{0};
+    std::atomic<std::uint64_t> m_consumerWaitMicros{0};
+};
+
+} // namespace pipeline
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_PIPELINE_SPSC_QUEUE_H
@@ -0,0 +1,386 @@
+#include "search/SymbolIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <unordered_set>
+
+#include "model/Class.h"
+#include "model/ModelVisitor.h"
+#include "model/Namespace.h"
+
+namespace cppuml {
+namespace search {
+
+namespace {
+
+// --- Utilidades de Ayuda ---
+
+std::string toLower(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+std::uint32_t packTrigram(const char* p) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(p[0])) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(p[2]));
+}
+
+/**
+ * @brief Trigramas únicos de un texto (ya en minúsculas).
+ */
+std::vector<std::uint32_t> trigramsOf(std::string_view text) {
+    std::vector<std::uint32_t> out;
+    if (text.size() < 3) return out;
+    out.reserve(text.size() - 2);
+    for (std::size_t i = 0; i + 3 <= text.size(); ++i) out.push_back(packTrigram(text.data() + i));
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+/**
+ * @brief Un contador por símbolo para la consulta en curso, reutilizado por
+ *        todas las consultas del hilo.
+ *
+ * Está a cero entre consultas: cada una limpia solo las posiciones que
+ * tocó, así que una pulsación de tecla no reserva ni recorre un arreglo del
+ * tamaño del índice. Al ser por hilo, las consultas (const) pueden seguir
+ * lanzándose en paralelo.
+ */
+std::vector<std::uint8_t>& symbolCounters(std::size_t symbols) {
+    thread_local std::vector<std::uint8_t> counters;
+    if (counters.size() < symbols) counters.resize(symbols, 0);
+    return counters;
+}
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * @brief Ordena por puntuación (desc.) y longitud del nombre (asc.), y recorta.
+ */
+void rankAndTrim(std::vector<SearchHit>& hits, std::size_t limit) {
+    auto better = [](const SearchHit& a, const SearchHit& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.entry->qualifiedName.size() < b.entry->qualifiedName.size();
+    };
+    if (limit && hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(limit), hits.end(), better);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+}
+
+/**
+ * @brief Las entradas de una TU, en orden de recorrido (el namespace global
+ *        "::" no se indexa a sí mismo).
+ */
+struct EntryCollector : ModelVisitor<EntryCollector> {
+    std::vector<SymbolEntry> entries;
+    std::vector<std::size_t> scopes; ///< Entrada de cada namespace o clase abierta
+    const Namespace* global = nullptr;
+
+    bool enterUnit(const TranslationUnit& tu) {
+        global = tu.getGlobalNamespace();
+        return true;
+    }
+    bool enterNamespace(const Namespace& ns) {
+        if (&ns != global) open(ns);
+        return true;
+    }
+    void leaveNamespace(const Namespace& ns) {
+        if (&ns != global) scopes.pop_back();
+    }
+    bool enterClass(const Class& cls) {
+        open(cls);
+        return true;
+    }
+    void leaveClass(const Class&) { scopes.pop_back(); }
+    void visitField(const Field& field, const Class&) { add(field); }
+    void visitMethod(const Method& method, const Class&) { add(method); }
+
+    void add(const Element& element) {
+        if (scopes.empty()) {
+            entries.push_back(SymbolEntry{element.getName(), element.getName(), element.getKind(), &element, nullptr});
+            return;
+        }
+        const SymbolEntry& owner = entries[scopes.back()];
+        std::string qualified = owner.qualifiedName + "::" + element.getName();
+        const Element* ownerElement = owner.element;
+        entries.push_back(SymbolEntry{std::move(qualified), element.getName(), element.getKind(), &element,
+                                      ownerElement});
+    }
+    void open(const Element& element) {
+        add(element);
+        scopes.push_back(entries.size() - 1);
+    }
+};
+
+} // namespace
+
+// --- Construcción ---
+
+void SymbolIndex::build(const Model& model) {
+    m_entries.clear();
+    m_loweredSimple.clear();
+    m_loweredQualified.clear();
+    m_exact.clear();
+    m_simplePrefix.clear();
+    m_qualifiedPrefix.clear();
+    m_trigrams.clear();
+
+    // 1. Recolectar cada TU por separado (en paralelo) y unir en orden.
+    std::vector<std::vector<SymbolEntry>> perUnit(model.getTranslationUnits().size());
+    forEachUnitParallel(model, 0, [&](const TranslationUnit& tu, std::size_t index) {
+        EntryCollector collector;
+        collector.traverse(tu);
+        perUnit[index] = std::move(collector.entries);
+    });
+    std::size_t total = 0;
+    for (const auto& entries : perUnit) total += entries.size();
+    m_entries.reserve(total); // Sin realocaciones: las vistas de 'merged' siguen válidas
+
+    // Una cabecera incluida desde varias TUs aporta sus símbolos una sola vez:
+    // cada clase es la de la primera TU que la define (con sus miembros, como
+    // en RelationshipGraph) y cada namespace se indexa una vez, aunque sus
+    // clases nuevas se sigan añadiendo desde cualquier TU.
+    std::unordered_set<std::string_view> merged;
+    for (auto& entries : perUnit) {
+        std::string skipped; // Clase repetida cuyo subárbol se descarta
+        for (auto& entry : entries) {
+            if (!skipped.empty()) {
+                if (entry.qualifiedName.size() > skipped.size() + 2 &&
+                    entry.qualifiedName.compare(0, skipped.size(), skipped) == 0 &&
+                    entry.qualifiedName.compare(skipped.size(), 2, "::") == 0) {
+                    continue;
+                }
+                skipped.clear();
+            }
+            const bool scope = entry.kind == ElementKind::Class || entry.kind == ElementKind::Namespace;
+            if (scope && merged.count(entry.qualifiedName)) {
+                if (entry.kind == ElementKind::Class) skipped = entry.qualifiedName;
+                continue;
+            }
+            m_entries.push_back(std::move(entry));
+            if (scope) merged.insert(m_entries.back().qualifiedName);
+        }
+    }
+
+    // 2. Indexar. Las vistas se crean después de llenar los vectores para
+    //    que ninguna realocación las invalide.
+    const std::size_t count = m_entries.size();
+    m_loweredSimple.reserve(count);
+    m_loweredQualified.reserve(count);
+    for (const auto& entry : m_entries) {
+        m_loweredSimple.push_back(toLower(entry.name));
+        m_loweredQualified.push_back(toLower(entry.qualifiedName));
+    }
+
+    m_exact.reserve(count);
+    m_simplePrefix.reserve(count);
+    m_qualifiedPrefix.reserve(count);
+    for (SymbolId id = 0; id < count; ++id) {
+        m_exact[m_entries[id].qualifiedName].push_back(id);
+        m_simplePrefix.emplace_back(m_loweredSimple[id], id);
+        m_qualifiedPrefix.emplace_back(m_loweredQualified[id], id);
+
+        // Se recorren en orden creciente de id: basta comparar con el último.
+        const std::string& lowered = m_loweredSimple[id];
+        for (std::size_t i = 0; i + 3 <= lowered.size(); ++i) {
+            auto& postings = m_trigrams[packTrigram(lowered.data() + i)];
+            if (postings.empty() || postings.back() != id) postings.push_back(id);
+        }
+    }
+    std::sort(m_simplePrefix.begin(), m_simplePrefix.end());
+    std::sort(m_qualifiedPrefix.begin(), m_qualifiedPrefix.end());
+}
+
+// --- Consultas ---
+
+std::vector<const SymbolEntry*> SymbolIndex::find(std::string_view qualifiedName) const {
+    std::vector<const SymbolEntry*> out;
+    auto it = m_exact.find(qualifiedName);
+    if (it != m_exact.end()) {
+        for (SymbolId id : it->second) out.push_back(&m_entries[id]);
+    }
+    return out;
+}
+
+std::vector<SearchHit> SymbolIndex::search(std::string_view query, MatchMode mode, std::size_t limit) const {
+    if (query.empty()) return {};
+
+    switch (mode) {
+        case MatchMode::Exact: {
+            std::vector<SearchHit> hits;
+            for (const SymbolEntry* entry : find(query)) hits.push_back(SearchHit{entry, 1.0});
+            if (limit && hits.size() > limit) hits.resize(limit);
+            return hits;
+        }
+        case MatchMode::Prefix:
+            return searchPrefix(toLower(query), limit);
+        case MatchMode::Substring:
+            return searchSubstring(toLower(query), limit);
+        case MatchMode::Fuzzy:
+            return searchFuzzy(toLower(query), limit);
+    }
+    return {};
+}
+
+std::vector<SearchHit> SymbolIndex::searchPrefix(const std::string& lowered, std::size_t limit) const {
+    std::vector<SearchHit> hits;
+    std::vector<std::uint8_t>& seen = symbolCounters(m_entries.size());
+
+    const std::string_view key(lowered);
+    for (const auto* table : {&m_simplePrefix, &m_qualifiedPrefix}) {
+        auto it = std::lower_bound(table->begin(), table->end(), key,
+                                   [](const auto& item, std::string_view k) { return item.first < k; });
+        for (; it != table->end() && startsWith(it->first, key); ++it) {
+            if (seen[it->second]) continue;
+            seen[it->second] = 1;
+            const double score = static_cast<double>(key.size()) / static_cast<double>(it->first.size());
+            hits.push_back(SearchHit{&m_entries[it->second], score});
+        }
+    }
+    for (const auto& hit : hits) {
+        seen[static_cast<SymbolId>(hit.entry - m_entries.data())] = 0;
+    }
+
+    rankAndTrim(hits, limit);
+    return hits;
+}
+
+std::vector<SearchHit> SymbolIndex::searchSubstring(const std::string& lowered, std::size_t limit) const {
+    // Si la consulta está calificada ("ns::Cla"), los candidatos se buscan por
+    // el último segmento y se verifican contra el nombre calificado completo.
+    const std::size_t sep = lowered.rfind("::");
+    const bool qualified = sep != std::string::npos;
+    const std::string tail = qualified ? lowered.substr(sep + 2) : lowered;
+    if (tail.empty()) {
+        return searchPrefix(lowered, limit);
+    }
+
+    std::vector<SearchHit> hits;
+
+    // 1. Primer nivel: el nombre simple empieza por la consulta (ya ordenado).
+    if (!qualified) {
+        auto it = std::lower_bound(m_simplePrefix.begin(), m_simplePrefix.end(), std::string_view(tail),
+                                   [](const auto& item, std::string_view k) { return item.first < k; });
+        for (; it != m_simplePrefix.end() && startsWith(it->first, tail); ++it) {
+            hits.push_back(SearchHit{&m_entries[it->second], it->first.size() == tail.size() ? 1.0 : 0.9});
+        }
+        if (limit && hits.size() >= limit) {
+            rankAndTrim(hits, limit);
+            return hits;
+        }
+    }
+
+    // 2. Segundo nivel: subcadena en cualquier posición.
+    const std::size_t wanted = limit ? limit * 4 : 0;
+    auto consider = [&](SymbolId id) {
+        const std::string& simple = m_loweredSimple[id];
+        if (qualified) {
+            if (m_loweredQualified[id].find(lowered) == std::string::npos) return;
+            hits.push_back(SearchHit{&m_entries[id], startsWith(simple, tail) ? 0.9 : 0.7});
+        } else if (!startsWith(simple, tail) && simple.find(tail) != std::string::npos) {
+            hits.push_back(SearchHit{&m_entries[id], 0.7});
+        }
+    };
+
+    const auto queryTrigrams = trigramsOf(tail);
+    if (queryTrigrams.empty()) {
+        // Segmentos de 1-2 caracteres: recorrido lineal con corte temprano.
+        for (SymbolId id = 0; id < m_entries.size() && !(wanted && hits.size() >= wanted); ++id) {
+            consider(id);
+        }
+        rankAndTrim(hits, limit);
+        return hits;
+    }
+
+    for (SymbolId id : candidatesFor(queryTrigrams)) {
+        consider(id);
+        if (wanted && hits.size() >= wanted) break;
+    }
+    rankAndTrim(hits, limit);
+    return hits;
+}
+
+std::vector<SymbolIndex::SymbolId> SymbolIndex::candidatesFor(const std::vector<Trigram>& trigrams) const {
+    // Intersección de las listas de trigramas, empezando por la más corta.
+    std::vector<const std::vector<SymbolId>*> lists;
+    for (Trigram t : trigrams) {
+        auto it = m_trigrams.find(t);
+        if (it == m_trigrams.end()) return {};
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    std::vector<SymbolId> candidates = *lists.front();
+    std::vector<SymbolId> next;
+    for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        next.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+                              lists[i]->begin(), lists[i]->end(), std::back_inserter(next));
+        candidates.swap(next);
+    }
+    return candidates;
+}
+
+std::vector<SearchHit> SymbolIndex::searchFuzzy(const std::string& lowered, std::size_t limit) const {
+    const std::size_t sep = lowered.rfind("::");
+    const std::string tail = sep == std::string::npos ? lowered : lowered.substr(sep + 2);
+    auto queryTrigrams = trigramsOf(tail);
+    if (queryTrigrams.size() <= 2) {
+        return searchSubstring(lowered, limit);
+    }
+
+    // Una subcadena exacta siempre es mejor que una coincidencia aproximada:
+    // si ya hay suficientes, no hace falta contar trigramas.
+    std::vector<SearchHit> hits = searchSubstring(lowered, limit);
+    if (limit && hits.size() >= limit) {
+        return hits;
+    }
+
+    // Cuenta cuántos trigramas de la consulta comparte cada nombre simple.
+    if (queryTrigrams.size() > 255) queryTrigrams.resize(255);
+    std::vector<std::uint8_t>& shared = symbolCounters(m_entries.size());
+    const std::size_t exactHits = hits.size();
+    for (const auto& hit : hits) {
+        shared[static_cast<SymbolId>(hit.entry - m_entries.data())] = 255; // Ya incluidos
+    }
+
+    std::vector<SymbolId> touched;
+    for (Trigram t : queryTrigrams) {
+        auto it = m_trigrams.find(t);
+        if (it == m_trigrams.end()) continue;
+        for (SymbolId id : it->second) {
+            if (shared[id] == 255) continue;
+            if (shared[id]++ == 0) touched.push_back(id);
+        }
+    }
+
+    const std::size_t total = queryTrigrams.size();
+    const std::size_t threshold = (total + 1) / 2;
+    for (SymbolId id : touched) {
+        if (shared[id] < threshold) continue;
+        // Similitud de Dice entre los trigramas de la consulta y los del nombre.
+        const std::size_t nameTrigrams = m_loweredSimple[id].size() >= 3 ? m_loweredSimple[id].size() - 2 : 1;
+        const double dice = 2.0 * shared[id] / static_cast<double>(total + nameTrigrams);
+        hits.push_back(SearchHit{&m_entries[id], std::min(0.69, dice)});
+    }
+
+    for (SymbolId id : touched) shared[id] = 0;
+    for (std::size_t i = 0; i < exactHits; ++i) {
+        shared[static_cast<SymbolId>(hits[i].entry - m_entries.data())] = 0;
+    }
+
+    rankAndTrim(hits, limit);
+    return hits;
+}
+
+} // namespace search
+} // namespace cppuml
@@ -0,0 +1,137 @@
+#ifndef CPP_UML_GENERATOR_CORE_SEARCH_SYMBOL_INDEX_H
+#define CPP_UML_GENERATOR_CORE_SEARCH_SYMBOL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "model/Element.h"
+#include "model/Model.h"
+
+namespace cppuml {
+namespace search {
+
+/**
+ * @brief Un símbolo indexado (namespace, clase, campo o método).
+ */
+struct SymbolEntry {
+    std::string qualifiedName;      ///< p.ej., "ui::Window::add"
+    std::string name;               ///< p.ej., "add"
+    ElementKind kind = ElementKind::Element;
+    const Element* element = nullptr; ///< Puntero no propietario al elemento del modelo
+    const Element* owner = nullptr;   ///< Clase o namespace que lo contiene (puede ser nulo)
+};
+
+/**
+ * @brief Estrategia de coincidencia de una consulta.
+ */
+enum class MatchMode {
+    Exact,     ///< Nombre calificado completo, sensible a mayúsculas
+    Prefix,    ///< Prefijo del nombre simple o calificado, sin distinguir mayúsculas
+    Substring, ///< Subcadena del nombre (o del calificado si contiene "::"), sin distinguir mayúsculas
+    Fuzzy      ///< Similitud por trigramas (tolera errores de tecleo)
+};
+
+/**
+ * @brief Un resultado de búsqueda.
+ */
+struct SearchHit {
+    const SymbolEntry* entry = nullptr;
+    double score = 0.0; ///< 1.0 = coincidencia perfecta
+};
+
+/**
+ * @class SymbolIndex
+ * @brief Índice de símbolos del modelo, construido una vez tras el análisis.
+ *
+ * Evita recorrer 'Namespace::getMembers()' en cada consulta:
+ *   - Exacta: tabla hash por nombre calificado, O(1).
+ *   - Prefijo: arreglos ordenados de nombres en minúsculas (equivalente a
+ *     un trie compacto), O(log N + k) por consulta.
+ *   - Subcadena y difusa: índice invertido de trigramas sobre el nombre
+ *     simple; solo se verifican los candidatos que comparten trigramas.
+ *     Una consulta calificada ("ui::Win") se resuelve por su último segmento
+ *     y se verifica contra el nombre calificado.
+ *
+ * Está pensado para búsqueda incremental (cada pulsación de tecla), por lo
+ * que todas las consultas aceptan un límite de resultados.
+ *
+ * Una clase incluida desde varias TUs se indexa una sola vez (la copia de
+ * la primera TU que la define, como en RelationshipGraph), igual que cada
+ * namespace: un símbolo de una cabecera da un único resultado.
+ *
+ * El índice guarda punteros al modelo: debe reconstruirse si el modelo cambia.
+ */
+class SymbolIndex {
+public:
+    SymbolIndex() = default;
+
+    /**
+     * @brief Construye el índice a partir de un modelo.
+     */
+    explicit SymbolIndex(const Model& model) { build(model); }
+
+    // Las vistas internas apuntan a las cadenas propias: mover es seguro
+    // (el búfer del vector se transfiere), copiar no.
+    SymbolIndex(const SymbolIndex&) = delete;
+    SymbolIndex& operator=(const SymbolIndex&) = delete;
+    SymbolIndex(SymbolIndex&&) = default;
+    SymbolIndex& operator=(SymbolIndex&&) = default;
+
+    /**
+     * @brief (Re)construye el índice completo.
+     */
+    void build(const Model& model);
+
+    /**
+     * @brief Busca todos los símbolos con ese nombre calificado (sobrecargas incluidas).
+     */
+    std::vector<const SymbolEntry*> find(std::string_view qualifiedName) const;
+
+    /**
+     * @brief Ejecuta una consulta.
+     * @param query El texto escrito por el usuario.
+     * @param mode La estrategia de coincidencia.
+     * @param limit Número máximo de resultados (0 = sin límite).
+     * @return Resultados ordenados por relevancia.
+     */
+    std::vector<SearchHit> search(std::string_view query, MatchMode mode, std::size_t limit = 50) const;
+
+    /**
+     * @brief Número de símbolos indexados.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    const std::vector<SymbolEntry>& getEntries() const { return m_entries; }
+
+private:
+    using SymbolId = std::uint32_t;
+    using Trigram = std::uint32_t;
+
+    std::vector<SearchHit> searchPrefix(const std::string& lowered, std::size_t limit) const;
+    std::vector<SearchHit> searchSubstring(const std::string& lowered, std::size_t limit) const;
+    std::vector<SearchHit> searchFuzzy(const std::string& lowered, std::size_t limit) const;
+    std::vector<SymbolId> candidatesFor(const std::vector<Trigram>& trigrams) const;
+
+    std::vector<SymbolEntry> m_entries;
+    std::vector<std::string> m_loweredSimple;
+    std::vector<std::string> m_loweredQualified;
+
+    std::unordered_map<std::string_view, std::vector<SymbolId>> m_exact;
+
+    // Pares (nombre en minúsculas, id) ordenados para la búsqueda por prefijo.
+    std::vector<std::pair<std::string_view, SymbolId>> m_simplePrefix;
+    std::vector<std::pair<std::string_view, SymbolId>> m_qualifiedPrefix;
+
+    // Índice invertido sobre el nombre simple: trigrama -> ids (ordenados, sin repetidos).
+    std::unordered_map<Trigram, std::vector<SymbolId>> m_trigrams;
+};
+
+} // namespace search
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_SEARCH_SYMBOL_INDEX_H
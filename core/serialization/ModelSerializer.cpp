@@ -0,0 +1,504 @@
+#include "serialization/ModelSerializer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+#include "model/Type.h"
+#include "parser/symbol_resolver.h"
+
+namespace cppuml {
+namespace serialization {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'U', 'M', 'L'};
+constexpr char kSnapshotMagic[4] = {'C', 'U', 'M', 'S'};
+constexpr std::uint64_t kVersion = 4;
+
+/// Bit de las banderas de un Type: enlazado a una instanciación (sigue una referencia, no nombre y argumentos).
+constexpr std::uint8_t kBoundType = 32;
+
+/**
+ * @brief Instanciaciones ya leídas en el proceso, por tipo canónico.
+ *
+ * Cada trabajador del ProcessPool (y cada bloque de una instantánea) envía
+ * sus instanciaciones completas; al leerlas, la misma especialización vista
+ * en miles de TUs vuelve a ser un solo TemplateBinding compartido, como en
+ * el análisis en el propio proceso. Se guardan con weak_ptr: una
+ * instanciación que ningún modelo usa ya se libera.
+ */
+class BindingInterner {
+public:
+    std::shared_ptr<const TemplateBinding> intern(std::shared_ptr<const TemplateBinding> binding) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::weak_ptr<const TemplateBinding>& slot = m_bindings[binding->canonicalName];
+        if (auto existing = slot.lock()) {
+            return existing;
+        }
+        slot = binding;
+        if (m_bindings.size() >= m_sweepAt) {
+            // Limpieza amortizada de las entradas caducadas.
+            for (auto it = m_bindings.begin(); it != m_bindings.end();) {
+                it = it->second.expired() ? m_bindings.erase(it) : std::next(it);
+            }
+            m_sweepAt = std::max<std::size_t>(1024, m_bindings.size() * 2);
+        }
+        return binding;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::weak_ptr<const TemplateBinding>> m_bindings;
+    std::size_t m_sweepAt = 1024;
+};
+
+BindingInterner& bindingInterner() {
+    static BindingInterner interner;
+    return interner;
+}
+
+// --- Escritura ---
+
+class Writer {
+public:
+    explicit Writer(std::string& out) : m_out(out) {}
+
+    void varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            m_out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        m_out += static_cast<char>(value);
+    }
+
+    void byte(std::uint8_t value) { m_out += static_cast<char>(value); }
+
+    void string(const std::string& value) {
+        varint(value.size());
+        m_out += value;
+    }
+
+    void type(const Type& t) {
+        const bool bound = t.getBinding() != nullptr;
+        byte(static_cast<std::uint8_t>((t.isConst() ? 1 : 0) | (t.isVolatile() ? 2 : 0) |
+                                       (t.isPointer() ? 4 : 0) | (t.isReference() ? 8 : 0) |
+                                       (t.isUnresolved() ? 16 : 0) | (bound ? kBoundType : 0)));
+        if (bound) {
+            binding(*t.getBinding());
+            return;
+        }
+        string(t.getName());
+        varint(t.getTemplateParameters().size());
+        for (const auto& param : t.getTemplateParameters()) type(param);
+    }
+
+    void field(const Field& f) {
+        string(f.getName());
+        byte(static_cast<std::uint8_t>(f.getVisibility()));
+        type(f.getType());
+        byte(f.isStatic() ? 1 : 0);
+    }
+
+    void method(const Method& m) {
+        string(m.getName());
+        byte(static_cast<std::uint8_t>(m.getVisibility()));
+        type(m.getReturnType());
+        byte(static_cast<std::uint8_t>((m.isStatic() ? 1 : 0) | (m.isConst() ? 2 : 0) |
+                                       (m.isVirtual() ? 4 : 0) | (m.isPureVirtual() ? 8 : 0)));
+        varint(m.getParameters().size());
+        for (const auto& param : m.getParameters()) field(*param);
+    }
+
+    void cls(const Class& c) {
+        string(c.getName());
+        byte(static_cast<std::uint8_t>(c.getVisibility()));
+        byte(static_cast<std::uint8_t>(c.getClassKind()));
+        varint(c.getFields().size());
+        for (const auto& f : c.getFields()) field(*f);
+        varint(c.getMethods().size());
+        for (const auto& m : c.getMethods()) method(*m);
+        varint(c.getBaseClasses().size());
+        for (const auto& base : c.getBaseClasses()) {
+            byte(static_cast<std::uint8_t>(base.visibility));
+            string(base.baseName);
+        }
+        varint(c.getTemplateParameters().size());
+        for (const auto& param : c.getTemplateParameters()) {
+            string(param.name);
+            string(param.kind);
+            string(param.defaultArgument);
+            byte(param.isPack ? 1 : 0);
+        }
+        string(c.getSpecializedTemplate());
+    }
+
+    /// Cada instanciación se escribe entera la primera vez; después, su número (desde 1).
+    void binding(const TemplateBinding& b) {
+        const auto inserted = m_bindings.emplace(&b, m_bindings.size() + 1);
+        if (!inserted.second) {
+            varint(inserted.first->second);
+            return;
+        }
+        varint(0);
+        string(b.canonicalName);
+        string(b.templateName);
+        varint(b.arguments.size());
+        for (const auto& argument : b.arguments) type(argument);
+    }
+
+    void element(const Element& e) {
+        byte(static_cast<std::uint8_t>(e.getKind()));
+        switch (e.getKind()) {
+            case ElementKind::Namespace: namespaceBody(static_cast<const Namespace&>(e)); break;
+            case ElementKind::Class:     cls(static_cast<const Class&>(e)); break;
+            case ElementKind::Field:     field(static_cast<const Field&>(e)); break;
+            case ElementKind::Method:    method(static_cast<const Method&>(e)); break;
+            default:                     string(e.getName()); break;
+        }
+    }
+
+    void namespaceBody(const Namespace& ns) {
+        string(ns.getName());
+        varint(ns.getMembers().size());
+        for (const auto& member : ns.getMembers()) element(*member);
+    }
+
+private:
+    std::string& m_out;
+    std::unordered_map<const TemplateBinding*, std::uint64_t> m_bindings; ///< Ya escritas, con su número
+};
+
+// --- Lectura ---
+
+class Reader {
+public:
+    explicit Reader(std::string_view data) : m_data(data) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos == m_data.size(); }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_data.size()) return fail();
+            const auto b = static_cast<std::uint8_t>(m_data[m_pos++]);
+            value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        return fail();
+    }
+
+    std::uint8_t byte() {
+        if (m_pos >= m_data.size()) return static_cast<std::uint8_t>(fail());
+        return static_cast<std::uint8_t>(m_data[m_pos++]);
+    }
+
+    std::string string() {
+        return std::string(view());
+    }
+
+    /// Como string(), pero sin copiar (válido mientras vivan los datos).
+    std::string_view view() {
+        const std::uint64_t len = varint();
+        if (!m_ok || len > m_data.size() - m_pos) {
+            fail();
+            return {};
+        }
+        std::string_view value = m_data.substr(m_pos, static_cast<std::size_t>(len));
+        m_pos += static_cast<std::size_t>(len);
+        return value;
+    }
+
+    /// Lee un contador y lo valida contra los bytes restantes (cada entrada ocupa >= 1 byte).
+    std::size_t count() {
+        const std::uint64_t n = varint();
+        if (n > m_data.size() - m_pos) return static_cast<std::size_t>(fail());
+        return static_cast<std::size_t>(n);
+    }
+
+    bool magic(const char (&expected)[4] = kMagic) {
+        if (m_data.size() < sizeof(expected) ||
+            m_data.compare(0, sizeof(expected), std::string_view(expected, sizeof(expected))) != 0) {
+            return fail() != 0;
+        }
+        m_pos = sizeof(expected);
+        return varint() == kVersion && m_ok;
+    }
+
+    Visibility visibility() {
+        const std::uint8_t v = byte();
+        if (v > static_cast<std::uint8_t>(Visibility::Private)) fail();
+        return static_cast<Visibility>(v);
+    }
+
+    Type type(int depth = 0) {
+        const std::uint8_t flags = byte();
+        if (depth > 64) {
+            fail(); // Anidamiento patológico: datos corruptos
+            return Type(std::string());
+        }
+        Type t((flags & kBoundType) ? std::string() : string());
+        if (flags & kBoundType) {
+            t.setBinding(binding(depth + 1));
+        }
+        t.setConst(flags & 1);
+        t.setVolatile(flags & 2);
+        t.setPointer(flags & 4);
+        t.setReference(flags & 8);
+        t.setUnresolved(flags & 16);
+        if (!(flags & kBoundType)) {
+            const std::size_t params = count();
+            for (std::size_t i = 0; i < params && m_ok; ++i) t.addTemplateParameter(type(depth + 1));
+        }
+        return t;
+    }
+
+    std::unique_ptr<Field> field() {
+        std::string name = string();
+        const Visibility vis = visibility();
+        auto f = std::make_unique<Field>(std::move(name), type());
+        f->setVisibility(vis);
+        f->setStatic(byte() != 0);
+        return f;
+    }
+
+    std::unique_ptr<Method> method() {
+        std::string name = string();
+        const Visibility vis = visibility();
+        auto m = std::make_unique<Method>(std::move(name), type());
+        m->setVisibility(vis);
+        const std::uint8_t flags = byte();
+        m->setStatic(flags & 1);
+        m->setConst(flags & 2);
+        m->setVirtual(flags & 4);
+        if (flags & 8) m->setPureVirtual();
+        const std::size_t params = count();
+        for (std::size_t i = 0; i < params && m_ok; ++i) m->addParameter(field());
+        return m;
+    }
+
+    std::unique_ptr<Class> cls() {
+        std::string name = string();
+        const Visibility vis = visibility();
+        const std::uint8_t kind = byte();
+        if (kind > static_cast<std::uint8_t>(ClassKind::Union)) fail();
+        auto c = std::make_unique<Class>(std::move(name), static_cast<ClassKind>(kind));
+        c->setVisibility(vis);
+
+        std::size_t n = count();
+        for (std::size_t i = 0; i < n && m_ok; ++i) c->addField(field());
+        n = count();
+        for (std::size_t i = 0; i < n && m_ok; ++i) c->addMethod(method());
+        n = count();
+        for (std::size_t i = 0; i < n && m_ok; ++i) {
+            const Visibility baseVis = visibility();
+            c->addBaseClass(string(), baseVis);
+        }
+        n = count();
+        for (std::size_t i = 0; i < n && m_ok; ++i) {
+            TemplateParameter param;
+            param.name = string();
+            param.kind = string();
+            param.defaultArgument = string();
+            param.isPack = byte() != 0;
+            c->addTemplateParameter(std::move(param));
+        }
+        c->setSpecializedTemplate(string());
+        return c;
+    }
+
+    /// Una instanciación (o una referencia a una ya leída), compartida con el resto del proceso.
+    std::shared_ptr<const TemplateBinding> binding(int depth = 0) {
+        const std::uint64_t ref = varint();
+        if (ref != 0) {
+            if (ref > m_bindings.size() || !m_bindings[static_cast<std::size_t>(ref - 1)]) {
+                fail(); // Referencia a una instanciación que no se ha leído
+                return nullptr;
+            }
+            return m_bindings[static_cast<std::size_t>(ref - 1)];
+        }
+
+        // El número se reserva antes de leer los argumentos (que pueden traer otras).
+        const std::size_t slot = m_bindings.size();
+        m_bindings.emplace_back();
+        auto b = std::make_shared<TemplateBinding>();
+        b->canonicalName = string();
+        b->templateName = string();
+        const std::size_t n = count();
+        for (std::size_t i = 0; i < n && m_ok; ++i) b->arguments.push_back(type(depth));
+        if (!m_ok) {
+            return nullptr;
+        }
+        m_bindings[slot] = bindingInterner().intern(std::move(b));
+        return m_bindings[slot];
+    }
+
+    std::unique_ptr<Element> element(int depth) {
+        const auto kind = static_cast<ElementKind>(byte());
+        switch (kind) {
+            case ElementKind::Namespace: {
+                auto ns = std::make_unique<Namespace>(std::string());
+                namespaceBody(*ns, depth + 1);
+                return ns;
+            }
+            case ElementKind::Class:  return cls();
+            case ElementKind::Field:  return field();
+            case ElementKind::Method: return method();
+            default:
+                fail();
+                return nullptr;
+        }
+    }
+
+    void namespaceBody(Namespace& ns, int depth = 0) {
+        ns.setName(string());
+        const std::size_t n = count();
+        if (depth > 256) {
+            fail();
+            return;
+        }
+        for (std::size_t i = 0; i < n && m_ok; ++i) {
+            auto member = element(depth);
+            if (member) ns.addMember(std::move(member));
+        }
+    }
+
+private:
+    std::uint64_t fail() {
+        m_ok = false;
+        m_pos = m_data.size();
+        return 0;
+    }
+
+    std::string_view m_data;
+    std::size_t m_pos = 0;
+    bool m_ok = true;
+    std::vector<std::shared_ptr<const TemplateBinding>> m_bindings; ///< Leídas, por número - 1
+};
+
+} // namespace
+
+// --- API Pública ---
+
+void ModelSerializer::serialize(const TranslationUnit& tu, std::string& out) {
+    out.append(kMagic, sizeof(kMagic));
+    Writer writer(out);
+    writer.varint(kVersion);
+    writer.string(tu.getName());
+    writer.varint(tu.getIncludedFiles().size());
+    for (const auto& file : tu.getIncludedFiles()) writer.string(file);
+    writer.varint(tu.getTemplateBindings().size());
+    for (const auto& binding : tu.getTemplateBindings()) writer.binding(*binding);
+    writer.namespaceBody(*tu.getGlobalNamespace());
+}
+
+std::unique_ptr<TranslationUnit> ModelSerializer::deserializeTranslationUnit(std::string_view data) {
+    Reader reader(data);
+    if (!reader.magic()) {
+        return nullptr;
+    }
+
+    auto tu = std::make_unique<TranslationUnit>(reader.string());
+    std::vector<std::string> includes(reader.count());
+    for (auto& file : includes) file = reader.string();
+    tu->setIncludedFiles(std::move(includes));
+    const std::size_t bindings = reader.count();
+    for (std::size_t i = 0; i < bindings && reader.ok(); ++i) {
+        auto binding = reader.binding();
+        if (binding) tu->addTemplateBinding(std::move(binding));
+    }
+    reader.namespaceBody(*tu->getGlobalNamespace());
+
+    if (!reader.ok() || !reader.atEnd()) {
+        return nullptr;
+    }
+    return tu;
+}
+
+void ModelSerializer::serialize(const Class& cls, std::string& out) {
+    Writer(out).cls(cls);
+}
+
+std::unique_ptr<Class> ModelSerializer::deserializeClass(std::string_view data) {
+    Reader reader(data);
+    auto cls = reader.cls();
+    if (!reader.ok() || !reader.atEnd()) {
+        return nullptr;
+    }
+    return cls;
+}
+
+void ModelSerializer::serialize(const Model& model, std::string& out) {
+    out.append(kSnapshotMagic, sizeof(kSnapshotMagic));
+    Writer writer(out);
+    writer.varint(kVersion);
+    writer.string(model.getName());
+    writer.varint(model.getTranslationUnits().size());
+
+    std::string block;
+    for (const auto& tu : model.getTranslationUnits()) {
+        block.clear();
+        serialize(*tu, block);
+        writer.string(block);
+    }
+}
+
+std::unique_ptr<Model> ModelSerializer::deserializeModel(std::string_view data) {
+    Reader reader(data);
+    if (!reader.magic(kSnapshotMagic)) {
+        return nullptr;
+    }
+
+    auto model = std::make_unique<Model>(reader.string());
+    const std::size_t units = reader.count();
+    for (std::size_t i = 0; i < units && reader.ok(); ++i) {
+        auto tu = deserializeTranslationUnit(reader.view());
+        if (!tu) return nullptr;
+        model->addTranslationUnit(std::move(tu));
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        return nullptr;
+    }
+
+    parser::SymbolResolver::resolve(*model);
+    return model;
+}
+
+bool ModelSerializer::saveModel(const Model& model, const std::string& path) {
+    std::string data;
+    serialize(model, data);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+        std::cerr << "Error: no se pudo guardar el modelo en " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<Model> ModelSerializer::loadModel(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: no se pudo abrir " << path << std::endl;
+        return nullptr;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto model = deserializeModel(data);
+    if (!model) {
+        std::cerr << "Error: " << path << " no es una instantánea válida (o es de otra versión)" << std::endl;
+    }
+    return model;
+}
+
+} // namespace serialization
+} // namespace cppuml
@@ -0,0 +1,97 @@
+#ifndef CPP_UML_GENERATOR_CORE_SERIALIZATION_MODEL_SERIALIZER_H
+#define CPP_UML_GENERATOR_CORE_SERIALIZATION_MODEL_SERIALIZER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/TranslationUnit.h"
+
+namespace cppuml {
+namespace serialization {
+
+/**
+ * @class ModelSerializer
+ * @brief Codificación binaria compacta del modelo.
+ *
+ * Permite mover modelos entre procesos (p.ej., de un proceso trabajador
+ * del ProcessPool al proceso principal) y guardarlos en disco.
+ *
+ * Formato: cabecera "CUML" + versión, la lista de archivos incluidos por
+ * la TU, sus instanciaciones de plantillas y el árbol de elementos en preorden. Enteros como varint (LEB128) y cadenas con prefijo de longitud.
+ * Cada instanciación (TemplateBinding) se escribe una vez por bloque y los
+ * tipos que la usan la citan por su número. Al leer, las instanciaciones se
+ * comparten por tipo canónico con las ya leídas en el proceso (de otras
+ * TUs o de otros trabajadores).
+ * Los punteros no propietarios (p.ej., 'InheritanceInfo::baseClass') no se
+ * serializan: se conservan los nombres y se vuelven a enlazar con
+ * SymbolResolver tras cargar.
+ */
+class ModelSerializer {
+public:
+    /**
+     * @brief Serializa una unidad de traducción.
+     * @param tu La unidad a codificar.
+     * @param out Búfer destino; los bytes se añaden al final.
+     */
+    static void serialize(const TranslationUnit& tu, std::string& out);
+
+    /**
+     * @brief Reconstruye una unidad de traducción.
+     * @param data Bytes producidos por serialize().
+     * @return La unidad reconstruida, o nullptr si los datos están corruptos
+     *         o son de otra versión.
+     */
+    static std::unique_ptr<TranslationUnit> deserializeTranslationUnit(std::string_view data);
+
+    // --- Clases Sueltas ---
+
+    /**
+     * @brief Serializa una sola clase (miembros, bases y parámetros de plantilla).
+     *
+     * Sin cabecera: el contenedor (p.ej., el índice de ModelStore) lleva su
+     * propia versión. Las bases se guardan por nombre, sin enlazar.
+     */
+    static void serialize(const Class& cls, std::string& out);
+
+    /**
+     * @brief Reconstruye una clase serializada con serialize(const Class&, ...).
+     * @return La clase, o nullptr si los datos están corruptos.
+     */
+    static std::unique_ptr<Class> deserializeClass(std::string_view data);
+
+    // --- Instantáneas de Modelo ---
+
+    /**
+     * @brief Serializa un modelo completo (todas sus TUs).
+     *
+     * Formato: cabecera "CUMS" + versión, nombre del modelo y cada TU
+     * como un bloque de serialize() con prefijo de longitud.
+     */
+    static void serialize(const Model& model, std::string& out);
+
+    /**
+     * @brief Reconstruye un modelo y vuelve a enlazar sus bases.
+     * @return El modelo, o nullptr si los datos están corruptos.
+     */
+    static std::unique_ptr<Model> deserializeModel(std::string_view data);
+
+    /**
+     * @brief Guarda una instantánea del modelo en disco.
+     * @return false si no se pudo escribir el archivo.
+     */
+    static bool saveModel(const Model& model, const std::string& path);
+
+    /**
+     * @brief Carga una instantánea guardada con saveModel().
+     * @return El modelo, o nullptr si no se pudo leer o está corrupto.
+     */
+    static std::unique_ptr<Model> loadModel(const std::string& path);
+};
+
+} // namespace serialization
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_SERIALIZATION_MODEL_SERIALIZER_H
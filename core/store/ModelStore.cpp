@@ -0,0 +1,588 @@
+#include "store/ModelStore.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "graph/RelationshipGraph.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+#include "serialization/ModelSerializer.h"
+
+namespace cppuml {
+namespace store {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'U', 'M', 'K'};
+constexpr std::uint32_t kVersion = 2; ///< 2: tipos enlazados a instanciaciones compartidas
+constexpr std::size_t kHeaderBytes = sizeof(kMagic) + 4 + 8; ///< Magia, versión y tamaño del esqueleto
+
+constexpr RelationshipKind kKinds[] = {RelationshipKind::Relationship, RelationshipKind::Inheritance,
+                                       RelationshipKind::Association,  RelationshipKind::Composition,
+                                       RelationshipKind::Aggregation,  RelationshipKind::Usage};
+
+// --- Nombres Calificados ---
+//
+// FNV-1a se puede continuar (como en NdjsonExporter): el hash de "a::b::C"
+// se obtiene extendiendo el de "a::b" con "::C".
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+std::uint64_t fnv(std::uint64_t hash, std::string_view text) {
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+/// Hash del nombre calificado de 'name' dentro de un ámbito (kFnvOffset = global).
+std::uint64_t childHash(std::uint64_t scope, std::string_view name) {
+    return fnv(scope == kFnvOffset ? scope : fnv(scope, "::"), name);
+}
+
+// --- Codificación del Esqueleto ---
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void putString(std::string& out, const std::string& value) {
+    putVarint(out, value.size());
+    out += value;
+}
+
+void putFixed(std::string& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+std::uint64_t getFixed(const char* data, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    return value;
+}
+
+class SkeletonReader {
+public:
+    explicit SkeletonReader(std::string_view data) : m_data(data) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos == m_data.size(); }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_data.size()) return fail();
+            const auto b = static_cast<std::uint8_t>(m_data[m_pos++]);
+            value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        return fail();
+    }
+
+    /// Un índice que debe ser menor que 'limit'.
+    std::uint32_t index(std::size_t limit) {
+        const std::uint64_t value = varint();
+        if (value >= limit) return static_cast<std::uint32_t>(fail());
+        return static_cast<std::uint32_t>(value);
+    }
+
+    std::uint8_t byte() {
+        if (m_pos >= m_data.size()) return static_cast<std::uint8_t>(fail());
+        return static_cast<std::uint8_t>(m_data[m_pos++]);
+    }
+
+    std::string_view view() {
+        const std::uint64_t len = varint();
+        if (!m_ok || len > m_data.size() - m_pos) {
+            fail();
+            return {};
+        }
+        std::string_view value = m_data.substr(m_pos, static_cast<std::size_t>(len));
+        m_pos += static_cast<std::size_t>(len);
+        return value;
+    }
+
+    std::size_t count() {
+        const std::uint64_t n = varint();
+        if (n > m_data.size() - m_pos) return static_cast<std::size_t>(fail());
+        return static_cast<std::size_t>(n);
+    }
+
+private:
+    std::uint64_t fail() {
+        m_ok = false;
+        m_pos = m_data.size();
+        return 0;
+    }
+
+    std::string_view m_data;
+    std::size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+/**
+ * @brief Recorre el modelo y codifica su esqueleto.
+ *
+ * Formato (varints): namespaces (el global es el 0 y no se escribe:
+ * nombre y padre), clases (nombre, namespace, tipo, visibilidad,
+ * plantilla, nº de campos, nº de métodos y tamaño de su bloque de
+ * detalles) y aristas ordenadas por origen (salto desde el origen
+ * anterior, tipo y destino).
+ */
+class SkeletonBuilder {
+public:
+    explicit SkeletonBuilder(const Model& model) {
+        m_namespaceIds.emplace(std::string(), kGlobalNamespace);
+        m_namespaces.push_back({std::string(), kNotFound});
+        for (const auto& tu : model.getTranslationUnits()) {
+            collect(*tu->getGlobalNamespace(), kGlobalNamespace, std::string());
+        }
+
+        // Las relaciones ya resueltas (herencia enlazada, tipos de campos y firmas).
+        const graph::RelationshipGraph graph(model);
+        for (ClassId id = 0; id < m_classes.size(); ++id) {
+            const graph::NodeId node = graph.find(m_qualified[id]);
+            if (node == graph::kInvalidNode) continue;
+            for (RelationshipKind kind : kKinds) {
+                for (graph::NodeId target : graph.neighbours(node, kind, graph::Direction::Outgoing)) {
+                    auto it = m_classIds.find(graph.name(target));
+                    if (it != m_classIds.end()) m_edges.push_back({id, kind, it->second});
+                }
+            }
+        }
+        m_qualified.clear();
+        m_classIds.clear();
+    }
+
+    /// Las clases canónicas, en orden de ClassId.
+    const std::vector<const Class*>& classes() const { return m_classes; }
+
+    /**
+     * @param detailSizes Tamaño del bloque de cada clase (vacío = sin bloques).
+     */
+    std::string encode(const std::vector<std::uint32_t>& detailSizes) const {
+        std::string out;
+        putVarint(out, m_namespaces.size());
+        for (std::size_t i = 1; i < m_namespaces.size(); ++i) {
+            putString(out, m_namespaces[i].name);
+            putVarint(out, m_namespaces[i].parent);
+        }
+        putVarint(out, m_classes.size());
+        for (std::size_t i = 0; i < m_classes.size(); ++i) {
+            const Class& cls = *m_classes[i];
+            putString(out, cls.getName());
+            putVarint(out, m_classNamespaces[i]);
+            out += static_cast<char>(cls.getClassKind());
+            out += static_cast<char>(cls.getVisibility());
+            out += static_cast<char>(cls.isTemplate() ? 1 : 0);
+            putVarint(out, cls.getFields().size());
+            putVarint(out, cls.getMethods().size());
+            putVarint(out, detailSizes.empty() ? 0 : detailSizes[i]);
+        }
+        putVarint(out, m_edges.size());
+        ClassId previous = 0;
+        for (const Edge& edge : m_edges) {
+            putVarint(out, edge.source - previous);
+            out += static_cast<char>(edge.kind);
+            putVarint(out, edge.target);
+            previous = edge.source;
+        }
+        return out;
+    }
+
+private:
+    struct NamespaceRecord {
+        std::string name;
+        NamespaceId parent;
+    };
+
+    struct Edge {
+        ClassId source;
+        RelationshipKind kind;
+        ClassId target;
+    };
+
+    void collect(const Namespace& ns, NamespaceId id, const std::string& prefix) {
+        for (const auto& member : ns.getMembers()) {
+            if (member->getKind() == ElementKind::Class) {
+                std::string qualified = prefix + member->getName();
+                if (m_classIds.emplace(qualified, static_cast<ClassId>(m_classes.size())).second) {
+                    m_classes.push_back(static_cast<const Class*>(member.get()));
+                    m_classNamespaces.push_back(id);
+                    m_qualified.push_back(std::move(qualified));
+                }
+            } else if (member->getKind() == ElementKind::Namespace) {
+                std::string qualified = prefix + member->getName();
+                auto inserted = m_namespaceIds.emplace(qualified, static_cast<NamespaceId>(m_namespaces.size()));
+                if (inserted.second) m_namespaces.push_back({member->getName(), id});
+                collect(*static_cast<const Namespace*>(member.get()), inserted.first->second, qualified + "::");
+            }
+        }
+    }
+
+    std::unordered_map<std::string, NamespaceId> m_namespaceIds;
+    std::vector<NamespaceRecord> m_namespaces;
+    std::unordered_map<std::string, ClassId> m_classIds;
+    std::vector<std::string> m_qualified;
+    std::vector<const Class*> m_classes;
+    std::vector<NamespaceId> m_classNamespaces;
+    std::vector<Edge> m_edges; ///< Ya agrupadas por origen (se recorren en orden de ClassId)
+};
+
+// --- Orígenes de Detalles ---
+
+/**
+ * @brief Lee el bloque de una clase del índice en disco.
+ */
+class SnapshotSource : public DetailSource {
+public:
+    SnapshotSource(const std::string& path, std::uint64_t blobStart, const std::vector<std::uint32_t>& sizes)
+        : m_in(path, std::ios::binary), m_offsets(sizes.size() + 1, blobStart) {
+        for (std::size_t i = 0; i < sizes.size(); ++i) m_offsets[i + 1] = m_offsets[i] + sizes[i];
+    }
+
+    bool ok() const { return static_cast<bool>(m_in); }
+
+    std::shared_ptr<const Class> load(ClassId id) override {
+        const std::uint64_t size = m_offsets[id + 1] - m_offsets[id];
+        m_buffer.resize(static_cast<std::size_t>(size));
+        m_in.clear();
+        m_in.seekg(static_cast<std::streamoff>(m_offsets[id]));
+        if (!m_in.read(&m_buffer[0], static_cast<std::streamsize>(size))) {
+            return nullptr;
+        }
+        return serialization::ModelSerializer::deserializeClass(m_buffer);
+    }
+
+private:
+    std::ifstream m_in;
+    std::vector<std::uint64_t> m_offsets; ///< Posición de cada bloque en el archivo (más el final)
+    std::string m_buffer;
+};
+
+/**
+ * @brief Las clases de un modelo que vive en este proceso (sin copiarlas).
+ */
+class ModelSource : public DetailSource {
+public:
+    explicit ModelSource(std::vector<const Class*> classes) : m_classes(std::move(classes)) {}
+
+    std::shared_ptr<const Class> load(ClassId id) override {
+        // Sin propietario: el modelo es quien la mantiene viva.
+        return std::shared_ptr<const Class>(std::shared_ptr<const Class>(), m_classes[id]);
+    }
+
+    bool resident() const override { return true; }
+
+private:
+    std::vector<const Class*> m_classes;
+};
+
+// --- Memoria de una Clase ---
+
+std::size_t heapBytes(const std::string& text) {
+    return text.capacity() > 15 ? text.capacity() + 1 : 0; // Cadenas cortas: dentro del objeto
+}
+
+std::size_t typeHeapBytes(const Type& type) {
+    if (type.getBinding()) return 0; // La instanciación es compartida: no es de esta clase
+    std::size_t bytes = heapBytes(type.getName());
+    for (const auto& param : type.getTemplateParameters()) bytes += sizeof(Type) + typeHeapBytes(param);
+    return bytes;
+}
+
+std::size_t fieldBytes(const Field& field) {
+    return sizeof(void*) + sizeof(Field) + heapBytes(field.getName()) + typeHeapBytes(field.getType());
+}
+
+/// Estimación de la memoria que ocupa una clase deserializada.
+std::size_t classBytes(const Class& cls) {
+    std::size_t bytes = sizeof(Class) + heapBytes(cls.getName()) + heapBytes(cls.getSpecializedTemplate());
+    for (const auto& field : cls.getFields()) bytes += fieldBytes(*field);
+    for (const auto& method : cls.getMethods()) {
+        bytes += sizeof(void*) + sizeof(Method) + heapBytes(method->getName()) +
+                 typeHeapBytes(method->getReturnType());
+        for (const auto& param : method->getParameters()) bytes += fieldBytes(*param);
+    }
+    for (const auto& base : cls.getBaseClasses()) bytes += sizeof(base) + heapBytes(base.baseName);
+    for (const auto& param : cls.getTemplateParameters()) {
+        bytes += sizeof(param) + heapBytes(param.name) + heapBytes(param.kind) + heapBytes(param.defaultArgument);
+    }
+    return bytes;
+}
+
+/// CSR a partir del grupo de cada elemento (en orden de aparición dentro de cada grupo).
+template <typename T>
+void buildCsr(std::size_t groups, const std::vector<std::pair<std::uint32_t, T>>& items,
+              std::vector<std::uint32_t>& offsets, std::vector<T>& values) {
+    offsets.assign(groups + 1, 0);
+    for (const auto& item : items) ++offsets[item.first + 1];
+    for (std::size_t g = 0; g < groups; ++g) offsets[g + 1] += offsets[g];
+    values.resize(items.size());
+    std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+    for (const auto& item : items) values[next[item.first]++] = item.second;
+}
+
+template <typename T>
+std::size_t vectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+ModelStore::~ModelStore() = default;
+
+// --- Creación ---
+
+bool ModelStore::save(const Model& model, const std::string& path) {
+    const SkeletonBuilder builder(model);
+
+    std::string blob;
+    std::vector<std::uint32_t> sizes;
+    sizes.reserve(builder.classes().size());
+    for (const Class* cls : builder.classes()) {
+        const std::size_t before = blob.size();
+        serialization::ModelSerializer::serialize(*cls, blob);
+        sizes.push_back(static_cast<std::uint32_t>(blob.size() - before));
+    }
+    const std::string skeleton = builder.encode(sizes);
+
+    std::string header(kMagic, sizeof(kMagic));
+    putFixed(header, kVersion, 4);
+    putFixed(header, skeleton.size(), 8);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(header.data(), static_cast<std::streamsize>(header.size())) ||
+        !out.write(skeleton.data(), static_cast<std::streamsize>(skeleton.size())) ||
+        !out.write(blob.data(), static_cast<std::streamsize>(blob.size()))) {
+        std::cerr << "Error: no se pudo guardar el índice del modelo en " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<ModelStore> ModelStore::open(const std::string& path, std::size_t cacheBytes) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: no se pudo abrir " << path << std::endl;
+        return nullptr;
+    }
+    char header[kHeaderBytes];
+    if (!in.read(header, sizeof(header)) || std::string_view(header, sizeof(kMagic)) != std::string_view(kMagic, sizeof(kMagic)) ||
+        getFixed(header + sizeof(kMagic), 4) != kVersion) {
+        std::cerr << "Error: " << path << " no es un índice de modelo válido (o es de otra versión)" << std::endl;
+        return nullptr;
+    }
+
+    // Solo se lee el esqueleto: los bloques de detalles quedan en disco.
+    const std::uint64_t skeletonBytes = getFixed(header + sizeof(kMagic) + 4, 8);
+    std::unique_ptr<ModelStore> store(new ModelStore());
+    store->m_skeleton.resize(static_cast<std::size_t>(skeletonBytes));
+    std::vector<std::uint32_t> sizes;
+    if (!in.read(&store->m_skeleton[0], static_cast<std::streamsize>(skeletonBytes)) || !store->parseSkeleton(&sizes)) {
+        std::cerr << "Error: " << path << " no es un índice de modelo válido (o es de otra versión)" << std::endl;
+        return nullptr;
+    }
+
+    auto source = std::make_unique<SnapshotSource>(path, kHeaderBytes + skeletonBytes, sizes);
+    if (!source->ok()) {
+        std::cerr << "Error: no se pudo abrir " << path << std::endl;
+        return nullptr;
+    }
+    store->m_source = std::move(source);
+    store->m_cacheBudget = cacheBytes;
+    return store;
+}
+
+std::unique_ptr<ModelStore> ModelStore::fromModel(const Model& model, std::size_t cacheBytes) {
+    const SkeletonBuilder builder(model);
+    std::unique_ptr<ModelStore> store(new ModelStore());
+    store->m_skeleton = builder.encode({});
+    if (!store->parseSkeleton(nullptr)) {
+        return nullptr;
+    }
+    store->m_source = std::make_unique<ModelSource>(builder.classes());
+    store->m_cacheBudget = cacheBytes;
+    return store;
+}
+
+bool ModelStore::parseSkeleton(std::vector<std::uint32_t>* detailSizes) {
+    SkeletonReader reader(m_skeleton);
+
+    const std::size_t namespaces = reader.count();
+    if (namespaces == 0) return false;
+    m_namespaces.assign(namespaces, NamespaceEntry{});
+    m_namespaceHashes.assign(namespaces, kFnvOffset);
+    std::vector<std::pair<std::uint32_t, NamespaceId>> children;
+    children.reserve(namespaces - 1);
+    for (NamespaceId id = 1; id < namespaces && reader.ok(); ++id) {
+        m_namespaces[id].name = reader.view();
+        m_namespaces[id].parent = reader.index(id); // Los padres aparecen antes que sus hijos
+        m_namespaceHashes[id] = childHash(m_namespaceHashes[m_namespaces[id].parent], m_namespaces[id].name);
+        children.emplace_back(m_namespaces[id].parent, id);
+    }
+
+    const std::size_t classes = reader.count();
+    m_classes.assign(classes, ClassEntry{});
+    if (detailSizes) detailSizes->assign(classes, 0);
+    std::vector<std::pair<std::uint32_t, ClassId>> members;
+    members.reserve(classes);
+    m_byHash.reserve(classes);
+    for (ClassId id = 0; id < classes && reader.ok(); ++id) {
+        ClassEntry& entry = m_classes[id];
+        entry.name = reader.view();
+        entry.ns = reader.index(namespaces);
+        const std::uint8_t kind = reader.byte();
+        const std::uint8_t visibility = reader.byte();
+        if (kind > static_cast<std::uint8_t>(ClassKind::Union) ||
+            visibility > static_cast<std::uint8_t>(Visibility::Private)) {
+            return false;
+        }
+        entry.kind = static_cast<ClassKind>(kind);
+        entry.visibility = static_cast<Visibility>(visibility);
+        entry.isTemplate = reader.byte() != 0;
+        entry.fieldCount = static_cast<std::uint32_t>(reader.varint());
+        entry.methodCount = static_cast<std::uint32_t>(reader.varint());
+        const auto size = static_cast<std::uint32_t>(reader.varint());
+        if (detailSizes) (*detailSizes)[id] = size;
+        members.emplace_back(entry.ns, id);
+        m_byHash.emplace_back(childHash(m_namespaceHashes[entry.ns], entry.name), id);
+    }
+
+    const std::size_t edges = reader.count();
+    std::vector<std::pair<std::uint32_t, EdgeEntry>> outgoing;
+    std::vector<std::pair<std::uint32_t, EdgeEntry>> incoming;
+    outgoing.reserve(edges);
+    incoming.reserve(edges);
+    std::uint64_t source = 0;
+    for (std::size_t i = 0; i < edges && reader.ok(); ++i) {
+        source += reader.varint();
+        const std::uint8_t kind = reader.byte();
+        const ClassId target = reader.index(classes);
+        if (source >= classes || kind > static_cast<std::uint8_t>(RelationshipKind::Usage)) return false;
+        outgoing.emplace_back(static_cast<ClassId>(source), EdgeEntry{static_cast<RelationshipKind>(kind), target});
+        incoming.emplace_back(target, EdgeEntry{static_cast<RelationshipKind>(kind), static_cast<ClassId>(source)});
+    }
+    if (!reader.ok() || !reader.atEnd()) return false;
+
+    buildCsr(namespaces, children, m_childOffsets, m_children);
+    buildCsr(namespaces, members, m_memberOffsets, m_members);
+    buildCsr(classes, outgoing, m_outOffsets, m_outgoing);
+    buildCsr(classes, incoming, m_inOffsets, m_incoming);
+    std::sort(m_byHash.begin(), m_byHash.end());
+    return true;
+}
+
+// --- Esqueleto ---
+
+Range<NamespaceId> ModelStore::childNamespaces(NamespaceId parent) const {
+    return {m_children.data() + m_childOffsets[parent], m_children.data() + m_childOffsets[parent + 1]};
+}
+
+Range<ClassId> ModelStore::classesIn(NamespaceId ns) const {
+    return {m_members.data() + m_memberOffsets[ns], m_members.data() + m_memberOffsets[ns + 1]};
+}
+
+Range<EdgeEntry> ModelStore::outgoing(ClassId id) const {
+    return {m_outgoing.data() + m_outOffsets[id], m_outgoing.data() + m_outOffsets[id + 1]};
+}
+
+Range<EdgeEntry> ModelStore::incoming(ClassId id) const {
+    return {m_incoming.data() + m_inOffsets[id], m_incoming.data() + m_inOffsets[id + 1]};
+}
+
+std::string ModelStore::qualifiedName(ClassId id) const {
+    std::vector<std::string_view> parts{m_classes[id].name};
+    for (NamespaceId ns = m_classes[id].ns; ns != kGlobalNamespace; ns = m_namespaces[ns].parent) {
+        parts.push_back(m_namespaces[ns].name);
+    }
+    std::string name;
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+        if (!name.empty()) name += "::";
+        name += *it;
+    }
+    return name;
+}
+
+ClassId ModelStore::find(std::string_view qualifiedName) const {
+    if (qualifiedName.compare(0, 2, "::") == 0) qualifiedName.remove_prefix(2);
+    const std::uint64_t hash = fnv(kFnvOffset, qualifiedName);
+    auto it = std::lower_bound(m_byHash.begin(), m_byHash.end(), std::make_pair(hash, ClassId(0)));
+    for (; it != m_byHash.end() && it->first == hash; ++it) {
+        if (this->qualifiedName(it->second) == qualifiedName) return it->second;
+    }
+    return kNotFound;
+}
+
+// --- Detalles ---
+
+std::shared_ptr<const Class> ModelStore::details(ClassId id) {
+    if (id >= m_classes.size()) return nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_source->resident()) {
+        ++m_hits;
+        return m_source->load(id);
+    }
+
+    auto it = m_cache.find(id);
+    if (it != m_cache.end()) {
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+        return it->second.cls;
+    }
+
+    ++m_misses;
+    std::shared_ptr<const Class> cls = m_source->load(id);
+    if (!cls) return nullptr;
+    m_lru.push_front(id);
+    const std::size_t bytes = classBytes(*cls);
+    m_cache.emplace(id, CacheEntry{cls, bytes, m_lru.begin()});
+    m_cachedBytes += bytes;
+    evict();
+    return cls;
+}
+
+void ModelStore::setCacheBudget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cacheBudget = bytes;
+    evict();
+}
+
+void ModelStore::evict() {
+    // La clase recién pedida se conserva aunque sola supere el presupuesto.
+    while (m_cachedBytes > m_cacheBudget && m_lru.size() > 1) {
+        auto it = m_cache.find(m_lru.back());
+        m_cachedBytes -= it->second.bytes;
+        m_cache.erase(it);
+        m_lru.pop_back();
+        ++m_evictions;
+    }
+}
+
+StoreStats ModelStore::stats() const {
+    StoreStats stats;
+    stats.skeletonBytes = m_skeleton.capacity() + vectorBytes(m_namespaces) + vectorBytes(m_classes) +
+                          vectorBytes(m_childOffsets) + vectorBytes(m_children) + vectorBytes(m_memberOffsets) +
+                          vectorBytes(m_members) + vectorBytes(m_outOffsets) + vectorBytes(m_outgoing) +
+                          vectorBytes(m_inOffsets) + vectorBytes(m_incoming) + vectorBytes(m_namespaceHashes) +
+                          vectorBytes(m_byHash);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats.cachedClasses = m_cache.size();
+    stats.cachedBytes = m_cachedBytes;
+    stats.cacheBudget = m_cacheBudget;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    return stats;
+}
+
+} // namespace store
+} // namespace cppuml
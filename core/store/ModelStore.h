@@ -0,0 +1,259 @@
+#ifndef CPP_UML_GENERATOR_CORE_STORE_MODEL_STORE_H
+#define CPP_UML_GENERATOR_CORE_STORE_MODEL_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Model.h"
+#include "model/Relationship.h"
+
+namespace cppuml {
+namespace store {
+
+using ClassId = std::uint32_t;
+using NamespaceId = std::uint32_t;
+
+constexpr NamespaceId kGlobalNamespace = 0;
+constexpr std::uint32_t kNotFound = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Un namespace del esqueleto.
+ */
+struct NamespaceEntry {
+    std::string_view name;  ///< Vacío para el namespace global
+    NamespaceId parent = kNotFound;
+};
+
+/**
+ * @brief Una clase del esqueleto: lo necesario para dibujar el árbol, sin sus miembros.
+ */
+struct ClassEntry {
+    std::string_view name;
+    NamespaceId ns = kGlobalNamespace;
+    ClassKind kind = ClassKind::Class;
+    Visibility visibility = Visibility::None;
+    bool isTemplate = false;
+    std::uint32_t fieldCount = 0;
+    std::uint32_t methodCount = 0;
+};
+
+/**
+ * @brief Una arista del esqueleto, vista desde uno de sus extremos.
+ */
+struct EdgeEntry {
+    RelationshipKind kind;
+    ClassId other; ///< El destino (salientes) o el origen (entrantes)
+};
+
+/**
+ * @brief Una vista contigua dentro de los arreglos del esqueleto.
+ */
+template <typename T>
+class Range {
+public:
+    Range(const T* first, const T* last) : m_first(first), m_last(last) {}
+
+    const T* begin() const { return m_first; }
+    const T* end() const { return m_last; }
+    std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+
+private:
+    const T* m_first;
+    const T* m_last;
+};
+
+/**
+ * @class DetailSource
+ * @brief De dónde se obtienen los miembros de una clase cuando se piden.
+ */
+class DetailSource {
+public:
+    virtual ~DetailSource() = default;
+
+    /**
+     * @brief La clase completa (campos, métodos, bases y plantilla).
+     * @return nullptr si no se pudo obtener (p.ej., el archivo cambió).
+     */
+    virtual std::shared_ptr<const Class> load(ClassId id) = 0;
+
+    /**
+     * @brief true si las clases ya viven en memoria (un modelo analizado):
+     *        entonces no se copian ni ocupan la caché.
+     */
+    virtual bool resident() const { return false; }
+};
+
+/**
+ * @brief Estado de la caché de detalles.
+ */
+struct StoreStats {
+    std::size_t skeletonBytes = 0;  ///< Memoria del esqueleto (nombres, tablas e índices)
+    std::size_t cachedClasses = 0;
+    std::size_t cachedBytes = 0;    ///< Estimación de la memoria de las clases en caché
+    std::size_t cacheBudget = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+};
+
+/**
+ * @class ModelStore
+ * @brief Acceso por niveles al modelo para el inspector: un esqueleto siempre
+ *        cargado y los miembros de cada clase solo cuando se piden.
+ *
+ * Nivel 1, el esqueleto: namespaces, nombres y tipo de cada clase, número
+ * de campos y métodos y las relaciones (herencia, asociación, uso, ...)
+ * ya resueltas con RelationshipGraph. Es un único búfer codificado con
+ * varints; los nombres son vistas dentro de él y los hijos de cada
+ * namespace y las aristas de cada clase son rangos CSR. Basta para pintar
+ * el árbol de clases y el grafo sin un solo Field ni Method en memoria.
+ *
+ * Nivel 2, los detalles: la Class completa de una clase se pide a un
+ * DetailSource al desplegarla o seleccionarla, y se guarda en una caché
+ * LRU con un presupuesto de bytes. Quien la está mostrando conserva su
+ * shared_ptr aunque se expulse de la caché.
+ *
+ * Orígenes:
+ *   - open(): un índice guardado con save(). Solo se lee el esqueleto; cada
+ *     clase es un bloque de ModelSerializer en una posición conocida del
+ *     archivo, que se lee al pedirla.
+ *   - fromModel(): un modelo analizado en este proceso (el parser en vivo,
+ *     el daemon). Los detalles son las propias clases del modelo.
+ *
+ * Las clases se identifican por nombre calificado: las copias de varias
+ * TUs comparten entrada y los detalles son los de la primera TU que la
+ * define (como en RelationshipGraph).
+ *
+ * Los accesos al esqueleto son de solo lectura y seguros desde varios
+ * hilos; details() está protegido por un mutex.
+ */
+class ModelStore {
+public:
+    ~ModelStore();
+
+    ModelStore(const ModelStore&) = delete;
+    ModelStore& operator=(const ModelStore&) = delete;
+
+    /**
+     * @brief Guarda un modelo (ya enlazado) como índice para open().
+     * @return false si el archivo no se pudo escribir.
+     */
+    static bool save(const Model& model, const std::string& path);
+
+    /**
+     * @brief Abre un índice guardado con save(); solo lee el esqueleto.
+     * @param cacheBytes Presupuesto de la caché de detalles.
+     * @return nullptr si el archivo no existe o no es válido.
+     */
+    static std::unique_ptr<ModelStore> open(const std::string& path, std::size_t cacheBytes = kDefaultCacheBytes);
+
+    /**
+     * @brief El esqueleto de un modelo analizado en este proceso.
+     *
+     * El modelo debe seguir vivo (y sin cambios) mientras se use el store.
+     */
+    static std::unique_ptr<ModelStore> fromModel(const Model& model, std::size_t cacheBytes = kDefaultCacheBytes);
+
+    static constexpr std::size_t kDefaultCacheBytes = std::size_t(64) << 20;
+
+    // --- Esqueleto ---
+
+    std::size_t namespaceCount() const { return m_namespaces.size(); }
+    const NamespaceEntry& namespaceAt(NamespaceId id) const { return m_namespaces[id]; }
+
+    /// Namespaces directamente dentro de 'parent', en orden de aparición.
+    Range<NamespaceId> childNamespaces(NamespaceId parent) const;
+
+    /// Clases directamente dentro de 'ns', en orden de aparición.
+    Range<ClassId> classesIn(NamespaceId ns) const;
+
+    std::size_t classCount() const { return m_classes.size(); }
+    const ClassEntry& classAt(ClassId id) const { return m_classes[id]; }
+
+    /// Nombre calificado ("a::b::C") de una clase.
+    std::string qualifiedName(ClassId id) const;
+
+    /// La clase con ese nombre calificado (kNotFound si no existe).
+    ClassId find(std::string_view qualifiedName) const;
+
+    std::size_t edgeCount() const { return m_outgoing.size(); }
+
+    /// Aristas que salen de la clase (hacia sus bases, los tipos que usa, ...).
+    Range<EdgeEntry> outgoing(ClassId id) const;
+
+    /// Aristas que llegan a la clase (sus derivadas, quién la usa, ...).
+    Range<EdgeEntry> incoming(ClassId id) const;
+
+    // --- Detalles ---
+
+    /**
+     * @brief Los miembros de una clase: de la caché o, si no están, del origen.
+     * @return nullptr si el origen no pudo proporcionarlos.
+     */
+    std::shared_ptr<const Class> details(ClassId id);
+
+    /**
+     * @brief Cambia el presupuesto de la caché (expulsa lo que sobre).
+     */
+    void setCacheBudget(std::size_t bytes);
+
+    StoreStats stats() const;
+
+private:
+    ModelStore() = default;
+
+    /**
+     * @brief Interpreta el esqueleto y construye los índices.
+     * @return false si los datos están corruptos.
+     */
+    bool parseSkeleton(std::vector<std::uint32_t>* detailSizes);
+
+    void evict();
+
+    // Esqueleto: 'm_skeleton' es el búfer del que los nombres son vistas.
+    std::string m_skeleton;
+    std::vector<NamespaceEntry> m_namespaces;
+    std::vector<ClassEntry> m_classes;
+    std::vector<std::uint32_t> m_childOffsets;  ///< CSR de namespaces hijos (por namespace)
+    std::vector<NamespaceId> m_children;
+    std::vector<std::uint32_t> m_memberOffsets; ///< CSR de clases (por namespace)
+    std::vector<ClassId> m_members;
+    std::vector<std::uint32_t> m_outOffsets;    ///< CSR de aristas salientes (por clase)
+    std::vector<EdgeEntry> m_outgoing;
+    std::vector<std::uint32_t> m_inOffsets;     ///< CSR de aristas entrantes (por clase)
+    std::vector<EdgeEntry> m_incoming;
+    std::vector<std::uint64_t> m_namespaceHashes;               ///< Hash del nombre calificado de cada namespace
+    std::vector<std::pair<std::uint64_t, ClassId>> m_byHash;   ///< Ordenado: búsqueda por nombre calificado
+
+    // Detalles
+    std::unique_ptr<DetailSource> m_source;
+    struct CacheEntry {
+        std::shared_ptr<const Class> cls;
+        std::size_t bytes = 0;
+        std::list<ClassId>::iterator position;
+    };
+    mutable std::mutex m_mutex;
+    std::unordered_map<ClassId, CacheEntry> m_cache;
+    std::list<ClassId> m_lru; ///< La más reciente al principio
+    std::size_t m_cacheBudget = kDefaultCacheBytes;
+    std::size_t m_cachedBytes = 0;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+    std::size_t m_evictions = 0;
+};
+
+} // namespace store
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_STORE_MODEL_STORE_H
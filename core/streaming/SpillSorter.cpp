@@ -0,0 +1,236 @@
+#include "streaming/SpillSorter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+
+namespace cppuml {
+namespace streaming {
+
+namespace {
+
+/// Sobrecoste aproximado del asignador por bloque reservado.
+constexpr std::size_t kAllocationOverhead = 32;
+
+/// Coste en memoria de un par pendiente (cadenas + hueco del vector).
+std::size_t footprint(const std::string& key, const std::string& value) {
+    return key.capacity() + value.capacity() + 2 * kAllocationOverhead +
+           sizeof(std::pair<std::string, std::string>);
+}
+
+void putVarint(std::ostream& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+void putString(std::ostream& out, const std::string& text) {
+    putVarint(out, text.size());
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/**
+ * @brief Lector secuencial de un run, con un búfer propio.
+ */
+class RunReader {
+public:
+    explicit RunReader(const std::string& path) : m_buffer(1 << 16) {
+        m_in.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_in.open(path, std::ios::binary);
+        m_failed = !m_in;
+    }
+
+    /// Avanza al siguiente par; false al final del run (o si falló).
+    bool next() {
+        if (m_failed) return false;
+        if (m_in.peek() == std::char_traits<char>::eof()) return false;
+        if (!readString(key) || !readString(value)) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool failed() const { return m_failed; }
+
+    std::string key;
+    std::string value;
+
+private:
+    bool readVarint(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const int c = m_in.get();
+            if (c == std::char_traits<char>::eof()) return false;
+            value |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+            if (!(c & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool readString(std::string& text) {
+        std::uint64_t size = 0;
+        if (!readVarint(size)) return false;
+        text.resize(static_cast<std::size_t>(size));
+        return size == 0 || m_in.read(&text[0], static_cast<std::streamsize>(size));
+    }
+
+    std::vector<char> m_buffer;
+    std::ifstream m_in;
+    bool m_failed = false;
+};
+
+/**
+ * @brief Mezcla k runs en orden (clave, índice de run); cada clave sale una vez.
+ */
+bool mergeRuns(const std::vector<std::string>& paths, const SpillSorter::Visitor& visit) {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    readers.reserve(paths.size());
+    for (const auto& path : paths) {
+        readers.push_back(std::make_unique<RunReader>(path));
+        if (readers.back()->failed()) {
+            std::cerr << "Error: no se pudo leer " << path << std::endl;
+            return false;
+        }
+    }
+
+    auto greater = [&](std::size_t a, std::size_t b) {
+        const int order = readers[a]->key.compare(readers[b]->key);
+        return order != 0 ? order > 0 : a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        if (readers[i]->next()) heap.push(i);
+    }
+
+    std::string lastKey;
+    bool first = true;
+    while (!heap.empty()) {
+        const std::size_t top = heap.top();
+        heap.pop();
+        RunReader& reader = *readers[top];
+        if (first || reader.key != lastKey) {
+            if (!visit(reader.key, reader.value)) return true;
+            lastKey = reader.key;
+            first = false;
+        }
+        if (reader.next()) heap.push(top);
+    }
+
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        if (readers[i]->failed()) {
+            std::cerr << "Error: run dañado: " << paths[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SpillSorter::SpillSorter(std::string directory, std::size_t memoryBytes, std::string name)
+    : m_directory(std::move(directory)), m_name(std::move(name)), m_memoryBytes(std::max<std::size_t>(memoryBytes, 1 << 16)) {}
+
+SpillSorter::~SpillSorter() {
+    for (const auto& run : m_runs) std::remove(run.c_str());
+}
+
+std::string SpillSorter::nextRunPath() {
+    return m_directory + "/" + m_name + "-" + std::to_string(m_runSerial++) + ".bin";
+}
+
+// --- Acumulación y Volcado ---
+
+bool SpillSorter::add(std::string key, std::string value) {
+    m_pendingBytes += footprint(key, value);
+    m_pending.emplace_back(std::move(key), std::move(value));
+    return m_pendingBytes < m_memoryBytes || spill();
+}
+
+bool SpillSorter::spill() {
+    if (m_pending.empty()) return true;
+
+    // Estable: entre claves iguales queda el primer valor añadido.
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    const std::string path = nextRunPath();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const std::string* lastKey = nullptr;
+    for (const auto& entry : m_pending) {
+        if (lastKey && *lastKey == entry.first) continue;
+        putString(out, entry.first);
+        putString(out, entry.second);
+        lastKey = &entry.first;
+    }
+    out.close();
+    if (!out) {
+        std::cerr << "Error: no se pudo escribir el run " << path << std::endl;
+        std::remove(path.c_str());
+        return false;
+    }
+
+    std::ifstream::pos_type size = std::ifstream(path, std::ios::binary | std::ios::ate).tellg();
+    m_spilledBytes += size > 0 ? static_cast<std::size_t>(size) : 0;
+    m_runs.push_back(path);
+
+    m_pending.clear();
+    m_pending.shrink_to_fit(); // Devolver la memoria: el siguiente run empieza de cero
+    m_pendingBytes = 0;
+    return true;
+}
+
+// --- Mezcla ---
+
+bool SpillSorter::merge(const Visitor& visit) {
+    if (m_runs.empty()) {
+        // Todo cupo en memoria: no hace falta tocar el disco.
+        std::stable_sort(m_pending.begin(), m_pending.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        const std::string* lastKey = nullptr;
+        for (const auto& entry : m_pending) {
+            if (lastKey && *lastKey == entry.first) continue;
+            if (!visit(entry.first, entry.second)) break;
+            lastKey = &entry.first;
+        }
+        return true;
+    }
+    if (!spill()) return false;
+
+    // Demasiados runs para abrirlos a la vez: se mezclan por grupos
+    // consecutivos (conservando el orden de los runs) hasta que quepan.
+    while (m_runs.size() > m_maxFanIn) {
+        std::vector<std::string> merged;
+        for (std::size_t begin = 0; begin < m_runs.size(); begin += m_maxFanIn) {
+            const std::size_t end = std::min(m_runs.size(), begin + m_maxFanIn);
+            const std::vector<std::string> group(m_runs.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                 m_runs.begin() + static_cast<std::ptrdiff_t>(end));
+            const std::string path = nextRunPath();
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            const bool ok = mergeRuns(group, [&](const std::string& key, const std::string& value) {
+                putString(out, key);
+                putString(out, value);
+                return static_cast<bool>(out);
+            });
+            out.close();
+            for (const auto& run : group) std::remove(run.c_str());
+            merged.push_back(path);
+            if (!ok || !out) {
+                std::cerr << "Error: no se pudo escribir el run " << path << std::endl;
+                m_runs.insert(m_runs.end(), merged.begin(), merged.end()); // El destructor los borra
+                return false;
+            }
+        }
+        m_runs = std::move(merged);
+    }
+    return mergeRuns(m_runs, visit);
+}
+
+} // namespace streaming
+} // namespace cppuml
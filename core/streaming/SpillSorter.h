@@ -0,0 +1,78 @@
+#ifndef CPP_UML_GENERATOR_CORE_STREAMING_SPILL_SORTER_H
+#define CPP_UML_GENERATOR_CORE_STREAMING_SPILL_SORTER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppuml {
+namespace streaming {
+
+/**
+ * @class SpillSorter
+ * @brief Ordenación externa de pares clave/valor con memoria acotada.
+ *
+ * Los pares se acumulan en memoria hasta 'memoryBytes'; entonces se ordenan
+ * por clave y se vuelcan a un archivo de "run" en disco. merge() mezcla
+ * todos los runs (k-way, en varias pasadas si hay más de 'maxFanIn') y
+ * entrega cada clave una sola vez, con el primer valor añadido.
+ *
+ * Los runs se escriben como [varint longitud][clave][varint longitud][valor]
+ * y se borran al destruir el objeto.
+ */
+class SpillSorter {
+public:
+    /**
+     * @param directory Directorio para los runs (debe existir).
+     * @param memoryBytes Memoria máxima de pares pendientes de volcar.
+     * @param name Prefijo de los archivos (varios sorters pueden compartir directorio).
+     */
+    SpillSorter(std::string directory, std::size_t memoryBytes, std::string name = "run");
+    ~SpillSorter();
+
+    SpillSorter(const SpillSorter&) = delete;
+    SpillSorter& operator=(const SpillSorter&) = delete;
+
+    /**
+     * @brief Añade un par. Si la clave se repite, merge() conserva el primer valor.
+     * @return false si un volcado a disco falló.
+     */
+    bool add(std::string key, std::string value);
+
+    /**
+     * @brief Recibe cada clave (en orden) con su valor; devuelve false para detener la mezcla.
+     */
+    using Visitor = std::function<bool(const std::string& key, const std::string& value)>;
+
+    /**
+     * @brief Mezcla todo lo añadido y lo entrega en orden de clave.
+     * @return false si la lectura o escritura de un run falló.
+     */
+    bool merge(const Visitor& visit);
+
+    std::size_t runCount() const { return m_runs.size(); }
+    std::size_t spilledBytes() const { return m_spilledBytes; }
+
+private:
+    bool spill();
+    std::string nextRunPath();
+
+    std::string m_directory;
+    std::string m_name;
+    std::size_t m_memoryBytes;
+    std::size_t m_maxFanIn = 64;
+
+    std::vector<std::pair<std::string, std::string>> m_pending;
+    std::size_t m_pendingBytes = 0;
+
+    std::vector<std::string> m_runs;
+    std::size_t m_runSerial = 0;
+    std::size_t m_spilledBytes = 0;
+};
+
+} // namespace streaming
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_STREAMING_SPILL_SORTER_H
@@ -0,0 +1,211 @@
+#include "streaming/StreamingAnalyzer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "model/Namespace.h"
+#include "parser/libclang_parser.h"
+#include "streaming/SpillSorter.h"
+
+namespace cppuml {
+namespace streaming {
+
+namespace {
+
+/**
+ * @brief Directorio de runs propio de una ejecución; se borra al terminar.
+ */
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& parent) {
+        std::error_code ec;
+        const std::filesystem::path base = parent.empty() ? std::filesystem::temp_directory_path(ec)
+                                                          : std::filesystem::path(parent);
+        for (int attempt = 0; attempt < 100 && m_path.empty(); ++attempt) {
+            const std::filesystem::path candidate =
+                base / ("cppuml-spill-" + std::to_string(::getpid()) + "-" + std::to_string(attempt));
+            if (std::filesystem::create_directories(candidate, ec)) {
+                m_path = candidate.string();
+            }
+        }
+    }
+
+    ~ScratchDirectory() {
+        if (m_path.empty()) return;
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    const std::string& path() const { return m_path; }
+
+private:
+    std::string m_path;
+};
+
+/**
+ * @brief Reduce TUs a registros y los acumula en los sorters.
+ */
+class Reducer {
+public:
+    Reducer(const StreamingOptions& options, const std::string& directory)
+        : m_exporter(options.diagram),
+          m_classes(directory, options.memoryBytes / 16 * 10, "classes"),
+          m_edges(directory, options.memoryBytes / 16 * 5, "edges"),
+          m_seen(std::max<std::size_t>(1024, options.memoryBytes / 16 / sizeof(std::size_t)), 0) {}
+
+    bool reduce(const TranslationUnit& tu) {
+        members(*tu.getGlobalNamespace(), "");
+        return m_ok;
+    }
+
+    bool ok() const { return m_ok; }
+    std::size_t skippedDuplicates() const { return m_skipped; }
+    SpillSorter& classes() { return m_classes; }
+    SpillSorter& edges() { return m_edges; }
+
+private:
+    void members(const Namespace& ns, const std::string& prefix) {
+        for (const auto& member : ns.getMembers()) {
+            if (!m_ok) return;
+            if (member->getKind() == ElementKind::Namespace) {
+                members(static_cast<const Namespace&>(*member), prefix + member->getName() + "::");
+            } else if (member->getKind() == ElementKind::Class) {
+                classRecord(static_cast<const Class&>(*member), prefix + member->getName());
+            }
+        }
+    }
+
+    void classRecord(const Class& cls, std::string qualifiedName) {
+        // Una clase ya registrada (la misma cabecera en otra TU) se descarta
+        // aquí. Un hueco ocupado por otra clase solo hace que la copia llegue
+        // a un run: merge() la elimina igualmente.
+        std::size_t hash = std::hash<std::string>()(qualifiedName);
+        if (hash == 0) hash = 1;
+        std::size_t& slot = m_seen[hash % m_seen.size()];
+        if (slot == hash) {
+            ++m_skipped;
+            return;
+        }
+        slot = hash;
+
+        m_block.str(std::string());
+        m_exporter.exportClass(qualifiedName, cls, m_block);
+        for (const auto& base : cls.getBaseClasses()) {
+            const std::string& baseName = base.baseName.empty() && base.baseClass ? base.baseClass->getName()
+                                                                                  : base.baseName;
+            if (baseName.empty()) continue;
+            std::string key = baseName;
+            key += '\0';
+            key += qualifiedName;
+            m_ok = m_ok && m_edges.add(std::move(key), std::string());
+        }
+        m_ok = m_ok && m_classes.add(std::move(qualifiedName), m_block.str());
+    }
+
+    exporter::PlantUmlExporter m_exporter;
+    SpillSorter m_classes;
+    SpillSorter m_edges;
+    std::vector<std::size_t> m_seen;
+    std::ostringstream m_block;
+    std::size_t m_skipped = 0;
+    bool m_ok = true;
+};
+
+} // namespace
+
+bool StreamingAnalyzer::run(const std::vector<parser::ParseJob>& jobs, std::ostream& diagram,
+                            StreamingReport* report) const {
+    StreamingReport localReport;
+    StreamingReport& stats = report ? *report : localReport;
+
+    ScratchDirectory scratch(m_options.spillDirectory);
+    if (scratch.path().empty()) {
+        std::cerr << "Error: no se pudo crear el directorio de runs en "
+                  << (m_options.spillDirectory.empty() ? "el directorio temporal" : m_options.spillDirectory)
+                  << std::endl;
+        return false;
+    }
+    Reducer reducer(m_options, scratch.path());
+
+    // 1. Analizar y reducir cada TU; el modelo se libera en cuanto se reduce
+    if (m_options.jobs > 1 || m_options.parseMemoryBytes > 0) {
+        parser::ProcessPoolReport poolReport;
+        const unsigned workers = m_options.jobs > 1 ? m_options.jobs : 0;
+        parser::ProcessPool({workers, m_options.filter, m_options.parseMemoryBytes, m_options.skim}).run(jobs, [&](std::size_t, std::unique_ptr<TranslationUnit> tu) {
+            if (!tu) return; // Ya consta en el informe
+            reducer.reduce(*tu);
+            ++stats.units;
+        }, &poolReport);
+        stats.failedUnits = poolReport.failedFiles.size() + poolReport.crashedFiles.size();
+    } else {
+        parser::LibClangParser parser;
+        parser.setFilter(m_options.filter);
+        parser.setSkim(m_options.skim);
+        for (const auto& job : jobs) {
+            if (!job.unityHeaders.empty()) {
+                // Lote unity: una TU por cabecera (ninguna si libclang falló)
+                auto units = parser.parseUnity(job.unityHeaders, job.compileArgs);
+                if (units.empty()) stats.failedUnits += job.unityHeaders.size();
+                for (const auto& tu : units) {
+                    reducer.reduce(*tu);
+                    ++stats.units;
+                }
+            } else if (auto tu = parser.parse(job.sourceFile, job.compileArgs)) {
+                reducer.reduce(*tu);
+                ++stats.units;
+            } else {
+                ++stats.failedUnits;
+            }
+            if (!reducer.ok()) break;
+        }
+    }
+    if (!reducer.ok()) return false;
+    stats.skippedDuplicates = reducer.skippedDuplicates();
+
+    // 2. Clases, en orden y sin repetir. Sus nombres (ya ordenados) se
+    //    guardan para filtrar después las herencias.
+    const std::string namesPath = scratch.path() + "/names.txt";
+    std::ofstream names(namesPath, std::ios::trunc);
+    exporter::PlantUmlExporter::beginDiagram(diagram);
+    bool ok = reducer.classes().merge([&](const std::string& name, const std::string& block) {
+        diagram << block;
+        names << name << '\n';
+        ++stats.classes;
+        return static_cast<bool>(diagram);
+    });
+    names.close();
+    ok = ok && names && diagram;
+
+    // 3. Herencias ordenadas por base: se cruzan con la lista de nombres.
+    std::ifstream known(namesPath);
+    std::string current;
+    bool more = static_cast<bool>(std::getline(known, current));
+    ok = ok && reducer.edges().merge([&](const std::string& key, const std::string&) {
+        const std::size_t split = key.find('\0');
+        const std::string base = key.substr(0, split);
+        while (more && current < base) more = static_cast<bool>(std::getline(known, current));
+        if (more && current == base) {
+            exporter::PlantUmlExporter::exportInheritance(key.substr(split + 1), base, diagram);
+            ++stats.edges;
+        }
+        return static_cast<bool>(diagram);
+    });
+    exporter::PlantUmlExporter::endDiagram(diagram);
+
+    stats.runs = reducer.classes().runCount() + reducer.edges().runCount();
+    stats.spilledBytes = reducer.classes().spilledBytes() + reducer.edges().spilledBytes();
+    return ok && static_cast<bool>(diagram);
+}
+
+} // namespace streaming
+} // namespace cppuml
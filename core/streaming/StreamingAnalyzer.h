@@ -0,0 +1,82 @@
+#ifndef CPP_UML_GENERATOR_CORE_STREAMING_STREAMING_ANALYZER_H
+#define CPP_UML_GENERATOR_CORE_STREAMING_STREAMING_ANALYZER_H
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "exporter/PlantUmlExporter.h"
+#include "parser/process_pool.h"
+
+namespace cppuml {
+namespace streaming {
+
+/**
+ * @brief Configuración del análisis en streaming.
+ */
+struct StreamingOptions {
+    std::size_t memoryBytes = std::size_t(512) << 20; ///< Presupuesto para los registros en memoria
+    std::string spillDirectory;                       ///< Dónde crear los runs (vacío = temporal del sistema)
+    unsigned jobs = 1;                                ///< > 1: procesos aislados (ProcessPool)
+    std::size_t parseMemoryBytes = 0;                 ///< > 0: los análisis se admiten por memoria (ProcessPool)
+    bool skim = false;                                ///< Análisis rápido sin inclusiones (LibClangParser::setSkim)
+    std::shared_ptr<const parser::ScopeFilter> filter; ///< Alcance del modelo (nullptr = todo)
+    exporter::PlantUmlOptions diagram;
+};
+
+/**
+ * @brief Resumen de una ejecución.
+ */
+struct StreamingReport {
+    std::size_t units = 0;             ///< TUs analizadas y reducidas
+    std::size_t failedUnits = 0;       ///< libclang falló o el trabajador se detuvo
+    std::size_t classes = 0;           ///< Clases únicas en el diagrama
+    std::size_t skippedDuplicates = 0; ///< Copias de una clase ya vista, descartadas sin ocupar memoria
+    std::size_t edges = 0;             ///< Herencias escritas (ambos extremos conocidos)
+    std::size_t runs = 0;              ///< Runs volcados a disco
+    std::size_t spilledBytes = 0;
+};
+
+/**
+ * @class StreamingAnalyzer
+ * @brief Análisis con memoria acotada para repositorios que no caben en RAM.
+ *
+ * En lugar de conservar todas las TranslationUnit hasta el final, cada TU
+ * se reduce en cuanto se analiza a registros compactos y se libera:
+ *   - una clase: nombre calificado -> su bloque PlantUML ya formateado;
+ *   - una herencia: "base\0derivada".
+ * Los registros se ordenan por clave y se vuelcan a runs en disco
+ * (SpillSorter) cuando superan el presupuesto. Al final se mezclan: cada
+ * clase se escribe una vez y cada herencia solo si su base existe.
+ *
+ * Una tabla de hashes de tamaño fijo (1/16 del presupuesto) descarta las
+ * copias de clases ya registradas, que son la mayoría cuando muchas TUs
+ * incluyen las mismas cabeceras. El pico de memoria es el presupuesto más
+ * la TU más grande en análisis, con independencia del tamaño del repositorio.
+ */
+class StreamingAnalyzer {
+public:
+    explicit StreamingAnalyzer(StreamingOptions options)
+        : m_options(std::move(options)) {}
+
+    /**
+     * @brief Analiza todos los trabajos y escribe el diagrama PlantUML.
+     *
+     * Los lotes unity (ParseJob::unityHeaders) se analizan con
+     * LibClangParser::parseUnity, en el proceso o en el ProcessPool, y cada
+     * cabecera se reduce como su propia TU.
+     * @return false si falló la escritura de un run o del diagrama.
+     */
+    bool run(const std::vector<parser::ParseJob>& jobs, std::ostream& diagram,
+             StreamingReport* report = nullptr) const;
+
+private:
+    StreamingOptions m_options;
+};
+
+} // namespace streaming
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_CORE_STREAMING_STREAMING_ANALYZER_H
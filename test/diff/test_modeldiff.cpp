@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "diff/ModelDiff.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::diff;
+
+namespace {
+
+const ClassChange* findChange(const ModelDiff& result, const std::string& name) {
+    for (const auto& change : result.classes) {
+        if (change.qualifiedName == name) return &change;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("ModelDiffer detecta clases añadidas, eliminadas y modificadas", "[diff]") {
+    auto before = test::makeSampleModel();
+    auto after = test::makeSampleModel({/*dropDialog=*/true, /*addButton=*/true, /*windowTitle=*/true});
+
+    const ModelDiff result = ModelDiffer::compare(*before, *after);
+    REQUIRE(result.classes.size() == 3);
+    CHECK(std::is_sorted(result.classes.begin(), result.classes.end(),
+                         [](const ClassChange& a, const ClassChange& b) { return a.qualifiedName < b.qualifiedName; }));
+
+    const ClassChange* button = findChange(result, "ui::Button");
+    REQUIRE(button);
+    CHECK(button->kind == ChangeKind::Added);
+    CHECK(button->before == nullptr);
+    CHECK(button->after != nullptr);
+
+    const ClassChange* dialog = findChange(result, "ui::Dialog");
+    REQUIRE(dialog);
+    CHECK(dialog->kind == ChangeKind::Removed);
+    CHECK(dialog->after == nullptr);
+
+    const ClassChange* window = findChange(result, "ui::Window");
+    REQUIRE(window);
+    CHECK(window->kind == ChangeKind::Changed);
+    CHECK_FALSE(window->headerChanged);
+    REQUIRE(window->members.size() == 1);
+    CHECK(window->members.front().kind == ChangeKind::Added);
+    REQUIRE(window->members.front().after);
+    CHECK(window->members.front().after->getName() == "m_title");
+
+    // Herencias: Button -> Widget aparece, Dialog -> Window desaparece.
+    bool buttonInherits = false, dialogInherits = false;
+    for (const auto& relationship : result.relationships) {
+        if (relationship.relationship != RelationshipKind::Inheritance) continue;
+        if (relationship.source == "ui::Button" && relationship.target == "ui::Widget") {
+            buttonInherits = relationship.kind == ChangeKind::Added;
+        }
+        if (relationship.source == "ui::Dialog" && relationship.target == "ui::Window") {
+            dialogInherits = relationship.kind == ChangeKind::Removed;
+        }
+    }
+    CHECK(buttonInherits);
+    CHECK(dialogInherits);
+}
+
+TEST_CASE("ModelDiffer salta los subárboles idénticos sin recorrerlos", "[diff]") {
+    SECTION("cambios en ui: core y app se descartan por hash") {
+        auto before = test::makeSampleModel();
+        auto after = test::makeSampleModel({false, false, /*windowTitle=*/true});
+        const ModelDiff result = ModelDiffer::compare(*before, *after);
+        REQUIRE(result.classes.size() == 1);
+        CHECK(result.skippedSubtrees >= 2);
+        // Solo Window difiere; Widget se salta aunque comparta namespace.
+        CHECK(result.comparedClasses == 1);
+    }
+    SECTION("modelos idénticos: basta el hash del modelo") {
+        auto before = test::makeSampleModel();
+        auto after = test::makeSampleModel();
+        const ModelDiff result = ModelDiffer::compare(*before, *after);
+        CHECK(result.empty());
+        CHECK(result.comparedClasses == 0);
+        CHECK(result.skippedSubtrees == 0);
+    }
+}
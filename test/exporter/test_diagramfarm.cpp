@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "exporter/DiagramFarm.h"
+
+using cppuml::exporter::DiagramFarm;
+
+namespace {
+
+bool hasHashSuffix(const std::string& path) {
+    if (path.size() < 9 || path[path.size() - 9] != '-') return false;
+    return path.find_first_not_of("0123456789abcdef", path.size() - 8) == std::string::npos;
+}
+
+} // namespace
+
+TEST_CASE("DiagramFarm::diagramPath convierte namespaces en directorios", "[exporter][diagram_farm]") {
+    CHECK(DiagramFarm::diagramPath("ui::Window") == "ui/Window");
+    CHECK(DiagramFarm::diagramPath("a::b::C") == "a/b/C");
+    CHECK(DiagramFarm::diagramPath("Global") == "Global");
+}
+
+TEST_CASE("DiagramFarm::diagramPath separa los nombres que se sanean igual", "[exporter][diagram_farm]") {
+    const std::string box = DiagramFarm::diagramPath("Box<int>");
+    const std::string pointer = DiagramFarm::diagramPath("Box<int*>");
+    CHECK(box.rfind("Box_int_", 0) == 0);
+    CHECK(hasHashSuffix(box));
+    CHECK(hasHashSuffix(pointer));
+    CHECK(box != pointer);
+    CHECK(DiagramFarm::diagramPath("Box<int>") == box); // Determinista
+
+    // Los argumentos con "::" no abren directorios nuevos.
+    const std::string nested = DiagramFarm::diagramPath("core::Box<ui::Widget>");
+    CHECK(nested.rfind("core/Box_ui", 0) == 0);
+    CHECK(hasHashSuffix(nested));
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "exporter/NdjsonExporter.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::exporter;
+
+namespace {
+
+std::string exportWith(const Model& model, unsigned threads, NdjsonStats* stats = nullptr) {
+    NdjsonOptions options;
+    options.threads = threads;
+    options.chunkBytes = 64; // Muchos bloques pequeños: el orden de escritura importa
+    options.pendingChunks = 1;
+    std::ostringstream out;
+    REQUIRE(NdjsonExporter(options).exportModel(model, out, stats));
+    return out.str();
+}
+
+} // namespace
+
+TEST_CASE("NdjsonExporter escribe los mismos bytes con cualquier número de hilos", "[exporter][ndjson]") {
+    const auto model = test::makeSampleModel();
+
+    NdjsonStats stats;
+    const std::string single = exportWith(*model, 1, &stats);
+    REQUIRE_FALSE(single.empty());
+    CHECK(single.back() == '\n');
+    CHECK(stats.bytes == single.size());
+    CHECK(stats.records == static_cast<std::size_t>(std::count(single.begin(), single.end(), '\n')));
+
+    CHECK(exportWith(*model, 2) == single);
+    CHECK(exportWith(*model, 8) == single);
+
+    // ui::Widget está en las dos TUs y sale una sola vez.
+    std::size_t widgets = 0;
+    for (std::size_t pos = 0; (pos = single.find("\"qualifiedName\":\"ui::Widget\"", pos)) != std::string::npos; ++pos) {
+        ++widgets;
+    }
+    CHECK(widgets == 1);
+}
+
+TEST_CASE("NdjsonStreamWriter produce la misma salida TU a TU", "[exporter][ndjson]") {
+    const auto model = test::makeSampleModel();
+    const std::string expected = exportWith(*model, 1);
+
+    for (unsigned threads : {1u, 4u}) {
+        INFO("hilos " << threads);
+        NdjsonOptions options;
+        options.threads = threads;
+        options.chunkBytes = 64;
+        std::ostringstream out;
+        NdjsonStreamWriter writer(out, options);
+        for (const auto& tu : model->getTranslationUnits()) REQUIRE(writer.add(*tu));
+        REQUIRE(writer.finish(*model));
+        CHECK(out.str() == expected);
+        CHECK(writer.stats().bytes == expected.size());
+    }
+}
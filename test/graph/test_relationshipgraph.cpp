@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "graph/RelationshipGraph.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::graph;
+
+namespace {
+
+/**
+ * Rombo:   Base
+ *         /    \
+ *      Left    Right
+ *         \    /
+ *         Bottom       (y Other, sin relación)
+ */
+std::unique_ptr<Model> makeDiamond() {
+    auto model = std::make_unique<Model>();
+    auto tu = std::make_unique<TranslationUnit>("diamond.cpp");
+    Namespace* ns = test::addNamespace(*tu->getGlobalNamespace(), "d");
+    test::addClass(*ns, "Base");
+    test::addClass(*ns, "Left")->addBaseClass(std::string("d::Base"), Visibility::Public);
+    test::addClass(*ns, "Right")->addBaseClass(std::string("d::Base"), Visibility::Public);
+    Class* bottom = test::addClass(*ns, "Bottom");
+    bottom->addBaseClass(std::string("d::Left"), Visibility::Public);
+    bottom->addBaseClass(std::string("d::Right"), Visibility::Public);
+    test::addField(*test::addClass(*ns, "Other"), "m_base", Type("Base"));
+    model->addTranslationUnit(std::move(tu));
+    parser::SymbolResolver::resolve(*model);
+    return model;
+}
+
+std::set<std::string> names(const RelationshipGraph& graph, const std::vector<NodeId>& nodes) {
+    std::set<std::string> result;
+    for (NodeId node : nodes) result.insert(graph.name(node));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("RelationshipGraph responde isDerivedFrom en un rombo", "[graph]") {
+    const auto model = makeDiamond();
+    const RelationshipGraph graph(*model);
+    const NodeId base = graph.find("d::Base");
+    const NodeId left = graph.find("d::Left");
+    const NodeId right = graph.find("d::Right");
+    const NodeId bottom = graph.find("d::Bottom");
+    const NodeId other = graph.find("d::Other");
+    REQUIRE(base != kInvalidNode);
+    REQUIRE(bottom != kInvalidNode);
+    REQUIRE(other != kInvalidNode);
+    CHECK(graph.find("d::Missing") == kInvalidNode);
+    CHECK(graph.edgeCount(RelationshipKind::Inheritance) == 4);
+
+    CHECK(graph.isDerivedFrom(left, base));
+    CHECK(graph.isDerivedFrom(right, base));
+    CHECK(graph.isDerivedFrom(bottom, left));
+    CHECK(graph.isDerivedFrom(bottom, right));
+    CHECK(graph.isDerivedFrom(bottom, base));
+
+    CHECK_FALSE(graph.isDerivedFrom(base, bottom));
+    CHECK_FALSE(graph.isDerivedFrom(left, right));
+    CHECK_FALSE(graph.isDerivedFrom(base, base));
+    CHECK_FALSE(graph.isDerivedFrom(other, base)); // Usa Base, no hereda de ella
+}
+
+TEST_CASE("RelationshipGraph lista descendientes y ancestros sin duplicados", "[graph]") {
+    const auto model = makeDiamond();
+    const RelationshipGraph graph(*model);
+    const NodeId base = graph.find("d::Base");
+    const NodeId left = graph.find("d::Left");
+    const NodeId bottom = graph.find("d::Bottom");
+
+    const std::vector<NodeId> below = graph.descendants(base);
+    CHECK(below.size() == 3); // Bottom se alcanza por dos caminos, pero sale una vez
+    CHECK(names(graph, below) == std::set<std::string>{"d::Left", "d::Right", "d::Bottom"});
+    CHECK(names(graph, graph.descendants(left)) == std::set<std::string>{"d::Bottom"});
+    CHECK(graph.descendants(bottom).empty());
+
+    const std::vector<NodeId> above = graph.ancestors(bottom);
+    REQUIRE(above.size() == 3);
+    CHECK(graph.name(above.back()) == "d::Base"); // De la más cercana a la más lejana
+    CHECK(names(graph, above) == std::set<std::string>{"d::Left", "d::Right", "d::Base"});
+}
+
+TEST_CASE("RelationshipGraph recorre las dependencias entrantes", "[graph]") {
+    const auto model = makeDiamond();
+    const RelationshipGraph graph(*model);
+    const NodeId base = graph.find("d::Base");
+
+    const auto reached = graph.reachable({base}, kAllKinds, Direction::Incoming, 1);
+    std::vector<NodeId> nodes;
+    for (const auto& entry : reached) {
+        CHECK(entry.second == 1);
+        nodes.push_back(entry.first);
+    }
+    CHECK(names(graph, nodes) == std::set<std::string>{"d::Left", "d::Right", "d::Other"});
+
+    const auto all = graph.reachable({base}, maskOf(RelationshipKind::Inheritance), Direction::Incoming);
+    REQUIRE(all.size() == 3);
+    CHECK(graph.name(all.back().first) == "d::Bottom");
+    CHECK(all.back().second == 2);
+}
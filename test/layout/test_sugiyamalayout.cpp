@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+#include "layout/SugiyamaLayout.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::layout;
+
+namespace {
+
+LayoutGraph makeGraph(std::size_t nodes, std::initializer_list<std::pair<std::size_t, std::size_t>> edges) {
+    LayoutGraph graph;
+    for (std::size_t i = 0; i < nodes; ++i) graph.nodes.push_back(LayoutNode{nullptr, 100.0, 50.0});
+    for (const auto& edge : edges) graph.edges.push_back({edge.first, edge.second, RelationshipKind::Inheritance});
+    return graph;
+}
+
+LayoutOptions singleThread() {
+    LayoutOptions options;
+    options.threads = 1;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("SugiyamaLayout asigna capas descendentes a un grafo acíclico", "[layout]") {
+    // 0 -> 1 -> 2 y el atajo 0 -> 2 (dos capas: un nodo ficticio)
+    const LayoutGraph graph = makeGraph(3, {{0, 1}, {1, 2}, {0, 2}});
+    const LayoutResult result = SugiyamaLayout(singleThread()).run(graph);
+
+    REQUIRE(result.layers.size() == 3);
+    REQUIRE(result.positions.size() == 3);
+    REQUIRE(result.edgeRoutes.size() == 3);
+    CHECK(result.layers[0] == 0);
+    CHECK(result.layers[1] == 1);
+    CHECK(result.layers[2] == 2);
+    CHECK(result.layerCount == 3);
+    CHECK(result.dummyCount == 1);
+    CHECK(std::none_of(result.reversedEdges.begin(), result.reversedEdges.end(), [](bool r) { return r; }));
+
+    // Cada capa se dibuja debajo de la anterior.
+    CHECK(result.positions[0].y < result.positions[1].y);
+    CHECK(result.positions[1].y < result.positions[2].y);
+}
+
+TEST_CASE("SugiyamaLayout rompe los ciclos invirtiendo aristas", "[layout]") {
+    const LayoutGraph graph = makeGraph(3, {{0, 1}, {1, 2}, {2, 0}});
+    const LayoutResult result = SugiyamaLayout(singleThread()).run(graph);
+
+    REQUIRE(result.reversedEdges.size() == 3);
+    CHECK(std::count(result.reversedEdges.begin(), result.reversedEdges.end(), true) == 1);
+    for (std::size_t e = 0; e < graph.edges.size(); ++e) {
+        const int source = result.layers[graph.edges[e].source];
+        const int target = result.layers[graph.edges[e].target];
+        CHECK((result.reversedEdges[e] ? target < source : source < target));
+    }
+}
+
+TEST_CASE("SugiyamaLayout cuenta los cruces inevitables", "[layout]") {
+    SECTION("un árbol se dibuja sin cruces") {
+        const LayoutGraph graph = makeGraph(7, {{0, 1}, {0, 2}, {1, 3}, {1, 4}, {2, 5}, {2, 6}});
+        CHECK(SugiyamaLayout(singleThread()).run(graph).crossings == 0);
+    }
+    SECTION("K2,2 entre dos capas cruza una vez") {
+        const LayoutGraph graph = makeGraph(4, {{0, 2}, {0, 3}, {1, 2}, {1, 3}});
+        CHECK(SugiyamaLayout(singleThread()).run(graph).crossings == 1);
+    }
+    SECTION("K3,3 entre dos capas cruza nueve veces en cualquier orden") {
+        const LayoutGraph graph =
+            makeGraph(6, {{0, 3}, {0, 4}, {0, 5}, {1, 3}, {1, 4}, {1, 5}, {2, 3}, {2, 4}, {2, 5}});
+        CHECK(SugiyamaLayout(singleThread()).run(graph).crossings == 9);
+    }
+}
+
+TEST_CASE("SugiyamaLayout separa los nodos de una misma capa", "[layout]") {
+    const LayoutGraph graph = makeGraph(4, {{0, 1}, {0, 2}, {0, 3}});
+    LayoutOptions options = singleThread();
+    const LayoutResult result = SugiyamaLayout(options).run(graph);
+
+    std::vector<double> xs{result.positions[1].x, result.positions[2].x, result.positions[3].x};
+    std::sort(xs.begin(), xs.end());
+    for (std::size_t i = 1; i < xs.size(); ++i) {
+        CHECK(xs[i] - xs[i - 1] >= 100.0 + options.nodeSpacing);
+    }
+}
+
+TEST_CASE("SugiyamaLayout da el mismo resultado con varios hilos", "[layout]") {
+    const LayoutGraph graph =
+        makeGraph(8, {{0, 2}, {0, 3}, {1, 3}, {1, 4}, {2, 5}, {3, 6}, {4, 7}, {2, 7}, {0, 7}});
+    LayoutOptions parallel = singleThread();
+    parallel.threads = 4;
+    const LayoutResult one = SugiyamaLayout(singleThread()).run(graph);
+    const LayoutResult four = SugiyamaLayout(parallel).run(graph);
+
+    CHECK(one.crossings == four.crossings);
+    CHECK(one.layers == four.layers);
+    for (std::size_t i = 0; i < graph.nodes.size(); ++i) {
+        CHECK(one.positions[i].x == four.positions[i].x);
+    }
+}
+
+TEST_CASE("SugiyamaLayout asigna las capas solo con la herencia", "[layout]") {
+    // Herencia 0 -> 1 -> 2; asociaciones 2 -> 0 (dos capas hacia arriba),
+    // 1 -> 0 (contigua, hacia arriba) y la cadena 0 -> 3 -> 4 en la capa 0.
+    LayoutGraph graph = makeGraph(5, {{0, 1}, {1, 2}});
+    graph.edges.push_back({2, 0, RelationshipKind::Association});
+    graph.edges.push_back({1, 0, RelationshipKind::Composition});
+    graph.edges.push_back({0, 3, RelationshipKind::Association});
+    graph.edges.push_back({3, 4, RelationshipKind::Association});
+    const LayoutResult result = SugiyamaLayout(singleThread()).run(graph);
+
+    CHECK(result.layerCount == 3);
+    CHECK(result.dummyCount == 0);
+    CHECK(result.layers[3] == 0);
+    CHECK(result.layers[4] == 0);
+    CHECK(result.directEdges == 3);
+    CHECK(std::none_of(result.reversedEdges.begin(), result.reversedEdges.end(), [](bool r) { return r; }));
+
+    // Las rutas van siempre del origen al destino.
+    auto center = [&](std::size_t v) { return result.positions[v].x + graph.nodes[v].width / 2.0; };
+    const auto& upward = result.edgeRoutes[2];
+    REQUIRE(upward.size() == 2);
+    CHECK(upward.front().y == result.positions[2].y);
+    CHECK(upward.back().y == result.positions[0].y + 50.0);
+    const auto& adjacent = result.edgeRoutes[3];
+    REQUIRE(adjacent.size() == 2);
+    CHECK(adjacent.front().x == center(1));
+    CHECK(adjacent.back().x == center(0));
+
+    // Misma capa: baja al pasillo entre capas y vuelve a subir.
+    const auto& sameLayer = result.edgeRoutes[4];
+    REQUIRE(sameLayer.size() == 4);
+    CHECK(sameLayer.front().x == center(0));
+    CHECK(sameLayer.back().x == center(3));
+    CHECK(sameLayer[1].y > result.positions[0].y + 50.0);
+    CHECK(sameLayer[1].y < result.positions[1].y);
+    CHECK(sameLayer[1].y == sameLayer[2].y);
+
+    SECTION("layerAssociations recupera las capas por asociación") {
+        LayoutOptions options = singleThread();
+        options.layerAssociations = true;
+        const LayoutResult layered = SugiyamaLayout(options).run(graph);
+        CHECK(layered.directEdges == 0);
+        CHECK(layered.layers[3] == layered.layers[0] + 1);
+        CHECK(layered.layers[4] == layered.layers[3] + 1);
+        CHECK(std::count(layered.reversedEdges.begin(), layered.reversedEdges.end(), true) >= 1);
+    }
+}
+
+TEST_CASE("buildClassGraph deduce las asociaciones de los campos", "[layout]") {
+    const auto model = test::makeSampleModel();
+    const LayoutGraph graph = buildClassGraph(*model);
+
+    auto indexOf = [&](const std::string& name) {
+        std::size_t found = graph.nodes.size();
+        std::size_t copies = 0;
+        for (std::size_t i = 0; i < graph.nodes.size(); ++i) {
+            if (graph.nodes[i].element->getName() == name) {
+                found = i;
+                ++copies;
+            }
+        }
+        CHECK(copies == 1); // ui::Widget está en las dos TUs y es un solo nodo
+        return found;
+    };
+    auto hasEdge = [&](std::size_t source, std::size_t target, RelationshipKind kind) {
+        return std::any_of(graph.edges.begin(), graph.edges.end(), [&](const LayoutEdge& edge) {
+            return edge.source == source && edge.target == target && edge.kind == kind;
+        });
+    };
+    const std::size_t widget = indexOf("Widget");
+    const std::size_t window = indexOf("Window");
+    const std::size_t main = indexOf("Main");
+    REQUIRE(main < graph.nodes.size());
+
+    // app::Main { m_window : ui::Window } y ui::Window { m_child : Widget }
+    CHECK(hasEdge(main, window, RelationshipKind::Association));
+    CHECK(hasEdge(window, widget, RelationshipKind::Association));
+    CHECK(hasEdge(widget, window, RelationshipKind::Inheritance));
+    // add(Widget*) es uso, no asociación: no se dibuja.
+    CHECK(std::none_of(graph.edges.begin(), graph.edges.end(),
+                       [](const LayoutEdge& edge) { return edge.kind == RelationshipKind::Usage; }));
+
+    const LayoutResult result = SugiyamaLayout(singleThread()).run(graph);
+    CHECK(result.layers[widget] < result.layers[window]);
+}
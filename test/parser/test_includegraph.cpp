@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "parser/include_graph.h"
+#include "test_support.h"
+
+using cppuml::parser::IncludeGraph;
+using Names = std::vector<std::string>;
+
+namespace {
+
+/// a.cpp incluye x.h e y.h; b.cpp incluye y.h (que incluye z.h).
+IncludeGraph makeGraph() {
+    IncludeGraph graph;
+    graph.record("/src/a.cpp", {"/src/a.cpp", "/src/x.h", "/src/y.h", "/src/z.h"});
+    graph.record("/src/b.cpp", {"/src/b.cpp", "/src/y.h", "/src/z.h"});
+    return graph;
+}
+
+} // namespace
+
+TEST_CASE("IncludeGraph::affectedUnits devuelve solo las TUs que incluyen lo modificado", "[parser][include_graph]") {
+    const IncludeGraph graph = makeGraph();
+    REQUIRE(graph.unitCount() == 2);
+
+    CHECK(graph.affectedUnits({"/src/x.h"}) == Names{"/src/a.cpp"});
+    CHECK(graph.affectedUnits({"/src/z.h"}) == Names{"/src/a.cpp", "/src/b.cpp"});
+    CHECK(graph.affectedUnits({"/src/b.cpp"}) == Names{"/src/b.cpp"});
+    CHECK(graph.affectedUnits({"/src/x.h", "/src/y.h"}) == Names{"/src/a.cpp", "/src/b.cpp"});
+    CHECK(graph.affectedUnits({"/src/unknown.h"}).empty());
+    CHECK(graph.affectedUnits({}).empty());
+}
+
+TEST_CASE("IncludeGraph normaliza las rutas antes de compararlas", "[parser][include_graph]") {
+    const IncludeGraph graph = makeGraph();
+    CHECK(graph.affectedUnits({"/src/sub/../x.h"}) == Names{"/src/a.cpp"});
+    CHECK(graph.affectedUnits({"/src/./y.h"}) == Names{"/src/a.cpp", "/src/b.cpp"});
+}
+
+TEST_CASE("IncludeGraph reemplaza y olvida las inclusiones de una TU", "[parser][include_graph]") {
+    IncludeGraph graph = makeGraph();
+
+    graph.record("/src/a.cpp", {"/src/a.cpp", "/src/x.h"});
+    CHECK(graph.includeCount("/src/a.cpp") == 2);
+    CHECK(graph.affectedUnits({"/src/y.h"}) == Names{"/src/b.cpp"});
+
+    graph.forget("/src/b.cpp");
+    CHECK(graph.unitCount() == 1);
+    CHECK(graph.affectedUnits({"/src/y.h"}).empty());
+    CHECK(graph.includeCount("/src/b.cpp") == 0);
+}
+
+TEST_CASE("IncludeGraph se guarda y se carga", "[parser][include_graph]") {
+    const cppuml::test::TempDirectory directory;
+    const IncludeGraph graph = makeGraph();
+    REQUIRE(graph.save(directory.file("includes.txt")));
+
+    IncludeGraph loaded;
+    REQUIRE(loaded.load(directory.file("includes.txt")));
+    CHECK(loaded.unitCount() == 2);
+    CHECK(loaded.includeCount("/src/a.cpp") == 4);
+    CHECK(loaded.affectedUnits({"/src/z.h"}) == Names{"/src/a.cpp", "/src/b.cpp"});
+
+    CHECK_FALSE(loaded.load(directory.file("missing.txt")));
+}
@@ -0,0 +1,497 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Namespace.h"
+#include "parser/libclang_parser.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using cppuml::parser::LibClangParser;
+using cppuml::parser::LiveUnitStats;
+using cppuml::parser::SourceBuffer;
+
+namespace {
+
+/// Analiza un fragmento en memoria, sin archivos en disco ni cabeceras del sistema.
+std::unique_ptr<TranslationUnit> parseSnippet(LibClangParser& parser, const std::string& path,
+                                              const std::string& code) {
+    return parser.parse(path, std::vector<SourceBuffer>{{path, code}}, {"-x", "c++", "-std=c++17"});
+}
+
+/// La clase con ese nombre calificado ("ui::Widget"), o nullptr.
+const Class* findClass(const TranslationUnit& tu, const std::string& qualifiedName) {
+    const Namespace* ns = tu.getGlobalNamespace();
+    std::string rest = qualifiedName;
+    for (std::size_t sep; (sep = rest.find("::")) != std::string::npos;) {
+        const std::string part = rest.substr(0, sep);
+        rest.erase(0, sep + 2);
+        const Namespace* next = nullptr;
+        for (const auto& member : ns->getMembers()) {
+            if (member->getKind() == ElementKind::Namespace && member->getName() == part) {
+                next = static_cast<const Namespace*>(member.get());
+            }
+        }
+        if (!next) return nullptr;
+        ns = next;
+    }
+    for (const auto& member : ns->getMembers()) {
+        if (member->getKind() == ElementKind::Class && member->getName() == rest) {
+            return static_cast<const Class*>(member.get());
+        }
+    }
+    return nullptr;
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream(path) << contents;
+}
+
+const Field* findField(const Class& cls, const std::string& name) {
+    for (const auto& field : cls.getFields()) {
+        if (field->getName() == name) return field.get();
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// --- Plantillas ---
+
+TEST_CASE("LibClangParser modela la plantilla una vez y comparte sus instanciaciones", "[parser][templates]") {
+    const std::string code = R"(
+namespace core {
+template <typename T, int N = 4>
+class Box { T items[N]; };
+}
+namespace ui {
+class Widget {};
+using WidgetBox = core::Box<Widget>;
+class Registry {
+    core::Box<Widget> m_first;
+    WidgetBox m_second;
+    core::Box<Widget, 4>* m_third;
+    core::Box<int> m_numbers;
+};
+}
+)";
+    LibClangParser parser;
+    const auto tu = parseSnippet(parser, "/virtual/registry.cpp", code);
+    REQUIRE(tu);
+
+    const Class* box = findClass(*tu, "core::Box");
+    REQUIRE(box);
+    REQUIRE(box->getTemplateParameters().size() == 2);
+    CHECK(box->getTemplateParameters()[0].name == "T");
+    CHECK(box->getTemplateParameters()[0].kind == "typename");
+    CHECK(box->getTemplateParameters()[1].name == "N");
+    CHECK(box->getTemplateParameters()[1].kind == "int");
+    CHECK(box->getTemplateParameters()[1].defaultArgument == "4");
+
+    const Class* registry = findClass(*tu, "ui::Registry");
+    REQUIRE(registry);
+    const Field* first = findField(*registry, "m_first");
+    const Field* second = findField(*registry, "m_second");
+    const Field* third = findField(*registry, "m_third");
+    const Field* numbers = findField(*registry, "m_numbers");
+    REQUIRE((first && second && third && numbers));
+
+    // El alias y el argumento por defecto explícito son la misma instanciación.
+    const auto& binding = first->getType().getBinding();
+    REQUIRE(binding);
+    CHECK(binding->templateName == "core::Box");
+    CHECK(binding->canonicalName == "core::Box<ui::Widget>");
+    REQUIRE(binding->arguments.size() == 1);
+    CHECK(second->getType().getBinding() == binding);
+    CHECK(third->getType().getBinding() == binding);
+    CHECK(third->getType().isPointer());
+    CHECK(first->getType().getName() == "core::Box");
+
+    CHECK(numbers->getType().getBinding() != binding);
+    CHECK(tu->getTemplateBindings().size() == 2); // Cada instanciación se registra una vez
+}
+
+TEST_CASE("LibClangParser memoriza las instanciaciones entre TUs", "[parser][templates]") {
+    const std::string header = "template <typename T> struct Handle { T* value; };\nstruct Order {};\n";
+    LibClangParser parser;
+    const auto a = parseSnippet(parser, "/virtual/a.cpp", header + "struct A { Handle<Order> order; };\n");
+    const auto b = parseSnippet(parser, "/virtual/b.cpp", header + "struct B { Handle<Order> order; };\n");
+    REQUIRE((a && b));
+
+    const Field* fromA = findField(*findClass(*a, "A"), "order");
+    const Field* fromB = findField(*findClass(*b, "B"), "order");
+    REQUIRE((fromA && fromB));
+    REQUIRE(fromA->getType().getBinding());
+    CHECK(fromA->getType().getBinding() == fromB->getType().getBinding());
+    CHECK(b->getTemplateBindings().size() == 1); // Cada TU registra las que usa
+
+    // Los tipos dependientes no son instanciaciones.
+    const Class* handle = findClass(*a, "Handle");
+    REQUIRE(handle);
+    const Field* value = findField(*handle, "value");
+    REQUIRE(value);
+    CHECK_FALSE(value->getType().getBinding());
+}
+
+// --- Recorrido del AST ---
+
+TEST_CASE("LibClangParser reparte cada tipo de cursor a su manejador", "[parser][visitor]") {
+    const std::string header = R"(
+#pragma once
+namespace sys { class Hidden { int m_value; }; }
+)";
+    const std::string code = R"(
+#include <hidden.h>
+namespace app {
+class Forward;
+template <typename T, int N = 2>
+class Holder {
+public:
+    template <typename U> void take(U value);
+    void clear();
+    static int s_count;
+    T m_items[N];
+private:
+    struct Node { Node* next; };
+    Node* m_head;
+};
+extern "C++" {
+class Linked { double m_weight; };
+}
+inline int helper() {
+    struct Local { int m_local; };
+    return Local{1}.m_local;
+}
+class Worker : public Linked, private sys::Hidden {
+public:
+    Worker() { int counter = 0; (void)counter; }
+    void run() const;
+    virtual ~Worker();
+};
+}
+)";
+    LibClangParser parser;
+    const auto tu = parser.parse("/virtual/dispatch.cpp",
+                                 std::vector<SourceBuffer>{{"/virtual/dispatch.cpp", code},
+                                                           {"/virtual/sys/hidden.h", header}},
+                                 {"-x", "c++", "-std=c++17", "-isystem", "/virtual/sys"});
+    REQUIRE(tu);
+
+    // Plantilla: sus parámetros, no los del método plantilla; un miembro
+    // estático (VarDecl) es un campo más.
+    const Class* holder = findClass(*tu, "app::Holder");
+    REQUIRE(holder);
+    REQUIRE(holder->getTemplateParameters().size() == 2);
+    CHECK(holder->getTemplateParameters()[0].name == "T");
+    CHECK(holder->getTemplateParameters()[1].name == "N");
+    CHECK(holder->getTemplateParameters()[1].defaultArgument == "2");
+    CHECK(std::any_of(holder->getMethods().begin(), holder->getMethods().end(),
+                      [](const auto& method) { return method->getName() == "clear"; }));
+    REQUIRE(holder->getFields().size() == 3);
+    const Field* count = findField(*holder, "s_count");
+    REQUIRE(count);
+    CHECK(count->isStatic());
+    CHECK(count->getVisibility() == Visibility::Public);
+    CHECK_FALSE(findField(*holder, "m_items")->isStatic());
+    CHECK(findField(*holder, "m_head")->getVisibility() == Visibility::Private);
+    CHECK(findClass(*tu, "app::Node")); // Las anidadas van al namespace
+
+    // 'extern "C++"' y el cuerpo de una función se recorren en busca de clases.
+    const Class* linked = findClass(*tu, "app::Linked");
+    REQUIRE(linked);
+    CHECK(linked->getFields().size() == 1);
+    CHECK(findClass(*tu, "app::Local"));
+
+    // Las variables locales de un constructor no son campos.
+    const Class* worker = findClass(*tu, "app::Worker");
+    REQUIRE(worker);
+    CHECK(worker->getFields().empty());
+    REQUIRE(worker->getMethods().size() == 1); // Constructor y destructor no son CXXMethod
+    CHECK(worker->getMethods().front()->getName() == "run");
+    CHECK(worker->getMethods().front()->isConst());
+    REQUIRE(worker->getBaseClasses().size() == 2);
+    CHECK(worker->getBaseClasses()[0].baseName == "app::Linked");
+    CHECK(worker->getBaseClasses()[1].baseName == "sys::Hidden"); // La cabecera se encontró
+
+    // Ni las declaraciones adelantadas ni las cabeceras del sistema.
+    CHECK_FALSE(findClass(*tu, "app::Forward"));
+    CHECK_FALSE(findClass(*tu, "sys::Hidden"));
+}
+
+// --- Buffers en Memoria ---
+
+TEST_CASE("LibClangParser analiza buffers en memoria en lugar del disco", "[parser][buffers]") {
+    const test::TempDirectory directory;
+    const std::string header = directory.file("widget.h");
+    const std::string source = directory.file("main.cpp");
+    writeFile(header, "#pragma once\nclass Widget { int m_saved; };\n");
+    writeFile(source, "#include \"widget.h\"\nclass Window { Widget m_child; };\n");
+    const std::vector<std::string> args{"-x", "c++", "-std=c++17"};
+    LibClangParser parser;
+
+    SECTION("una cabecera sin guardar reemplaza a la del disco") {
+        const auto tu = parser.parse(source, {SourceBuffer{header, "#pragma once\nclass Widget { int m_unsaved; };\n"}},
+                                     args);
+        REQUIRE(tu);
+        const Class* widget = findClass(*tu, "Widget");
+        REQUIRE(widget);
+        CHECK(findField(*widget, "m_unsaved"));
+        CHECK_FALSE(findField(*widget, "m_saved"));
+        const auto& included = tu->getIncludedFiles();
+        CHECK(std::any_of(included.begin(), included.end(),
+                          [](const std::string& file) { return file.find("widget.h") != std::string::npos; }));
+    }
+    SECTION("el archivo principal no necesita existir") {
+        const std::string unsaved = directory.file("scratch.cpp");
+        const auto tu = parser.parse(unsaved, {SourceBuffer{unsaved, "#include \"widget.h\"\nstruct Draft { Widget w; };\n"}},
+                                     args);
+        REQUIRE(tu);
+        CHECK(findClass(*tu, "Draft"));
+        const Class* widget = findClass(*tu, "Widget");
+        REQUIRE(widget);
+        CHECK(findField(*widget, "m_saved")); // Sin buffer, la cabecera se lee del disco
+    }
+    SECTION("sin buffers se lee el disco") {
+        const auto tu = parser.parse(source, args);
+        REQUIRE(tu);
+        const Class* window = findClass(*tu, "Window");
+        REQUIRE(window);
+        CHECK(findField(*window, "m_child"));
+    }
+}
+
+// --- TUs Vivas ---
+
+TEST_CASE("LibClangParser reanaliza las TUs vivas con los buffers nuevos", "[parser][live_units]") {
+    const std::string path = "/virtual/editor.cpp";
+    LibClangParser parser;
+    parser.setKeepAlive(true);
+
+    const auto before = parseSnippet(parser, path, "struct Shape { int m_sides; };\n");
+    REQUIRE(before);
+    CHECK(parser.liveUnitStats().misses == 1);
+    CHECK(parser.liveUnitStats().units == 1);
+    CHECK(parser.liveUnitStats().bytes > 0);
+
+    const auto after = parseSnippet(parser, path, "struct Shape { int m_sides; double m_area; };\n");
+    REQUIRE(after);
+    const LiveUnitStats stats = parser.liveUnitStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 1);
+    CHECK(stats.units == 1);
+    const Class* shape = findClass(*after, "Shape");
+    REQUIRE(shape);
+    CHECK(findField(*shape, "m_area")); // El re-análisis ve el texto nuevo
+
+    // Con otros argumentos la TU retenida ya no sirve.
+    REQUIRE(parser.parse(path, {SourceBuffer{path, "struct Shape {};\n"}}, {"-x", "c++", "-std=c++14"}));
+    CHECK(parser.liveUnitStats().misses == 2);
+    CHECK(parser.liveUnitStats().units == 1);
+
+    parser.release(path);
+    CHECK(parser.liveUnitStats().units == 0);
+    CHECK(parser.liveUnitStats().bytes == 0);
+
+    parser.setKeepAlive(false);
+    REQUIRE(parseSnippet(parser, path, "struct Shape {};\n"));
+    CHECK(parser.liveUnitStats().units == 0);
+}
+
+TEST_CASE("LibClangParser libera las TUs vivas menos usadas al pasar del límite", "[parser][live_units]") {
+    const std::string code = "struct Node { Node* next; int value; };\n";
+    LibClangParser parser;
+    parser.setKeepAlive(true);
+    REQUIRE(parseSnippet(parser, "/virtual/a.cpp", code));
+    const std::size_t one = parser.liveUnitStats().bytes;
+    REQUIRE(one > 0);
+
+    // Cabe una TU y media: la segunda desaloja a la primera.
+    parser.setKeepAlive(true, one + one / 2);
+    REQUIRE(parseSnippet(parser, "/virtual/b.cpp", code));
+    LiveUnitStats stats = parser.liveUnitStats();
+    CHECK(stats.units == 1);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.bytes <= one + one / 2);
+
+    // 'a' ya no está: vuelve a crearse (y desaloja a 'b').
+    REQUIRE(parseSnippet(parser, "/virtual/a.cpp", code));
+    stats = parser.liveUnitStats();
+    CHECK(stats.misses == 3);
+    CHECK(stats.hits == 0);
+    CHECK(stats.evictions == 2);
+
+    SECTION("una TU mayor que el límite no se retiene") {
+        parser.setKeepAlive(true, 1);
+        const auto tu = parseSnippet(parser, "/virtual/c.cpp", code);
+        REQUIRE(tu);
+        CHECK(findClass(*tu, "Node"));
+        CHECK(parser.liveUnitStats().units == 0);
+    }
+}
+
+// --- Lotes Unity ---
+
+TEST_CASE("LibClangParser reparte un lote unity en una TU por cabecera", "[parser][unity]") {
+    const test::TempDirectory directory;
+    const std::string common = directory.file("common.h");
+    const std::string a = directory.file("a.h");
+    const std::string b = directory.file("b.h");
+    writeFile(common, "#pragma once\nstruct Common { int id; };\n");
+    writeFile(a, "#pragma once\n#include \"common.h\"\nnamespace app { struct A { Common c; }; }\n");
+    writeFile(b, "#pragma once\n#include \"common.h\"\nnamespace app { struct B : Common {}; }\n");
+
+    LibClangParser parser;
+    const auto units = parser.parseUnity({a, b}, {"-x", "c++", "-std=c++17"});
+    REQUIRE(units.size() == 2);
+    CHECK(units[0]->getName() == a);
+    CHECK(units[1]->getName() == b);
+
+    // Cada clase va a la cabecera que la declara; lo incluido, a la primera que lo incluyó.
+    CHECK(findClass(*units[0], "app::A"));
+    CHECK_FALSE(findClass(*units[0], "app::B"));
+    CHECK(findClass(*units[0], "Common"));
+    const Class* derived = findClass(*units[1], "app::B");
+    REQUIRE(derived);
+    CHECK_FALSE(findClass(*units[1], "app::A"));
+    CHECK_FALSE(findClass(*units[1], "Common"));
+    REQUIRE(derived->getBaseClasses().size() == 1);
+    CHECK(derived->getBaseClasses().front().baseName == "Common");
+
+    // Las dos registran las inclusiones del lote entero.
+    for (const auto& unit : units) {
+        const auto& included = unit->getIncludedFiles();
+        CHECK(std::any_of(included.begin(), included.end(),
+                          [](const std::string& file) { return file.find("common.h") != std::string::npos; }));
+    }
+}
+
+// --- Modo Skim ---
+
+TEST_CASE("LibClangParser en modo skim conserva los tipos desconocidos como se escribieron", "[parser][skim]") {
+    const std::string code = R"(
+#include "missing/widgets.h"
+#include <vector>
+namespace app {
+class Known {};
+class View {
+public:
+    const Foo& current() const;
+    void show(Foo const& foo, std::map<std::string, std::vector<Bar*>>& index);
+private:
+    std::map<std::string, std::vector<Foo>> m_byName;
+    Foo const& m_ref;
+    std::unique_ptr<Bar> m_bar;
+    Known m_known;
+    ns::Deep<ns::Inner<int>>* m_deep;
+    using Id = std::uint32_t;
+    std::unordered_map<Id, std::vector<Id>> m_index;
+};
+}
+)";
+    LibClangParser parser;
+    parser.setSkim(true);
+    const auto tu = parseSnippet(parser, "/virtual/view.cpp", code);
+    REQUIRE(tu);
+    const Class* view = findClass(*tu, "app::View");
+    REQUIRE(view);
+    CHECK(view->getFields().size() == 6);
+
+    // Plantillas anidadas: la declaración no se pierde y los argumentos se conservan.
+    const Field* byName = findField(*view, "m_byName");
+    REQUIRE(byName);
+    CHECK(byName->getType().isUnresolved());
+    CHECK(byName->getType().getFullName() == "std::map<std::string, std::vector<Foo>>");
+    REQUIRE(byName->getType().getTemplateParameters().size() == 2);
+    const Type& inner = byName->getType().getTemplateParameters()[1];
+    CHECK(inner.getName() == "std::vector");
+    REQUIRE(inner.getTemplateParameters().size() == 1);
+    CHECK(inner.getTemplateParameters().front().getName() == "Foo");
+
+    const Field* deep = findField(*view, "m_deep");
+    REQUIRE(deep);
+    CHECK(deep->getType().isPointer());
+    CHECK(deep->getType().getFullName() == "ns::Deep<ns::Inner<int>>*");
+
+    // Un alias de un tipo desconocido ('using Id = std::uint32_t;') como argumento.
+    const Field* index = findField(*view, "m_index");
+    REQUIRE(index);
+    CHECK(index->getType().getFullName() == "std::unordered_map<Id, std::vector<Id>>");
+
+    // 'Foo const&': el const escrito detrás también cuenta.
+    const Field* ref = findField(*view, "m_ref");
+    REQUIRE(ref);
+    CHECK(ref->getType().isConst());
+    CHECK(ref->getType().isReference());
+    CHECK(ref->getType().isUnresolved());
+    CHECK(ref->getType().getName() == "Foo");
+
+    const Field* known = findField(*view, "m_known");
+    REQUIRE(known);
+    CHECK_FALSE(known->getType().isUnresolved());
+
+    const Method* show = nullptr;
+    const Method* current = nullptr;
+    for (const auto& method : view->getMethods()) {
+        if (method->getName() == "show") show = method.get();
+        if (method->getName() == "current") current = method.get();
+    }
+    REQUIRE(current);
+    CHECK(current->getReturnType().getFullName() == "const Foo&");
+    REQUIRE(show);
+    REQUIRE(show->getParameters().size() == 2);
+    CHECK(show->getParameters()[0]->getType().getFullName() == "const Foo&");
+    CHECK(show->getParameters()[1]->getType().getFullName() == "std::map<std::string, std::vector<Bar*>>&");
+}
+
+TEST_CASE("LibClangParser en modo skim conserva las bases virtuales, múltiples y calificadas", "[parser][skim]") {
+    const std::string code = R"(
+#include "missing/base.h"
+namespace app {
+class Known {};
+class View : public virtual Known, protected ext::Observer<int, std::vector<Known>>, lib::detail::Base {};
+struct Plain : Known {};
+}
+namespace other {
+namespace util { class Local {}; }
+class Uses : public util::Local {};
+}
+)";
+    LibClangParser parser;
+    parser.setSkim(true);
+    const auto tu = parseSnippet(parser, "/virtual/bases.cpp", code);
+    REQUIRE(tu);
+
+    const Class* view = findClass(*tu, "app::View");
+    REQUIRE(view);
+    const auto& bases = view->getBaseClasses();
+    REQUIRE(bases.size() == 3);
+    CHECK(bases[0].baseName == "app::Known");
+    CHECK(bases[0].visibility == Visibility::Public);
+    CHECK(bases[1].baseName == "ext::Observer<int, std::vector<Known>>");
+    CHECK(bases[1].visibility == Visibility::Protected);
+    // Sin especificador, la herencia de una 'class' es privada.
+    CHECK(bases[2].baseName == "lib::detail::Base");
+    CHECK(bases[2].visibility == Visibility::Private);
+
+    const Class* plain = findClass(*tu, "app::Plain");
+    REQUIRE(plain);
+    REQUIRE(plain->getBaseClasses().size() == 1);
+    CHECK(plain->getBaseClasses().front().baseName == "app::Known");
+    CHECK(plain->getBaseClasses().front().visibility == Visibility::Public);
+
+    // Un namespace declarado en el archivo se resuelve con normalidad.
+    const Class* uses = findClass(*tu, "other::Uses");
+    REQUIRE(uses);
+    REQUIRE(uses->getBaseClasses().size() == 1);
+    CHECK(uses->getBaseClasses().front().baseName == "other::util::Local");
+    // El relleno no aparece en el modelo.
+    CHECK_FALSE(findClass(*tu, "ext::Observer"));
+    CHECK_FALSE(findClass(*tu, "lib::detail::Base"));
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "parser/include_graph.h"
+#include "parser/parse_scheduler.h"
+#include "test_support.h"
+
+using namespace cppuml::parser;
+
+namespace {
+
+std::vector<ParseJob> makeJobs(const std::vector<std::string>& files) {
+    std::vector<ParseJob> jobs;
+    for (const auto& file : files) jobs.push_back(ParseJob{file, {}});
+    return jobs;
+}
+
+/// Un historial con a = 2 s, b = 2 s y c = 4 s (y sus picos de memoria).
+ParseScheduler makeScheduler(const std::vector<ParseJob>& jobs) {
+    ProcessPoolReport report;
+    report.jobSeconds = {2.0, 2.0, 4.0};
+    report.jobPeakBytes = {100, 200, 400};
+    ParseScheduler scheduler;
+    scheduler.record(jobs, report);
+    return scheduler;
+}
+
+} // namespace
+
+TEST_CASE("ParseScheduler despacha primero las TUs más costosas", "[parser][parse_scheduler]") {
+    const auto jobs = makeJobs({"/src/a.cpp", "/src/b.cpp", "/src/c.cpp"});
+    const ParseScheduler scheduler = makeScheduler(jobs);
+    REQUIRE(scheduler.size() == 3);
+
+    const ParseSchedule schedule = scheduler.plan(jobs, 2);
+    CHECK(schedule.order == std::vector<std::size_t>{2, 0, 1});
+    CHECK(schedule.estimates == std::vector<double>{2.0, 2.0, 4.0});
+    CHECK(schedule.memoryEstimates == std::vector<std::size_t>{100, 200, 400});
+    CHECK(schedule.estimatedFromHistory == 3);
+    // LPT: c | a, b -> 4 s; en el orden de entrada: a, c | b -> 6 s.
+    CHECK(schedule.expectedMakespanSeconds == 4.0);
+    CHECK(schedule.naiveMakespanSeconds == 6.0);
+    CHECK(schedule.expectedTailIdleSeconds == 0.0);
+}
+
+TEST_CASE("ParseScheduler suaviza las mediciones repetidas", "[parser][parse_scheduler]") {
+    const auto jobs = makeJobs({"/src/a.cpp", "/src/b.cpp", "/src/c.cpp"});
+    ParseScheduler scheduler = makeScheduler(jobs);
+
+    ProcessPoolReport again;
+    again.jobSeconds = {6.0, 0.0, 4.0}; // b no llegó a ejecutarse
+    again.jobPeakBytes = {50, 0, 800};
+    scheduler.record(jobs, again);
+
+    const ParseSchedule schedule = scheduler.plan(jobs, 1);
+    CHECK(schedule.estimates == std::vector<double>{4.0, 2.0, 4.0});
+    // La memoria baja suavizada pero sube de golpe: subestimarla provocaría un OOM.
+    CHECK(schedule.memoryEstimates == std::vector<std::size_t>{75, 200, 800});
+    CHECK(schedule.order == std::vector<std::size_t>{0, 2, 1});
+}
+
+TEST_CASE("ParseScheduler guarda y carga los tiempos", "[parser][parse_scheduler]") {
+    const cppuml::test::TempDirectory directory;
+    const auto jobs = makeJobs({"/src/a.cpp", "/src/b.cpp", "/src/c.cpp"});
+
+    SECTION("formato actual (v2, con memoria)") {
+        REQUIRE(makeScheduler(jobs).save(directory.file("timings.txt")));
+        ParseScheduler loaded;
+        REQUIRE(loaded.load(directory.file("timings.txt")));
+        CHECK(loaded.size() == 3);
+        const ParseSchedule schedule = loaded.plan(jobs, 2);
+        CHECK(schedule.order == std::vector<std::size_t>{2, 0, 1});
+        CHECK(schedule.memoryEstimates == std::vector<std::size_t>{100, 200, 400});
+    }
+    SECTION("formato v1 (sin columna de memoria)") {
+        {
+            std::ofstream out(directory.file("timings.txt"));
+            out << "cppuml-parse-timings 1\n"
+                << "3.5\t" << IncludeGraph::normalize("/src/a.cpp") << '\n'
+                << "1.5\t" << IncludeGraph::normalize("/src/c.cpp") << '\n';
+        }
+        ParseScheduler loaded;
+        REQUIRE(loaded.load(directory.file("timings.txt")));
+        CHECK(loaded.size() == 2);
+        const ParseSchedule schedule = loaded.plan(jobs, 2);
+        CHECK(schedule.estimatedFromHistory == 2);
+        CHECK(schedule.estimates[0] == 3.5);
+        CHECK(schedule.estimates[2] == 1.5);
+        CHECK(schedule.memoryEstimates == std::vector<std::size_t>{0, 0, 0});
+        CHECK(schedule.order.front() == 0);
+    }
+    SECTION("archivos no válidos") {
+        ParseScheduler loaded = makeScheduler(jobs);
+        {
+            std::ofstream out(directory.file("bad-header.txt"));
+            out << "cppuml-parse-timings 9\n";
+        }
+        {
+            std::ofstream out(directory.file("bad-line.txt"));
+            out << "cppuml-parse-timings 2\nnot-a-number\t0\t/src/a.cpp\n";
+        }
+        CHECK_FALSE(loaded.load(directory.file("bad-header.txt")));
+        CHECK_FALSE(loaded.load(directory.file("bad-line.txt")));
+        CHECK_FALSE(loaded.load(directory.file("missing.txt")));
+        CHECK(loaded.size() == 3); // Un fallo no toca el historial
+    }
+}
+
+TEST_CASE("ParseScheduler estima las TUs sin historial al final", "[parser][parse_scheduler]") {
+    const auto known = makeJobs({"/src/a.cpp", "/src/b.cpp", "/src/c.cpp"});
+    const ParseScheduler scheduler = makeScheduler(known);
+
+    // Sin archivo en disco ni inclusiones conocidas su estimación es 0.
+    const auto jobs = makeJobs({"/src/new.cpp", "/src/c.cpp"});
+    const ParseSchedule schedule = scheduler.plan(jobs, 2);
+    CHECK(schedule.estimatedFromHistory == 1);
+    CHECK(schedule.order == std::vector<std::size_t>{1, 0});
+}
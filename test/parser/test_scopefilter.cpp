@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "parser/scope_filter.h"
+
+using cppuml::Visibility;
+using namespace cppuml::parser;
+
+TEST_CASE("ScopeFilter::globMatch compara el texto completo", "[parser][scope_filter]") {
+    CHECK(ScopeFilter::globMatch("myco::trading", "myco::trading"));
+    CHECK_FALSE(ScopeFilter::globMatch("myco::trading", "myco::trading::detail"));
+
+    // '*' admite cualquier secuencia, "::" y '/' incluidos, también la vacía.
+    CHECK(ScopeFilter::globMatch("*::detail", "a::b::detail"));
+    CHECK_FALSE(ScopeFilter::globMatch("*::detail", "a::detail::x"));
+    CHECK(ScopeFilter::globMatch("*/generated/*", "/src/generated/a.pb.h"));
+    CHECK(ScopeFilter::globMatch("*.pb.h", ".pb.h"));
+    CHECK(ScopeFilter::globMatch("*", ""));
+    CHECK(ScopeFilter::globMatch("a**b", "ab"));
+
+    // '?' es exactamente un carácter.
+    CHECK(ScopeFilter::globMatch("v?", "v2"));
+    CHECK_FALSE(ScopeFilter::globMatch("v?", "v"));
+    CHECK_FALSE(ScopeFilter::globMatch("v?", "v10"));
+
+    // Retroceso: el primer '*' no debe quedarse con lo que necesita el resto.
+    CHECK(ScopeFilter::globMatch("*a*b", "xaxxab"));
+    CHECK_FALSE(ScopeFilter::globMatch("*a*b", "xaxxa"));
+    CHECK_FALSE(ScopeFilter::globMatch("", "a"));
+}
+
+TEST_CASE("ScopeFilter::globMatchesPrefix acepta prefijos que el glob aún puede completar",
+          "[parser][scope_filter]") {
+    CHECK(ScopeFilter::globMatchesPrefix("myco::trading", "myco::"));
+    CHECK(ScopeFilter::globMatchesPrefix("myco::trading", ""));
+    CHECK(ScopeFilter::globMatchesPrefix("myco::trading", "myco::trading"));
+    CHECK_FALSE(ScopeFilter::globMatchesPrefix("myco::trading", "other::"));
+    CHECK_FALSE(ScopeFilter::globMatchesPrefix("myco::trading", "myco::trading::x"));
+
+    CHECK(ScopeFilter::globMatchesPrefix("*::api", "anything::at::all::"));
+    CHECK(ScopeFilter::globMatchesPrefix("myco::*::api", "myco::a::b::"));
+    CHECK_FALSE(ScopeFilter::globMatchesPrefix("myco::*::api", "other::"));
+    CHECK(ScopeFilter::globMatchesPrefix("v?::x", "v2::"));
+    CHECK_FALSE(ScopeFilter::globMatchesPrefix("v?::x", "v22"));
+}
+
+TEST_CASE("ScopeFilter decide los namespaces al entrar en ellos", "[parser][scope_filter]") {
+    ScopeFilterSpec spec;
+    REQUIRE(ScopeFilter::addRule("include-namespace", "myco::trading", spec));
+    REQUIRE(ScopeFilter::addRule("exclude-namespace", "*::detail", spec));
+    ScopeFilter filter;
+    REQUIRE(filter.compile(spec));
+
+    REQUIRE(filter.globalDecision() == ScopeDecision::Descend);
+    CHECK(filter.namespaceDecision("myco", ScopeDecision::Descend) == ScopeDecision::Descend);
+    CHECK(filter.namespaceDecision("myco::trading", ScopeDecision::Descend) == ScopeDecision::Include);
+    CHECK(filter.namespaceDecision("myco::trading::orders", ScopeDecision::Include) == ScopeDecision::Include);
+    CHECK(filter.namespaceDecision("myco::trading::detail", ScopeDecision::Include) == ScopeDecision::Exclude);
+    CHECK(filter.namespaceDecision("other", ScopeDecision::Descend) == ScopeDecision::Exclude);
+}
+
+TEST_CASE("ScopeFilter filtra clases, rutas y visibilidad", "[parser][scope_filter]") {
+    ScopeFilterSpec spec;
+    REQUIRE(ScopeFilter::addRule("exclude-path", "*/generated/*", spec));
+    REQUIRE(ScopeFilter::addRule("exclude-class", "Impl$", spec));
+    REQUIRE(ScopeFilter::addRule("min-visibility", "protected", spec));
+    CHECK_FALSE(ScopeFilter::addRule("min-visibility", "sometimes", spec));
+    CHECK_FALSE(ScopeFilter::addRule("no-such-rule", "x", spec));
+
+    ScopeFilter filter;
+    REQUIRE(filter.compile(spec));
+    CHECK(filter.acceptsPath("/src/ui/window.h"));
+    CHECK_FALSE(filter.acceptsPath("/src/generated/window.pb.h"));
+    CHECK(filter.acceptsClass("ui::Window"));
+    CHECK_FALSE(filter.acceptsClass("ui::WindowImpl"));
+    CHECK(filter.acceptsVisibility(Visibility::Public));
+    CHECK(filter.acceptsVisibility(Visibility::Protected));
+    CHECK_FALSE(filter.acceptsVisibility(Visibility::Private));
+
+    ScopeFilterSpec invalid;
+    REQUIRE(ScopeFilter::addRule("include-class", "([", invalid));
+    CHECK_FALSE(ScopeFilter().compile(invalid));
+}
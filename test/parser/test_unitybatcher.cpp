@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "parser/unity_batcher.h"
+#include "test_support.h"
+
+using namespace cppuml::parser;
+
+namespace {
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream(path) << contents;
+}
+
+} // namespace
+
+TEST_CASE("UnityBatcher agrupa las cabeceras que comparten inclusiones", "[parser][unity_batcher]") {
+    const cppuml::test::TempDirectory directory;
+    const std::string a = directory.file("a.h");
+    const std::string b = directory.file("b.h");
+    const std::string c = directory.file("c.h");
+    const std::string main = directory.file("main.cpp");
+    writeFile(a, "#include <vector>\n#include <string>\nstruct A {};\n");
+    writeFile(b, "#include <string>\n#include <vector>\n#include \"a.h\"\nstruct B {};\n");
+    writeFile(c, "#include <map>\nstruct C {};\n");
+    writeFile(main, "#include <vector>\nint main() {}\n");
+
+    CHECK(UnityBatcher::isHeader(a));
+    CHECK_FALSE(UnityBatcher::isHeader(main));
+    CHECK(UnityBatcher::systemIncludes(b) == std::vector<std::string>{"string", "vector"});
+
+    std::vector<ParseJob> jobs{{main, {}}, {a, {}}, {b, {}}, {c, {}}};
+    const UnityReport report = UnityBatcher(UnityOptions{}).apply(jobs);
+
+    CHECK(report.headers == 3);
+    CHECK(report.batches == 1);
+    CHECK(report.batchedHeaders == 2);
+    CHECK(report.systemIncludes == 5); // 2 + 2 + 1 cabecera a cabecera
+    CHECK(report.unityIncludes == 3);  // El lote lee <string> y <vector> una vez
+
+    // El lote ocupa el lugar de su primera cabecera; el resto conserva su orden.
+    REQUIRE(jobs.size() == 3);
+    CHECK(jobs[0].sourceFile == main);
+    CHECK(jobs[1].unityHeaders == std::vector<std::string>{a, b});
+    CHECK(jobs[2].sourceFile == c);
+    CHECK(jobs[2].unityHeaders.empty());
+    CHECK(outputCount(jobs[1]) == 2);
+}
+
+TEST_CASE("UnityBatcher no agrupa cabeceras con argumentos distintos", "[parser][unity_batcher]") {
+    const cppuml::test::TempDirectory directory;
+    const std::string a = directory.file("a.hpp");
+    const std::string b = directory.file("b.hpp");
+    writeFile(a, "#include <vector>\nstruct A {};\n");
+    writeFile(b, "#include <vector>\nstruct B {};\n");
+
+    std::vector<ParseJob> jobs{{a, {"-DONE"}}, {b, {"-DTWO"}}};
+    const UnityReport report = UnityBatcher(UnityOptions{}).apply(jobs);
+    CHECK(report.batches == 0);
+    REQUIRE(jobs.size() == 2);
+    CHECK(jobs[0].unityHeaders.empty());
+    CHECK(jobs[1].unityHeaders.empty());
+}
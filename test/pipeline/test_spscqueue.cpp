@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "pipeline/SpscQueue.h"
+
+using cppuml::pipeline::SpscQueue;
+
+TEST_CASE("SpscQueue redondea la capacidad a potencia de dos", "[pipeline][spsc_queue]") {
+    CHECK(SpscQueue<int>(1).capacity() == 1);
+    CHECK(SpscQueue<int>(3).capacity() == 4);
+    CHECK(SpscQueue<int>(8).capacity() == 8);
+    CHECK(SpscQueue<int>(100).capacity() == 128);
+}
+
+TEST_CASE("SpscQueue entrega en orden entre dos hilos", "[pipeline][spsc_queue]") {
+    constexpr int kItems = 20000;
+    SpscQueue<std::unique_ptr<int>> queue(4); // Pequeña: fuerza esperas en ambos lados
+
+    // Las aserciones de Catch2 no son seguras fuera del hilo principal.
+    bool pushed = true;
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) pushed = queue.push(std::make_unique<int>(i)) && pushed;
+        queue.close();
+    });
+
+    std::vector<int> received;
+    received.reserve(kItems);
+    for (std::unique_ptr<int> value; queue.pop(value);) received.push_back(*value);
+    producer.join();
+
+    CHECK(pushed);
+    REQUIRE(received.size() == static_cast<std::size_t>(kItems));
+    bool ordered = true;
+    for (int i = 0; i < kItems; ++i) ordered = ordered && received[i] == i;
+    CHECK(ordered);
+
+    const auto metrics = queue.metrics();
+    CHECK(metrics.capacity == 4);
+    CHECK(metrics.items == static_cast<std::size_t>(kItems));
+    CHECK(metrics.maxDepth >= 1);
+    CHECK(metrics.maxDepth <= 4);
+    CHECK(metrics.meanDepth > 0.0);
+    CHECK(queue.depth() == 0);
+}
+
+TEST_CASE("SpscQueue vacía lo pendiente tras cerrarse y rechaza más elementos", "[pipeline][spsc_queue]") {
+    SpscQueue<int> queue(4);
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.push(2));
+    queue.close();
+    CHECK_FALSE(queue.push(3));
+
+    int value = 0;
+    REQUIRE(queue.pop(value));
+    CHECK(value == 1);
+    REQUIRE(queue.pop(value));
+    CHECK(value == 2);
+    CHECK_FALSE(queue.pop(value));
+    CHECK(queue.metrics().items == 2);
+}
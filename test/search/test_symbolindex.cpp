@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "search/SymbolIndex.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::search;
+
+namespace {
+
+bool contains(const std::vector<SearchHit>& hits, const std::string& qualifiedName) {
+    return std::any_of(hits.begin(), hits.end(),
+                       [&](const SearchHit& hit) { return hit.entry->qualifiedName == qualifiedName; });
+}
+
+} // namespace
+
+TEST_CASE("SymbolIndex encuentra nombres calificados exactos", "[search]") {
+    const auto model = test::makeSampleModel();
+    const SymbolIndex index(*model);
+    REQUIRE(index.size() > 0);
+
+    const auto window = index.find("ui::Window");
+    REQUIRE(window.size() == 1);
+    CHECK(window.front()->kind == ElementKind::Class);
+    CHECK(window.front()->name == "Window");
+
+    const auto add = index.find("ui::Window::add");
+    REQUIRE(add.size() == 1);
+    CHECK(add.front()->kind == ElementKind::Method);
+    CHECK(add.front()->owner == window.front()->element);
+
+    CHECK(index.find("ui::window").empty()); // Sensible a mayúsculas
+    CHECK(index.find("Window").empty());     // Nombre completo
+
+    const auto hits = index.search("core::Registry", MatchMode::Exact);
+    REQUIRE_FALSE(hits.empty());
+    CHECK(hits.front().entry->qualifiedName == "core::Registry");
+    CHECK(hits.front().score == 1.0);
+}
+
+TEST_CASE("SymbolIndex indexa una sola vez lo que varias TUs incluyen", "[search]") {
+    // ui::Widget (y el namespace ui) están en a.cpp y en b.cpp.
+    const auto model = test::makeSampleModel();
+    const SymbolIndex index(*model);
+
+    REQUIRE(index.find("ui::Widget").size() == 1);
+    CHECK(index.find("ui::Widget::draw").size() == 1);
+    CHECK(index.find("ui::Widget::m_id").size() == 1);
+    CHECK(index.find("ui").size() == 1);
+    CHECK(index.search("ui", MatchMode::Exact).size() == 1);
+    // La copia indexada es la de la primera TU.
+    const auto& ui = model->getTranslationUnits().front()->getGlobalNamespace()->getMembers().front();
+    const auto& widget = static_cast<const Namespace&>(*ui).getMembers().front();
+    CHECK(index.find("ui::Widget").front()->element == widget.get());
+
+    for (MatchMode mode : {MatchMode::Prefix, MatchMode::Substring, MatchMode::Fuzzy}) {
+        const auto hits = index.search("widget", mode, 0);
+        CHECK(std::count_if(hits.begin(), hits.end(), [](const SearchHit& hit) {
+                  return hit.entry->qualifiedName == "ui::Widget";
+              }) == 1);
+    }
+    // b.cpp sigue aportando lo que solo está en ella.
+    CHECK(index.find("app::Main::m_window").size() == 1);
+}
+
+TEST_CASE("SymbolIndex busca por prefijo sin distinguir mayúsculas", "[search]") {
+    const auto model = test::makeSampleModel();
+    const SymbolIndex index(*model);
+
+    const auto hits = index.search("win", MatchMode::Prefix);
+    CHECK(contains(hits, "ui::Window"));
+    CHECK_FALSE(contains(hits, "ui::Widget"));
+
+    const auto qualified = index.search("UI::Wi", MatchMode::Prefix);
+    CHECK(contains(qualified, "ui::Window"));
+    CHECK(contains(qualified, "ui::Widget"));
+    CHECK_FALSE(contains(qualified, "core::Registry"));
+
+    CHECK(index.search("win", MatchMode::Prefix, 1).size() == 1);
+    CHECK(index.search("zzz", MatchMode::Prefix).empty());
+}
+
+TEST_CASE("SymbolIndex tolera errores de tecleo en la búsqueda difusa", "[search]") {
+    const auto model = test::makeSampleModel();
+    const SymbolIndex index(*model);
+
+    const auto hits = index.search("Registy", MatchMode::Fuzzy);
+    REQUIRE_FALSE(hits.empty());
+    CHECK(hits.front().entry->qualifiedName == "core::Registry");
+    CHECK(hits.front().score < 1.0);
+    CHECK(std::is_sorted(hits.begin(), hits.end(),
+                         [](const SearchHit& a, const SearchHit& b) { return a.score > b.score; }));
+
+    CHECK(index.search("qqqqqq", MatchMode::Fuzzy).empty());
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "serialization/ModelSerializer.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using cppuml::serialization::ModelSerializer;
+
+namespace {
+
+const Class* findClass(const Namespace& ns, const std::string& name) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Class && member->getName() == name) {
+            return static_cast<const Class*>(member.get());
+        }
+    }
+    return nullptr;
+}
+
+const Namespace* findNamespace(const Namespace& ns, const std::string& name) {
+    for (const auto& member : ns.getMembers()) {
+        if (member->getKind() == ElementKind::Namespace && member->getName() == name) {
+            return static_cast<const Namespace*>(member.get());
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("ModelSerializer conserva una TU al ida y vuelta", "[serialization]") {
+    const auto model = test::makeSampleModel();
+    const TranslationUnit& original = *model->getTranslationUnits().front();
+
+    std::string bytes;
+    ModelSerializer::serialize(original, bytes);
+    const auto copy = ModelSerializer::deserializeTranslationUnit(bytes);
+    REQUIRE(copy);
+
+    // Volver a codificarla da exactamente los mismos bytes.
+    std::string again;
+    ModelSerializer::serialize(*copy, again);
+    CHECK(again == bytes);
+
+    CHECK(copy->getName() == "a.cpp");
+    const Namespace* ui = findNamespace(*copy->getGlobalNamespace(), "ui");
+    REQUIRE(ui);
+    const Class* window = findClass(*ui, "Window");
+    REQUIRE(window);
+    REQUIRE(window->getBaseClasses().size() == 1);
+    CHECK(window->getBaseClasses().front().baseName == "ui::Widget");
+    REQUIRE(window->getMethods().size() == 2);
+    CHECK(window->getMethods()[1]->isConst());
+    REQUIRE(window->getMethods()[0]->getParameters().size() == 1);
+    CHECK(window->getMethods()[0]->getParameters()[0]->getType().isPointer());
+
+    // El campo plantilla cita la instanciación que la TU registra.
+    const Namespace* core = findNamespace(*copy->getGlobalNamespace(), "core");
+    REQUIRE(core);
+    const Class* registry = findClass(*core, "Registry");
+    REQUIRE(registry);
+    REQUIRE(copy->getTemplateBindings().size() == 1);
+    const Type& items = registry->getFields().front()->getType();
+    CHECK(items.getBinding() == copy->getTemplateBindings().front());
+    CHECK(items.getFullName() == "core::Box<ui::Widget>");
+}
+
+TEST_CASE("ModelSerializer conserva una clase suelta y un modelo", "[serialization]") {
+    const auto model = test::makeSampleModel();
+
+    SECTION("clase") {
+        const Namespace* ui = findNamespace(*model->getTranslationUnits().front()->getGlobalNamespace(), "ui");
+        const Class* widget = findClass(*ui, "Widget");
+        std::string bytes;
+        ModelSerializer::serialize(*widget, bytes);
+        const auto copy = ModelSerializer::deserializeClass(bytes);
+        REQUIRE(copy);
+        CHECK(copy->getName() == "Widget");
+        REQUIRE(copy->getMethods().size() == 1);
+        CHECK(copy->getMethods().front()->isVirtual());
+    }
+    SECTION("modelo") {
+        std::string bytes;
+        ModelSerializer::serialize(*model, bytes);
+        const auto copy = ModelSerializer::deserializeModel(bytes);
+        REQUIRE(copy);
+        REQUIRE(copy->getTranslationUnits().size() == 2);
+        CHECK(copy->getTranslationUnits()[1]->getName() == "b.cpp");
+        std::string again;
+        ModelSerializer::serialize(*copy, again);
+        CHECK(again == bytes);
+    }
+}
+
+TEST_CASE("ModelSerializer rechaza datos truncados o corruptos", "[serialization]") {
+    const auto model = test::makeSampleModel();
+    std::string bytes;
+    ModelSerializer::serialize(*model->getTranslationUnits().front(), bytes);
+    REQUIRE(bytes.size() > 8);
+
+    SECTION("cualquier prefijo") {
+        for (std::size_t length = 0; length < bytes.size(); ++length) {
+            INFO("longitud " << length);
+            CHECK_FALSE(ModelSerializer::deserializeTranslationUnit(std::string_view(bytes).substr(0, length)));
+        }
+    }
+    SECTION("cabecera o versión distintas") {
+        std::string badMagic = bytes;
+        badMagic[0] = 'X';
+        CHECK_FALSE(ModelSerializer::deserializeTranslationUnit(badMagic));
+
+        std::string badVersion = bytes;
+        badVersion[4] = static_cast<char>(badVersion[4] + 1);
+        CHECK_FALSE(ModelSerializer::deserializeTranslationUnit(badVersion));
+    }
+    SECTION("basura") {
+        CHECK_FALSE(ModelSerializer::deserializeTranslationUnit(std::string(64, '\xff')));
+        CHECK_FALSE(ModelSerializer::deserializeModel(std::string("CUML")));
+    }
+}
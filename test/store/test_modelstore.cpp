@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "store/ModelStore.h"
+#include "test_support.h"
+
+using namespace cppuml;
+using namespace cppuml::store;
+
+TEST_CASE("ModelStore abre el esqueleto de un índice guardado", "[store]") {
+    const test::TempDirectory directory;
+    const auto model = test::makeSampleModel();
+    REQUIRE(ModelStore::save(*model, directory.file("model.idx")));
+
+    const auto store = ModelStore::open(directory.file("model.idx"));
+    REQUIRE(store);
+    // ui::Widget está en las dos TUs pero es una sola entrada.
+    CHECK(store->classCount() == 6);
+    const ClassId window = store->find("ui::Window");
+    REQUIRE(window != kNotFound);
+    CHECK(store->qualifiedName(window) == "ui::Window");
+    CHECK(store->find("ui::Missing") == kNotFound);
+    CHECK(store->stats().cachedClasses == 0); // Nada de detalles todavía
+
+    const auto details = store->details(window);
+    REQUIRE(details);
+    CHECK(details->getName() == "Window");
+    CHECK(details->getFields().size() == 1);
+    CHECK(details->getMethods().size() == 2);
+
+    CHECK_FALSE(ModelStore::open(directory.file("missing.idx")));
+}
+
+TEST_CASE("ModelStore expulsa de la caché la clase usada hace más tiempo", "[store]") {
+    const test::TempDirectory directory;
+    const auto model = test::makeSampleModel();
+    REQUIRE(ModelStore::save(*model, directory.file("model.idx")));
+    const auto store = ModelStore::open(directory.file("model.idx"));
+    REQUIRE(store);
+
+    const ClassId a = store->find("ui::Widget");
+    const ClassId b = store->find("ui::Window");
+    const ClassId c = store->find("app::Main"); // No mayor que Window
+    REQUIRE(store->details(a));
+    REQUIRE(store->details(b));
+    CHECK(store->stats().misses == 2);
+
+    // Justo lo que ocupan A y B: C solo cabe expulsando una de ellas.
+    store->setCacheBudget(store->stats().cachedBytes);
+    CHECK(store->stats().evictions == 0);
+
+    REQUIRE(store->details(a)); // A pasa a ser la más reciente
+    CHECK(store->stats().hits == 1);
+
+    REQUIRE(store->details(c));
+    StoreStats stats = store->stats();
+    CHECK(stats.evictions == 1);
+    CHECK(stats.cachedClasses == 2);
+    CHECK(stats.cachedBytes <= stats.cacheBudget);
+
+    REQUIRE(store->details(a)); // Sigue en caché
+    CHECK(store->stats().hits == 2);
+    REQUIRE(store->details(b)); // Fue la expulsada: se vuelve a leer
+    CHECK(store->stats().misses == 4);
+}
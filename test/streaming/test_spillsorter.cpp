@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "streaming/SpillSorter.h"
+#include "test_support.h"
+
+using cppuml::streaming::SpillSorter;
+
+namespace {
+
+std::string key(int i) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "k%03d", i);
+    return buffer;
+}
+
+/// Un valor que por sí solo llena la memoria mínima del sorter (64 KiB).
+std::string bigValue(int i) {
+    return "v" + std::to_string(i) + "|" + std::string(std::size_t(1) << 16, '.');
+}
+
+std::string tagOf(const std::string& value) {
+    return value.substr(0, value.find('|'));
+}
+
+} // namespace
+
+TEST_CASE("SpillSorter mezcla más runs que el fan-in en varias pasadas", "[streaming][spill_sorter]") {
+    const cppuml::test::TempDirectory directory;
+    // Cada par supera la memoria mínima, así que se vuelca en su propio run.
+    SpillSorter sorter(directory.path().string(), 1);
+
+    // 150 pares en orden descendente; las claves 50..99 se repiten con otro valor.
+    constexpr int kKeys = 100;
+    constexpr int kPairs = 150;
+    for (int i = 0; i < kPairs; ++i) {
+        const int k = (kKeys - 1) - (i % kKeys);
+        REQUIRE(sorter.add(key(k), bigValue(i)));
+    }
+    REQUIRE(sorter.runCount() > 64);
+    CHECK(sorter.spilledBytes() > 0);
+
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    REQUIRE(sorter.merge([&](const std::string& k, const std::string& v) {
+        keys.push_back(k);
+        values.push_back(tagOf(v));
+        return true;
+    }));
+
+    REQUIRE(keys.size() == static_cast<std::size_t>(kKeys));
+    for (int k = 0; k < kKeys; ++k) {
+        INFO("clave " << k);
+        CHECK(keys[k] == key(k));
+        // Gana el primer valor añadido, no el del último run ni el de la última pasada.
+        CHECK(values[k] == "v" + std::to_string(kKeys - 1 - k));
+    }
+}
+
+TEST_CASE("SpillSorter mezcla lo pendiente en memoria con los runs", "[streaming][spill_sorter]") {
+    const cppuml::test::TempDirectory directory;
+    SpillSorter sorter(directory.path().string(), 1);
+    for (int i = 0; i < 20; ++i) REQUIRE(sorter.add(key(19 - i), "first"));
+    REQUIRE(sorter.add(key(5), bigValue(0)));  // Vuelca las 21 primeras
+    REQUIRE(sorter.add(key(7), "pending"));    // Queda en memoria
+    CHECK(sorter.runCount() == 1);
+
+    std::vector<std::string> keys;
+    REQUIRE(sorter.merge([&](const std::string& k, const std::string& v) {
+        CHECK(v == "first");
+        keys.push_back(k);
+        return true;
+    }));
+    REQUIRE(keys.size() == 20);
+    CHECK(keys.front() == key(0));
+    CHECK(keys.back() == key(19));
+}
+
+TEST_CASE("SpillSorter se detiene cuando el visitante lo pide", "[streaming][spill_sorter]") {
+    const cppuml::test::TempDirectory directory;
+    SpillSorter sorter(directory.path().string(), 1);
+    for (int i = 0; i < 10; ++i) REQUIRE(sorter.add(key(i), bigValue(i)));
+
+    std::size_t visited = 0;
+    sorter.merge([&](const std::string&, const std::string&) { return ++visited < 3; });
+    CHECK(visited == 3);
+}
@@ -0,0 +1,171 @@
+#ifndef CPP_UML_GENERATOR_TEST_TEST_SUPPORT_H
+#define CPP_UML_GENERATOR_TEST_TEST_SUPPORT_H
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include "model/Class.h"
+#include "model/Field.h"
+#include "model/Method.h"
+#include "model/Model.h"
+#include "model/Namespace.h"
+#include "model/TemplateBinding.h"
+#include "model/TranslationUnit.h"
+#include "parser/symbol_resolver.h"
+
+namespace cppuml {
+namespace test {
+
+// --- Construcción de Modelos ---
+
+inline Namespace* addNamespace(Namespace& parent, const std::string& name) {
+    auto ns = std::make_unique<Namespace>(name);
+    Namespace* ptr = ns.get();
+    parent.addMember(std::move(ns));
+    return ptr;
+}
+
+inline Class* addClass(Namespace& parent, const std::string& name, ClassKind kind = ClassKind::Class) {
+    auto cls = std::make_unique<Class>(name, kind);
+    cls->setVisibility(Visibility::Public);
+    Class* ptr = cls.get();
+    parent.addMember(std::move(cls));
+    return ptr;
+}
+
+inline Field* addField(Class& cls, const std::string& name, Type type, Visibility visibility = Visibility::Private) {
+    auto field = std::make_unique<Field>(name, std::move(type));
+    field->setVisibility(visibility);
+    Field* ptr = field.get();
+    cls.addField(std::move(field));
+    return ptr;
+}
+
+inline Method* addMethod(Class& cls, const std::string& name, const std::string& returnType,
+                         Visibility visibility = Visibility::Public) {
+    auto method = std::make_unique<Method>(name, Type(returnType));
+    method->setVisibility(visibility);
+    Method* ptr = method.get();
+    cls.addMethod(std::move(method));
+    return ptr;
+}
+
+/// Un tipo enlazado a una instanciación ("core::Box<ui::Widget>").
+inline Type boundType(const std::shared_ptr<const TemplateBinding>& binding) {
+    Type type{std::string()};
+    type.setBinding(binding);
+    return type;
+}
+
+/**
+ * @brief Variaciones de makeSampleModel (para comparar dos versiones).
+ */
+struct SampleEdits {
+    bool dropDialog = false;   ///< Sin ui::Dialog
+    bool addButton = false;    ///< Con ui::Button : ui::Widget
+    bool windowTitle = false;  ///< ui::Window con un campo más ('m_title')
+};
+
+/**
+ * @brief Un modelo pequeño, ya enlazado, con dos TUs:
+ *
+ * a.cpp:
+ *   ui::Widget { +draw() : void; -m_id : int }
+ *   ui::Window : ui::Widget { -m_child : Widget; +add(w : Widget*) : void; +title() const : std::string }
+ *   ui::Dialog : ui::Window
+ *   core::Box<T> { -m_value : T }
+ *   core::Registry { -m_items : core::Box<ui::Widget> }
+ * b.cpp (incluye de nuevo ui::Widget):
+ *   ui::Widget
+ *   app::Main { -m_window : ui::Window }
+ */
+inline std::unique_ptr<Model> makeSampleModel(const SampleEdits& edits = {}) {
+    auto model = std::make_unique<Model>();
+
+    auto binding = std::make_shared<TemplateBinding>();
+    binding->canonicalName = "core::Box<ui::Widget>";
+    binding->templateName = "core::Box";
+    binding->arguments.emplace_back("ui::Widget");
+
+    auto a = std::make_unique<TranslationUnit>("a.cpp");
+    a->addTemplateBinding(binding);
+    Namespace* ui = addNamespace(*a->getGlobalNamespace(), "ui");
+    Class* widget = addClass(*ui, "Widget");
+    addMethod(*widget, "draw", "void")->setVirtual();
+    addField(*widget, "m_id", Type("int"));
+
+    Class* window = addClass(*ui, "Window");
+    window->addBaseClass(std::string("ui::Widget"), Visibility::Public);
+    addField(*window, "m_child", Type("Widget"));
+    if (edits.windowTitle) addField(*window, "m_title", Type("std::string"));
+    Method* add = addMethod(*window, "add", "void");
+    Type pointer("Widget");
+    pointer.setPointer();
+    add->addParameter(std::make_unique<Field>("w", pointer));
+    addMethod(*window, "title", "std::string")->setConst();
+
+    if (!edits.dropDialog) {
+        addClass(*ui, "Dialog")->addBaseClass(std::string("ui::Window"), Visibility::Public);
+    }
+    if (edits.addButton) {
+        addClass(*ui, "Button")->addBaseClass(std::string("ui::Widget"), Visibility::Public);
+    }
+
+    Namespace* core = addNamespace(*a->getGlobalNamespace(), "core");
+    Class* box = addClass(*core, "Box");
+    box->addTemplateParameter(TemplateParameter{"T", "typename", "", false});
+    addField(*box, "m_value", Type("T"));
+    Class* registry = addClass(*core, "Registry");
+    addField(*registry, "m_items", boundType(binding));
+    model->addTranslationUnit(std::move(a));
+
+    auto b = std::make_unique<TranslationUnit>("b.cpp");
+    Namespace* uiAgain = addNamespace(*b->getGlobalNamespace(), "ui");
+    Class* widgetAgain = addClass(*uiAgain, "Widget");
+    addMethod(*widgetAgain, "draw", "void")->setVirtual();
+    addField(*widgetAgain, "m_id", Type("int"));
+    Namespace* app = addNamespace(*b->getGlobalNamespace(), "app");
+    addField(*addClass(*app, "Main"), "m_window", Type("ui::Window"));
+    model->addTranslationUnit(std::move(b));
+
+    parser::SymbolResolver::resolve(*model);
+    return model;
+}
+
+// --- Archivos Temporales ---
+
+/**
+ * @brief Un directorio temporal propio que se borra (con su contenido) al destruirse.
+ */
+class TempDirectory {
+public:
+    TempDirectory() {
+        static std::atomic<unsigned> serial{0};
+        m_path = std::filesystem::temp_directory_path() /
+                 ("cppuml-test-" + std::to_string(::getpid()) + "-" + std::to_string(serial++));
+        std::filesystem::create_directories(m_path);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    const std::filesystem::path& path() const { return m_path; }
+    std::string file(const std::string& name) const { return (m_path / name).string(); }
+
+private:
+    std::filesystem::path m_path;
+};
+
+} // namespace test
+} // namespace cppuml
+
+#endif // CPP_UML_GENERATOR_TEST_TEST_SUPPORT_H